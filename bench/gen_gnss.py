@@ -0,0 +1,603 @@
+#!/usr/bin/env python
+# coding:utf-8
+
+
+################################################################################
+# PROGRAM:
+################################################################################
+"""
+
+ Synthetic GNSS file generator for the benchmarks of GOOD, the same files are generated for the same seed
+
+ Usage: python gen_gnss.py obs -out <dir> [-ver 2|3] [-fmt rnx|crx] [-sites <num>] [-rate <sec>] [-hours <num>] [-sys <GRECJI>]
+           [-nsat <num>] [-time <yyyy> <doy>] [-seed <seed>] [-zip none|gz|Z]
+        python gen_gnss.py sp3 -out <dir> [-ver c|d] [-ac <AC>] [-rate <sec>] [-sys <GRECJI>] [-nsat <num>] [-time <yyyy> <doy>] ...
+        python gen_gnss.py clk -out <dir> [-ac <AC>] [-rate <sec>] [-sites <num>] [-sys <GRECJI>] [-nsat <num>] [-time <yyyy> <doy>] ...
+        python gen_gnss.py ionex -out <dir> [-ac <AC>] [-rate <sec>] [-time <yyyy> <doy>] ...
+
+ OPTIONS:
+   <obs>           - RINEX observation files, one per station, i.e., 'b0011000.26o' (RINEX 2.11) or
+                      'B00100XXX_R_20261000000_01D_30S_MO.rnx' (RINEX 3.04), or their Hatanaka-compressed files (CRINEX 1.0/3.0)
+                      'b0011000.26d' and '*.crx' for '-fmt crx'
+   <sp3>           - SP3-c or SP3-d precise orbit file, i.e., 'IGS0OPSFIN_20261000000_01D_15M_ORB.SP3'
+   <clk>           - RINEX clock (3.00) file with the satellite and station clocks, i.e., 'IGS0OPSFIN_20261000000_01D_30S_CLK.CLK'
+   <ionex>         - IONEX (1.0) global ionosphere map file, i.e., 'COD0OPSFIN_20261000000_01D_01H_GIM.INX'
+   <-out>          - The output directory
+   <-ver>          - [optional] The version, '2' or '3' for 'obs' (default: 3), 'c' or 'd' for 'sp3' (default: 'd')
+   <-fmt>          - [optional] 'rnx' (RINEX) or 'crx' (Hatanaka-compressed), valid only for 'obs' (default: 'crx')
+   <-sites>        - [optional] The number of stations of 'obs' and 'clk' (default: 1)
+   <-rate>         - [optional] The sampling interval (s), i.e., 1, 5 or 30 for 'obs' (default: 30 for 'obs' and 'clk', 900 for
+                      'sp3', 3600 for 'ionex')
+   <-hours>        - [optional] The hours spanned from 00:00 (default: 24)
+   <-sys>          - [optional] The constellations, 'G': GPS, 'R': GLONASS, 'E': Galileo, 'C': BDS, 'J': QZSS, 'I': IRNSS
+                      (default: 'GRECJI')
+   <-nsat>         - [optional] The maximum number of satellites of each constellation (default: all)
+   <-ac>           - [optional] The 3-character analysis center of the products (default: 'IGS')
+   <-time>         - [optional] The 4-digit year and the day of year (default: 2026 100)
+   <-seed>         - [optional] The seed (default: 1)
+   <-zip>          - [optional] The compression of the files written, 'none', 'gz' or 'Z' (LZW of 'compress') (default: 'none')
+
+ EXAMPLES: python gen_gnss.py obs -out ./obs -ver 2 -sites 100 -rate 30 -zip Z
+           python gen_gnss.py obs -out ./hr -ver 3 -rate 1 -hours 1 -sys GEC
+           python gen_gnss.py sp3 -out ./orb -ver c -sys G -ac COD
+
+ Changes:
+   19-Oct-2026   new
+
+ DEPENDENCIES:
+   Python 3.6 or later (standard library only)
+
+"""
+
+import argparse
+import datetime
+import gzip
+import math
+import os
+import random
+import sys
+
+CLIGHT = 299792458.0                                          # speed of light (m/s)
+NSATS = {'G': 32, 'R': 24, 'E': 36, 'C': 46, 'J': 7, 'I': 7}  # the satellites of each constellation
+FREQS = {                                                     # the frequencies (MHz) of the bands of each constellation
+    'G': {'1': 1575.42, '2': 1227.60, '5': 1176.45},
+    'R': {'1': 1602.00, '2': 1246.00},
+    'E': {'1': 1575.42, '5': 1176.45, '7': 1207.14},
+    'C': {'2': 1561.098, '6': 1268.52, '7': 1207.14},
+    'J': {'1': 1575.42, '2': 1227.60, '5': 1176.45},
+    'I': {'5': 1176.45},
+}
+OBSTYPES3 = {                                                 # the observation types of RINEX 3 of each constellation
+    'G': ['C1C', 'L1C', 'D1C', 'S1C', 'C2W', 'L2W', 'S2W', 'C5Q', 'L5Q', 'S5Q'],
+    'R': ['C1C', 'L1C', 'D1C', 'S1C', 'C2P', 'L2P', 'S2P'],
+    'E': ['C1C', 'L1C', 'D1C', 'S1C', 'C5Q', 'L5Q', 'S5Q', 'C7Q', 'L7Q', 'S7Q'],
+    'C': ['C2I', 'L2I', 'D2I', 'S2I', 'C6I', 'L6I', 'S6I', 'C7I', 'L7I', 'S7I'],
+    'J': ['C1C', 'L1C', 'D1C', 'S1C', 'C2L', 'L2L', 'S2L', 'C5Q', 'L5Q', 'S5Q'],
+    'I': ['C5A', 'L5A', 'D5A', 'S5A'],
+}
+OBSTYPES2 = ['C1', 'P2', 'L1', 'L2', 'D1', 'S1', 'S2', 'C5', 'L5', 'S5']  # the observation types of RINEX 2
+SYSNAMES = {'G': 'GPS', 'R': 'GLONASS', 'E': 'Galileo', 'C': 'BDS', 'J': 'QZSS', 'I': 'IRNSS'}
+
+
+################################################################################
+# time and satellites
+################################################################################
+def epoch(yyyy, doy):
+    """the first epoch (00:00 of one day), the GPS week and the day of week"""
+    t = datetime.datetime(yyyy, 1, 1) + datetime.timedelta(days=doy - 1)
+    gpsd = (t.date() - datetime.date(1980, 1, 6)).days
+    return t, gpsd // 7, gpsd % 7
+
+
+def satellites(syss, nsat):
+    """the satellites of the constellations, i.e., ['G01', 'G02', ..., 'R01', ...]"""
+    sats = []
+    for s in syss:
+        n = NSATS[s] if nsat <= 0 else min(nsat, NSATS[s])
+        sats += ['%s%02d' % (s, i + 1) for i in range(n)]
+    return sats
+
+
+class Sky:
+    """the smooth geometry of the satellites seen by one station, deterministic for the seed and the station"""
+
+    def __init__(self, seed, site, sats):
+        rnd = random.Random('%d:%s' % (seed, site))
+        self.rnd = rnd
+        self.geo = {}
+        for sat in sats:
+            period = 43082.0 if sat[0] in 'GJ' else 40544.0 if sat[0] == 'R' else 50680.0 if sat[0] == 'E' else 45900.0
+            isgeo = (sat[0] == 'C' and int(sat[1:]) <= 5) or sat[0] == 'I'
+            self.geo[sat] = {
+                'w': 2.0 * math.pi / period, 'phi': rnd.uniform(0.0, 2.0 * math.pi), 'geo': isgeo,
+                'r0': rnd.uniform(2.05e7, 2.25e7) if not isgeo else rnd.uniform(3.6e7, 3.8e7),
+                'amp': rnd.uniform(2.0e6, 3.5e6) if not isgeo else rnd.uniform(1.0e4, 5.0e4),
+                'clk': rnd.uniform(-3.0e-4, 3.0e-4), 'drift': rnd.uniform(-1.0e-11, 1.0e-11),
+                'amb': {b: rnd.randint(-2000000, 2000000) for b in '125678'},
+            }
+
+    def elevation(self, sat, sec):
+        g = self.geo[sat]
+        if g['geo']:
+            return 0.6
+        return math.sin(g['w'] * sec + g['phi'])
+
+    def range(self, sat, sec):
+        """the geometric range (m) and its rate (m/s)"""
+        g = self.geo[sat]
+        x = g['w'] * sec + g['phi']
+        return g['r0'] - g['amp'] * math.sin(x), -g['amp'] * g['w'] * math.cos(x)
+
+    def clock(self, sat, sec):
+        g = self.geo[sat]
+        return g['clk'] + g['drift'] * sec
+
+
+################################################################################
+# observations
+################################################################################
+def observe(sky, sat, sec, types, rnd):
+    """the observations (value or None, LLI, SSI) of one satellite at one epoch"""
+    rho, rate = sky.range(sat, sec)
+    g = sky.geo[sat]
+    el = sky.elevation(sat, sec)
+    snr = 30.0 + 20.0 * max(el, 0.0)
+    slip = rnd.random() < 2.0e-4
+    obs = []
+    for t in types:
+        band = t[1]
+        f = FREQS[sat[0]].get(band, 1575.42) * 1.0e6
+        lam = CLIGHT / f
+        if rnd.random() < 0.005 and t[0] != 'C':
+            obs.append((None, ' ', ' '))
+            continue
+        if t[0] == 'C' or t[0] == 'P':
+            v = rho + rnd.gauss(0.0, 0.3)
+        elif t[0] == 'L':
+            if slip:
+                g['amb'][band] += rnd.randint(-50, 50)
+            v = rho / lam + g['amb'][band] + rnd.gauss(0.0, 0.01)
+        elif t[0] == 'D':
+            v = -rate / lam + rnd.gauss(0.0, 0.05)
+        else:
+            v = snr + rnd.gauss(0.0, 0.5)
+        lli = '1' if slip and t[0] == 'L' else ' '
+        ssi = str(min(9, max(1, int(snr / 6.0)))) if t[0] == 'L' else ' '
+        obs.append((round(v, 3) + 0.0, lli, ssi))  # no negative zero
+    return obs
+
+
+def epochs(t0, rate, hours):
+    n = int(hours * 3600 / rate)
+    return [(i * rate, t0 + datetime.timedelta(seconds=i * rate)) for i in range(n)]
+
+
+def visible(sky, sats, sec):
+    return [s for s in sats if sky.elevation(s, sec) > 0.05]
+
+
+def rinex2_header(site, syss, rate, t0, types):
+    h = []
+    h.append('%9s%11s%-20s%-20s%-20s' % ('2.11', '', 'OBSERVATION DATA', 'M (MIXED)' if len(syss) > 1 else syss[0], 'RINEX VERSION / TYPE'))
+    h.append('%-20s%-20s%-20s%-20s' % ('gen_gnss.py', 'GOOD', t0.strftime('%d-%b-%y %H:%M').upper(), 'PGM / RUN BY / DATE'))
+    h.append('%-60s%-20s' % (site.upper(), 'MARKER NAME'))
+    h.append('%-60s%-20s' % (site.upper() + ' M001', 'MARKER NUMBER'))
+    h.append('%-20s%-40s%-20s' % ('GOOD', 'UNIQ', 'OBSERVER / AGENCY'))
+    h.append('%-20s%-20s%-20s%-20s' % ('0001', 'SYNTHETIC', '1.0', 'REC # / TYPE / VERS'))
+    h.append('%-20s%-20s%-20s%-20s' % ('0001', 'SYNTHETIC NONE', '', 'ANT # / TYPE'))
+    h.append('%14.4f%14.4f%14.4f%18s%-20s' % (-2148744.3969, 4426641.2099, 4044655.8564, '', 'APPROX POSITION XYZ'))
+    h.append('%14.4f%14.4f%14.4f%18s%-20s' % (0.0, 0.0, 0.0, '', 'ANTENNA: DELTA H/E/N'))
+    h.append('%6d%6d%48s%-20s' % (1, 1, '', 'WAVELENGTH FACT L1/2'))
+    line = '%6d' % len(types)
+    for i, t in enumerate(types):
+        if i > 0 and i % 9 == 0:
+            h.append('%-60s%-20s' % (line, '# / TYPES OF OBSERV'))
+            line = '      '
+        line += '    %2s' % t
+    h.append('%-60s%-20s' % (line, '# / TYPES OF OBSERV'))
+    h.append('%10.3f%50s%-20s' % (rate, '', 'INTERVAL'))
+    h.append('%6d%6d%6d%6d%6d%13.7f%5s%3s%9s%-20s' % (t0.year, t0.month, t0.day, 0, 0, 0.0, '', 'GPS', '', 'TIME OF FIRST OBS'))
+    h.append('%-60s%-20s' % ('', 'END OF HEADER'))
+    return [l.rstrip() for l in h]
+
+
+def rinex3_header(site, syss, rate, t0):
+    h = []
+    h.append('%9s%11s%-20s%-20s%-20s' % ('3.04', '', 'OBSERVATION DATA', 'M' if len(syss) > 1 else syss[0], 'RINEX VERSION / TYPE'))
+    h.append('%-20s%-20s%-20s%-20s' % ('gen_gnss.py', 'GOOD', t0.strftime('%Y%m%d %H%M%S') + ' UTC', 'PGM / RUN BY / DATE'))
+    h.append('%-60s%-20s' % (site.upper(), 'MARKER NAME'))
+    h.append('%-60s%-20s' % (site.upper() + ' M001', 'MARKER NUMBER'))
+    h.append('%-20s%-40s%-20s' % ('GOOD', 'UNIQ', 'OBSERVER / AGENCY'))
+    h.append('%-20s%-20s%-20s%-20s' % ('0001', 'SYNTHETIC', '1.0', 'REC # / TYPE / VERS'))
+    h.append('%-20s%-20s%-20s%-20s' % ('0001', 'SYNTHETIC NONE', '', 'ANT # / TYPE'))
+    h.append('%14.4f%14.4f%14.4f%18s%-20s' % (-2148744.3969, 4426641.2099, 4044655.8564, '', 'APPROX POSITION XYZ'))
+    h.append('%14.4f%14.4f%14.4f%18s%-20s' % (0.0, 0.0, 0.0, '', 'ANTENNA: DELTA H/E/N'))
+    for s in syss:
+        types = OBSTYPES3[s]
+        line = '%1s  %3d' % (s, len(types))
+        for i, t in enumerate(types):
+            if i > 0 and i % 13 == 0:
+                h.append('%-60s%-20s' % (line, 'SYS / # / OBS TYPES'))
+                line = '      '
+            line += ' %3s' % t
+        h.append('%-60s%-20s' % (line, 'SYS / # / OBS TYPES'))
+    h.append('%10.3f%50s%-20s' % (rate, '', 'INTERVAL'))
+    h.append('%6d%6d%6d%6d%6d%13.7f%5s%3s%9s%-20s' % (t0.year, t0.month, t0.day, 0, 0, 0.0, '', 'GPS', '', 'TIME OF FIRST OBS'))
+    h.append('%-60s%-20s' % ('', 'END OF HEADER'))
+    return [l.rstrip() for l in h]
+
+
+def field(o):
+    """one observation of RINEX, F14.3 with LLI and SSI, the leading zero of a fraction is omitted as 'crx2rnx'"""
+    v, lli, ssi = o
+    if v is None:
+        return ' ' * 14 + lli + ssi
+    return ('%14.3f' % v).replace(' -0.', '  -.').replace(' 0.', '  .') + lli + ssi
+
+
+def epoch_line(ver, t, sats):
+    sec = t.second + t.microsecond * 1.0e-6
+    if ver == 2:
+        return ' %02d %2d %2d %2d %2d%11.7f  %d%3d' % (t.year % 100, t.month, t.day, t.hour, t.minute, sec, 0, len(sats))
+    return '> %04d %02d %02d %02d %02d%11.7f  %d%3d' % (t.year, t.month, t.day, t.hour, t.minute, sec, 0, len(sats))
+
+
+def rinex_lines(ver, site, syss, sats, rate, hours, t0, seed):
+    """the lines of one RINEX observation file and the records of its epochs for the Hatanaka compression"""
+    sky = Sky(seed, site, sats)
+    rnd = random.Random('%d:%s:obs' % (seed, site))
+    types2 = [t for t in OBSTYPES2]
+    lines = rinex2_header(site, syss, rate, t0, types2) if ver == 2 else rinex3_header(site, syss, rate, t0)
+    records = []
+    for sec, t in epochs(t0, rate, hours):
+        vis = visible(sky, sats, sec)
+        data = {s: observe(sky, s, sec, types2 if ver == 2 else OBSTYPES3[s[0]], rnd) for s in vis}
+        head = epoch_line(ver, t, vis)
+        if ver == 2:
+            ids = ''.join(vis)
+            lines.append(head + ids[:36])
+            for i in range(36, len(ids), 36):
+                lines.append(' ' * 32 + ids[i:i + 36])
+            for s in vis:
+                fs = [field(o) for o in data[s]]
+                for i in range(0, len(fs), 5):
+                    lines.append(''.join(fs[i:i + 5]).rstrip())
+        else:
+            lines.append(head)
+            for s in vis:
+                lines.append((s + ''.join(field(o) for o in data[s])).rstrip())
+        records.append((head, vis, data))
+    return lines, records
+
+
+################################################################################
+# Hatanaka compression (CRINEX 1.0 for RINEX 2, CRINEX 3.0 for RINEX 3)
+################################################################################
+def textdiff(old, new):
+    """the text difference of CRINEX: the same characters are blank, the changed to blank are '&', trailing blanks removed"""
+    if old == new:
+        return ''
+    out = []
+    for i in range(max(len(old), len(new))):
+        o = old[i] if i < len(old) else ' '
+        n = new[i] if i < len(new) else ' '
+        out.append(' ' if o == n else '&' if n == ' ' else n)
+    return ''.join(out).rstrip()
+
+
+def crinex_lines(ver, header, records):
+    """the lines of one CRINEX file, the observations are the 3rd-order differences of their arcs"""
+    lines = ['%-20s%-40s%-20s' % ('1.0' if ver == 2 else '3.0', 'COMPACT RINEX FORMAT', 'CRINEX VERS   / TYPE'),
+             '%-40s%-20s%-20s' % ('gen_gnss.py', '19-Oct-26 00:00', 'CRINEX PROG / DATE')]
+    lines += header
+    oldepoch = ''
+    arcs = {}      # the differences of each arc, (satellite, index) -> [order 0, order 1, ...]
+    flags = {}     # the LLI and SSI of each satellite of the last epoch
+    for head, vis, data in records:
+        if ver == 2:
+            newepoch = head + ''.join(vis)
+        else:
+            newepoch = '%-41s' % head + ''.join(vis)
+        if not oldepoch:
+            lines.append(('&' + newepoch[1:]) if ver == 2 else newepoch)
+        else:
+            lines.append(textdiff(oldepoch, newepoch))
+        oldepoch = newepoch
+        lines.append('')  # no receiver clock offset
+        seen = set(vis)
+        for key in [k for k in arcs if k[0] not in seen]:
+            del arcs[key]
+        for s in [k for k in flags if k not in seen]:
+            del flags[s]
+        for s in vis:
+            fields = []
+            fl = ''
+            for i, (v, lli, ssi) in enumerate(data[s]):
+                fl += lli + ssi
+                if v is None:
+                    arcs.pop((s, i), None)
+                    fields.append('')
+                    continue
+                y = int(round(v * 1000.0))
+                arc = arcs.get((s, i))
+                if arc is None:
+                    arcs[(s, i)] = [y]
+                    fields.append('3&%d' % y)
+                    continue
+                new = [y]
+                for k in range(1, min(len(arc) + 1, 4)):
+                    new.append(new[k - 1] - arc[k - 1])
+                arcs[(s, i)] = new
+                fields.append('%d' % new[-1])
+            # the flags of one new satellite are written in full, so that their length is kept by the decoder
+            fdiff = textdiff(flags[s], fl) if s in flags else fl
+            flags[s] = fl
+            line = ' '.join(fields)
+            line = (line + ' ' + fdiff) if fdiff else line.rstrip()
+            lines.append(line)
+    return lines
+
+
+################################################################################
+# products
+################################################################################
+def sp3_lines(ver, ac, sats, rate, hours, t0, seed):
+    """the lines of one SP3-c or SP3-d file, the positions (km) and clocks (microsecond) of the satellites"""
+    _, week, dow = epoch(t0.year, t0.timetuple().tm_yday)
+    eps = epochs(t0, rate, hours)
+    if ver == 'c':
+        sats = sats[:85]
+    sky = Sky(seed, 'sp3', sats)
+    rnd = random.Random('%d:sp3' % seed)
+    mjd = (t0.date() - datetime.date(1858, 11, 17)).days
+    lines = ['#%sP%4d %2d %2d %2d %2d %11.8f %7d ORBIT IGS20 HLM  %-4s' % (ver, t0.year, t0.month, t0.day, 0, 0, 0.0, len(eps), ac[:4]),
+             '## %4d %15.8f %14.8f %5d %15.13f' % (week, dow * 86400.0, float(rate), mjd, 0.0)]
+    nline = max(5, (len(sats) + 16) // 17)
+    for i in range(nline):
+        ids = ''.join('%3s' % s for s in sats[i * 17:(i + 1) * 17])
+        if i == 0:
+            lines.append('+  %3d   %-51s' % (len(sats), ids.ljust(51, '0') if len(ids) < 51 else ids))
+        else:
+            lines.append('+        %-51s' % (ids.ljust(51, '0') if len(ids) < 51 else ids))
+    for i in range(nline):
+        lines.append('++       %-51s' % ''.join('%3d' % (5 if i * 17 + j < len(sats) else 0) for j in range(17)))
+    sysc = 'M ' if len(set(s[0] for s in sats)) > 1 else sats[0][0] + ' '
+    lines += ['%%c %s cc GPS ccc cccc cccc cccc cccc ccccc ccccc ccccc ccccc' % sysc,
+              '%c cc cc ccc ccc cccc cccc cccc cccc ccccc ccccc ccccc ccccc',
+              '%f  1.2500000  1.025000000  0.00000000000  0.000000000000000',
+              '%f  0.0000000  0.000000000  0.00000000000  0.000000000000000',
+              '%i    0    0    0    0      0      0      0      0         0',
+              '%i    0    0    0    0      0      0      0      0         0',
+              '/* SYNTHETIC ORBIT AND CLOCK OF gen_gnss.py, NOT FOR PROCESSING']
+    for sec, t in eps:
+        lines.append('*  %4d %2d %2d %2d %2d %11.8f' % (t.year, t.month, t.day, t.hour, t.minute, t.second))
+        for s in sats:
+            g = sky.geo[s]
+            x = g['w'] * sec + g['phi']
+            r = (g['r0'] + 6.371e6) / 1000.0
+            inc = 0.96 + 0.05 * (int(s[1:]) % 3)
+            pos = (r * math.cos(x), r * math.sin(x) * math.cos(inc), r * math.sin(x) * math.sin(inc))
+            clk = sky.clock(s, sec) * 1.0e6 + rnd.gauss(0.0, 1.0e-5)
+            lines.append('P%3s%14.6f%14.6f%14.6f%14.6f' % (s, pos[0], pos[1], pos[2], clk))
+    lines.append('EOF')
+    return lines
+
+
+def clk_lines(ac, sats, sites, rate, hours, t0, seed):
+    """the lines of one RINEX clock (3.00) file with the satellite ('AS') and station ('AR') clocks"""
+    sky = Sky(seed, 'sp3', sats)
+    rnd = random.Random('%d:clk' % seed)
+    lines = ['%9s%11s%-20s%-20s%-20s' % ('3.00', '', 'C', 'M' if len(set(s[0] for s in sats)) > 1 else sats[0][0], 'RINEX VERSION / TYPE'),
+             '%-20s%-20s%-20s%-20s' % ('gen_gnss.py', ac, t0.strftime('%Y%m%d %H%M%S') + ' UTC', 'PGM / RUN BY / DATE'),
+             '%6d    AR    AS%42s%-20s' % (2, '', '# / TYPES OF DATA'),
+             '%-3s  %-55s%-20s' % (ac[:3], 'SYNTHETIC CLOCKS OF gen_gnss.py', 'ANALYSIS CENTER'),
+             '%6d%54s%-20s' % (len(sites), '', '# OF SOLN STA / TRF')]
+    for site in sites:
+        lines.append('%-4s %-20s%11d %11d %11d%-20s' % (site.upper(), site.upper() + ' M001', -2148744397, 4426641210, 4044655856,
+                                                       'SOLN STA NAME / NUM'))
+    lines.append('%6d%54s%-20s' % (len(sats), '', '# OF SOLN SATS'))
+    for i in range(0, len(sats), 15):
+        lines.append('%-60s%-20s' % (''.join('%-4s' % s for s in sats[i:i + 15]), 'PRN LIST'))
+    lines.append('%-60s%-20s' % ('', 'END OF HEADER'))
+    lines = [l.rstrip() for l in lines]
+    offs = {site: rnd.uniform(-1.0e-6, 1.0e-6) for site in sites}
+    for sec, t in epochs(t0, rate, hours):
+        stamp = '%4d %2d %2d %2d %2d %9.6f' % (t.year, t.month, t.day, t.hour, t.minute, t.second)
+        for site in sites:
+            lines.append('AR %-4s %s %2d   %19.12E' % (site.upper(), stamp, 1, offs[site] + 1.0e-9 * sec / 86400.0))
+        for s in sats:
+            lines.append('AS %-4s %s %2d   %19.12E' % (s, stamp, 1, sky.clock(s, sec) + rnd.gauss(0.0, 1.0e-11)))
+    return lines
+
+
+def ionex_lines(ac, rate, hours, t0, seed):
+    """the lines of one IONEX (1.0) file, the TEC maps of 2.5 x 5.0 degrees in 0.1 TECU"""
+    rnd = random.Random('%d:ionex' % seed)
+    eps = epochs(t0, rate, hours) + [(hours * 3600, t0 + datetime.timedelta(hours=hours))]
+    tlast = eps[-1][1]
+    lines = ['%8s%12s%-20s%-20s%-20s' % ('1.0', '', 'IONOSPHERE MAPS', 'GNSS', 'IONEX VERSION / TYPE'),
+             '%-20s%-20s%-20s%-20s' % ('gen_gnss.py', ac, t0.strftime('%d-%b-%y %H:%M').upper(), 'PGM / RUN BY / DATE'),
+             '%-60s%-20s' % ('SYNTHETIC GLOBAL IONOSPHERE MAPS OF gen_gnss.py', 'DESCRIPTION'),
+             '%6d%6d%6d%6d%6d%6d%24s%-20s' % (t0.year, t0.month, t0.day, 0, 0, 0, '', 'EPOCH OF FIRST MAP'),
+             '%6d%6d%6d%6d%6d%6d%24s%-20s' % (tlast.year, tlast.month, tlast.day, tlast.hour, 0, 0, '', 'EPOCH OF LAST MAP'),
+             '%6d%54s%-20s' % (rate, '', 'INTERVAL'),
+             '%6d%54s%-20s' % (len(eps), '', '# OF MAPS IN FILE'),
+             '%2s%-58s%-20s' % ('', 'COSZ', 'MAPPING FUNCTION'),
+             '%8.1f%52s%-20s' % (10.0, '', 'ELEVATION CUTOFF'),
+             '%-60s%-20s' % ('', 'OBSERVABLES USED'),
+             '%8.1f%52s%-20s' % (6371.0, '', 'BASE RADIUS'),
+             '%6d%54s%-20s' % (2, '', 'MAP DIMENSION'),
+             '%2s%6.1f%6.1f%6.1f%40s%-20s' % ('', 450.0, 450.0, 0.0, '', 'HGT1 / HGT2 / DHGT'),
+             '%2s%6.1f%6.1f%6.1f%40s%-20s' % ('', 87.5, -87.5, -2.5, '', 'LAT1 / LAT2 / DLAT'),
+             '%2s%6.1f%6.1f%6.1f%40s%-20s' % ('', -180.0, 180.0, 5.0, '', 'LON1 / LON2 / DLON'),
+             '%6d%54s%-20s' % (-1, '', 'EXPONENT'),
+             '%-60s%-20s' % ('', 'END OF HEADER')]
+    lines = [l.rstrip() for l in lines]
+    for n, (sec, t) in enumerate(eps):
+        lines.append('%6d%54s%-20s' % (n + 1, '', 'START OF TEC MAP'))
+        lines.append('%6d%6d%6d%6d%6d%6d%24s%-20s' % (t.year, t.month, t.day, t.hour, t.minute, t.second, '', 'EPOCH OF CURRENT MAP'))
+        sun = 2.0 * math.pi * sec / 86400.0
+        for i in range(71):
+            lat = 87.5 - 2.5 * i
+            lines.append('%2s%6.1f%6.1f%6.1f%6.1f%6.1f%28s%-20s' % ('', lat, -180.0, 180.0, 5.0, 450.0, '', 'LAT/LON1/LON2/DLON/H'))
+            vals = []
+            for j in range(73):
+                lon = math.radians(-180.0 + 5.0 * j)
+                tec = 100.0 + 400.0 * math.cos(math.radians(lat)) ** 2 * max(0.0, math.cos(lon + sun - math.pi)) + rnd.uniform(0.0, 20.0)
+                vals.append('%5d' % int(tec))
+            for k in range(0, 73, 16):
+                lines.append(''.join(vals[k:k + 16]))
+        lines.append('%6d%54s%-20s' % (n + 1, '', 'END OF TEC MAP'))
+    lines.append('%-60s%-20s' % ('', 'END OF FILE'))
+    return [l.rstrip() for l in lines]
+
+
+################################################################################
+# compression
+################################################################################
+def lzw(data, maxbits=16):
+    """the LZW compression of 'compress' (block mode), i.e., '*.Z' decompressed by 'gzip -d' or 'uncompress'"""
+    out = bytearray(b'\x1f\x9d' + bytes([0x80 | maxbits]))
+    maxmax = 1 << maxbits
+    st = {'bits': 9, 'maxcode': 511, 'free': 257, 'buf': 0, 'nbuf': 0, 'ncode': 0}
+
+    def emit(code, clear=False):
+        st['buf'] |= code << st['nbuf']
+        st['nbuf'] += st['bits']
+        st['ncode'] += 1
+        while st['nbuf'] >= 8:
+            out.append(st['buf'] & 0xff)
+            st['buf'] >>= 8
+            st['nbuf'] -= 8
+        if st['free'] > st['maxcode'] or clear:
+            # the codes are read in groups of eight, so the group is padded before the code size is changed
+            if st['ncode'] % 8:
+                st['nbuf'] += (8 - st['ncode'] % 8) * st['bits']
+                while st['nbuf'] >= 8:
+                    out.append(st['buf'] & 0xff)
+                    st['buf'] >>= 8
+                    st['nbuf'] -= 8
+            st['ncode'] = 0
+            if clear:
+                st['bits'] = 9
+            else:
+                st['bits'] += 1
+            st['maxcode'] = maxmax if st['bits'] == maxbits else (1 << st['bits']) - 1
+
+    table = {}
+    if not data:
+        return bytes(out)
+    ent = data[0]
+    for c in data[1:]:
+        code = table.get((ent, c))
+        if code is not None:
+            ent = code
+            continue
+        emit(ent)
+        if st['free'] < maxmax:
+            table[(ent, c)] = st['free']
+            st['free'] += 1
+        else:
+            table.clear()
+            st['free'] = 257
+            emit(256, True)
+        ent = c
+    emit(ent)
+    if st['nbuf'] > 0:
+        out.append(st['buf'] & 0xff)
+    return bytes(out)
+
+
+def write(path, lines, zip):
+    """to write one file, compressed or not, and return its name"""
+    data = ('\n'.join(lines) + '\n').encode('latin-1')
+    if zip == 'gz':
+        path += '.gz'
+        data = gzip.compress(data, 6, mtime=0)
+    elif zip == 'Z':
+        path += '.Z'
+        data = lzw(data)
+    with open(path + '.tmp', 'wb') as fp:
+        fp.write(data)
+    os.replace(path + '.tmp', path)
+    return path
+
+
+################################################################################
+# files
+################################################################################
+def obs_name(ver, fmt, site, t0, rate, hours):
+    yy, doy = t0.year % 100, t0.timetuple().tm_yday
+    if ver == 2:
+        return '%s%03d0.%02d%s' % (site.lower(), doy, yy, 'd' if fmt == 'crx' else 'o')
+    span = '01D' if hours >= 24 else '%02dH' % hours if hours >= 1 else '%02dM' % int(hours * 60)
+    return '%s00XXX_R_%04d%03d0000_%s_%02dS_MO.%s' % (site.upper(), t0.year, doy, span, rate, fmt)
+
+
+def gen_obs(out, ver, fmt, site, syss, nsat, rate, hours, t0, seed, zip):
+    sats = satellites(syss, nsat)
+    lines, records = rinex_lines(ver, site, syss, sats, rate, hours, t0, seed)
+    if fmt == 'crx':
+        nhead = next(i for i, l in enumerate(lines) if l.endswith('END OF HEADER')) + 1
+        lines = crinex_lines(ver, lines[:nhead], records)
+    return write(os.path.join(out, obs_name(ver, fmt, site, t0, rate, hours)), lines, zip)
+
+
+def gen_sp3(out, ver, ac, syss, nsat, rate, hours, t0, seed, zip):
+    doy = t0.timetuple().tm_yday
+    name = '%s0OPSFIN_%04d%03d0000_01D_%02dM_ORB.SP3' % (ac.upper(), t0.year, doy, rate // 60)
+    return write(os.path.join(out, name), sp3_lines(ver, ac.upper(), satellites(syss, nsat), rate, hours, t0, seed), zip)
+
+
+def gen_clk(out, ac, syss, nsat, sites, rate, hours, t0, seed, zip):
+    doy = t0.timetuple().tm_yday
+    name = '%s0OPSFIN_%04d%03d0000_01D_%02dS_CLK.CLK' % (ac.upper(), t0.year, doy, rate)
+    return write(os.path.join(out, name), clk_lines(ac.upper(), satellites(syss, nsat), sites, rate, hours, t0, seed), zip)
+
+
+def gen_ionex(out, ac, rate, hours, t0, seed, zip):
+    doy = t0.timetuple().tm_yday
+    name = '%s0OPSFIN_%04d%03d0000_01D_%02dH_GIM.INX' % (ac.upper(), t0.year, doy, rate // 3600)
+    return write(os.path.join(out, name), ionex_lines(ac.upper(), rate, hours, t0, seed), zip)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Synthetic GNSS file generator for the benchmarks of GOOD')
+    parser.add_argument('kind', choices=['obs', 'sp3', 'clk', 'ionex'], help='the kind of the files')
+    parser.add_argument('-out', required=True, help='the output directory')
+    parser.add_argument('-ver', default='', help="'2' or '3' for 'obs', 'c' or 'd' for 'sp3'")
+    parser.add_argument('-fmt', default='crx', choices=['rnx', 'crx'], help="'rnx' or 'crx' for 'obs'")
+    parser.add_argument('-sites', type=int, default=1, help='the number of stations')
+    parser.add_argument('-rate', type=int, default=0, help='the sampling interval (s)')
+    parser.add_argument('-hours', type=float, default=24.0, help='the hours spanned from 00:00')
+    parser.add_argument('-sys', default='GRECJI', help='the constellations')
+    parser.add_argument('-nsat', type=int, default=0, help='the maximum number of satellites of each constellation')
+    parser.add_argument('-ac', default='IGS', help='the analysis center')
+    parser.add_argument('-time', type=int, nargs=2, default=[2026, 100], help='the 4-digit year and the day of year')
+    parser.add_argument('-seed', type=int, default=1, help='the seed')
+    parser.add_argument('-zip', default='none', choices=['none', 'gz', 'Z'], help='the compression')
+    args = parser.parse_args()
+
+    syss = [s for s in args.sys.upper() if s in NSATS]
+    t0, _, _ = epoch(args.time[0], args.time[1])
+    os.makedirs(args.out, exist_ok=True)
+    sites = ['b%03d' % (i + 1) for i in range(args.sites)]
+    files = []
+    if args.kind == 'obs':
+        ver = int(args.ver or '3')
+        for site in sites:
+            files.append(gen_obs(args.out, ver, args.fmt, site, syss, args.nsat, args.rate or 30, args.hours, t0, args.seed, args.zip))
+    elif args.kind == 'sp3':
+        files.append(gen_sp3(args.out, args.ver or 'd', args.ac, syss, args.nsat, args.rate or 900, args.hours, t0, args.seed,
+                             args.zip))
+    elif args.kind == 'clk':
+        files.append(gen_clk(args.out, args.ac, syss, args.nsat, sites, args.rate or 30, args.hours, t0, args.seed, args.zip))
+    else:
+        files.append(gen_ionex(args.out, args.ac, args.rate or 3600, args.hours, t0, args.seed, args.zip))
+    for f in files:
+        print(f)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
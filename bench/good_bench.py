@@ -0,0 +1,391 @@
+#!/usr/bin/env python
+# coding:utf-8
+
+
+################################################################################
+# PROGRAM:
+################################################################################
+"""
+
+ Offline end-to-end benchmark of GOOD against the local mock archive server (see mock_archive.py)
+
+ Usage: python good_bench.py -exe <GOODpath> [-work <workDir>] [-scenario <name> ...] [-sites <num>] [-days <num>] [-hours <num>]
+           [-size <KB>] [-latency <sec>] [-bandwidth <bytesPerSec>] [-error <rate>] [-seed <seed>] [-repeat <num>] [-set <key>=<value> ...]
+           [-out <jsonFile>] [-list]
+
+ OPTIONS:
+   <-exe>          - The full path of executable GOOD program, i.e., 'bin/run_GOOD'
+   <-work>         - [optional] The working directory, where the synthetic trees ('archive') and the data directories of each
+                      scenario are created (default: './good_bench')
+   <-scenario>     - [optional] The scenarios run (default: all), see '-list'
+   <-sites>        - [optional] The number of stations of the observation scenarios (default: 20)
+   <-days>         - [optional] The number of consecutive days (default: 2)
+   <-hours>        - [optional] The hours spanned by each synthetic observation file (CRINEX, see gen_gnss.py), 24 for the
+                      realistic sizes of the daily files (default: 1)
+   <-size>         - [optional] The size (KB) of each synthetic file with no generator (the broadcast ephemeris) before
+                      compression (default: 256)
+   <-latency>      - [optional] The latency (s) of each command or request of the mock server (default: 0)
+   <-bandwidth>    - [optional] The bandwidth (bytes/s) of each transfer of the mock server, 0: unlimited (default: 0)
+   <-error>        - [optional] The rate (0~1) of the transfers failed by the mock server (default: 0)
+   <-seed>         - [optional] The seed of the synthetic files and the failures (default: 1)
+   <-repeat>       - [optional] The number of runs of each scenario, the median is reported (default: 1)
+   <-set>          - [optional] The items of the configuration overridden for all the scenarios, i.e., '-set backfill=1 maxProcs=8'
+   <-out>          - [optional] The JSON file of the results (default: '<workDir>/results.json')
+   <-list>         - [optional] List the scenarios and exit
+
+ EXAMPLES: python good_bench.py -exe ../bin/run_GOOD -sites 50 -latency 0.05 -bandwidth 5000000 -error 0.02
+           python good_bench.py -exe ../bin/run_GOOD -scenario ign_mgex_all -set backfill=1 maxProcs=8
+
+ Changes:
+   19-Oct-2026   new
+   19-Oct-2026   the observations, orbits and clocks are the valid files of gen_gnss.py
+
+ DEPENDENCIES:
+   Python 3.6 or later (standard library only), 'gen_gnss.py' of this directory, 'wget', 'gzip' and 'openssl'
+
+"""
+
+import argparse
+import datetime
+import gzip
+import hashlib
+import json
+import os
+import random
+import re
+import shutil
+import socket
+import statistics
+import subprocess
+import sys
+import time
+
+import gen_gnss
+
+BENCHDIR = os.path.dirname(os.path.realpath(__file__))
+REPODIR = os.path.dirname(BENCHDIR)
+TEMPLATE = os.path.join(REPODIR, 'dataset_Linux', 'GOOD_cfg.yaml')
+CRX2RNX = os.path.join(REPODIR, 'dataset_Linux', 'thirdparty_Linux', 'crx2rnx')
+YEAR, DOY = 2026, 100  # the first day of the synthetic trees
+
+
+def epoch(day):
+    """the date, the 4-digit year, the 2-digit year, the day of year, the GPS week and the day of week of one day"""
+    t = datetime.date(YEAR, 1, 1) + datetime.timedelta(days=DOY - 1 + day)
+    gpsd = (t - datetime.date(1980, 1, 6)).days
+    return {'yyyy': '%04d' % t.year, 'yy': '%02d' % (t.year % 100), 'doy': '%03d' % t.timetuple().tm_yday,
+            'wwww': '%04d' % (gpsd // 7), 'dow': '%d' % (gpsd % 7)}
+
+
+def sites(n):
+    """the names of the synthetic stations, i.e., 'b001'"""
+    return ['b%03d' % (i + 1) for i in range(n)]
+
+
+# the scenarios: the redirected servers are given by the schemes of the URLs, the items of the configuration, and the remote
+# files (host/path of each day and station) with the kind of the synthetic content
+SCENARIOS = {
+    'cddis_igs_daily': {
+        'info': 'IGS daily observations (RINEX 2, site by site) from CDDIS over FTPS',
+        'cfg': {'ftpArch': 'cddis', 'opt4obs': '1', 'obsType': 'daily', 'obsFrom': 'igs', 'obsList': 'site.list'},
+        'files': lambda e, s: ['gdc.cddis.eosdis.nasa.gov/pub/gnss/data/daily/%s/%s/%sd/%s%s0.%sd.gz' %
+                               (e['yyyy'], e['doy'], e['yy'], s, e['doy'], e['yy'])],
+        'kind': 'crx2',
+    },
+    'ign_mgex_all': {
+        'info': 'MGEX daily observations (RINEX 3, the whole directory listed) from IGN over FTP',
+        'cfg': {'ftpArch': 'ign', 'opt4obs': '1', 'obsType': 'daily', 'obsFrom': 'mgex', 'obsList': 'all'},
+        'files': lambda e, s: ['igs.ign.fr/pub/igs/data/%s/%s/%s00XXX_R_%s%s0000_01D_30S_MO.crx.gz' %
+                               (e['yyyy'], e['doy'], s.upper(), e['yyyy'], e['doy'])],
+        'kind': 'crx3',
+    },
+    'whu_products': {
+        'info': 'Mixed broadcast ephemeris and IGS final orbits and clocks from WHU over FTP',
+        'cfg': {'ftpArch': 'whu', 'opt4nav': '1', 'navType': 'daily', 'navSys': 'mixed3', 'navFrom': 'igs', 'opt4oc': '1',
+                'ocFrom': 'igs'},
+        'files': lambda e, s: ['igs.gnsswhu.cn/pub/gps/data/daily/%s/brdc/BRDC00IGS_R_%s%s0000_01D_MN.rnx.gz' %
+                               (e['yyyy'], e['yyyy'], e['doy']),
+                               'igs.gnsswhu.cn/pub/gps/products/%s/IGS0OPSFIN_%s%s0000_01D_15M_ORB.SP3.gz' %
+                               (e['wwww'], e['yyyy'], e['doy']),
+                               'igs.gnsswhu.cn/pub/gps/products/%s/IGS0OPSFIN_%s%s0000_01D_30S_CLK.CLK.gz' %
+                               (e['wwww'], e['yyyy'], e['doy'])],
+        'persite': False,
+        'kind': 'text',
+    },
+    'hk_30s': {
+        'info': 'Hong Kong CORS 30s observations (RINEX 3, site by site) over HTTPS',
+        'cfg': {'ftpArch': 'cddis', 'opt4obs': '1', 'obsType': '30s', 'obsFrom': 'hk', 'obsList': 'site.list'},
+        'files': lambda e, s: ['rinex.geodetic.gov.hk/rinex3/%s/%s/%s/30s/%s00HKG_R_%s%s0000_01D_30S_MO.crx.gz' %
+                               (e['yyyy'], e['doy'], s, s.upper(), e['yyyy'], e['doy'])],
+        'kind': 'crx3',
+    },
+    'noaa_daily': {
+        'info': 'NGS/NOAA CORS daily observations (RINEX 2, site by site) over HTTPS',
+        'cfg': {'ftpArch': 'cddis', 'opt4obs': '1', 'obsType': 'daily', 'obsFrom': 'ngs', 'obsList': 'site.list'},
+        'files': lambda e, s: ['noaa-cors-pds.s3.amazonaws.com/rinex/%s/%s/%s/%s%s0.%sd.gz' %
+                               (e['yyyy'], e['doy'], s, s, e['doy'], e['yy'])],
+        'kind': 'crx2',
+    },
+    'unavco_pbo': {
+        'info': 'UNAVCO/PBO daily observations (RINEX 3, site by site) over HTTPS',
+        'cfg': {'ftpArch': 'cddis', 'opt4obs': '1', 'obsType': 'daily', 'obsFrom': 'pbo', 'obsList': 'site.list'},
+        'files': lambda e, s: ['data.unavco.org/archive/gnss/rinex3/obs/%s/%s/%s00USA_R_%s%s0000_01D_15S_MO.crx.gz' %
+                               (e['yyyy'], e['doy'], s.upper(), e['yyyy'], e['doy'])],
+        'kind': 'crx3',
+    },
+    'ultra_esa_gfz': {
+        'info': 'ESA (HTTP) and GFZ (FTP) ultra-rapid orbits',
+        'cfg': {'ftpArch': 'cddis', 'opt4oc': '1', 'ocFrom': 'esa_u+gfz_u', 'sHH4oc': '00', 'nHH4oc': '4'},
+        'files': lambda e, s: ['navigation-office.esa.int/products/gnss-products/%s/esu%s%s_%02d.sp3.Z' %
+                               (e['wwww'], e['wwww'], e['dow'], h) for h in range(0, 24, 6)] +
+                              ['ftp.gfz-potsdam.de/pub/GNSS/products/ultra/w%s/gfu%s%s_%02d.sp3.gz' %
+                               (e['wwww'], e['wwww'], e['dow'], h) for h in range(0, 24, 3)],
+        'persite': False,
+        'kind': 'text',
+    },
+    'cnes_rt': {
+        'info': 'CNES real-time orbits and clocks over HTTP',
+        'cfg': {'ftpArch': 'cddis', 'opt4oc': '1', 'ocFrom': 'cnt'},
+        'files': lambda e, s: ['www.ppp-wizard.net/products/REAL_TIME/cnt%s%s.sp3.gz' % (e['wwww'], e['dow']),
+                               'www.ppp-wizard.net/products/REAL_TIME/cnt%s%s.clk.gz' % (e['wwww'], e['dow'])],
+        'persite': False,
+        'kind': 'text',
+    },
+}
+
+# the switches of all the products, which are off unless the scenario turns them on
+SWITCHES = ['opt4obs', 'opt4nav', 'opt4oc', 'opt4eop', 'opt4obx', 'opt4dsb', 'opt4osb', 'opt4snx', 'opt4ion', 'opt4rot', 'opt4trp',
+            'opt4atx']
+
+
+def payload(kind, name, site, day, args, rnd):
+    """the synthetic content of one file: the CRINEX observations, the SP3 orbits and the clocks are valid files of gen_gnss.py,
+    the others are one plain text padded to the size"""
+    t0 = datetime.datetime(YEAR, 1, 1) + datetime.timedelta(days=DOY - 1 + day)
+    syss = list(gen_gnss.NSATS)
+    sats = gen_gnss.satellites(syss, 0)
+    base = re.sub(r'\.(gz|Z)$', '', name)
+    if kind in ('crx2', 'crx3'):
+        ver = 2 if kind == 'crx2' else 3
+        m = re.search(r'_(\d\d)S_MO', base)
+        lines, records = gen_gnss.rinex_lines(ver, site, syss, sats, int(m.group(1)) if m else 30, args.hours, t0, args.seed)
+        nhead = next(i for i, l in enumerate(lines) if l.endswith('END OF HEADER')) + 1
+        lines = gen_gnss.crinex_lines(ver, lines[:nhead], records)
+    elif base.lower().endswith('.sp3'):
+        lines = gen_gnss.sp3_lines('d' if base.endswith('.SP3') else 'c', base[:3].upper(), sats, 900, 24, t0, args.seed)
+    elif base.lower().endswith('.clk'):
+        lines = gen_gnss.clk_lines(base[:3].upper(), sats, sites(args.sites), 30, 24, t0, args.seed)
+    else:
+        lines = ['%-60s%-20s' % (name, 'GOOD_BENCH')]
+        nbytes = 81
+        while nbytes < args.size * 1024:
+            lines.append('%-60s%-20s' % (' '.join('%12.3f' % rnd.uniform(-2.0e7, 2.0e7) for _ in range(4)), 'COMMENT'))
+            nbytes += 81
+    return ('\n'.join(lines) + '\n').encode('latin-1')
+
+
+def build(archive, names, args):
+    """to write the synthetic trees of the scenarios, the existing files are kept unless the settings of the contents changed"""
+    stamp = os.path.join(archive, 'settings.json')
+    settings = {k: getattr(args, k) for k in ('sites', 'hours', 'size', 'seed')}
+    if os.path.exists(stamp) and json.load(open(stamp)) != settings:
+        shutil.rmtree(archive)
+    os.makedirs(archive, exist_ok=True)
+    with open(stamp, 'w') as fp:
+        json.dump(settings, fp)
+    rnd = random.Random(args.seed)
+    count = 0
+    for name in names:
+        scn = SCENARIOS[name]
+        stations = sites(args.sites) if scn.get('persite', True) else [None]
+        for day in range(args.days):
+            e = epoch(day)
+            for s in stations:
+                for rel in scn['files'](e, s):
+                    path = os.path.join(archive, rel)
+                    if os.path.exists(path):
+                        continue
+                    os.makedirs(os.path.dirname(path), exist_ok=True)
+                    data = payload(scn['kind'], os.path.basename(rel), s or 'b001', day, args, rnd)
+                    if rel.endswith('.gz'):
+                        data = gzip.compress(data, 6, mtime=0)
+                    elif rel.endswith('.Z'):
+                        data = gen_gnss.lzw(data)
+                    with open(path + '.tmp', 'wb') as fp:
+                        fp.write(data)
+                    os.replace(path + '.tmp', path)
+                    count += 1
+
+    # CDDIS publishes the checksums of the files of each directory in 'SHA512SUMS', see 'checksum' of GOOD
+    for root, _, files in os.walk(os.path.join(archive, 'gdc.cddis.eosdis.nasa.gov')):
+        names = sorted(f for f in files if not f.endswith(('SUMS', '.tmp')))
+        if not names:
+            continue
+        text = ''.join('%s  %s\n' % (hashlib.sha512(open(os.path.join(root, f), 'rb').read()).hexdigest(), f) for f in names)
+        sumfile = os.path.join(root, 'SHA512SUMS')
+        if os.path.exists(sumfile) and open(sumfile).read() == text:
+            continue
+        with open(sumfile + '.tmp', 'w') as fp:
+            fp.write(text)
+        os.replace(sumfile + '.tmp', sumfile)
+    return count
+
+
+def freeport():
+    s = socket.socket()
+    s.bind(('127.0.0.1', 0))
+    port = s.getsockname()[1]
+    s.close()
+    return port
+
+
+def configure(maindir, name, args, redirect):
+    """to write the configuration of one scenario from the template of 'dataset_Linux'"""
+    e = epoch(0)
+    items = {'mainDir': maindir, '3partyDir': 'thirdparty_Linux', 'procTime': '2  %s  %d  %d' % (e['yyyy'], int(e['doy']), args.days),
+             'minusAdd1day': '0', 'printInfoWget': '0', 'retryWait': '0.2', 'opt4ftp': '1', 'l2s4obs': '1', 'l2s4oc': '0'}
+    items.update({k: '0' for k in SWITCHES})
+    items.update(SCENARIOS[name]['cfg'])
+    for kv in args.set:
+        k, _, v = kv.partition('=')
+        items[k] = v
+
+    out = []
+    for line in open(TEMPLATE):
+        m = re.match(r'^(\s*)([A-Za-z0-9_]+)(\s*:\s*)(\S.*?)?(\s+#.*)?$', line.rstrip('\n'))
+        if m and m.group(2) in items and m.group(4) is not None:
+            line = '%s%s%s%s%s\n' % (m.group(1), m.group(2), m.group(3), items.pop(m.group(2)), m.group(5) or '')
+        out.append(line)
+    out.append('redirect      : %s\n' % redirect)
+    for k, v in items.items():
+        out.append('%-14s: %s\n' % (k, v))
+    cfgfile = os.path.join(maindir, 'GOOD_cfg.yaml')
+    with open(cfgfile, 'w') as fp:
+        fp.write(''.join(out))
+
+    with open(os.path.join(maindir, 'site.list'), 'w') as fp:
+        fp.write(''.join(s.upper() + '\n' for s in sites(args.sites)))
+    tpdir = os.path.join(maindir, 'thirdparty_Linux')
+    os.makedirs(tpdir, exist_ok=True)
+    shutil.copy(CRX2RNX, tpdir)
+    os.chmod(os.path.join(tpdir, 'crx2rnx'), 0o755)
+    return cfgfile
+
+
+def run(name, args, archive, pem):
+    """to run one scenario once: the mock server is started, GOOD is run against it, and the results are collected"""
+    maindir = os.path.join(os.path.realpath(args.work), name)
+    shutil.rmtree(maindir, ignore_errors=True)
+    os.makedirs(maindir)
+    ports = {s: freeport() for s in ('ftp', 'ftps', 'http', 'https')}
+    redirect = ' '.join('%s=127.0.0.1:%d' % (s, p) for s, p in ports.items())
+    cfgfile = configure(maindir, name, args, redirect)
+
+    statsfile = os.path.join(maindir, 'mock_stats.json')
+    server = subprocess.Popen([sys.executable, os.path.join(BENCHDIR, 'mock_archive.py'), '-root', archive, '-cert', pem,
+                               '-ftp', str(ports['ftp']), '-ftps', str(ports['ftps']), '-http', str(ports['http']),
+                               '-https', str(ports['https']), '-latency', str(args.latency), '-bandwidth', str(args.bandwidth),
+                               '-error', str(args.error), '-seed', str(args.seed), '-stats', statsfile],
+                              stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    server.stdout.readline()
+
+    env = dict(os.environ)
+    wgetrc = os.path.join(maindir, '.wgetrc')
+    with open(wgetrc, 'w') as fp:
+        fp.write('check_certificate = off\n')
+    env['WGETRC'] = wgetrc
+    t0 = time.time()
+    with open(os.path.join(maindir, 'good.out'), 'w') as fp:
+        rc = subprocess.call([os.path.realpath(args.exe), cfgfile], cwd=maindir, stdout=fp, stderr=subprocess.STDOUT, env=env)
+    wall = time.time() - t0
+
+    server.terminate()
+    server.wait()
+    served = json.load(open(statsfile)) if os.path.exists(statsfile) else {}
+
+    ok, failed, retries = 0, 0, 0
+    logfile = os.path.join(maindir, 'log', 'log.jsonl')
+    if os.path.exists(logfile):
+        for line in open(logfile):
+            try:
+                rec = json.loads(line)
+            except ValueError:
+                continue
+            if rec.get('status') == 'ok':
+                ok += 1
+            else:
+                failed += 1
+            retries += rec.get('retries', 0)
+
+    files = served.get('files', 0)
+    mbytes = served.get('bytes', 0) / 1.0e6
+    return {'scenario': name, 'rc': rc, 'wall_s': round(wall, 3), 'files': files, 'mbytes': round(mbytes, 3),
+            'files_per_s': round(files / wall, 3) if wall > 0 else 0.0, 'mb_per_s': round(mbytes / wall, 3) if wall > 0 else 0.0,
+            'log_ok': ok, 'log_failed': failed, 'retries': retries, 'server': served}
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Offline end-to-end benchmark of GOOD against the local mock archive server')
+    parser.add_argument('-exe', default=os.path.join(REPODIR, 'bin', 'run_GOOD'), help='the full path of executable GOOD program')
+    parser.add_argument('-work', default='good_bench', help='the working directory')
+    parser.add_argument('-scenario', nargs='+', default=sorted(SCENARIOS), help='the scenarios run')
+    parser.add_argument('-sites', type=int, default=20, help='the number of stations')
+    parser.add_argument('-days', type=int, default=2, help='the number of consecutive days')
+    parser.add_argument('-hours', type=float, default=1.0, help='the hours spanned by each synthetic observation file')
+    parser.add_argument('-size', type=int, default=256, help='the size (KB) of each synthetic file with no generator')
+    parser.add_argument('-latency', type=float, default=0.0, help='the latency (s) of each command or request')
+    parser.add_argument('-bandwidth', type=float, default=0.0, help='the bandwidth (bytes/s) of each transfer, 0: unlimited')
+    parser.add_argument('-error', type=float, default=0.0, help='the rate (0~1) of the transfers failed')
+    parser.add_argument('-seed', type=int, default=1, help='the seed of the synthetic files and the failures')
+    parser.add_argument('-repeat', type=int, default=1, help='the number of runs of each scenario')
+    parser.add_argument('-set', nargs='+', default=[], help='the items of the configuration overridden, i.e., backfill=1')
+    parser.add_argument('-out', default='', help='the JSON file of the results')
+    parser.add_argument('-list', action='store_true', help='list the scenarios and exit')
+    args = parser.parse_args()
+
+    if args.list:
+        for name in sorted(SCENARIOS):
+            print('%-16s %s' % (name, SCENARIOS[name]['info']))
+        return 0
+    unknown = [s for s in args.scenario if s not in SCENARIOS]
+    if unknown:
+        print('*** ERROR: unknown scenario(s) ' + ' '.join(unknown) + ', see -list')
+        return 1
+    if not os.path.exists(args.exe):
+        print('*** ERROR: GOOD program ' + args.exe + ' is NOT found')
+        return 1
+
+    work = os.path.realpath(args.work)
+    archive = os.path.join(work, 'archive')
+    nfile = build(archive, args.scenario, args)
+    print('synthetic trees: %s (%d files written)' % (archive, nfile))
+    pem = os.path.join(work, 'mock_archive.pem')
+    if not os.path.exists(pem):
+        subprocess.check_call(['openssl', 'req', '-x509', '-newkey', 'rsa:2048', '-nodes', '-days', '365', '-subj', '/CN=127.0.0.1',
+                               '-keyout', pem + '.key', '-out', pem + '.crt'], stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+        with open(pem, 'w') as fp:
+            fp.write(open(pem + '.crt').read() + open(pem + '.key').read())
+
+    results = []
+    print('%-16s %8s %7s %9s %9s %9s %5s %5s %7s' % ('scenario', 'wall_s', 'files', 'MB', 'files/s', 'MB/s', 'ok', 'fail', 'retries'))
+    for name in args.scenario:
+        runs = [run(name, args, archive, pem) for _ in range(args.repeat)]
+        res = sorted(runs, key=lambda r: r['wall_s'])[len(runs) // 2]
+        res['runs'] = [r['wall_s'] for r in runs]
+        if len(runs) > 1:
+            res['wall_s_stdev'] = round(statistics.stdev(res['runs']), 3)
+        results.append(res)
+        print('%-16s %8.2f %7d %9.2f %9.2f %9.2f %5d %5d %7d' % (name, res['wall_s'], res['files'], res['mbytes'], res['files_per_s'],
+                                                                 res['mb_per_s'], res['log_ok'], res['log_failed'], res['retries']))
+
+    out = args.out or os.path.join(work, 'results.json')
+    settings = {k: getattr(args, k) for k in ('sites', 'days', 'hours', 'size', 'latency', 'bandwidth', 'error', 'seed', 'repeat', 'set')}
+    with open(out, 'w') as fp:
+        json.dump({'time': time.strftime('%Y-%m-%dT%H:%M:%S'), 'exe': os.path.realpath(args.exe), 'settings': settings,
+                   'results': results}, fp, indent=2)
+    print('results: ' + out)
+    return 0 if all(r['rc'] == 0 for r in results) else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
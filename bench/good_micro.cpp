@@ -0,0 +1,327 @@
+/*------------------------------------------------------------------------------
+* good_micro.cpp : micro-benchmarks of the common utilities and the hot parsers (Google Benchmark)
+*
+* Copyright (C) 2020-2099 by Ubiquitous Navigation & Integrated positioning lab in Quest (UNIQ), all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader)
+*
+* Usage   : good_micro [--benchmark_filter=<regex>] [--benchmark_out=<jsonFile> --benchmark_out_format=json]
+*
+*           the inputs of the decoding and merging are written by 'bench/gen_gnss.py' to the directory GOOD_MICRO_DATA (or
+*           the environment variable of the same name), see the target 'good_micro_data' of CMakeLists.txt
+*
+* history : 2026/10/19 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "common/common.h"
+#include "common/types.h"
+#include "common/gtime.h"
+#include "common/cstring.h"
+#include "common/logger.h"
+#include "core/cache.h"
+#include "core/journal.h"
+#include "core/profile.h"
+#include "core/ftps.h"
+
+#include <benchmark/benchmark.h>
+
+#ifndef GOOD_MICRO_DATA
+#define GOOD_MICRO_DATA "good_micro_data"
+#endif
+
+/* the time of the synthetic inputs, 2026/04/10 (DOY 100) */
+static const gtime_t tbench = { 61140, 3600.0 };
+
+/**
+* @brief   : DataDir - to get the directory of the inputs
+* @param[I]: none
+* @param[O]: none
+* @return  : directory
+* @note    :
+**/
+static std::string DataDir()
+{
+    const char* dir = getenv("GOOD_MICRO_DATA");
+    return (dir && *dir) ? std::string(dir) : std::string(GOOD_MICRO_DATA);
+} /* end of DataDir */
+
+/**
+* @brief   : CopyFile - to copy one file
+* @param[I]: src (source file)
+* @param[I]: dst (destination file)
+* @param[O]: none
+* @return  : size (bytes) of the file, -1 if failed
+* @note    :
+**/
+static long CopyFile(std::string src, std::string dst)
+{
+    std::ifstream fpin(src.c_str(), std::ios::binary);
+    if (!fpin.is_open()) return -1;
+    std::ofstream fpout(dst.c_str(), std::ios::binary);
+    fpout << fpin.rdbuf();
+    return (long)fpout.tellp();
+} /* end of CopyFile */
+
+/**
+* @brief   : FileSize - to get the size of one file
+* @param[I]: file (file name)
+* @param[O]: none
+* @return  : size (bytes), -1 if NOT found
+* @note    :
+**/
+static long FileSize(std::string file)
+{
+    std::ifstream fp(file.c_str(), std::ios::binary | std::ios::ate);
+    return fp.is_open() ? (long)fp.tellg() : -1;
+} /* end of FileSize */
+
+/* time conversions ----------------------------------------------------------*/
+static void BM_Time2Ymdhms(benchmark::State& state)
+{
+    gtime_t tt = tbench;
+    for (auto _ : state)
+    {
+        std::vector<double> ep = GTime::time2ymdhms(tt);
+        benchmark::DoNotOptimize(ep);
+        tt.sod += 1.0;
+    }
+}
+BENCHMARK(BM_Time2Ymdhms);
+
+static void BM_Time2Yrdoy(benchmark::State& state)
+{
+    gtime_t tt = tbench;
+    int yyyy, doy;
+    for (auto _ : state)
+    {
+        GTime::time2yrdoy(tt, yyyy, doy);
+        benchmark::DoNotOptimize(doy);
+        tt.sod += 1.0;
+    }
+}
+BENCHMARK(BM_Time2Yrdoy);
+
+static void BM_Time2Gpst(benchmark::State& state)
+{
+    gtime_t tt = tbench;
+    int week;
+    double sow;
+    for (auto _ : state)
+    {
+        int dow = GTime::time2gpst(tt, week, sow);
+        benchmark::DoNotOptimize(dow);
+        tt.sod += 1.0;
+    }
+}
+BENCHMARK(BM_Time2Gpst);
+
+/* the time strings of one file name as built by the downloading functions, i.e., 'IGS0OPSFIN_20261000000_01D_15M_ORB.SP3' */
+static void BM_FileNameTime(benchmark::State& state)
+{
+    gtime_t tt = tbench;
+    for (auto _ : state)
+    {
+        int yyyy, doy, week;
+        double sow;
+        GTime::time2yrdoy(tt, yyyy, doy);
+        int dow = GTime::time2gpst(tt, week, sow);
+        std::string name = "IGS0OPSFIN_" + CString::int2str(yyyy, 4) + CString::int2str(doy, 3) + "0000_01D_15M_ORB.SP3" +
+            CString::int2str(week, 4) + std::to_string(dow);
+        benchmark::DoNotOptimize(name);
+    }
+}
+BENCHMARK(BM_FileNameTime);
+
+/* string manipulations ------------------------------------------------------*/
+static void BM_Int2Str(benchmark::State& state)
+{
+    int ii = 0;
+    for (auto _ : state)
+    {
+        std::string s = CString::int2str(ii++ % 366, 3);
+        benchmark::DoNotOptimize(s);
+    }
+}
+BENCHMARK(BM_Int2Str);
+
+static void BM_Split(benchmark::State& state)
+{
+    const std::string line = "-rw-r--r--   1 ftp      ftp       1234567 Oct 19 01:05 ABMF00GLP_R_20261000000_01D_30S_MO.crx.gz";
+    for (auto _ : state)
+    {
+        std::vector<std::string> items = CString::split(line, " ");
+        benchmark::DoNotOptimize(items);
+    }
+}
+BENCHMARK(BM_Split);
+
+static void BM_Trim(benchmark::State& state)
+{
+    const std::string line = "    ABMF00GLP_R_20261000000_01D_30S_MO.crx.gz     ";
+    for (auto _ : state)
+    {
+        std::string s = line;
+        CString::trim(s);
+        benchmark::DoNotOptimize(s);
+    }
+}
+BENCHMARK(BM_Trim);
+
+/* logging -----------------------------------------------------------------*/
+static void BM_TraceFiltered(benchmark::State& state)
+{
+    /* the message above the level of debug trace is dropped before it is queued */
+    Logger::TraceLevel(TERROR);
+    for (auto _ : state)
+    {
+        Logger::Trace(TINFO, "*** INFO(FtpUtil::GetDailyObsIgs): IGS daily observation file abmf1000.26o has existed!");
+    }
+    Logger::TraceLevel(TEXPORT);
+}
+BENCHMARK(BM_TraceFiltered);
+
+static void BM_TraceQueued(benchmark::State& state)
+{
+    /* the message is queued and written by the background thread, the console is off so that the output is NOT mixed */
+    const std::string info = "*** INFO(FtpUtil::GetDailyObsIgs): IGS daily observation file abmf1000.26o has existed!";
+    Logger::TraceConsole(false);
+    for (auto _ : state)
+    {
+        Logger::Trace(TINFO, info);
+    }
+    Logger::Flush();
+    Logger::TraceConsole(true);
+}
+BENCHMARK(BM_TraceQueued)->ThreadRange(1, 4);
+
+/* listing parsing and glob matching -----------------------------------------*/
+static void BM_ParseListing(benchmark::State& state)
+{
+    /* one 'LIST' reply of the daily MGEX directory with the number of files given */
+    std::string lstfile = DataDir() + FILEPATHSEP + "listing_" + std::to_string(state.range(0)) + ".txt";
+    if (FileSize(lstfile) <= 0)
+    {
+        std::ofstream fp(lstfile.c_str());
+        fp << "total " << state.range(0) << "\n";
+        for (int i = 0; i < state.range(0); i++)
+        {
+            fp << "-rw-r--r--   1 ftp      ftp      " << std::setw(9) << 2000000 + 7919 * i << " Apr " << std::setw(2)
+               << 10 + i % 3 << " " << std::setw(2) << std::setfill('0') << i % 24 << ":" << std::setw(2) << i % 60
+               << std::setfill(' ') << " " << (char)('A' + i / 1000 % 26) << std::setw(3) << std::setfill('0') << i % 1000 << std::setfill(' ')
+               << "00XXX_R_20261000000_01D_30S_MO.crx.gz\n";
+        }
+    }
+    std::map<std::string, std::pair<double, double>> entries;
+    double snow = (tbench.mjd - 40587) * 86400.0 + tbench.sod;
+    for (auto _ : state)
+    {
+        if (!FtpUtil::ParseListing(lstfile, snow, entries)) state.SkipWithError("the listing is NOT parsed");
+        benchmark::DoNotOptimize(entries);
+        entries.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ParseListing)->Arg(100)->Arg(5000);
+
+static void BM_MatchWild(benchmark::State& state)
+{
+    std::vector<std::string> names;
+    for (int i = 0; i < 1000; i++)
+    {
+        names.push_back("s" + CString::int2str(i % 1000, 3) + "1000." + (i % 2 ? "26d.gz" : "26o.Z"));
+        names.push_back("S" + CString::int2str(i % 1000, 3) + "00XXX_R_2026100" + CString::int2str(i % 24, 2) +
+            "00_01H_30S_MO.crx.gz");
+    }
+    const std::vector<std::string> patterns = { "????1000.26d.*", "*_20261000000_01D_30S_MO.crx.*", "*_2026100??00_01H_*_MO.crx.*" };
+    for (auto _ : state)
+    {
+        int nmatch = 0;
+        for (size_t i = 0; i < patterns.size(); i++)
+        {
+            for (size_t j = 0; j < names.size(); j++) nmatch += FtpUtil::MatchWild(patterns[i].c_str(), names[j].c_str());
+        }
+        benchmark::DoNotOptimize(nmatch);
+    }
+    state.SetItemsProcessed(state.iterations() * patterns.size() * names.size());
+}
+BENCHMARK(BM_MatchWild);
+
+/* decoding by the third-party programs, as called in the downloading, the time is the wall time of the child processes */
+/**
+* @brief   : RunDecode - to decode one input per iteration: the input is copied (NOT timed) and decoded by the command
+* @param[I]: state (state of the benchmark)
+* @param[I]: input (file name of the input in the data directory)
+* @param[I]: cmd (command line, "%i" and "%o" are replaced by the copy of the input and the output)
+* @param[I]: output (file name of the output in the data directory)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+static void RunDecode(benchmark::State& state, std::string input, std::string cmd, std::string output)
+{
+    std::string dir = DataDir() + FILEPATHSEP, work = dir + "work_" + input;
+    std::string::size_type ipos = cmd.find("%i");
+    cmd.replace(ipos, 2, work);
+    ipos = cmd.find("%o");
+    if (ipos != std::string::npos) cmd.replace(ipos, 2, dir + output);
+    if (FileSize(dir + input) <= 0)
+    {
+        state.SkipWithError(("the input " + dir + input + " is NOT found, see the target 'good_micro_data'").c_str());
+        return;
+    }
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        CopyFile(dir + input, work);
+        state.ResumeTiming();
+        if (ProfUtil::System(cmd) != 0) state.SkipWithError(("failed to run " + cmd).c_str());
+    }
+    state.SetBytesProcessed(state.iterations() * std::max(FileSize(dir + output), 0L));
+    std::remove(work.c_str());
+    std::remove((dir + output).c_str());
+}
+
+static void BM_GzipDecode(benchmark::State& state)
+{
+    RunDecode(state, "b0011000.26d.gz", "gzip -d -f -c %i > %o", "gzip.out");
+}
+BENCHMARK(BM_GzipDecode)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_LzwDecode(benchmark::State& state)
+{
+    RunDecode(state, "b0011000.26d.Z", "gzip -d -f -c %i > %o", "lzw.out");
+}
+BENCHMARK(BM_LzwDecode)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_CrxDecode(benchmark::State& state)
+{
+    RunDecode(state, "B00100XXX_R_20261000000_06H_30S_MO.crx", DataDir() + FILEPATHSEP + "crx2rnx %i -f - > %o", "crx.out");
+}
+BENCHMARK(BM_CrxDecode)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+/* merging -------------------------------------------------------------------*/
+static void BM_Sp3Merge(benchmark::State& state)
+{
+    /* the SP3 files of DOY 099, 100 and 101 are copied, and the middle one is merged again and again from its '*.orig' */
+    std::string dir = DataDir() + FILEPATHSEP;
+    std::vector<std::string> sp3files;
+    for (int doy = 99; doy <= 101; doy++)
+    {
+        std::string name = "IGS0OPSFIN_2026" + CString::int2str(doy, 3) + "0000_01D_15M_ORB.SP3";
+        if (CopyFile(dir + name, dir + "merge_" + name) <= 0)
+        {
+            state.SkipWithError(("the input " + dir + name + " is NOT found, see the target 'good_micro_data'").c_str());
+            return;
+        }
+        sp3files.push_back(dir + "merge_" + name);
+    }
+    std::remove((sp3files[1] + ".orig").c_str());
+    for (auto _ : state)
+    {
+        FtpUtil::Sp3FilesIntoOneFile(sp3files);
+    }
+    state.SetBytesProcessed(state.iterations() * FileSize(sp3files[1]));
+    for (size_t i = 0; i < sp3files.size(); i++) std::remove(sp3files[i].c_str());
+    std::remove((sp3files[1] + ".orig").c_str());
+}
+BENCHMARK(BM_Sp3Merge)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
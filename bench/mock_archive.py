@@ -0,0 +1,472 @@
+#!/usr/bin/env python
+# coding:utf-8
+
+
+################################################################################
+# PROGRAM:
+################################################################################
+"""
+
+ Local mock archive server (FTP, FTPS, HTTP and HTTPS) for the offline benchmark of GOOD
+
+ Usage: python mock_archive.py -root <rootDir> [-ftp <port>] [-ftps <port>] [-http <port>] [-https <port>] [-cert <pemFile>]
+           [-latency <sec>] [-bandwidth <bytesPerSec>] [-error <rate>] [-seed <seed>] [-stats <jsonFile>]
+
+ OPTIONS:
+   <-root>         - The root directory of the synthetic trees, the files of one host are served from '<rootDir>/<host>/<path>',
+                      i.e., '<rootDir>/igs.ign.fr/pub/igs/data/2026/292/abcd2920.26d.gz'. The redirected URL is
+                      'ftp://127.0.0.1:<port>/igs.ign.fr/pub/igs/data/...', see the option 'redirect' of GOOD
+   <-ftp>          - [optional] The port of FTP (0: off, default: 2121)
+   <-ftps>         - [optional] The port of explicit FTPS, i.e., 'AUTH TLS' (0: off, default: 2990)
+   <-http>         - [optional] The port of HTTP (0: off, default: 8080)
+   <-https>        - [optional] The port of HTTPS (0: off, default: 8443)
+   <-cert>         - [optional] The PEM file with the certificate and the private key for FTPS and HTTPS, a self-signed one is
+                      generated by 'openssl' if it is not given
+   <-latency>      - [optional] The latency (s) added to each command of FTP and each request of HTTP (default: 0)
+   <-bandwidth>    - [optional] The bandwidth (bytes/s) of each transfer, 0: unlimited (default: 0)
+   <-error>        - [optional] The rate (0~1) of the transfers failed, half of them are refused (FTP '421' or HTTP '503') and the
+                      others are dropped halfway (default: 0)
+   <-seed>         - [optional] The seed of the failures, the n-th request of one path fails or not in the same way in each run
+                      (default: 0)
+   <-stats>        - [optional] The JSON file of the counters (requests, files, bytes and failures), written at the exit
+
+ EXAMPLES: python mock_archive.py -root /tmp/bench/archive -latency 0.05 -bandwidth 2000000 -error 0.02
+
+ Changes:
+   19-Oct-2026   new
+
+ DEPENDENCIES:
+   Python 3.6 or later (standard library only), 'openssl' for the self-signed certificate
+
+"""
+
+import argparse
+import email.utils
+import hashlib
+import html
+import json
+import os
+import signal
+import socket
+import socketserver
+import ssl
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+import urllib.parse
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+
+class Archive:
+    """the synthetic trees, the injected faults and the counters shared by all the servers"""
+
+    def __init__(self, root, latency, bandwidth, error, seed):
+        self.root = os.path.realpath(root)
+        self.latency = latency
+        self.bandwidth = bandwidth
+        self.error = error
+        self.seed = seed
+        self.lock = threading.Lock()
+        self.tries = {}
+        self.stats = {'requests': 0, 'files': 0, 'bytes': 0, 'refused': 0, 'dropped': 0, 'notfound': 0}
+
+    def count(self, key, n=1):
+        with self.lock:
+            self.stats[key] += n
+
+    def resolve(self, path):
+        """to map one remote path to the local one, None if it is outside the root"""
+        path = urllib.parse.unquote(path).split('?')[0]
+        local = os.path.realpath(os.path.join(self.root, path.lstrip('/')))
+        if local != self.root and not local.startswith(self.root + os.sep):
+            return None
+        return local
+
+    def fault(self, path):
+        """to decide the fault of this request of one path: None, 'refuse' or 'drop'"""
+        if self.error <= 0.0:
+            return None
+        with self.lock:
+            n = self.tries.get(path, 0)
+            self.tries[path] = n + 1
+        h = hashlib.sha1(('%d:%s:%d' % (self.seed, path, n)).encode()).digest()
+        u = int.from_bytes(h[:8], 'big') / float(1 << 64)
+        if u >= self.error:
+            return None
+        return 'refuse' if u < self.error / 2.0 else 'drop'
+
+    def delay(self):
+        if self.latency > 0.0:
+            time.sleep(self.latency)
+
+    def send(self, write, fp, offset, size, drop):
+        """to send one file (from the offset) with the bandwidth limited, half of it if it is dropped"""
+        fp.seek(offset)
+        left = size - offset
+        if drop:
+            left //= 2
+        chunk = 65536
+        if self.bandwidth > 0:
+            chunk = max(1024, min(chunk, int(self.bandwidth / 20)))
+        t0 = time.time()
+        sent = 0
+        while left > 0:
+            buf = fp.read(min(chunk, left))
+            if not buf:
+                break
+            write(buf)
+            sent += len(buf)
+            left -= len(buf)
+            if self.bandwidth > 0:
+                ahead = sent / float(self.bandwidth) - (time.time() - t0)
+                if ahead > 0:
+                    time.sleep(ahead)
+        self.count('bytes', sent)
+        return sent
+
+
+def ls_line(local, name):
+    """one line of the listing of 'ls -l', the year is given instead of the time for the files older than half a year"""
+    st = os.stat(os.path.join(local, name))
+    mode = 'drwxr-xr-x' if os.path.isdir(os.path.join(local, name)) else '-rw-r--r--'
+    t = time.gmtime(st.st_mtime)
+    if time.time() - st.st_mtime > 180 * 86400:
+        stamp = time.strftime('%b %d  %Y', t)
+    else:
+        stamp = time.strftime('%b %d %H:%M', t)
+    return '%s   1 ftp      ftp  %12d %s %s' % (mode, st.st_size, stamp, name)
+
+
+class FtpHandler(socketserver.StreamRequestHandler):
+    """one control connection of FTP (or explicit FTPS), only the commands used by 'wget' are supported"""
+
+    tls = None  # the SSL context of the FTPS server, None for FTP
+
+    def reply(self, text):
+        self.wfile.write((text + '\r\n').encode('latin-1'))
+        self.wfile.flush()
+
+    def handle(self):
+        arch = self.server.archive
+        self.cwd = '/'
+        self.pasv = None
+        self.rest = 0
+        self.prot = False
+        self.reply('220 GOOD mock archive ready')
+        while True:
+            try:
+                line = self.rfile.readline()
+            except (OSError, ssl.SSLError):
+                break
+            if not line:
+                break
+            line = line.decode('latin-1').rstrip('\r\n')
+            cmd, _, arg = line.partition(' ')
+            cmd = cmd.upper()
+            arch.delay()
+            try:
+                if not self.dispatch(arch, cmd, arg):
+                    break
+            except (OSError, ssl.SSLError):
+                break
+        if self.pasv is not None:
+            self.pasv.close()
+
+    def dispatch(self, arch, cmd, arg):
+        if cmd == 'AUTH' and self.tls is not None:
+            self.reply('234 AUTH TLS successful')
+            self.request = self.tls.wrap_socket(self.request, server_side=True)
+            self.rfile = self.request.makefile('rb')
+            self.wfile = self.request.makefile('wb')
+        elif cmd == 'USER':
+            self.reply('331 Please specify the password')
+        elif cmd == 'PASS':
+            self.reply('230 Login successful')
+        elif cmd == 'SYST':
+            self.reply('215 UNIX Type: L8')
+        elif cmd == 'PBSZ':
+            self.reply('200 PBSZ=0')
+        elif cmd == 'PROT':
+            self.prot = arg.strip().upper() == 'P'
+            self.reply('200 PROT now %s' % ('Private' if self.prot else 'Clear'))
+        elif cmd == 'PWD':
+            self.reply('257 "%s" is the current directory' % self.cwd)
+        elif cmd == 'TYPE':
+            self.reply('200 Switching to %s mode' % ('Binary' if arg.upper().startswith('I') else 'ASCII'))
+        elif cmd == 'CWD':
+            path = self.abspath(arg)
+            local = arch.resolve(path)
+            if local is not None and os.path.isdir(local):
+                self.cwd = path
+                self.reply('250 Directory successfully changed')
+            else:
+                self.reply('550 Failed to change directory')
+        elif cmd == 'PASV' or cmd == 'EPSV':
+            if self.pasv is not None:
+                self.pasv.close()
+            self.pasv = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+            self.pasv.bind((self.server.server_address[0], 0))
+            self.pasv.listen(1)
+            host, port = self.pasv.getsockname()
+            if cmd == 'PASV':
+                self.reply('227 Entering Passive Mode (%s,%d,%d)' % (host.replace('.', ','), port >> 8, port & 0xff))
+            else:
+                self.reply('229 Entering Extended Passive Mode (|||%d|)' % port)
+        elif cmd == 'SIZE' or cmd == 'MDTM':
+            local = arch.resolve(self.abspath(arg))
+            if local is None or not os.path.isfile(local):
+                self.reply('550 Could not get file size')
+            elif cmd == 'SIZE':
+                self.reply('213 %d' % os.path.getsize(local))
+            else:
+                self.reply('213 ' + time.strftime('%Y%m%d%H%M%S', time.gmtime(os.path.getmtime(local))))
+        elif cmd == 'REST':
+            self.rest = int(arg or 0)
+            self.reply('350 Restart position accepted (%d)' % self.rest)
+        elif cmd == 'LIST' or cmd == 'NLST':
+            self.listing(arch, cmd, arg)
+        elif cmd == 'RETR':
+            self.retrieve(arch, arg)
+        elif cmd == 'NOOP':
+            self.reply('200 NOOP ok')
+        elif cmd == 'QUIT':
+            self.reply('221 Goodbye')
+            return False
+        else:
+            self.reply('502 Command not implemented')
+        return True
+
+    def abspath(self, arg):
+        arg = arg.strip()
+        path = arg if arg.startswith('/') else self.cwd.rstrip('/') + '/' + arg
+        return os.path.normpath(path).replace(os.sep, '/')
+
+    def data(self):
+        """to accept the data connection of the passive mode"""
+        if self.pasv is None:
+            self.reply('425 Use PASV first')
+            return None
+        self.pasv.settimeout(30)
+        try:
+            conn, _ = self.pasv.accept()
+        finally:
+            self.pasv.close()
+            self.pasv = None
+        if self.prot and self.tls is not None:
+            conn = self.tls.wrap_socket(conn, server_side=True)
+        return conn
+
+    def close(self, conn):
+        try:
+            if isinstance(conn, ssl.SSLSocket):
+                conn = conn.unwrap()
+        except (OSError, ssl.SSLError):
+            pass
+        conn.close()
+
+    def listing(self, arch, cmd, arg):
+        args = [a for a in arg.split() if not a.startswith('-')]
+        path = self.abspath(args[0]) if args else self.cwd
+        local = arch.resolve(path)
+        arch.count('requests')
+        if local is None or not os.path.isdir(local):
+            self.reply('450 No such directory')
+            return
+        names = sorted(os.listdir(local))
+        if cmd == 'LIST':
+            lines = [ls_line(local, n) for n in names]
+        else:
+            lines = names
+        self.reply('150 Here comes the directory listing')
+        conn = self.data()
+        if conn is None:
+            return
+        conn.sendall(''.join(l + '\r\n' for l in lines).encode('latin-1'))
+        self.close(conn)
+        self.reply('226 Directory send OK')
+
+    def retrieve(self, arch, arg):
+        path = self.abspath(arg)
+        local = arch.resolve(path)
+        rest, self.rest = self.rest, 0
+        arch.count('requests')
+        if local is None or not os.path.isfile(local):
+            arch.count('notfound')
+            self.reply('550 Failed to open file')
+            return
+        fault = arch.fault(path)
+        if fault == 'refuse':
+            arch.count('refused')
+            self.reply('421 Service not available, too many connections')
+            return
+        size = os.path.getsize(local)
+        self.reply('150 Opening BINARY mode data connection for %s (%d bytes)' % (os.path.basename(local), size))
+        conn = self.data()
+        if conn is None:
+            return
+        with open(local, 'rb') as fp:
+            arch.send(conn.sendall, fp, min(rest, size), size, fault == 'drop')
+        if fault == 'drop':
+            arch.count('dropped')
+            conn.close()
+            self.reply('426 Connection closed; transfer aborted')
+            return
+        self.close(conn)
+        arch.count('files')
+        self.reply('226 Transfer complete')
+
+
+class FtpServer(socketserver.ThreadingTCPServer):
+    daemon_threads = True
+    allow_reuse_address = True
+
+
+class HttpHandler(BaseHTTPRequestHandler):
+    """one request of HTTP (or HTTPS), the directories are listed as the index pages of Apache"""
+
+    protocol_version = 'HTTP/1.1'
+    server_version = 'GOODMock/1.0'
+
+    def log_message(self, format, *args):
+        pass
+
+    def do_HEAD(self):
+        self.serve(False)
+
+    def do_GET(self):
+        self.serve(True)
+
+    def serve(self, body):
+        arch = self.server.archive
+        arch.delay()
+        arch.count('requests')
+        path = urllib.parse.urlsplit(self.path).path
+        local = arch.resolve(path)
+        if local is not None and os.path.isdir(local):
+            if not path.endswith('/'):
+                self.send_response(301)
+                self.send_header('Location', path + '/')
+                self.send_header('Content-Length', '0')
+                self.end_headers()
+                return
+            names = sorted(os.listdir(local))
+            items = ''.join('<a href="%s">%s</a>\n' % (urllib.parse.quote(n + ('/' if os.path.isdir(os.path.join(local, n)) else '')),
+                                                       html.escape(n)) for n in names)
+            page = ('<html><head><title>Index of %s</title></head><body><h1>Index of %s</h1><pre>\n%s</pre></body></html>\n' %
+                    (html.escape(path), html.escape(path), items)).encode('utf-8')
+            self.send_response(200)
+            self.send_header('Content-Type', 'text/html')
+            self.send_header('Content-Length', str(len(page)))
+            self.end_headers()
+            if body:
+                self.wfile.write(page)
+            return
+        if local is None or not os.path.isfile(local):
+            arch.count('notfound')
+            self.send_error(404, 'Not Found')
+            return
+        fault = arch.fault(path) if body else None
+        if fault == 'refuse':
+            arch.count('refused')
+            self.send_response(503)
+            self.send_header('Retry-After', '1')
+            self.send_header('Content-Length', '0')
+            self.end_headers()
+            return
+
+        st = os.stat(local)
+        offset = 0
+        rng = self.headers.get('Range', '')
+        if rng.startswith('bytes=') and rng[6:].split('-')[0].isdigit():
+            offset = min(int(rng[6:].split('-')[0]), st.st_size)
+        self.send_response(206 if offset > 0 else 200)
+        self.send_header('Content-Type', 'application/octet-stream')
+        self.send_header('Content-Length', str(st.st_size - offset))
+        if offset > 0:
+            self.send_header('Content-Range', 'bytes %d-%d/%d' % (offset, st.st_size - 1, st.st_size))
+        self.send_header('Last-Modified', email.utils.formatdate(st.st_mtime, usegmt=True))
+        self.send_header('ETag', '"%x-%x"' % (int(st.st_mtime), st.st_size))
+        self.send_header('Accept-Ranges', 'bytes')
+        self.end_headers()
+        if not body:
+            return
+        with open(local, 'rb') as fp:
+            arch.send(self.wfile.write, fp, offset, st.st_size, fault == 'drop')
+        if fault == 'drop':
+            arch.count('dropped')
+            self.close_connection = True
+            return
+        arch.count('files')
+
+
+def selfsigned(workdir):
+    """to generate one self-signed certificate by 'openssl'"""
+    pem = os.path.join(workdir, 'mock_archive.pem')
+    key = os.path.join(workdir, 'mock_archive.key')
+    crt = os.path.join(workdir, 'mock_archive.crt')
+    subprocess.check_call(['openssl', 'req', '-x509', '-newkey', 'rsa:2048', '-nodes', '-days', '30', '-subj', '/CN=127.0.0.1',
+                           '-keyout', key, '-out', crt], stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    with open(pem, 'w') as fp:
+        fp.write(open(crt).read() + open(key).read())
+    return pem
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Local mock archive server (FTP, FTPS, HTTP and HTTPS) for the offline benchmark of GOOD')
+    parser.add_argument('-root', required=True, help='the root directory of the synthetic trees')
+    parser.add_argument('-bind', default='127.0.0.1', help='the address bound')
+    parser.add_argument('-ftp', type=int, default=2121, help='the port of FTP (0: off)')
+    parser.add_argument('-ftps', type=int, default=2990, help='the port of explicit FTPS (0: off)')
+    parser.add_argument('-http', type=int, default=8080, help='the port of HTTP (0: off)')
+    parser.add_argument('-https', type=int, default=8443, help='the port of HTTPS (0: off)')
+    parser.add_argument('-cert', default='', help='the PEM file with the certificate and the private key')
+    parser.add_argument('-latency', type=float, default=0.0, help='the latency (s) of each command or request')
+    parser.add_argument('-bandwidth', type=float, default=0.0, help='the bandwidth (bytes/s) of each transfer, 0: unlimited')
+    parser.add_argument('-error', type=float, default=0.0, help='the rate (0~1) of the transfers failed')
+    parser.add_argument('-seed', type=int, default=0, help='the seed of the failures')
+    parser.add_argument('-stats', default='', help='the JSON file of the counters, written at the exit')
+    args = parser.parse_args()
+
+    arch = Archive(args.root, args.latency, args.bandwidth, args.error, args.seed)
+    tls = None
+    if args.ftps > 0 or args.https > 0:
+        pem = args.cert or selfsigned(tempfile.mkdtemp(prefix='mock_archive_'))
+        tls = ssl.SSLContext(ssl.PROTOCOL_TLS_SERVER)
+        tls.load_cert_chain(pem)
+
+    servers = []
+    if args.ftp > 0:
+        servers.append(('ftp', args.ftp, FtpServer((args.bind, args.ftp), FtpHandler)))
+    if args.ftps > 0:
+        handler = type('FtpsHandler', (FtpHandler,), {'tls': tls})
+        servers.append(('ftps', args.ftps, FtpServer((args.bind, args.ftps), handler)))
+    if args.http > 0:
+        servers.append(('http', args.http, ThreadingHTTPServer((args.bind, args.http), HttpHandler)))
+    if args.https > 0:
+        srv = ThreadingHTTPServer((args.bind, args.https), HttpHandler)
+        srv.socket = tls.wrap_socket(srv.socket, server_side=True)
+        servers.append(('https', args.https, srv))
+
+    for scheme, port, srv in servers:
+        srv.archive = arch
+        srv.daemon_threads = True
+        threading.Thread(target=srv.serve_forever, daemon=True).start()
+    print('mock archive: ' + ' '.join('%s=%s:%d' % (s, args.bind, p) for s, p, _ in servers), flush=True)
+
+    done = threading.Event()
+    signal.signal(signal.SIGTERM, lambda *a: done.set())
+    signal.signal(signal.SIGINT, lambda *a: done.set())
+    while not done.wait(1.0):
+        pass
+    for _, _, srv in servers:
+        srv.shutdown()
+    if args.stats:
+        with open(args.stats, 'w') as fp:
+            json.dump(arch.stats, fp, indent=2)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
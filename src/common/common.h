@@ -15,12 +15,21 @@
 #include <sstream>
 #include <iomanip>
 #include <vector>
+#include <map>
+#include <set>
+#include <list>
 #include <algorithm>
+#include <functional>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <random>
 #ifdef _WIN32  /* for Windows */
 #include <string>
 #include <winsock2.h>
 #include <windows.h>
 #include <direct.h>
+#include <sys/utime.h>
 #include "..\win\unistd.h"
 #pragma warning(disable:4996)
 #pragma warning(disable:4101)
@@ -29,6 +38,20 @@
 #include <math.h>
 #include <unistd.h>
 #include <pthread.h>
+#include <sys/wait.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/ioctl.h>
+#include <sys/file.h>
+#include <utime.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <fnmatch.h>
+#ifdef __linux__
+#include <linux/fs.h>
+#endif
 #endif
 
 /* Trace debug export level --------------------------------------------------*/
@@ -26,14 +26,20 @@ public:
     **/
     static std::string int2str(int ii, int len)
     {
-        std::string xii(std::to_string(ii));
-        std::string sii;
-        if (len == 2) sii = "00";
-        else if (len == 3) sii = "000";
-        else if (len == 4) sii = "0000";
-        sii.replace(len - xii.size(), xii.size(), xii);
-
-        return sii;
+        /* the digits are written backwards into one buffer without the temporary strings, and padded with '0' */
+        char sii[16];
+        char* p = sii + sizeof(sii);
+        unsigned int xii = ii < 0 ? 0u - (unsigned int)ii : (unsigned int)ii;
+        do
+        {
+            *--p = (char)('0' + xii % 10);
+            xii /= 10;
+        } while (xii > 0);
+        int npad = len - (ii < 0 ? 1 : 0);
+        while (sii + sizeof(sii) - p < npad && p > sii + 1) *--p = '0';
+        if (ii < 0) *--p = '-';
+
+        return std::string(p, sii + sizeof(sii) - p);
     } /* end of int2str */
     /**
     * @brief     : ToUpper - convert the string from lower case to upper case
@@ -58,7 +64,7 @@ public:
     } /* end of ToLower */
 
     /* split buff by sep */
-    static std::vector<std::string> split(std::string buff, std::string sep)
+    static std::vector<std::string> split(const std::string& buff, const std::string& sep)
     {
         std::vector<std::string> tokens;
         tokens.clear();
@@ -88,6 +94,55 @@ public:
         s.erase(s.find_last_not_of(" ") + 1);
     } /* end of trim */
 
+    /**
+    * @brief   : HashStr - to get the 32-bit FNV-1a hash of one string
+    * @param[I]: str (string)
+    * @param[O]: none
+    * @return  : hash value
+    * @note    : unlike std::hash, it is the same on all platforms and compilers
+    **/
+    static unsigned int HashStr(std::string str)
+    {
+        unsigned int hash = 2166136261u;
+        for (size_t i = 0; i < str.size(); i++)
+        {
+            hash ^= (unsigned char)str[i];
+            hash *= 16777619u;
+        }
+
+        return hash;
+    } /* end of HashStr */
+
+    /**
+    * @brief   : EscapeJson - to escape one string as the value of a JSON string
+    * @param[I]: str (string)
+    * @param[O]: none
+    * @return  : escaped string without the quotes
+    * @note    :
+    **/
+    static std::string EscapeJson(std::string str)
+    {
+        std::string out;
+        for (size_t i = 0; i < str.size(); i++)
+        {
+            unsigned char c = (unsigned char)str[i];
+            if (c == '"') out += "\\\"";
+            else if (c == '\\') out += "\\\\";
+            else if (c == '\n') out += "\\n";
+            else if (c == '\r') out += "\\r";
+            else if (c == '\t') out += "\\t";
+            else if (c < 0x20)
+            {
+                char hex[8];
+                sprintf(hex, "\\u%04x", c);
+                out += hex;
+            }
+            else out += str[i];
+        }
+
+        return out;
+    } /* end of EscapeJson */
+
     /**
     * @brief   : GetFile - get the full name of a specific file from the current directory
     * @param[I]: dir (the current directory)
@@ -105,7 +160,8 @@ public:
         chdir(dir.c_str());
 #endif
 
-        std::string cmd, filelist = "files.list";
+        /* the name is unique per process, so that the processes sharing one directory do NOT clash */
+        std::string cmd, filelist = "files." + std::to_string(getpid()) + ".list";
 #ifdef _WIN32   /* for Windows */
         cmd = "dir /b | find \"" + str + "\"" + " > " + filelist;
 #else           /* for Linux or Mac */
@@ -160,7 +216,8 @@ public:
     **/
     static void GetFilesAll(std::string dir, std::string str, std::vector<std::string>& files)
     {
-        std::string cmd, filelist = "files.list";
+        /* the name is unique per process, so that the processes sharing one directory do NOT clash */
+        std::string cmd, filelist = "files." + std::to_string(getpid()) + ".list";
 #ifdef _WIN32   /* for Windows */
         cmd = "dir /b " + dir + " | find \"" + str + "\"" + " > " + filelist;
 #else           /* for Linux or Mac */
@@ -176,7 +233,7 @@ public:
             if (!fillst.is_open())
             {
                 std::string out = "*** ERROR(CString::getFiles): open files.list = " + filelist + " file failed, please check it";
-                std::cout << out << std::endl;
+                Logger::Trace(TERROR, out);
                 return;
             }
 
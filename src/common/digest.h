@@ -0,0 +1,414 @@
+/*------------------------------------------------------------------------------
+* digest.h : message digests (checksums) of the files
+*
+* Copyright (C) 2020-2099 by Ubiquitous Navigation & Integrated positioning lab in Quest (UNIQ), all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader)
+*
+* history : 2026/10/19 1.0  new
+*-----------------------------------------------------------------------------*/
+#ifndef DIGEST_H
+#define DIGEST_H
+
+#include "common.h"
+#include <cstdint>
+#include <cstring>
+
+#define DIGEST_BUFSIZE  (1 << 20)       /* size (bytes) of the buffer of reading the files */
+
+#define DIGEST_MD5       0   /* MD5 (RFC 1321), i.e., 'MD5SUMS' of the archives */
+#define DIGEST_SHA256    1   /* SHA-256 (FIPS 180-4), i.e., the run manifest */
+#define DIGEST_SHA512    2   /* SHA-512 (FIPS 180-4), i.e., 'SHA512SUMS' of the archives */
+
+class Digest
+{
+public:
+    struct hash_t
+    {                                    /* state of one digest */
+        int algo;                        /* algorithm (DIGEST_*) */
+        uint32_t h32[8];                 /* hash values of MD5 (the first four) and SHA-256 */
+        uint64_t h64[8];                 /* hash values of SHA-512 */
+        uint64_t nbytes;                 /* bytes hashed */
+        unsigned char block[128];        /* the bytes of the block NOT full yet */
+        size_t nblock;                   /* number of the bytes in 'block' */
+    };
+
+private:
+    /**
+    * @brief   : Md5Block - to hash one block of 64 bytes by MD5
+    * @param[I]: st (state)
+    * @param[I]: p (block)
+    * @param[O]: st (state)
+    * @return  : none
+    * @note    :
+    **/
+    static void Md5Block(hash_t& st, const unsigned char* p)
+    {
+        static const uint32_t k[64] = {
+            0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+            0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+            0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+            0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+            0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+            0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+            0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+            0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391 };
+        static const int r[64] = {
+            7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20,
+            4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21 };
+        auto rotl = [](uint32_t x, int n) -> uint32_t { return (x << n) | (x >> (32 - n)); };
+
+        uint32_t m[16];
+        for (int i = 0; i < 16; i++)
+        {
+            m[i] = (uint32_t)p[4 * i] | ((uint32_t)p[4 * i + 1] << 8) | ((uint32_t)p[4 * i + 2] << 16) | ((uint32_t)p[4 * i + 3] << 24);
+        }
+
+        uint32_t a = st.h32[0], b = st.h32[1], c = st.h32[2], d = st.h32[3];
+        for (int i = 0; i < 64; i++)
+        {
+            uint32_t f;
+            int g;
+            if (i < 16)
+            {
+                f = (b & c) | (~b & d);
+                g = i;
+            }
+            else if (i < 32)
+            {
+                f = (d & b) | (~d & c);
+                g = (5 * i + 1) % 16;
+            }
+            else if (i < 48)
+            {
+                f = b ^ c ^ d;
+                g = (3 * i + 5) % 16;
+            }
+            else
+            {
+                f = c ^ (b | ~d);
+                g = (7 * i) % 16;
+            }
+            uint32_t t = d;
+            d = c;
+            c = b;
+            b = b + rotl(a + f + k[i] + m[g], r[i]);
+            a = t;
+        }
+        st.h32[0] += a;
+        st.h32[1] += b;
+        st.h32[2] += c;
+        st.h32[3] += d;
+    } /* end of Md5Block */
+
+    /**
+    * @brief   : Sha256Block - to hash one block of 64 bytes by SHA-256
+    * @param[I]: st (state)
+    * @param[I]: p (block)
+    * @param[O]: st (state)
+    * @return  : none
+    * @note    :
+    **/
+    static void Sha256Block(hash_t& st, const unsigned char* p)
+    {
+        static const uint32_t k[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2 };
+        auto rotr = [](uint32_t x, int n) -> uint32_t { return (x >> n) | (x << (32 - n)); };
+
+        uint32_t w[64];
+        for (int i = 0; i < 16; i++)
+        {
+            w[i] = ((uint32_t)p[4 * i] << 24) | ((uint32_t)p[4 * i + 1] << 16) | ((uint32_t)p[4 * i + 2] << 8) | (uint32_t)p[4 * i + 3];
+        }
+        for (int i = 16; i < 64; i++)
+        {
+            uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint32_t a = st.h32[0], b = st.h32[1], c = st.h32[2], d = st.h32[3], e = st.h32[4], f = st.h32[5], g = st.h32[6],
+            h = st.h32[7];
+        for (int i = 0; i < 64; i++)
+        {
+            uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + k[i] + w[i];
+            uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        st.h32[0] += a;
+        st.h32[1] += b;
+        st.h32[2] += c;
+        st.h32[3] += d;
+        st.h32[4] += e;
+        st.h32[5] += f;
+        st.h32[6] += g;
+        st.h32[7] += h;
+    } /* end of Sha256Block */
+
+    /**
+    * @brief   : Sha512Block - to hash one block of 128 bytes by SHA-512
+    * @param[I]: st (state)
+    * @param[I]: p (block)
+    * @param[O]: st (state)
+    * @return  : none
+    * @note    :
+    **/
+    static void Sha512Block(hash_t& st, const unsigned char* p)
+    {
+        static const uint64_t k[80] = {
+            0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+            0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+            0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+            0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+            0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+            0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+            0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+            0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+            0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+            0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+            0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+            0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+            0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+            0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+            0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+            0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+            0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+            0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+            0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+            0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL };
+        auto rotr = [](uint64_t x, int n) -> uint64_t { return (x >> n) | (x << (64 - n)); };
+
+        uint64_t w[80];
+        for (int i = 0; i < 16; i++)
+        {
+            w[i] = 0;
+            for (int j = 0; j < 8; j++) w[i] = (w[i] << 8) | (uint64_t)p[8 * i + j];
+        }
+        for (int i = 16; i < 80; i++)
+        {
+            uint64_t s0 = rotr(w[i - 15], 1) ^ rotr(w[i - 15], 8) ^ (w[i - 15] >> 7);
+            uint64_t s1 = rotr(w[i - 2], 19) ^ rotr(w[i - 2], 61) ^ (w[i - 2] >> 6);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint64_t a = st.h64[0], b = st.h64[1], c = st.h64[2], d = st.h64[3], e = st.h64[4], f = st.h64[5], g = st.h64[6],
+            h = st.h64[7];
+        for (int i = 0; i < 80; i++)
+        {
+            uint64_t t1 = h + (rotr(e, 14) ^ rotr(e, 18) ^ rotr(e, 41)) + ((e & f) ^ (~e & g)) + k[i] + w[i];
+            uint64_t t2 = (rotr(a, 28) ^ rotr(a, 34) ^ rotr(a, 39)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        st.h64[0] += a;
+        st.h64[1] += b;
+        st.h64[2] += c;
+        st.h64[3] += d;
+        st.h64[4] += e;
+        st.h64[5] += f;
+        st.h64[6] += g;
+        st.h64[7] += h;
+    } /* end of Sha512Block */
+
+    /**
+    * @brief   : Block - to hash one full block by the algorithm of the state
+    * @param[I]: st (state)
+    * @param[I]: p (block)
+    * @param[O]: st (state)
+    * @return  : none
+    * @note    :
+    **/
+    static void Block(hash_t& st, const unsigned char* p)
+    {
+        if (st.algo == DIGEST_MD5) Md5Block(st, p);
+        else if (st.algo == DIGEST_SHA512) Sha512Block(st, p);
+        else Sha256Block(st, p);
+    } /* end of Block */
+
+    /**
+    * @brief   : Hex - to convert the bytes of one digest to lowercase hexadecimal
+    * @param[I]: p (bytes)
+    * @param[I]: n (number of the bytes)
+    * @param[O]: none
+    * @return  : digest in hexadecimal
+    * @note    :
+    **/
+    static std::string Hex(const unsigned char* p, size_t n)
+    {
+        static const char digits[] = "0123456789abcdef";
+        std::string hex(2 * n, '0');
+        for (size_t i = 0; i < n; i++)
+        {
+            hex[2 * i] = digits[p[i] >> 4];
+            hex[2 * i + 1] = digits[p[i] & 0x0f];
+        }
+
+        return hex;
+    } /* end of Hex */
+
+public:
+    /**
+    * @brief   : Algo - to get the algorithm by its name
+    * @param[I]: name (name of the algorithm, i.e., "md5", "SHA256", "sha512")
+    * @param[O]: none
+    * @return  : algorithm (DIGEST_*), -1 if it is NOT supported
+    * @note    :
+    **/
+    static int Algo(std::string name)
+    {
+        for (size_t i = 0; i < name.size(); i++) name[i] = (char)tolower((unsigned char)name[i]);
+        name.erase(std::remove(name.begin(), name.end(), '-'), name.end());
+        if (name == "md5") return DIGEST_MD5;
+        else if (name == "sha256") return DIGEST_SHA256;
+        else if (name == "sha512") return DIGEST_SHA512;
+
+        return -1;
+    } /* end of Algo */
+
+    /**
+    * @brief   : Init - to initialize the state of one digest
+    * @param[I]: algo (algorithm, DIGEST_*)
+    * @param[O]: st (state)
+    * @return  : none
+    * @note    :
+    **/
+    static void Init(hash_t& st, int algo)
+    {
+        static const uint32_t h0md5[4] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476 };
+        static const uint32_t h0sha256[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c,
+            0x1f83d9ab, 0x5be0cd19 };
+        static const uint64_t h0sha512[8] = { 0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL,
+            0xa54ff53a5f1d36f1ULL, 0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL };
+        memset(&st, 0, sizeof(st));
+        st.algo = algo;
+        if (algo == DIGEST_MD5) memcpy(st.h32, h0md5, sizeof(h0md5));
+        else if (algo == DIGEST_SHA512) memcpy(st.h64, h0sha512, sizeof(h0sha512));
+        else memcpy(st.h32, h0sha256, sizeof(h0sha256));
+    } /* end of Init */
+
+    /**
+    * @brief   : Update - to hash the bytes following the ones hashed
+    * @param[I]: st (state)
+    * @param[I]: data (bytes)
+    * @param[I]: n (number of the bytes)
+    * @param[O]: st (state)
+    * @return  : none
+    * @note    :
+    **/
+    static void Update(hash_t& st, const void* data, size_t n)
+    {
+        const unsigned char* p = (const unsigned char*)data;
+        size_t bsize = st.algo == DIGEST_SHA512 ? 128 : 64;
+        st.nbytes += n;
+        if (st.nblock > 0)
+        {
+            size_t m = std::min(n, bsize - st.nblock);
+            memcpy(st.block + st.nblock, p, m);
+            st.nblock += m;
+            p += m;
+            n -= m;
+            if (st.nblock < bsize) return;
+            Block(st, st.block);
+            st.nblock = 0;
+        }
+        for (; n >= bsize; p += bsize, n -= bsize) Block(st, p);
+        if (n > 0)
+        {
+            memcpy(st.block, p, n);
+            st.nblock = n;
+        }
+    } /* end of Update */
+
+    /**
+    * @brief   : Final - to pad the bytes hashed and get the digest
+    * @param[I]: st (state)
+    * @param[O]: st (state, NOT usable any more)
+    * @return  : digest in lowercase hexadecimal (32, 64 or 128 characters for MD5, SHA-256 or SHA-512)
+    * @note    :
+    **/
+    static std::string Final(hash_t& st)
+    {
+        /* the length in bits is 64 bits (little-endian for MD5) or 128 bits (SHA-512) at the end of the last block */
+        size_t bsize = st.algo == DIGEST_SHA512 ? 128 : 64, lsize = st.algo == DIGEST_SHA512 ? 16 : 8;
+        uint64_t nbits = st.nbytes * 8;
+        unsigned char pad[272] = { 0x80 };
+        size_t npad = (st.nblock < bsize - lsize ? bsize : 2 * bsize) - lsize - st.nblock;
+        for (int i = 0; i < 8; i++)
+        {
+            if (st.algo == DIGEST_MD5) pad[npad + i] = (unsigned char)(nbits >> (8 * i));
+            else pad[npad + lsize - 8 + i] = (unsigned char)(nbits >> (56 - 8 * i));
+        }
+        Update(st, pad, npad + lsize);
+
+        unsigned char out[64];
+        size_t nout = 0;
+        if (st.algo == DIGEST_MD5)
+        {
+            for (int i = 0; i < 4; i++)
+            {
+                for (int j = 0; j < 4; j++) out[nout++] = (unsigned char)(st.h32[i] >> (8 * j));
+            }
+        }
+        else if (st.algo == DIGEST_SHA512)
+        {
+            for (int i = 0; i < 8; i++)
+            {
+                for (int j = 0; j < 8; j++) out[nout++] = (unsigned char)(st.h64[i] >> (56 - 8 * j));
+            }
+        }
+        else
+        {
+            for (int i = 0; i < 8; i++)
+            {
+                for (int j = 0; j < 4; j++) out[nout++] = (unsigned char)(st.h32[i] >> (24 - 8 * j));
+            }
+        }
+
+        return Hex(out, nout);
+    } /* end of Final */
+
+    /**
+    * @brief   : File - to get the digest of one file
+    * @param[I]: file (file with full path)
+    * @param[I]: algo (algorithm, DIGEST_*)
+    * @param[O]: none
+    * @return  : digest in lowercase hexadecimal, empty if the file is NOT readable
+    * @note    :
+    **/
+    static std::string File(std::string file, int algo)
+    {
+        FILE* fp = fopen(file.c_str(), "rb");
+        if (fp == NULL) return "";
+
+        hash_t st;
+        Init(st, algo);
+        std::vector<char> buff(DIGEST_BUFSIZE);
+        size_t n;
+        while ((n = fread(buff.data(), 1, buff.size(), fp)) > 0) Update(st, buff.data(), n);
+        bool iserr = ferror(fp) != 0;
+        fclose(fp);
+
+        return iserr ? "" : Final(st);
+    } /* end of File */
+};
+
+#endif  // DIGEST_H
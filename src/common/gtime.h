@@ -111,9 +111,21 @@ public:
     * @return  : time struct (.mjd and .sod)
     * @note    :
     **/
-    static gtime_t ymdhms2time(const std::vector<double> ep)
+    static gtime_t ymdhms2time(const std::vector<double>& ep)
     {
-        gtime_t tt = {0};
+        return ymdhms2time(ep.data());
+    } /* end of ymdhms2time */
+
+    /**
+    * @brief   : ymdhms2time - the conversion from year, month, day, hour, minute, second to time
+    * @param[I]: ep (6 x 1 array indicating year, month, day, hour, minute, and second)
+    * @param[O]: none
+    * @return  : time struct (.mjd and .sod)
+    * @note    : no allocation, for the conversions called many times per file name
+    **/
+    static gtime_t ymdhms2time(const double* ep)
+    {
+        gtime_t tt = {};
         tt.sod = hms2sod((int)floor(ep[3]), (int)floor(ep[4]), ep[5]);
 
         int yyyy = yy2yyyy((int)floor(ep[0]));
@@ -140,6 +152,21 @@ public:
     * @note    :
     **/
     static std::vector<double> time2ymdhms(gtime_t tt)
+    {
+        std::vector<double> ep(6);
+        time2ymdhms(tt, ep.data());
+
+        return ep;
+    } /* end of time2ymdhms */
+
+    /**
+    * @brief   : time2ymdhms - the conversion from time to year, month, day, hour, minute, second
+    * @param[I]: tt (time struct (.mjd and .sod))
+    * @param[O]: ep (6 x 1 array indicating year, month, day, hour, minute, and second)
+    * @return  : none
+    * @note    : no allocation, for the conversions called many times per file name
+    **/
+    static void time2ymdhms(gtime_t tt, double* ep)
     {
         double mjd = tt.mjd + tt.sod / 86400.0;
 
@@ -169,11 +196,8 @@ public:
             hour += 1;
         }
 
-        std::vector<double> ep;
-        ep.push_back(year); ep.push_back(month); ep.push_back(day);
-        ep.push_back(hour); ep.push_back(min); ep.push_back(sec);
-
-        return ep;
+        ep[0] = year; ep[1] = month; ep[2] = day;
+        ep[3] = hour; ep[4] = min; ep[5] = sec;
     } /* end of time2ymdhms */
 
     /**
@@ -187,9 +211,7 @@ public:
     static gtime_t yrdoy2time(int year, int doy)
     {
         /* time at yyyy-01-01 00:00:00 */
-        std::vector<double> ep;
-        ep.push_back(year); ep.push_back(1); ep.push_back(1);
-        ep.push_back(0); ep.push_back(0); ep.push_back(0);
+        const double ep[6] = { (double)year, 1, 1, 0, 0, 0 };
         gtime_t t_jan1 = ymdhms2time(ep);
         double dt = (doy - 1) * 86400.0;
         gtime_t tt = TimeAdd(t_jan1, dt);
@@ -207,8 +229,8 @@ public:
     **/
     static void time2yrdoy(gtime_t tt, int& year, int& doy)
     {
-        std::vector<double> ep;
-        ep = time2ymdhms(tt);
+        double ep[6];
+        time2ymdhms(tt, ep);
         year = (int)ep[0];
 
         /* time at yyyy-01-01 00:00:00 */
@@ -229,9 +251,8 @@ public:
     **/
     static gtime_t gpst2time(int week, double sow)
     {
-        /* compute the time of the GPS starting time (1980-01-06 00:00:00) */
-        const std::vector<double> gpst0 = { 1980, 1, 6, 0, 0, 0 };  /* GPS time reference */
-        gtime_t t_gpst0 = ymdhms2time(gpst0);
+        /* the GPS starting time (1980-01-06 00:00:00) */
+        const gtime_t t_gpst0 = { 44244, 0.0 };  /* GPS time reference */
 
         double dt = week * 7 * 86400.0 + sow;
         gtime_t tt = TimeAdd(t_gpst0, dt);
@@ -249,9 +270,8 @@ public:
     **/
     static int time2gpst(gtime_t tt, int& week, double& sow)
     {
-        /* compute the time of the GPS starting time (1980-01-06 00:00:00) */
-        const std::vector<double> gpst0 = { 1980, 1, 6, 0, 0, 0 };  /* GPS time reference */
-        gtime_t t_gpst0 = ymdhms2time(gpst0);
+        /* the GPS starting time (1980-01-06 00:00:00) */
+        const gtime_t t_gpst0 = { 44244, 0.0 };  /* GPS time reference */
 
         /* compute the time differences */
         double delta_day = TimeDiff(tt, t_gpst0) / 86400.0;
@@ -268,6 +288,23 @@ public:
         return dow;
     } /* end of time2gpst */
 
+    /**
+    * @brief   : now - to get the current time of the system clock
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : time struct (.mjd and .sod) in UTC
+    * @note    : the leap seconds are NOT considered
+    **/
+    static gtime_t now()
+    {
+        gtime_t tt;
+        time_t tnow = time(NULL);
+        tt.mjd = 40587 + (int)(tnow / 86400);  /* MJD of 1970/01/01 is 40587 */
+        tt.sod = (double)(tnow % 86400);
+
+        return tt;
+    } /* end of now */
+
     /**
     * @brief   : time2str - the conversion from gtime_t struct to string
     * @param[I]: tt (time struct (.mjd and .sod))
@@ -277,10 +314,10 @@ public:
     **/
     static std::string time2str(gtime_t tt)
     {
-        std::vector<double> ep;
+        double ep[6];
         std::stringstream stime;
 
-        ep = time2ymdhms(tt);
+        time2ymdhms(tt, ep);
         stime << std::fixed   << std::setprecision(0) << ep[0] << "/"
               << std::setw(2) << std::setfill('0')    << ep[1] << "/"
               << std::setw(2) << std::setfill('0')    << ep[2] << " "
@@ -6,6 +6,9 @@
 *
 * history : 2020/08/16 1.0  new (by Feng Zhou)
 *           2020/10/12 3.0  mojor modifications (by Feng Zhou)
+*           2026/10/19      asynchronous: one process-wide logger, the messages are queued in one lock-free ring buffer
+*                             and written by one background thread, and the repetitive messages are rate-limited
+*           2026/10/19      one status line kept at the bottom of the console, see Status
 *-----------------------------------------------------------------------------*/
 #ifndef LOGGER_H
 #define LOGGER_H
@@ -13,41 +16,442 @@
 #include "common.h"
 #include "types.h"
 #include "gtime.h"
+#include <mutex>
+#include <condition_variable>
 
-static int ilevel_ = 5;        /* level of debug trace */
-static std::ofstream sfile_;   /* iostream of output file */
+#define LOG_RINGSIZE    4096           /* slots of the ring buffer of the messages, power of 2 */
+#define LOG_FLUSHMS     100            /* interval (ms) of the background flushing */
+#define LOG_MAXRATE     10             /* maximum messages per second of the same kind printed, INFO and DEBUG only */
 
 class Logger
 {
+private:
+    struct slot_t
+    {                                    /* one message in the ring buffer */
+        std::atomic<size_t> seq;         /* sequence number: == position: free, == position + 1: written */
+        int level;                       /* level of debug trace */
+        std::time_t tnow;                /* time of the message, 0: NOT printed */
+        std::string info;                /* message */
+    };
+
+    struct limit_t
+    {                                    /* rate limiting of one kind of messages */
+        std::chrono::steady_clock::time_point t0;  /* start of the window of one second */
+        int nprint;                      /* messages printed in the window */
+        int nskip;                       /* messages suppressed in the window */
+        std::string last;                /* last message suppressed */
+    };
+
+    struct state_t
+    {                                    /* the state of the process-wide logger */
+        std::atomic<int> level;          /* level of debug trace */
+        std::atomic<int> maxrate;        /* maximum messages per second of the same kind printed, 0: no limit */
+        std::atomic<bool> console;       /* whether the messages are printed to the console */
+        std::atomic<bool> status;        /* whether one status line is kept at the bottom of the console, see Status */
+        std::atomic<size_t> tail;        /* next position written by the producers */
+        size_t head;                     /* next position read by the consumer, under 'drain' */
+        slot_t ring[LOG_RINGSIZE];       /* ring buffer of the messages */
+        std::mutex* drain;               /* lock of the consumer and the sinks */
+        std::mutex* wake;                /* lock of the condition variable */
+        std::condition_variable* cv;     /* to wake up the background thread */
+        std::thread* flusher;            /* background thread, NULL: NOT started */
+        std::atomic<bool> running;       /* whether the background thread is running */
+        bool stop;                       /* to stop the background thread */
+        std::ofstream sfile;             /* iostream of output file */
+        std::map<std::string, limit_t> limits;  /* rate limiting of each kind of messages, under 'drain' */
+        std::string outbuf, filebuf;     /* messages formatted and NOT written yet, under 'drain' */
+
+        state_t() : level(5), maxrate(LOG_MAXRATE), console(true), status(false), tail(0), head(0), running(false), stop(false)
+        {
+            for (size_t i = 0; i < LOG_RINGSIZE; i++) ring[i].seq.store(i, std::memory_order_relaxed);
+            drain = new std::mutex;
+            wake = new std::mutex;
+            cv = new std::condition_variable;
+            flusher = NULL;
+#ifndef _WIN32
+            /* the child of 'fork' has no background thread and gets the locks unlocked */
+            pthread_atfork(Logger::AtForkPrepare, Logger::AtForkParent, Logger::AtForkChild);
+#endif
+        }
+    };
+
+    struct guard_t
+    {                                    /* to stop the background thread at the exit of the process */
+        ~guard_t() { Logger::Stop(); }
+    };
+
+    /**
+    * @brief   : State - to get the state of the process-wide logger
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : state, created at the first call and never destroyed
+    * @note    : one instance in the process, because the inline function has one local static in all translation units
+    **/
+    static state_t& State()
+    {
+        static state_t* st = new state_t;
+        static guard_t guard;
+        return *st;
+    } /* end of State */
+
+    /**
+    * @brief   : Kind - to get the kind of one message for the rate limiting, i.e., the file names and numbers are masked
+    * @param[I]: level (level of debug trace)
+    * @param[I]: info (message)
+    * @param[O]: none
+    * @return  : kind of the message
+    * @note    :
+    **/
+    static std::string Kind(int level, const std::string& info)
+    {
+        std::string kind(1, (char)('0' + level));
+        size_t i = 0, n = info.size();
+        while (i < n)
+        {
+            size_t j = info.find(' ', i);
+            if (j == std::string::npos) j = n;
+            bool masked = false;
+            for (size_t k = i; k < j && !masked; k++)
+            {
+                char c = info[k];
+                masked = (c >= '0' && c <= '9') || c == '.' || c == '/' || c == '\\';
+            }
+            if (masked) kind += "*";
+            else kind.append(info, i, j - i);
+            kind += ' ';
+            i = j + 1;
+        }
+        return kind;
+    } /* end of Kind */
+
+    /**
+    * @brief   : Format - to format one message to the buffers of the sinks
+    * @param[I]: st (state)
+    * @param[I]: level (level of debug trace)
+    * @param[I]: tnow (time of the message, 0: NOT printed)
+    * @param[I]: info (message)
+    * @param[O]: none
+    * @return  : none
+    * @note    : under 'drain'
+    **/
+    static void Format(state_t& st, int level, std::time_t tnow, const std::string& info)
+    {
+        if (st.sfile.is_open()) st.filebuf.append(info).append("\n");
+        if (!st.console.load(std::memory_order_relaxed)) return;
+
+        /* the repetitive INFO and DEBUG messages of the same kind are rate-limited on the console */
+        int maxrate = st.maxrate.load(std::memory_order_relaxed);
+        if (maxrate > 0 && (level == TINFO || level == TDEBUG))
+        {
+            auto now = std::chrono::steady_clock::now();
+            limit_t& lim = st.limits[Kind(level, info)];
+            if (lim.nprint == 0 || now - lim.t0 >= std::chrono::seconds(1))
+            {
+                Summary(st, level, lim);
+                lim.t0 = now;
+                lim.nprint = 0;
+            }
+            if (lim.nprint >= maxrate)
+            {
+                lim.nskip++;
+                lim.last = info;
+                return;
+            }
+            lim.nprint++;
+        }
+
+        static const char* colors[] = { "", TEXT_RED, TEXT_GREEN, TEXT_YELLOW, TEXT_CYAN, TEXT_PURPLE };
+        if (level < 1 || level > 5) return;
+        st.outbuf.append(colors[level]);
+        if (tnow != 0)
+        {
+            char stime[256];  /* string of time for output  */
+            std::strftime(stime, sizeof(stime), "%Y-%m-%d %H:%M:%S: ", std::localtime(&tnow));
+            st.outbuf.append(stime);
+        }
+        st.outbuf.append(info).append("\n").append(TEXT_RESET);
+    } /* end of Format */
+
+    /**
+    * @brief   : Summary - to print the number of the messages of one kind suppressed in the last window
+    * @param[I]: st (state)
+    * @param[I]: level (level of debug trace)
+    * @param[I]: lim (rate limiting of the kind)
+    * @param[O]: none
+    * @return  : none
+    * @note    : under 'drain'
+    **/
+    static void Summary(state_t& st, int level, limit_t& lim)
+    {
+        if (lim.nskip == 0) return;
+        st.outbuf.append(level == TINFO ? TEXT_GREEN : TEXT_CYAN).append("*** INFO(Logger::Trace): " + std::to_string(lim.nskip) +
+            " similar messages are NOT printed, the last one: ").append(lim.last).append("\n").append(TEXT_RESET);
+        lim.nskip = 0;
+        lim.last.clear();
+    } /* end of Summary */
+
+    /**
+    * @brief   : Drain - to write all the messages in the ring buffer to the sinks
+    * @param[I]: st (state)
+    * @param[I]: isall (true: the summaries of all the kinds suppressed are printed, false: only the expired ones)
+    * @param[O]: none
+    * @return  : none
+    * @note    : under 'drain'
+    **/
+    static void Drain(state_t& st, bool isall)
+    {
+        while (true)
+        {
+            slot_t& s = st.ring[st.head & (LOG_RINGSIZE - 1)];
+            if (s.seq.load(std::memory_order_acquire) != st.head + 1) break;
+            Format(st, s.level, s.tnow, s.info);
+            s.info.clear();
+            s.seq.store(st.head + LOG_RINGSIZE, std::memory_order_release);
+            st.head++;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        for (auto it = st.limits.begin(); it != st.limits.end(); )
+        {
+            if (isall || now - it->second.t0 >= std::chrono::seconds(1))
+            {
+                Summary(st, it->first[0] - '0', it->second);
+                it = st.limits.erase(it);
+            }
+            else ++it;
+        }
+
+        if (!st.outbuf.empty())
+        {
+            /* the status line is erased, and it is drawn again below the messages by the next Status */
+            if (st.status.load(std::memory_order_relaxed)) std::cout.write("\r\033[K", 4);
+            std::cout.write(st.outbuf.data(), st.outbuf.size());
+            st.outbuf.clear();
+        }
+        std::cout.flush();
+        if (!st.filebuf.empty() && st.sfile.is_open())
+        {
+            st.sfile.write(st.filebuf.data(), st.filebuf.size());
+            st.sfile.flush();
+        }
+        st.filebuf.clear();
+    } /* end of Drain */
+
+    /**
+    * @brief   : Run - the loop of the background thread
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    static void Run()
+    {
+        state_t& st = State();
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(*st.wake);
+                if (!st.stop) st.cv->wait_for(lock, std::chrono::milliseconds(LOG_FLUSHMS));
+                if (st.stop) break;
+            }
+            std::lock_guard<std::mutex> lock(*st.drain);
+            Drain(st, false);
+        }
+    } /* end of Run */
+
+    /**
+    * @brief   : Start - to start the background thread if NOT running
+    * @param[I]: st (state)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    static void Start(state_t& st)
+    {
+        std::lock_guard<std::mutex> lock(*st.wake);
+        if (st.running.load(std::memory_order_acquire) || st.stop) return;
+        st.flusher = new std::thread(Logger::Run);
+        st.running.store(true, std::memory_order_release);
+    } /* end of Start */
+
+    /**
+    * @brief   : Push - to queue one message into the ring buffer
+    * @param[I]: level (level of debug trace)
+    * @param[I]: tnow (time of the message, 0: NOT printed)
+    * @param[I]: info (message)
+    * @param[O]: none
+    * @return  : none
+    * @note    : lock-free for the producers, which wait only if the ring buffer is full
+    **/
+    static void Push(int level, std::time_t tnow, std::string& info)
+    {
+        state_t& st = State();
+        if (!st.running.load(std::memory_order_acquire))
+        {
+            Start(st);
+            if (st.stop)
+            {
+                /* after the exit of the process, the message is written directly */
+                std::lock_guard<std::mutex> lock(*st.drain);
+                Format(st, level, tnow, info);
+                Drain(st, true);
+                return;
+            }
+        }
+
+        size_t pos = st.tail.load(std::memory_order_relaxed);
+        slot_t* s;
+        while (true)
+        {
+            s = &st.ring[pos & (LOG_RINGSIZE - 1)];
+            size_t seq = s->seq.load(std::memory_order_acquire);
+            if (seq == pos)
+            {
+                if (st.tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            }
+            else if ((std::ptrdiff_t)(seq - pos) < 0)
+            {
+                /* the ring buffer is full */
+                st.cv->notify_one();
+                std::this_thread::yield();
+                pos = st.tail.load(std::memory_order_relaxed);
+            }
+            else pos = st.tail.load(std::memory_order_relaxed);
+        }
+        s->level = level;
+        s->tnow = tnow;
+        s->info.swap(info);
+        s->seq.store(pos + 1, std::memory_order_release);
+
+        /* the background thread is woken up for the errors, or if the ring buffer is half full */
+        if (level == TERROR || (pos & (LOG_RINGSIZE / 2 - 1)) == LOG_RINGSIZE / 2 - 1) st.cv->notify_one();
+    } /* end of Push */
+
+#ifndef _WIN32
+    static void AtForkPrepare()
+    {
+        state_t& st = State();
+        st.drain->lock();
+        Drain(st, true);
+    }
+
+    static void AtForkParent()
+    {
+        State().drain->unlock();
+    }
+
+    static void AtForkChild()
+    {
+        /* the background thread and the waiters of the parent do NOT exist in the child, so the locks and the condition
+           variable are created again, and the old ones are left */
+        state_t& st = State();
+        st.drain = new std::mutex;
+        st.wake = new std::mutex;
+        st.cv = new std::condition_variable;
+        st.flusher = NULL;
+        st.running.store(false, std::memory_order_release);
+    }
+#endif
+
 public:
     /**
-    * @brief   : TraceLevel -
-    * @param[I]: level ()
+    * @brief   : TraceLevel - to set the level of debug trace, the messages above it are dropped before any formatting
+    * @param[I]: level (level of debug trace, TERROR ~ TEXPORT)
     * @param[O]: none
     * @return  : none
     * @note    :
     **/
     static void TraceLevel(int level)
     {
-        ilevel_ = level;
+        State().level.store(level, std::memory_order_relaxed);
     } /* end of TraceLevel */
 
     /**
-    * @brief   : TraceOpen -
-    * @param[I]: filename ()
+    * @brief   : IsOn - to check whether the messages of one level are printed, i.e., before an expensive message is built
+    * @param[I]: level (level of debug trace)
+    * @param[O]: none
+    * @return  : true: printed, false: dropped
+    * @note    :
+    **/
+    static bool IsOn(int level)
+    {
+        return level <= State().level.load(std::memory_order_relaxed);
+    } /* end of IsOn */
+
+    /**
+    * @brief   : TraceRate - to set the maximum messages per second of the same kind printed to the console
+    * @param[I]: maxrate (maximum messages per second, INFO and DEBUG only, 0: no limit)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the output file gets all the messages
+    **/
+    static void TraceRate(int maxrate)
+    {
+        State().maxrate.store(maxrate, std::memory_order_relaxed);
+    } /* end of TraceRate */
+
+    /**
+    * @brief   : TraceConsole - to switch the printing to the console on or off
+    * @param[I]: ison (true: on, false: off)
     * @param[O]: none
     * @return  : none
     * @note    :
     **/
+    static void TraceConsole(bool ison)
+    {
+        State().console.store(ison, std::memory_order_relaxed);
+    } /* end of TraceConsole */
+
+    /**
+    * @brief   : StatusMode - to switch the status line at the bottom of the console on or off
+    * @param[I]: ison (true: on, false: off)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the console must be a terminal, and the child processes forked after it erase the status line too
+    **/
+    static void StatusMode(bool ison)
+    {
+        State().status.store(ison, std::memory_order_relaxed);
+    } /* end of StatusMode */
+
+    /**
+    * @brief   : Status - to draw the status line at the bottom of the console in place of the last one
+    * @param[I]: line (status line, shorter than the width of the terminal)
+    * @param[I]: isfinal (true: the status line is ended with a line feed and kept)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the messages queued are written above it first
+    **/
+    static void Status(std::string line, bool isfinal)
+    {
+        state_t& st = State();
+        std::lock_guard<std::mutex> lock(*st.drain);
+        Drain(st, false);
+        if (!st.console.load(std::memory_order_relaxed)) return;
+        line = "\r\033[K" + line + (isfinal ? "\n" : "");
+        std::cout.write(line.data(), line.size());
+        std::cout.flush();
+    } /* end of Status */
+
+    /**
+    * @brief   : TraceOpen - to open the output file, which gets all the messages without colors
+    * @param[I]: filename (output file)
+    * @param[O]: none
+    * @return  : true: opened, false: NOT
+    * @note    :
+    **/
     static bool TraceOpen(std::string filename)
     {
-        sfile_.open(filename, std::ios::out);
-        if (!sfile_.is_open()) return false;
-        return true;
+        state_t& st = State();
+        std::lock_guard<std::mutex> lock(*st.drain);
+        Drain(st, false);
+        if (st.sfile.is_open()) st.sfile.close();
+        st.sfile.open(filename, std::ios::out);
+        return st.sfile.is_open();
     } /* end of TraceOpen */
 
     /**
-    * @brief   : TraceClose -
+    * @brief   : TraceClose - to close the output file
     * @param[I]: none
     * @param[O]: none
     * @return  : none
@@ -55,59 +459,96 @@ public:
     **/
     static void TraceClose()
     {
-        if (!sfile_.is_open()) sfile_.close();
+        state_t& st = State();
+        std::lock_guard<std::mutex> lock(*st.drain);
+        Drain(st, false);
+        if (st.sfile.is_open()) st.sfile.close();
     } /* end of TraceClose */
 
     /**
-    * @brief   : Trace -
-    * @param[I]: level ()
-    * @param[I]: info ()
+    * @brief   : Flush - to write all the messages queued to the sinks now
+    * @param[I]: none
     * @param[O]: none
     * @return  : none
-    * @note    :
+    * @note    : i.e., before 'fork', before running the external programs whose output goes to the same console, or
+    *              before '_exit'
     **/
-    static void Trace(int level, std::string info)
+    static void Flush()
+    {
+        state_t& st = State();
+        std::lock_guard<std::mutex> lock(*st.drain);
+        Drain(st, false);
+    } /* end of Flush */
+
+    /**
+    * @brief   : Stop - to stop the background thread and write all the messages queued, at the exit of the process
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    : the messages after it are written directly
+    **/
+    static void Stop()
     {
-        if (level > ilevel_) return;
-        switch (level)
+        state_t& st = State();
+        std::thread* flusher = NULL;
         {
-            case 1 : std::cout << TEXT_RED << info << std::endl << TEXT_RESET; break;
-            case 2 : std::cout << TEXT_GREEN << info << std::endl << TEXT_RESET; break;
-            case 3 : std::cout << TEXT_YELLOW << info << std::endl << TEXT_RESET; break;
-            case 4 : std::cout << TEXT_CYAN << info << std::endl << TEXT_RESET; break;
-            case 5 : std::cout << TEXT_PURPLE << info << std::endl << TEXT_RESET; break;
-            default: break;
+            std::lock_guard<std::mutex> lock(*st.wake);
+            st.stop = true;
+            flusher = st.flusher;
+            st.flusher = NULL;
         }
-        if (sfile_.is_open()) sfile_ << info << std::endl;
+        st.cv->notify_one();
+        if (flusher && flusher->joinable()) flusher->join();
+        delete flusher;
+        st.running.store(false, std::memory_order_release);
+        std::lock_guard<std::mutex> lock(*st.drain);
+        Drain(st, true);
+        if (st.sfile.is_open()) st.sfile.flush();
+    } /* end of Stop */
+
+    /**
+    * @brief   : Trace - to print one message to the console (in the color of its level) and the output file
+    * @param[I]: level (level of debug trace)
+    * @param[I]: info (message)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the message is queued and written by the background thread
+    **/
+    static void Trace(int level, std::string info)
+    {
+        if (level > State().level.load(std::memory_order_relaxed)) return;
+        Push(level, 0, info);
     } /* end of Trace */
 
     /**
-    * @brief   : Trace -
-    * @param[I]: level ()
-    * @param[I]: info ()
-    * @param[I]: isnow ()
+    * @brief   : Trace - to print one constant message to the console (in the color of its level) and the output file
+    * @param[I]: level (level of debug trace)
+    * @param[I]: info (message)
+    * @param[O]: none
+    * @return  : none
+    * @note    : no string is made if the message is dropped by its level
+    **/
+    static void Trace(int level, const char* info)
+    {
+        if (level > State().level.load(std::memory_order_relaxed)) return;
+        std::string sinfo(info);
+        Push(level, 0, sinfo);
+    } /* end of Trace */
+
+    /**
+    * @brief   : Trace - to print one message with the time now or not
+    * @param[I]: level (level of debug trace)
+    * @param[I]: info (message)
+    * @param[I]: isnow (true: the local time is printed before the message on the console)
     * @param[O]: none
     * @return  : none
     * @note    :
     **/
     static void Trace(int level, std::string info, bool isnow)
     {
-        if (level > ilevel_) return;
-        if (!isnow) Trace(level, info);
-        std::time_t tnow = std::time(0);  /* time of program now moment */
-        char stime[256];  /* string of time for output  */
-        std::strftime(stime, sizeof(stime), "%Y-%m-%d %H:%M:%S: ", std::localtime(&tnow));
-        switch (level)
-        {
-            case 1 : std::cout << TEXT_RED << stime << info << std::endl << TEXT_RESET; break;
-            case 2 : std::cout << TEXT_GREEN << stime << info << std::endl << TEXT_RESET; break;
-            case 3 : std::cout << TEXT_YELLOW << stime << info << std::endl << TEXT_RESET; break;
-            case 4 : std::cout << TEXT_CYAN << stime << info << std::endl << TEXT_RESET; break;
-            case 5 : std::cout << TEXT_PURPLE << stime << info << std::endl << TEXT_RESET; break;
-            default: break;
-        }
-        if (sfile_.is_open()) sfile_ << info << std::endl;
+        if (level > State().level.load(std::memory_order_relaxed)) return;
+        Push(level, isnow ? std::time(0) : 0, info);
     } /* end of Trace */
 };
 
-#endif  // LOGGER_H
\ No newline at end of file
+#endif  // LOGGER_H
@@ -22,7 +22,9 @@ struct gtime_t
 struct ftpopt_t
 {                                 /* the type of GNSS data downloading */
     bool ftpdownloading;          /* the master switch for data downloading, 0:off  1:on, only for data downloading */
-    std::string ftpfrom;          /* FTP archive: CDDIS, IGN, or WHU */
+    std::string ftpfrom;          /* FTP archive: CDDIS, IGN, WHU, or LOCAL */
+    std::string mirrordir;        /* valid only for LOCAL, the root directory of the local mirror of CDDIS archive (i.e., the mirror of
+                                     'ftps://gdc.cddis.eosdis.nasa.gov/pub') */
     bool getobs;                  /* (0:off  1:on) GNSS observation data downloading option */
     std::string obstype;          /* "daily", "hourly", "highrate", "30s", "5s", or "1s" */
     std::string obsfrom;          /* where to download the observations (i.e., "igs", "mgex", "igm", "cut", "ga", "hk", "ngs", or "epn") */
@@ -41,10 +43,13 @@ struct ftpopt_t
     std::string orbclkfrom;       /* analysis center (i.e., final: "cod", "emr", "esa", "gfz", "grg", "igs", "jpl", "mit", "cod_m", "gfz_m",
                                      "grg_m", "whu_m"; rapid: "cod_r", "emr_r", "esa_r", "gfz_r", "igs_r"; ultra-rapid: "esa_u", "gfz_u",
                                      "igs_u", "whu_u"; real-time: "cnt"). NOTE: the option of "cnt" is for real-time precise orbit and
-                                     clock products from CNES offline files */
+                                     clock products from CNES offline files; best available: "best", see bestchain */
     std::vector<std::vector<int>> hhorbclk;  /* hours array (0: 00:00, 6: 6:00, 12: 12:00, 18: 18:00 for esa_u and/or igs_u; 0: 00:00, 3: 3:00,
                                                  6: 6:00, ... for gfz_u; 0: 00:00, 1: 1:00, 2: 2:00, ... for whu_u) */
     int l2s4oc;                   /* valid only for the precise orbit and clock files with long name, 0: long name, 1: short name, 2: long and short name */
+    std::string bestchain;        /* valid only for 'best' of 'orbclkfrom', the analysis centers tried in order (i.e., "igs+igs_r+igs_u+cnt") */
+    bool ultralatest;             /* (0:off  1:on) valid only for the ultra-rapid products, to fetch only the newest issued session of each day
+                                     instead of the sessions of 'hhorbclk', and keep 'latest_<igu|esu|gfu|wuu>.sp3' linked to it */
     bool getobx;                  /* (0:off  1:on) ORBEX (ORBit EXchange format) for satellite attitude information */
     std::string obxfrom;          /* analysis center (i.e., final/rapid: "cod_m", "gfz_m", "grg_m", "whu_m"; real-time: cnt). NOTE: the
                                      option of "cnt" is for real-time ORBEX from CNES offline files */
@@ -77,7 +82,22 @@ struct ftpopt_t
                                      clock products downloading */
     bool merge_sp3files;          /* (0: off  1: on) to merge three consecutive sp3 files into one file */
     bool printinfo4wget;          /* (0:off  1 : on) print the information generated by 'wget' */
-    std::string qr;               /* "-qr" (printInfoWget == false) or "r" (printInfoWget == true) in 'wget' command line */
+    std::string qr;               /* "-nv -r" (printInfoWget == false) or "-r" (printInfoWget == true) in 'wget' command line */
+    bool refresh_mutable;         /* (0:off  1:on) to re-fetch the mutable products (i.e., ANTEX, ultra-rapid and CNES real-time files) only when
+                                     they are changed on the remote server */
+    int retrymax;                 /* maximum number of retries per transfer for transient, throttled or corrupt failures */
+    double retrywait;             /* base waiting time (seconds) of the jittered exponential backoff between retries */
+    int retrybudget;              /* maximum number of retries in total for one run */
+    std::string cachedir;         /* root directory of the shared read-through cache for many GOOD instances, empty: off */
+    double cachesize;             /* size budget (GB) of the shared cache, the least recently used files are evicted beyond it, 0: unlimited */
+    std::string redirect;         /* the servers of each scheme redirected to, i.e., "ftp=127.0.0.1:2121 http=127.0.0.1:8080" for the mock
+                                     archive of the offline benchmark, empty: off */
+    bool hourly_diff;             /* (0:off  1:on) to keep the last listing of each hourly observation directory and fetch only the newly
+                                     published files, valid only for the 'all' option of IGS and MGEX hourly observations */
+    bool checksum;                /* (0:off  1:on) to verify each file downloaded against the checksum file (i.e., 'SHA512SUMS' or
+                                     'MD5SUMS') published in its remote directory, and re-fetch it if they mismatch */
+    int ishard;                   /* index (0, 1, ..., nshard - 1) of this shard, see nshard */
+    int nshard;                   /* number of shards (i.e., nodes) the run is split over by '--shard ishard/nshard', 1: NOT split */
 };
 
 struct prcopt_t
@@ -102,6 +122,23 @@ struct prcopt_t
     /* time settings */
     gtime_t ts;                   /* start time for processing */
     int ndays;                    /* number of consecutive days */
+    bool watchmode;               /* (0:off  1:on) to keep running and poll the newly published data and products around the current time,
+                                     'procTime' is ignored */
+    int pollintvl;                /* valid only for the watch mode, the interval (seconds) between two polling cycles */
+    bool backfill;                /* (0:off  1:on) to plan all the days of 'procTime' as one queue of jobs (one product of one day each), run
+                                     them in parallel processes, and resume from the journal in 'logDir' after a restart */
+    int maxprocs;                 /* valid only for the backfill mode, the maximum number of jobs running at the same time */
+    int hostcap;                  /* valid only for the backfill mode, the maximum number of jobs running at the same time on one host */
+    bool metrics;                 /* (0:off  1:on) to rewrite the live metrics in the Prometheus exposition format as 'good.prom' in 'logDir' */
+    int metricsintvl;             /* valid only if the metrics are on, the minimum interval (seconds) between two rewrites of 'good.prom' */
+    bool progress;                /* (0:off  1:on) to display the jobs done per product family, the bytes, the throughput, the transfers
+                                     per host and the ETA, in one status line on a terminal or one message per 'progressintvl' */
+    int progressintvl;            /* valid only if the progress is on and the console is NOT a terminal, the interval (seconds) between
+                                     two messages of the progress */
+    bool manifest;                /* (0:off  1:on) to write the manifest of the files materialized (local file, source URL, host, size,
+                                     SHA-256, product tier and fetch time) as 'run.manifest' in 'logDir' */
+    std::string manifestin;       /* valid only if the manifest is on, the input manifest with full path (i.e., the one of another site),
+                                     the local files differing from it are fetched again, empty: none */
 };
 
 #endif  // TYPES_H
\ No newline at end of file
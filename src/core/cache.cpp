@@ -0,0 +1,280 @@
+/*------------------------------------------------------------------------------
+* cache.cpp : shared read-through cache of downloaded files
+*
+* Copyright (C) 2020-2099 by Ubiquitous Navigation & Integrated positioning lab in Quest (UNIQ), all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader)
+*
+* history : 2026/10/19 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "../common/common.h"
+#include "../common/types.h"
+#include "../common/cstring.h"
+#include "../common/logger.h"
+#include "cache.h"
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : Init - to set the root directory and size budget of the shared cache
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void CacheUtil::Init(const ftpopt_t* fopt)
+{
+    dir_ = fopt->cachedir;
+    CString::trim(dir_);
+    while (dir_.size() > 1 && (dir_.back() == '/' || dir_.back() == '\\')) dir_.pop_back();
+    maxbytes_ = fopt->cachesize * 1024.0 * 1024.0 * 1024.0;
+} /* end of Init */
+
+/**
+* @brief   : GetPath - to get the cached file of one remote file, i.e., 'ftps://gdc.cddis.eosdis.nasa.gov/pub/x.gz' ->
+*              '<cacheDir>/gdc.cddis.eosdis.nasa.gov/pub/x.gz'
+* @param[I]: url (full URL of the remote file)
+* @param[O]: none
+* @return  : cached file with full path, empty if the cache is off
+* @note    :
+**/
+std::string CacheUtil::GetPath(std::string url)
+{
+    if (dir_.empty()) return "";
+
+    std::string::size_type ipos = url.find("://");
+    if (ipos == std::string::npos) return "";
+    std::string path = url.substr(ipos + 3);
+    /* the file name and the path must be exactly known */
+    if (path.empty() || path.back() == '/' || path.find_first_of("*?") != std::string::npos) return "";
+    if (path.find("..") != std::string::npos) return "";
+
+    return dir_ + "/" + path;
+} /* end of GetPath */
+
+/**
+* @brief   : MakeDirs - to create the parent directories of one file
+* @param[I]: path (file with full path)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void CacheUtil::MakeDirs(std::string path)
+{
+    for (std::string::size_type ipos = path.find_first_of("/\\", 1); ipos != std::string::npos;
+        ipos = path.find_first_of("/\\", ipos + 1))
+    {
+        std::string dir = path.substr(0, ipos);
+        if (access(dir.c_str(), 0) == 0) continue;
+#ifdef _WIN32   /* for Windows */
+        _mkdir(dir.c_str());
+#else           /* for Linux or Mac */
+        mkdir(dir.c_str(), 0775);
+#endif
+    }
+} /* end of MakeDirs */
+
+/**
+* @brief   : Lock - to hold the advisory lock of one cached file, so that the concurrent instances requesting the same
+*              file coalesce on one download
+* @param[I]: path (cached file with full path)
+* @param[I]: wait (true: wait until the lock is released by the other instance, false: return at once)
+* @param[O]: none
+* @return  : true: the lock is held, false: NOT
+* @note    : only one lock is held at a time
+**/
+bool CacheUtil::Lock(std::string path, bool wait)
+{
+    Unlock();
+    MakeDirs(path);
+    std::string lockfile = path + ".lock";
+
+#ifdef _WIN32   /* for Windows */
+    /* the lock file is removed when its last handle is closed, and it can NOT be opened again until then */
+    while (true)
+    {
+        hlock_ = CreateFileA(lockfile.c_str(), GENERIC_READ | GENERIC_WRITE | DELETE, FILE_SHARE_READ | FILE_SHARE_WRITE |
+            FILE_SHARE_DELETE, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_DELETE_ON_CLOSE, NULL);
+        if (hlock_ != INVALID_HANDLE_VALUE) break;
+        if (!wait || GetLastError() != ERROR_ACCESS_DENIED) return false;
+        Sleep(50);
+    }
+    OVERLAPPED ov = {};
+    DWORD flags = LOCKFILE_EXCLUSIVE_LOCK | (wait ? 0 : LOCKFILE_FAIL_IMMEDIATELY);
+    if (!LockFileEx(hlock_, flags, 0, 1, 0, &ov))
+    {
+        CloseHandle(hlock_);
+        hlock_ = INVALID_HANDLE_VALUE;
+        return false;
+    }
+#else           /* for Linux or Mac */
+    while (true)
+    {
+        fdlock_ = open(lockfile.c_str(), O_RDWR | O_CREAT, 0664);
+        if (fdlock_ < 0) return false;
+        if (flock(fdlock_, LOCK_EX | (wait ? 0 : LOCK_NB)) != 0)
+        {
+            close(fdlock_);
+            fdlock_ = -1;
+            return false;
+        }
+
+        /* the lock file may have been removed by its last holder while waiting, then the new one is locked again */
+        struct stat st, stf;
+        if (fstat(fdlock_, &stf) == 0 && stat(lockfile.c_str(), &st) == 0 && st.st_dev == stf.st_dev &&
+            st.st_ino == stf.st_ino) break;
+        close(fdlock_);
+        fdlock_ = -1;
+    }
+#endif
+    lockfile_ = lockfile;
+
+    return true;
+} /* end of Lock */
+
+/**
+* @brief   : Unlock - to release the lock held and remove its lock file
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    : the lock file is removed while the lock is still held, and the waiters lock the new one if it has been removed
+*              (see Lock), so that the cache directory does NOT fill with the lock files of all the files ever fetched
+**/
+void CacheUtil::Unlock()
+{
+#ifdef _WIN32   /* for Windows */
+    if (hlock_ == INVALID_HANDLE_VALUE) return;
+    OVERLAPPED ov = {};
+    UnlockFileEx(hlock_, 0, 1, 0, &ov);
+    CloseHandle(hlock_);
+    hlock_ = INVALID_HANDLE_VALUE;
+#else           /* for Linux or Mac */
+    if (fdlock_ < 0) return;
+    std::remove(lockfile_.c_str());
+    flock(fdlock_, LOCK_UN);
+    close(fdlock_);
+    fdlock_ = -1;
+#endif
+    lockfile_.clear();
+} /* end of Unlock */
+
+/**
+* @brief   : Touch - to mark one cached file as just used for the LRU eviction
+* @param[I]: path (cached file with full path)
+* @param[O]: none
+* @return  : none
+* @note    : the modification time is used, because the access time is often NOT updated (i.e., 'noatime')
+**/
+void CacheUtil::Touch(std::string path)
+{
+#ifdef _WIN32   /* for Windows */
+    _utime(path.c_str(), NULL);
+#else           /* for Linux or Mac */
+    utime(path.c_str(), NULL);
+#endif
+} /* end of Touch */
+
+/**
+* @brief   : ListFiles - to list all the cached files under one directory recursively
+* @param[I]: dir (directory)
+* @param[O]: files (cached files with their sizes and last used times)
+* @return  : none
+* @note    : the lock files, the temporary files and the files hardlinked out of the cache are NOT listed
+**/
+void CacheUtil::ListFiles(std::string dir, std::vector<std::pair<std::string, std::pair<double, double>>>& files)
+{
+#ifdef _WIN32   /* for Windows */
+    WIN32_FIND_DATAA fd;
+    HANDLE hfind = FindFirstFileA((dir + "\\*").c_str(), &fd);
+    if (hfind == INVALID_HANDLE_VALUE) return;
+    do
+    {
+        std::string name = fd.cFileName;
+        if (name == "." || name == "..") continue;
+        std::string path = dir + "\\" + name;
+        if (fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) ListFiles(path, files);
+        else
+        {
+            ULARGE_INTEGER size, time;
+            size.LowPart = fd.nFileSizeLow;
+            size.HighPart = fd.nFileSizeHigh;
+            time.LowPart = fd.ftLastWriteTime.dwLowDateTime;
+            time.HighPart = fd.ftLastWriteTime.dwHighDateTime;
+            if (name.size() > 5 && name.substr(name.size() - 5) == ".lock") continue;
+            if (name.size() > 4 && name.substr(name.size() - 4) == ".tmp") continue;
+            HANDLE hfile = CreateFileA(path.c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL,
+                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+            BY_HANDLE_FILE_INFORMATION info;
+            bool islinked = hfile != INVALID_HANDLE_VALUE && GetFileInformationByHandle(hfile, &info) &&
+                info.nNumberOfLinks > 1;
+            if (hfile != INVALID_HANDLE_VALUE) CloseHandle(hfile);
+            if (islinked) continue;
+            files.push_back({ path, { (double)size.QuadPart, (double)time.QuadPart } });
+        }
+    } while (FindNextFileA(hfind, &fd));
+    FindClose(hfind);
+#else           /* for Linux or Mac */
+    DIR* dp = opendir(dir.c_str());
+    if (dp == NULL) return;
+    struct dirent* ep;
+    while ((ep = readdir(dp)) != NULL)
+    {
+        std::string name = ep->d_name;
+        if (name == "." || name == "..") continue;
+        std::string path = dir + "/" + name;
+        struct stat st;
+        if (lstat(path.c_str(), &st) != 0) continue;
+        if (S_ISDIR(st.st_mode)) ListFiles(path, files);
+        else if (S_ISREG(st.st_mode))
+        {
+            if (name.size() > 5 && name.substr(name.size() - 5) == ".lock") continue;
+            if (name.size() > 4 && name.substr(name.size() - 4) == ".tmp") continue;
+            /* the hardlinks out of the cache share the blocks, so that evicting them frees no space */
+            if (st.st_nlink > 1) continue;
+#ifdef __linux__
+            double mtime = (double)st.st_mtim.tv_sec + (double)st.st_mtim.tv_nsec * 1.0e-9;
+#else
+            double mtime = (double)st.st_mtime;
+#endif
+            files.push_back({ path, { (double)st.st_size, mtime } });
+        }
+    }
+    closedir(dp);
+#endif
+} /* end of ListFiles */
+
+/**
+* @brief   : Prune - to evict the least recently used files until the shared cache is within its size budget
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    : the files locked by the other instances are skipped, and so are the ones hardlinked out of the cache,
+*              whose eviction frees no space
+**/
+void CacheUtil::Prune()
+{
+    if (dir_.empty() || maxbytes_ <= 0.0) return;
+
+    std::vector<std::pair<std::string, std::pair<double, double>>> files;
+    ListFiles(dir_, files);
+    double total = 0.0;
+    for (size_t i = 0; i < files.size(); i++) total += files[i].second.first;
+    if (total <= maxbytes_) return;
+
+    /* the least recently used first */
+    std::sort(files.begin(), files.end(), [](const std::pair<std::string, std::pair<double, double>>& a,
+        const std::pair<std::string, std::pair<double, double>>& b) { return a.second.second < b.second.second; });
+
+    int nevict = 0;
+    for (size_t i = 0; i < files.size() && total > maxbytes_; i++)
+    {
+        if (!Lock(files[i].first, false)) continue;
+        if (std::remove(files[i].first.c_str()) == 0)
+        {
+            total -= files[i].second.first;
+            nevict++;
+        }
+        Unlock();
+    }
+
+    Logger::Trace(TINFO, "*** INFO(CacheUtil::Prune): " + std::to_string(nevict) + " least recently used files are evicted from the shared cache " + dir_);
+} /* end of Prune */
@@ -0,0 +1,106 @@
+/*------------------------------------------------------------------------------
+* cache.h : header file of cache.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+class CacheUtil
+{
+private:
+    std::string dir_;                    /* root directory of the shared cache, empty: the cache is off */
+    double maxbytes_ = 0.0;              /* size budget (bytes) of the shared cache, 0: unlimited */
+    std::string lockfile_;               /* lock file held, removed when it is released */
+#ifdef _WIN32   /* for Windows */
+    HANDLE hlock_ = INVALID_HANDLE_VALUE;  /* handle of the lock file held */
+#else           /* for Linux or Mac */
+    int fdlock_ = -1;                    /* descriptor of the lock file held */
+#endif
+
+    /**
+    * @brief   : MakeDirs - to create the parent directories of one file
+    * @param[I]: path (file with full path)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void MakeDirs(std::string path);
+
+    /**
+    * @brief   : ListFiles - to list all the cached files under one directory recursively
+    * @param[I]: dir (directory)
+    * @param[O]: files (cached files with their sizes and last used times)
+    * @return  : none
+    * @note    : the lock files, the temporary files and the files hardlinked out of the cache are NOT listed
+    **/
+    void ListFiles(std::string dir, std::vector<std::pair<std::string, std::pair<double, double>>>& files);
+
+public:
+    CacheUtil() = default;
+    ~CacheUtil() { Unlock(); }
+
+    /**
+    * @brief   : Init - to set the root directory and size budget of the shared cache
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Init(const ftpopt_t* fopt);
+
+    /**
+    * @brief   : GetPath - to get the cached file of one remote file, i.e., 'ftps://gdc.cddis.eosdis.nasa.gov/pub/x.gz' ->
+    *              '<cacheDir>/gdc.cddis.eosdis.nasa.gov/pub/x.gz'
+    * @param[I]: url (full URL of the remote file)
+    * @param[O]: none
+    * @return  : cached file with full path, empty if the cache is off
+    * @note    :
+    **/
+    std::string GetPath(std::string url);
+
+    /**
+    * @brief   : Lock - to hold the advisory lock of one cached file, so that the concurrent instances requesting the same
+    *              file coalesce on one download
+    * @param[I]: path (cached file with full path)
+    * @param[I]: wait (true: wait until the lock is released by the other instance, false: return at once)
+    * @param[O]: none
+    * @return  : true: the lock is held, false: NOT
+    * @note    : only one lock is held at a time
+    **/
+    bool Lock(std::string path, bool wait = true);
+
+    /**
+    * @brief   : Unlock - to release the lock held and remove its lock file
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Unlock();
+
+    /**
+    * @brief   : Touch - to mark one cached file as just used for the LRU eviction
+    * @param[I]: path (cached file with full path)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Touch(std::string path);
+
+    /**
+    * @brief   : Prepare - to create the parent directories of one cached file before it is stored
+    * @param[I]: path (cached file with full path)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Prepare(std::string path) { MakeDirs(path); }
+
+    /**
+    * @brief   : Prune - to evict the least recently used files until the shared cache is within its size budget
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    : the files locked by the other instances are skipped, and so are the ones hardlinked out of the cache,
+    *              whose eviction frees no space
+    **/
+    void Prune();
+};
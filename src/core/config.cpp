@@ -12,6 +12,12 @@
 #include "../common/cstring.h"
 #include "../common/gtime.h"
 #include "../common/logger.h"
+#include "cache.h"
+#include "journal.h"
+#include "profile.h"
+#include "metrics.h"
+#include "progress.h"
+#include "manifest.h"
 #include "ftps.h"
 #include "config.h"
 
@@ -24,6 +30,31 @@
 /* constants/macros ----------------------------------------------------------*/
 #define MIN(x,y)    ((x) <= (y) ? (x) : (y))
 
+/* type definitions ----------------------------------------------------------*/
+struct watch_t
+{                                 /* polling schedule of one product in the watch mode */
+    std::string name;             /* "obs", "nav", "orbclk", "obx", "eop", "snx", "dsb", "osb", "ion", "roti", "trp", or "atx" */
+    std::string from;             /* analysis center (only one for "orbclk") or data center of the product */
+    double step;                  /* interval (s) between two consecutive epochs (i.e., hours, sessions or days) of the product */
+    double latency;               /* expected publication time (s) after the beginning of one epoch, i.e., the epoch length plus the
+                                     processing latency of the archive or analysis center */
+    double window;                /* time span (s) after the expected publication during which one epoch is still polled */
+    double revisit;               /* minimum interval (s) between two polls of the product */
+    double tlast;                 /* time (s) of the last poll, -1: never */
+    std::map<double, double> tepochs;  /* time (s) of the last poll of each epoch, i.e., for the days of 'best' polled less
+                                          often as they get older */
+};
+
+struct job_t
+{                                 /* one job of the backfill mode, i.e., one product of one day */
+    gtime_t ts;                   /* the day */
+    std::string name;             /* product, see watch_t */
+    std::string from;             /* analysis center (only one for "orbclk") or data center of the product */
+    std::string host;             /* host (or archive) the product is downloaded from, for the per-host concurrency cap */
+    std::string key;              /* key of the job in the journal, i.e., "2024 001 orbclk igs" */
+    double size;                  /* estimated size (bytes) of the files of the job, for the longest-processing-time-first order */
+};
+
 /* function definition -------------------------------------------------------*/
 
 /**
@@ -36,14 +67,37 @@
 void Config::init(prcopt_t* popt, ftpopt_t* fopt)
 {
     /* time settings */
-    popt->ts = { 0 };                            /* start time for processing */
+    popt->ts = {};                               /* start time for processing */
     popt->ndays = 1;                             /* number of consecutive days */
+    popt->watchmode = false;                     /* (0:off  1:on) to keep running and poll the newly published data and products */
+    popt->pollintvl = 60;                        /* the interval (seconds) between two polling cycles in the watch mode */
+    popt->backfill = false;                      /* (0:off  1:on) to run all the days as one queue of jobs, resumable from the journal */
+    popt->maxprocs = 4;                          /* the maximum number of jobs running at the same time in the backfill mode */
+    popt->hostcap = 2;                           /* the maximum number of jobs running at the same time on one host in the backfill mode */
+    popt->metrics = false;                       /* (0:off  1:on) to rewrite the live metrics in the Prometheus exposition format */
+    popt->metricsintvl = 15;                     /* the minimum interval (seconds) between two rewrites of the metrics */
+    popt->progress = true;                       /* (0:off  1:on) to display the progress and ETA of the downloading */
+    popt->progressintvl = 30;                    /* the interval (seconds) between two messages of the progress if NOT on a terminal */
+    popt->manifest = true;                       /* (0:off  1:on) to write the manifest of the files materialized with their SHA-256 */
+    popt->manifestin = "";                       /* the input manifest, i.e., the one of another site, empty: none */
 
     /* FTP downloading settings */
     fopt->minus_add_1day = true;                 /* (0:off  1:on) the day before and after the current day for precise satellite orbit and clock
                                                     products downloading */
     fopt->merge_sp3files = false;                /* (0: off  1: on) to merge three consecutive sp3 files into one file */
     fopt->printinfo4wget = false;                /* (0:off  1:on) print the information generated by 'wget' */
+    fopt->refresh_mutable = false;               /* (0:off  1:on) to re-fetch the mutable products (i.e., ANTEX, ultra-rapid and CNES real-time
+                                                    files) only when they are changed on the remote server */
+    fopt->retrymax = 3;                          /* maximum number of retries per transfer for transient, throttled or corrupt failures */
+    fopt->retrywait = 2.0;                       /* base waiting time (seconds) of the jittered exponential backoff between retries */
+    fopt->retrybudget = 100;                     /* maximum number of retries in total for one run */
+    fopt->cachedir = "";                         /* root directory of the shared read-through cache for many GOOD instances, empty: off */
+    fopt->cachesize = 10.0;                      /* size budget (GB) of the shared cache, 0: unlimited */
+    fopt->redirect = "";                         /* the servers of each scheme redirected to (i.e., the mock archive), empty: off */
+    fopt->hourly_diff = false;                   /* (0:off  1:on) to fetch only the newly published hourly observation files by listing diffs */
+    fopt->checksum = false;                      /* (0:off  1:on) to verify the files downloaded against the checksum files of the archive */
+    fopt->ishard = 0;                            /* index of this shard */
+    fopt->nshard = 1;                            /* number of shards, 1: NOT split */
 
     /* initialization for FTP options */
     fopt->ftpdownloading = false;                /* the master switch for data downloading, 0:off  1:on, only for data downloading */
@@ -53,6 +107,8 @@ void Config::init(prcopt_t* popt, ftpopt_t* fopt)
     fopt->l2s4nav = 1;                           /* valid only for the navigation files with long name, 0: long name, 1: short name, 2: long and short name */
     fopt->getorbclk = false;                     /* (0:off  1:on) precise orbit 'sp3' and precise clock 'clk' */
     fopt->l2s4oc = 1;                            /* valid only for the precise orbit and clock files with long name, 0: long name, 1: short name, 2: long and short name */
+    fopt->bestchain = "igs+igs_r+igs_u+cnt";     /* valid only for 'best', the analysis centers tried in order, i.e., final, rapid, ultra-rapid and real-time */
+    fopt->ultralatest = false;                   /* (0:off  1:on) valid only for the ultra-rapid products, to fetch only the newest issued session */
     fopt->geteop = false;                        /* (0:off  1:on) earth rotation parameter */
     fopt->l2s4eop = 1;                           /* valid only for EOP file with long name, 0: long name, 1: short name, 2: long and short name */
     fopt->getobx = false;                        /* (0:off  1:on) ORBEX (ORBit EXchange format) for satellite attitude information */
@@ -217,7 +273,7 @@ bool Config::ReadCfgYaml(std::string cfgfile, prcopt_t* popt, ftpopt_t* fopt)
     try
     {
         popt->logdir = popt->maindir + sep + config["logDir"].as<std::string>();
-        popt->logfil = popt->logdir + sep + "log.txt";
+        popt->logfil = popt->logdir + sep + "log.jsonl";
     }
     catch (YAML::Exception& exception)
     {
@@ -283,6 +339,68 @@ bool Config::ReadCfgYaml(std::string cfgfile, prcopt_t* popt, ftpopt_t* fopt)
         msg.push_back("procTime");
     }
 
+    try
+    {
+        /* (0:off  1:on) the watch mode, it is optional */
+        if (config["watchMode"]) popt->watchmode = config["watchMode"].as<int>() == 1 ? true : false;
+        if (config["pollInterval"]) popt->pollintvl = config["pollInterval"].as<int>();
+        if (popt->pollintvl < 1) popt->pollintvl = 1;
+    }
+    catch (YAML::Exception& exception)
+    {
+        msg.push_back("watchMode/pollInterval");
+    }
+
+    try
+    {
+        /* (0:off  1:on) the backfill mode, it is optional */
+        if (config["backfill"]) popt->backfill = config["backfill"].as<int>() == 1 ? true : false;
+        if (config["maxProcs"]) popt->maxprocs = config["maxProcs"].as<int>();
+        if (config["hostCap"]) popt->hostcap = config["hostCap"].as<int>();
+        if (popt->maxprocs < 1) popt->maxprocs = 1;
+        if (popt->hostcap < 1) popt->hostcap = 1;
+    }
+    catch (YAML::Exception& exception)
+    {
+        msg.push_back("backfill/maxProcs/hostCap");
+    }
+
+    try
+    {
+        /* (0:off  1:on) the live metrics, it is optional */
+        if (config["metrics"]) popt->metrics = config["metrics"].as<int>() == 1 ? true : false;
+        if (config["metricsInterval"]) popt->metricsintvl = config["metricsInterval"].as<int>();
+        if (popt->metricsintvl < 1) popt->metricsintvl = 1;
+    }
+    catch (YAML::Exception& exception)
+    {
+        msg.push_back("metrics/metricsInterval");
+    }
+
+    try
+    {
+        /* (0:off  1:on) the progress, it is optional */
+        if (config["progress"]) popt->progress = config["progress"].as<int>() == 1 ? true : false;
+        if (config["progressInterval"]) popt->progressintvl = config["progressInterval"].as<int>();
+        if (popt->progressintvl < 1) popt->progressintvl = 1;
+    }
+    catch (YAML::Exception& exception)
+    {
+        msg.push_back("progress/progressInterval");
+    }
+
+    try
+    {
+        /* (0:off  1:on) the run manifest, it is optional */
+        if (config["manifest"]) popt->manifest = config["manifest"].as<int>() == 1 ? true : false;
+        if (config["manifestInput"]) popt->manifestin = config["manifestInput"].as<std::string>();
+        CString::trim(popt->manifestin);
+    }
+    catch (YAML::Exception& exception)
+    {
+        msg.push_back("manifest/manifestInput");
+    }
+
     /* FTP downloading settings */
     try
     {
@@ -314,11 +432,76 @@ bool Config::ReadCfgYaml(std::string cfgfile, prcopt_t* popt, ftpopt_t* fopt)
         msg.push_back("printInfoWget");
     }
 
+    try
+    {
+        /* (0:off  1:on) to re-fetch the mutable products only when they are changed on the remote server, it is optional */
+        if (config["refreshMutable"]) fopt->refresh_mutable = config["refreshMutable"].as<int>() == 1 ? true : false;
+    }
+    catch (YAML::Exception& exception)
+    {
+        msg.push_back("refreshMutable");
+    }
+
+    try
+    {
+        /* retry policy for the transient, throttled or corrupt failures of transfers, it is optional */
+        if (config["retryMax"]) fopt->retrymax = config["retryMax"].as<int>();
+        if (config["retryWait"]) fopt->retrywait = config["retryWait"].as<double>();
+        if (config["retryBudget"]) fopt->retrybudget = config["retryBudget"].as<int>();
+    }
+    catch (YAML::Exception& exception)
+    {
+        msg.push_back("retryMax/retryWait/retryBudget");
+    }
+
+    try
+    {
+        /* shared read-through cache, it is optional */
+        if (config["cacheDir"]) fopt->cachedir = config["cacheDir"].as<std::string>();
+        if (config["cacheSize"]) fopt->cachesize = config["cacheSize"].as<double>();
+    }
+    catch (YAML::Exception& exception)
+    {
+        msg.push_back("cacheDir/cacheSize");
+    }
+
+    try
+    {
+        /* the redirection to the mock archive, it is optional */
+        if (config["redirect"]) fopt->redirect = config["redirect"].as<std::string>();
+    }
+    catch (YAML::Exception& exception)
+    {
+        msg.push_back("redirect");
+    }
+
+    try
+    {
+        /* (0:off  1:on) to fetch only the newly published hourly observation files by listing diffs, it is optional */
+        if (config["hourlyDiff"]) fopt->hourly_diff = config["hourlyDiff"].as<int>() == 1 ? true : false;
+    }
+    catch (YAML::Exception& exception)
+    {
+        msg.push_back("hourlyDiff");
+    }
+
+    try
+    {
+        /* (0:off  1:on) to verify the files downloaded against the checksum files of the archive, it is optional */
+        if (config["checksum"]) fopt->checksum = config["checksum"].as<int>() == 1 ? true : false;
+    }
+    catch (YAML::Exception& exception)
+    {
+        msg.push_back("checksum");
+    }
+
     /* handling of FTP downloading */
     try
     {
         fopt->ftpdownloading = config["ftpDownloading"]["opt4ftp"].as<int>() == 1 ? true : false;
         fopt->ftpfrom = config["ftpDownloading"]["ftpArch"].as<std::string>();
+        /* it is optional, and valid only for the local mirror */
+        if (config["ftpDownloading"]["mirrorDir"]) fopt->mirrordir = config["ftpDownloading"]["mirrorDir"].as<std::string>();
     }
     catch (YAML::Exception& exception)
     {
@@ -368,7 +551,14 @@ bool Config::ReadCfgYaml(std::string cfgfile, prcopt_t* popt, ftpopt_t* fopt)
         hh = config["getOrbClk"]["sHH4oc"].as<int>();
         nh = config["getOrbClk"]["nHH4oc"].as<int>();
 
+        /* it is optional, and valid only for 'best' */
+        if (config["getOrbClk"]["ocBest"]) fopt->bestchain = config["getOrbClk"]["ocBest"].as<std::string>();
+        /* it is optional, and valid only for the ultra-rapid products */
+        if (config["getOrbClk"]["ocLatest"]) fopt->ultralatest = config["getOrbClk"]["ocLatest"].as<int>() == 1 ? true : false;
+
         std::string ocopt = fopt->orbclkfrom;
+        CString::trim(ocopt);
+        if (ocopt == "best") ocopt = fopt->bestchain;
         std::vector<std::string> acs;
         int ipos = (int)ocopt.find_first_of('+');
         if (ipos > 0) acs = CString::split(ocopt, "+");
@@ -525,116 +715,1151 @@ bool Config::ReadCfgYaml(std::string cfgfile, prcopt_t* popt, ftpopt_t* fopt)
 } /* end of ReadCfgYaml */
 
 /**
-* @brief   : run - start GOOD processing
-* @param[I]: cfgFile (configure file with full path)
+* @brief   : GetDay - to create the sub-directories of one day and download the data and products of the day
+* @param[I]: ftp (FTP downloader)
+* @param[I]: popt (processing options, the time is the day to be downloaded)
+* @param[I]: fopt (FTP options)
+* @return  : number of files failed
+* @note    : the options are copied, because the sub-directories of the day are set to them
+**/
+int Config::GetDay(FtpUtil* ftp, prcopt_t popt, ftpopt_t fopt)
+{
+    int yyyy, doy;
+    GTime::time2yrdoy(popt.ts, yyyy, doy);
+    std::string syyyy = CString::int2str(yyyy, 4);
+    std::string sdoy = CString::int2str(doy, 3);
+    std::string dir, sep;
+    sep.push_back((char)FILEPATHSEP);
+    /* creat new observation sub-directory */
+    if (fopt.getobs)
+    {
+        dir = popt.obsdir + sep + syyyy + sep + sdoy;
+        CString::trim(dir);
+        popt.obsdir = dir;
+        if (access(dir.c_str(), 0) == -1)
+        {
+            /* If the directory does not exist, creat it */
+#ifdef _WIN32   /* for Windows */
+            std::string cmd = "mkdir " + dir;
+#else           /* for Linux or Mac */
+            std::string cmd = "mkdir -p " + dir;
+#endif
+            ProfUtil::System(cmd);
+        }
+    }
+
+    /* creat new NAV sub-directory */
+    if (fopt.getnav)
+    {
+        dir = popt.navdir + sep + syyyy + sep + sdoy;
+        CString::trim(dir);
+        popt.navdir = dir;
+        if (access(dir.c_str(), 0) == -1)
+        {
+            /* If the directory does not exist, creat it */
+#ifdef _WIN32   /* for Windows */
+            std::string cmd = "mkdir " + dir;
+#else           /* for Linux or Mac */
+            std::string cmd = "mkdir -p " + dir;
+#endif
+            ProfUtil::System(cmd);
+        }
+    }
+
+    /* creat new ION sub-directory */
+    if (fopt.getion)
+    {
+        dir = popt.iondir + sep + syyyy + sep + sdoy;
+        CString::trim(dir);
+        popt.iondir = dir;
+        if (access(dir.c_str(), 0) == -1)
+        {
+            /* If the directory does not exist, creat it */
+#ifdef _WIN32   /* for Windows */
+            std::string cmd = "mkdir " + dir;
+#else           /* for Linux or Mac */
+            std::string cmd = "mkdir -p " + dir;
+#endif
+            ProfUtil::System(cmd);
+        }
+    }
+
+    /* creat new ZTD sub-directory */
+    if (fopt.gettrp)
+    {
+        dir = popt.ztddir + sep + syyyy + sep + sdoy;
+        CString::trim(dir);
+        popt.ztddir = dir;
+        if (access(dir.c_str(), 0) == -1)
+        {
+            /* If the directory does not exist, creat it */
+#ifdef _WIN32   /* for Windows */
+            std::string cmd = "mkdir " + dir;
+#else           /* for Linux or Mac */
+            std::string cmd = "mkdir -p " + dir;
+#endif
+            ProfUtil::System(cmd);
+        }
+    }
+
+    /* the main entry of FTP downloader */
+    return ftp->FtpDownload(&popt, &fopt);
+} /* end of GetDay */
+
+/**
+* @brief   : GetProducts - to get the products to be downloaded, one item per analysis center for the precise orbit and clock
+* @param[I]: fopt (FTP options)
 * @param[O]: none
+* @return  : products, i.e., {"obs", "igs"}, {"orbclk", "cod"}, {"orbclk", "gfz_m"}, ...
+* @note    :
+**/
+std::vector<std::pair<std::string, std::string>> Config::GetProducts(const ftpopt_t* fopt)
+{
+    std::vector<std::pair<std::string, std::string>> prods;
+    if (fopt->getobs) prods.push_back({ "obs", fopt->obsfrom });
+    if (fopt->getnav) prods.push_back({ "nav", fopt->navfrom });
+    if (fopt->getorbclk)
+    {
+        std::vector<std::string> acs = CString::split(fopt->orbclkfrom, "+");
+        for (size_t i = 0; i < acs.size(); i++)
+        {
+            CString::trim(acs[i]);
+            prods.push_back({ "orbclk", acs[i] });
+        }
+    }
+    if (fopt->getobx) prods.push_back({ "obx", fopt->obxfrom });
+    if (fopt->geteop) prods.push_back({ "eop", fopt->eopfrom });
+    if (fopt->getsnx) prods.push_back({ "snx", "" });
+    if (fopt->getdsb) prods.push_back({ "dsb", fopt->dsbfrom });
+    if (fopt->getosb) prods.push_back({ "osb", fopt->osbfrom });
+    if (fopt->getion) prods.push_back({ "ion", fopt->ionfrom });
+    if (fopt->getroti) prods.push_back({ "roti", "" });
+    if (fopt->gettrp) prods.push_back({ "trp", fopt->trpfrom });
+    if (fopt->getatx) prods.push_back({ "atx", "" });
+
+    return prods;
+} /* end of GetProducts */
+
+/**
+* @brief   : SelectProduct - to switch off all the products but one
+* @param[I]: name (product, see watch_t)
+* @param[I]: from (analysis center, valid only for "orbclk")
+* @param[O]: fopt (FTP options)
 * @return  : none
 * @note    :
 **/
-void Config::run(std::string cfgfile)
+void Config::SelectProduct(ftpopt_t* fopt, std::string name, std::string from)
 {
-    prcopt_t popt;
-    ftpopt_t fopt;
-    /* initialization */
-    init(&popt, &fopt);
+    fopt->getobs = fopt->getnav = fopt->getorbclk = fopt->getobx = fopt->geteop = fopt->getsnx = false;
+    fopt->getdsb = fopt->getosb = fopt->getion = fopt->getroti = fopt->gettrp = fopt->getatx = false;
+    AddProduct(fopt, name, from);
+} /* end of SelectProduct */
 
-    /* read configure file to get processing information */
-    bool stat = false;
-    stat = ReadCfgYaml(cfgfile, &popt, &fopt);
-    if (!stat) return;
+/**
+* @brief   : AddProduct - to switch on one more product
+* @param[I]: name (product, see watch_t)
+* @param[I]: from (analysis center, valid only for "orbclk")
+* @param[O]: fopt (FTP options)
+* @return  : none
+* @note    : the analysis centers of "orbclk" are accumulated, i.e., "cod" + "gfz" -> "cod+gfz"
+**/
+void Config::AddProduct(ftpopt_t* fopt, std::string name, std::string from)
+{
+    if (name == "obs") fopt->getobs = true;
+    else if (name == "nav") fopt->getnav = true;
+    else if (name == "orbclk")
+    {
+        fopt->orbclkfrom = fopt->getorbclk ? fopt->orbclkfrom + "+" + from : from;
+        fopt->getorbclk = true;
+    }
+    else if (name == "obx") fopt->getobx = true;
+    else if (name == "eop") fopt->geteop = true;
+    else if (name == "snx") fopt->getsnx = true;
+    else if (name == "dsb") fopt->getdsb = true;
+    else if (name == "osb") fopt->getosb = true;
+    else if (name == "ion") fopt->getion = true;
+    else if (name == "roti") fopt->getroti = true;
+    else if (name == "trp") fopt->gettrp = true;
+    else if (name == "atx") fopt->getatx = true;
+} /* end of AddProduct */
 
-    /* data downloading for GNSS further processing */
-    if (fopt.ftpdownloading)
+/**
+* @brief   : HostOf - to get the host (or archive) one product is downloaded from
+* @param[I]: name (product, see watch_t)
+* @param[I]: from (analysis center or data center of the product)
+* @param[I]: fopt (FTP options)
+* @return  : host, i.e., "CDDIS", "aiub", "esa", ...
+* @note    : the products NOT from the dedicated servers of the analysis or data centers are from the FTP archive
+**/
+std::string Config::HostOf(std::string name, std::string from, const ftpopt_t* fopt)
+{
+    std::string archive = fopt->ftpfrom;
+    CString::trim(archive);
+    CString::ToUpper(archive);
+    CString::trim(from);
+    CString::ToLower(from);
+
+    if (name == "obs" && (from == "cut" || from == "hk" || from == "ngs" || from == "epn" || from == "pbo" || from == "chi")) return from;
+    if (name == "nav" && (from == "gop" || from == "wrd")) return from;
+    if (from == "cnt") return "cnes";
+    if (from == "esa_u" || from == "esa_r") return "esa";
+    if (from == "gfz_u" || from == "gfz_r") return "gfz";
+    if (from == "emr_r") return "nrcan";
+    if (from == "cod_r" || ((name == "dsb" || name == "trp") && from == "cod")) return "aiub";
+    if (name == "atx") return "igs";
+
+    return archive;
+} /* end of HostOf */
+
+/**
+* @brief   : FamilyOf - to get the product family of one product, the same as the profile and the metrics
+* @param[I]: name (product, see watch_t)
+* @param[I]: from (analysis center or data center of the product)
+* @return  : product family, i.e., "obs_igs", "nav", "orbclk_cod"
+* @note    : see the families begun in FtpUtil::FtpDownload
+**/
+std::string Config::FamilyOf(std::string name, std::string from)
+{
+    if ((name == "obs" || name == "orbclk") && !from.empty()) return name + "_" + from;
+
+    return name;
+} /* end of FamilyOf */
+
+/**
+* @brief   : SizeOf - to estimate the size of the files of one product of one day, i.e., the typical sizes of the products
+*              at CDDIS scaled by the numbers of sites, hours, sessions and analysis centers
+* @param[I]: name (product, see watch_t)
+* @param[I]: from (analysis center or data center of the product)
+* @param[I]: fopt (FTP options)
+* @return  : size (bytes)
+* @note    : it is only for ordering the jobs, and the observations are better sized by the listings, see GetListedSize
+**/
+double Config::SizeOf(std::string name, std::string from, const ftpopt_t* fopt)
+{
+    const double MB = 1024.0 * 1024.0;
+    CString::trim(from);
+    CString::ToLower(from);
+
+    /* the number of the sites in one site list, or the typical one of the whole directory */
+    auto nsite = [](std::string list, double nall) -> double {
+        if (!IsSiteList(list)) return nall;
+        std::ifstream fp(list.c_str());
+        std::string line;
+        double n = 0.0;
+        while (fp.is_open() && getline(fp, line))
+        {
+            CString::trim(line);
+            if (line.size() >= 4 && line[0] != '#') n += 1.0;
+        }
+        return n;
+    };
+    /* the number of the analysis centers, i.e., 'cod+igs' -> 2, 'all' -> 7 */
+    auto nac = [](std::string acs) -> double {
+        if (acs == "all" || acs == "all_m") return 7.0;
+        return (double)CString::split(acs, "+").size();
+    };
+    double nhh = (double)std::max((int)fopt->hhobs.size(), 1);
+
+    if (name == "obs")
+    {
+        std::string obstype = fopt->obstype;
+        CString::trim(obstype);
+        CString::ToLower(obstype);
+        bool isdc = from == "igs" || from == "mgex" || from == "igm";
+        if (obstype == "daily") return nsite(fopt->obslist, isdc ? 500.0 : 100.0) * 2.0 * MB;
+        if (obstype == "hourly") return nsite(fopt->obslist, 300.0) * nhh * 0.1 * MB;
+        if (obstype == "highrate") return nsite(fopt->obslist, 150.0) * nhh * 2.0 * MB;
+        if (obstype == "5s") return nsite(fopt->obslist, 50.0) * 12.0 * MB;
+        if (obstype == "1s") return nsite(fopt->obslist, 50.0) * 60.0 * MB;
+        return nsite(fopt->obslist, 50.0) * 2.0 * MB;
+    }
+    if (name == "nav")
+    {
+        if (fopt->navtype == "hourly") return nsite(fopt->navlist, 100.0) * (double)std::max((int)fopt->hhnav.size(), 1) * 0.05 * MB;
+        return 5.0 * MB;
+    }
+    if (name == "orbclk")
+    {
+        if (from == "cnt") return 30.0 * MB;
+        if (from.size() > 2 && from.substr(from.size() - 2) == "_u") return 0.5 * MB;
+        if (from.size() > 2 && from.substr(from.size() - 2) == "_r") return 3.0 * MB;
+        if (from.size() > 2 && from.substr(from.size() - 2) == "_m") return nac(from) * 10.0 * MB;
+        return nac(from) * 5.0 * MB;
+    }
+    if (name == "obx") return 5.0 * MB;
+    if (name == "eop") return 0.05 * MB;
+    if (name == "snx") return 25.0 * MB;
+    if (name == "dsb") return 0.2 * MB;
+    if (name == "osb") return 2.0 * MB;
+    if (name == "ion") return nac(from) * 1.5 * MB;
+    if (name == "roti") return 0.5 * MB;
+    if (name == "trp") return from == "igs" ? nsite(fopt->trplist, 100.0) * 0.05 * MB : 5.0 * MB;
+    if (name == "atx") return 4.0 * MB;
+
+    return 1.0 * MB;
+} /* end of SizeOf */
+
+/**
+* @brief   : Makespan - to project the wall-clock time of the jobs in one order, i.e., the scheduler of the backfill mode is
+*              simulated with the jobs taking their sizes over one transfer rate
+* @param[I]: sizes (sizes (bytes) of the jobs, in order)
+* @param[I]: hosts (hosts of the jobs, in order)
+* @param[I]: rate (transfer rate (bytes/s) of one process)
+* @param[I]: maxprocs (maximum number of processes)
+* @param[I]: hostcap (maximum number of processes per host)
+* @return  : makespan (s)
+* @note    :
+**/
+double Config::Makespan(const std::vector<double>& sizes, const std::vector<std::string>& hosts, double rate, int maxprocs,
+    int hostcap)
+{
+    if (rate <= 0.0) return 0.0;
+
+    std::list<size_t> queue;
+    for (size_t i = 0; i < sizes.size(); i++) queue.push_back(i);
+    std::vector<std::pair<double, size_t>> running;  /* (end time, job) */
+    std::map<std::string, int> nhost;
+    double t = 0.0;
+    while (!queue.empty() || !running.empty())
+    {
+        for (auto it = queue.begin(); it != queue.end() && (int)running.size() < maxprocs; )
+        {
+            if (nhost[hosts[*it]] >= hostcap)
+            {
+                ++it;
+                continue;
+            }
+            running.push_back({ t + sizes[*it] / rate, *it });
+            nhost[hosts[*it]]++;
+            it = queue.erase(it);
+        }
+        if (running.empty()) break;
+
+        auto first = std::min_element(running.begin(), running.end());
+        t = first->first;
+        nhost[hosts[first->second]]--;
+        running.erase(first);
+    }
+
+    return t;
+} /* end of Makespan */
+
+/**
+* @brief   : IsSiteList - to check if one list option is the full path of a site list file rather than 'all'
+* @param[I]: list (list option with full path)
+* @return  : true: site list file, false: 'all'
+* @note    : the same as the downloader, the length of "site.list" is nine
+**/
+bool Config::IsSiteList(std::string list)
+{
+    std::string::size_type ipos = list.find_last_of("/\\") + 1;
+
+    return list.size() - ipos >= 9;
+} /* end of IsSiteList */
+
+/**
+* @brief   : IsOwned - to check if one job (one product of one day) is run by this shard
+* @param[I]: ts (the day)
+* @param[I]: name (product, see watch_t)
+* @param[I]: from (analysis center or data center of the product)
+* @param[I]: fopt (FTP options)
+* @return  : true: run by this shard, false: by the other one
+* @note    : the jobs downloaded site-by-site are run by all the shards, each with its own part of the site list
+**/
+bool Config::IsOwned(gtime_t ts, std::string name, std::string from, const ftpopt_t* fopt)
+{
+    if (fopt->nshard <= 1) return true;
+    if (name == "obs" && IsSiteList(fopt->obslist)) return true;
+    if (name == "nav" && fopt->navtype == "hourly") return true;
+    if (name == "trp" && fopt->trpfrom == "igs") return true;
+
+    return CString::HashStr(JobKey(ts, name, from)) % (unsigned int)fopt->nshard == (unsigned int)fopt->ishard;
+} /* end of IsOwned */
+
+/**
+* @brief   : JobKey - to get the key of one job (one product of one day), i.e., "2024 001 orbclk igs"
+* @param[I]: ts (the day)
+* @param[I]: name (product, see watch_t)
+* @param[I]: from (analysis center or data center of the product)
+* @return  : key of the job
+* @note    :
+**/
+std::string Config::JobKey(gtime_t ts, std::string name, std::string from)
+{
+    int yyyy, doy;
+    GTime::time2yrdoy(ts, yyyy, doy);
+
+    return CString::int2str(yyyy, 4) + " " + CString::int2str(doy, 3) + " " + name + (from.empty() ? "" : " " + from);
+} /* end of JobKey */
+
+/**
+* @brief   : IsFileOf - to check whether one local file may be got by the job of one product of one day, i.e., it is in
+*              the directory of the product, and its path or name refers to the day
+* @param[I]: file (local file with full path)
+* @param[I]: ts (the day)
+* @param[I]: name (product, see watch_t)
+* @param[I]: popt (processing options)
+* @return  : true: it may be got by the job, false: NOT
+* @note    : the day is referred to by the directories 'yyyy/doy' (i.e., observations), the 'yyyydoy' of the long names,
+*              the 'doy' + session + '.yy' of the short names, or the GPS week and day (or the week of the weekly products).
+*              The products of the same directory (i.e., the precise orbits of all the analysis centers) are NOT told apart
+**/
+bool Config::IsFileOf(std::string file, gtime_t ts, std::string name, const prcopt_t* popt)
+{
+    std::string sep;
+    sep.push_back((char)FILEPATHSEP);
+    std::vector<std::string> dirs;
+    if (name == "obs") dirs.push_back(popt->obsdir);
+    else if (name == "nav") dirs.push_back(popt->navdir);
+    else if (name == "orbclk") dirs = { popt->orbdir, popt->clkdir };
+    else if (name == "obx") dirs.push_back(popt->obxdir);
+    else if (name == "eop") dirs.push_back(popt->eopdir);
+    else if (name == "snx") dirs.push_back(popt->snxdir);
+    else if (name == "dsb" || name == "osb") dirs.push_back(popt->biadir);
+    else if (name == "ion" || name == "roti") dirs.push_back(popt->iondir);
+    else if (name == "trp") dirs.push_back(popt->ztddir);
+    else if (name == "atx") dirs.push_back(popt->tbldir);
+    bool isin = false;
+    for (size_t i = 0; i < dirs.size() && !isin; i++)
+    {
+        std::string dir = dirs[i];
+        CString::trim(dir);
+        isin = !dir.empty() && file.compare(0, dir.size() + 1, dir + sep) == 0;
+    }
+    if (!isin) return false;
+    if (name == "atx") return true;  /* the ANTEX file does NOT depend on the day */
+
+    int yyyy, doy, wwww;
+    double sow;
+    GTime::time2yrdoy(ts, yyyy, doy);
+    int dow = GTime::time2gpst(ts, wwww, sow);
+    std::string syyyy = CString::int2str(yyyy, 4), sdoy = CString::int2str(doy, 3), swwww = CString::int2str(wwww, 4);
+    std::string syy = CString::int2str(GTime::yyyy2yy(yyyy), 2);
+    if (file.find(sep + syyyy + sep + sdoy + sep) != std::string::npos) return true;
+
+    std::string fname = file.substr(file.find_last_of(sep) + 1);
+    if (fname.find(syyyy + sdoy) != std::string::npos) return true;
+    for (std::string::size_type ipos = fname.find(sdoy); ipos != std::string::npos; ipos = fname.find(sdoy, ipos + 1))
     {
-        FtpUtil ftp;
-        std::string obsdirmain = popt.obsdir;
-        std::string navdirmain = popt.navdir;
-        std::string iondirmain = popt.iondir;
-        std::string ztddirmain = popt.ztddir;
-        for (int i = 0; i < popt.ndays; i++)
+        if (fname.compare(ipos + 4, 3, "." + syy) == 0) return true;
+    }
+    if (fname.find(swwww + std::to_string(dow)) != std::string::npos) return true;
+
+    return (name == "eop" || name == "snx") && (fname.find(swwww + "7") != std::string::npos ||
+        fname.find(swwww + ".") != std::string::npos);
+} /* end of IsFileOf */
+
+/**
+* @brief   : ShardSiteList - to write the part of one site list owned by this shard, i.e., the sites whose hashes of the
+*              4-character IDs modulo the number of shards are the index of this shard
+* @param[I]: list (site list file with full path)
+* @param[I]: dir (directory of the new site list, i.e., 'logDir')
+* @param[I]: fopt (FTP options)
+* @return  : the new site list file with full path, or the old one if it is NOT a site list file
+* @note    :
+**/
+std::string Config::ShardSiteList(std::string list, std::string dir, const ftpopt_t* fopt)
+{
+    if (!IsSiteList(list)) return list;
+    std::ifstream fp(list.c_str());
+    if (!fp.is_open()) return list;
+
+    std::string::size_type ipos = list.find_last_of("/\\") + 1;
+    std::string name = list.substr(ipos);
+    std::string::size_type jpos = name.find_last_of('.');
+    std::string sep;
+    sep.push_back((char)FILEPATHSEP);
+    std::string shardlist = dir + sep + name.substr(0, jpos) + FtpUtil::ShardTag(fopt) + (jpos == std::string::npos ? "" : name.substr(jpos));
+    std::ofstream fpout(shardlist.c_str());
+    std::string line;
+    int nsite = 0, nown = 0;
+    while (getline(fp, line))
+    {
+        std::string site = line;
+        CString::trim(site);
+        if (site.size() < 4 || site[0] == '#') continue;
+        site = site.substr(0, 4);
+        CString::ToLower(site);
+        nsite++;
+        if (CString::HashStr(site) % (unsigned int)fopt->nshard != (unsigned int)fopt->ishard) continue;
+        fpout << line << std::endl;
+        nown++;
+    }
+    fp.close();
+    fpout.close();
+
+    Logger::Trace(TINFO, "*** INFO(Config::ShardSiteList): " + std::to_string(nown) + " of " + std::to_string(nsite) +
+        " sites in " + list + " are owned by this shard");
+
+    return shardlist;
+} /* end of ShardSiteList */
+
+/**
+* @brief   : watch - to keep running and poll the data and products around the current time, each according to its
+*              publication latency
+* @param[I]: ftp (FTP downloader)
+* @param[I]: popt (processing options)
+* @param[I]: fopt (FTP options)
+* @return  : none
+* @note    : it never returns, and the process is stopped by the user (i.e., Ctrl+C). The days of 'best' that can NOT be
+*              upgraded any more are skipped, see 'best_orbclk.manifest'
+**/
+void Config::watch(FtpUtil* ftp, const prcopt_t* popt, const ftpopt_t* fopt)
+{
+    /* the publication schedule of one product, the times (s) are counted from the beginning of one epoch */
+    auto schedule = [&](std::string name, std::string from, std::string tier) -> watch_t {
+        double poll = (double)popt->pollintvl;
+        watch_t w = { name, from, 86400.0, 86400.0 + 3600.0, 86400.0, std::max(poll, 600.0), -1.0 };
+        if (tier == "hourly") w = { name, from, 3600.0, 3600.0, 7200.0, poll, -1.0 };
+        else if (tier == "igs_u" || tier == "esa_u") w = { name, from, 21600.0, 10800.0, 21600.0, std::max(poll, 300.0), -1.0 };
+        else if (tier == "gfz_u") w = { name, from, 10800.0, 7200.0, 10800.0, std::max(poll, 300.0), -1.0 };
+        else if (tier == "whu_u") w = { name, from, 3600.0, 3600.0, 3600.0, std::max(poll, 300.0), -1.0 };
+        else if (tier == "rapid") w = { name, from, 86400.0, 86400.0 + 17.0 * 3600.0, 86400.0, std::max(poll, 600.0), -1.0 };
+        else if (tier == "final") w = { name, from, 86400.0, 13.0 * 86400.0, 7.0 * 86400.0, std::max(poll, 10800.0), -1.0 };
+        else if (tier == "best") w = { name, from, 86400.0, 0.0, 14.0 * 86400.0, std::max(poll, 900.0), -1.0 };
+        else if (tier == "atx") w = { name, from, 86400.0, 0.0, 86400.0, std::max(poll, 86400.0), -1.0 };
+        return w;
+    };
+    /* the tier of one analysis center, i.e., 'igs_u' -> ultra-rapid, 'cod_r' -> rapid, 'cnt' -> real-time */
+    auto tierof = [](std::string ac) -> std::string {
+        if (ac == "best") return "best";
+        if (ac.size() > 2 && ac.substr(ac.size() - 2) == "_u") return ac;
+        if (ac.size() > 2 && ac.substr(ac.size() - 2) == "_r") return "rapid";
+        if (ac == "cnt") return "daily";
+        return "final";
+    };
+
+    std::vector<watch_t> ws;
+    std::vector<std::pair<std::string, std::string>> prods = GetProducts(fopt);
+    for (size_t i = 0; i < prods.size(); i++)
+    {
+        std::string name = prods[i].first, from = prods[i].second, tier = tierof(from);
+        if (name == "obs") tier = (fopt->obstype == "hourly" || fopt->obstype == "highrate") ? "hourly" : "daily";
+        else if (name == "nav") tier = fopt->navtype == "hourly" ? "hourly" : "daily";
+        else if (name == "snx" || name == "dsb" || name == "ion" || name == "roti" || name == "trp") tier = "final";
+        else if (name == "atx") tier = "atx";
+        ws.push_back(schedule(name, from, tier));
+    }
+
+    Logger::Trace(TINFO, "*** INFO(Config::watch): the watch mode is on, polling every " + std::to_string(popt->pollintvl) +
+        " seconds (press Ctrl+C to stop)");
+
+    while (true)
+    {
+        for (size_t i = 0; i < ws.size(); i++)
         {
-            int yyyy, doy;
-            GTime::time2yrdoy(popt.ts, yyyy, doy);
-            std::string syyyy = CString::int2str(yyyy, 4);
-            std::string sdoy = CString::int2str(doy, 3);
-            std::string dir, sep;
-            sep.push_back((char)FILEPATHSEP);
-            /* creat new observation sub-directory */
-            if (fopt.getobs)
+            gtime_t tnow = GTime::now();
+            double snow = tnow.mjd * 86400.0 + tnow.sod;
+            if (ws[i].tlast >= 0.0 && snow - ws[i].tlast < ws[i].revisit) continue;
+            ws[i].tlast = snow;
+
+            /* the tier got at each day of 'best', i.e., "2026 100" -> "final igs", see FtpUtil::GetOrbClkBest */
+            std::map<std::string, std::string> bests;
+            std::string bestac0;
+            if (ws[i].from == "best")
             {
-                dir = obsdirmain + sep + syyyy + sep + sdoy;
-                CString::trim(dir);
-                popt.obsdir = dir;
-                if (access(dir.c_str(), 0) == -1)
+                std::string sep;
+                sep.push_back((char)FILEPATHSEP);
+                std::ifstream fp((popt->orbdir + sep + "best_orbclk" + FtpUtil::ShardTag(fopt) + ".manifest").c_str());
+                std::string line;
+                while (fp.is_open() && getline(fp, line))
                 {
-                    /* If the directory does not exist, creat it */
-#ifdef _WIN32   /* for Windows */
-                    std::string cmd = "mkdir " + dir;
-#else           /* for Linux or Mac */
-                    std::string cmd = "mkdir -p " + dir;
-#endif
-                    std::system(cmd.c_str());
+                    std::vector<std::string> items = CString::split(line, " ");
+                    if (items.size() >= 4) bests[items[0] + " " + items[1]] = items[2] + " " + items[3];
                 }
+                if (fp.is_open()) fp.close();
+                std::string chain = fopt->bestchain;
+                CString::trim(chain);
+                CString::ToLower(chain);
+                std::vector<std::string> acs = CString::split(chain, "+");
+                if (!acs.empty()) bestac0 = acs[0];
             }
 
-            /* creat new NAV sub-directory */
-            if (fopt.getnav)
+            /* the epochs whose expected publication is within the polling window, the latest first */
+            for (double sep = floor(snow / ws[i].step) * ws[i].step; ; sep -= ws[i].step)
             {
-                dir = navdirmain + sep + syyyy + sep + sdoy;
-                CString::trim(dir);
-                popt.navdir = dir;
-                if (access(dir.c_str(), 0) == -1)
+                double spub = sep + ws[i].latency;
+                if (spub > snow) continue;
+                if (snow - spub > ws[i].window) break;
+
+                prcopt_t popt_i = *popt;
+                ftpopt_t fopt_i = *fopt;
+                popt_i.ts.mjd = (int)(sep / 86400.0);
+                popt_i.ts.sod = 0.0;
+                int hh = (int)((sep - popt_i.ts.mjd * 86400.0) / 3600.0 + 0.5);
+                if (!IsOwned(popt_i.ts, ws[i].name, ws[i].from, fopt)) continue;
+
+                /* the days of 'best' got at the final tier (or from the first analysis center of the chain) can NOT be
+                   upgraded any more, and the older days are polled less often, since they are waiting for the final
+                   products published days later, i.e., every 'revisit' up to two days old, and one more 'revisit' per day
+                   older than that */
+                if (ws[i].from == "best")
+                {
+                    int yyyy, doy;
+                    GTime::time2yrdoy(popt_i.ts, yyyy, doy);
+                    auto ib = bests.find(CString::int2str(yyyy, 4) + " " + CString::int2str(doy, 3));
+                    if (ib != bests.end() && (ib->second.compare(0, 6, "final ") == 0 ||
+                        ib->second.substr(ib->second.find(' ') + 1) == bestac0)) continue;
+                    double age = floor((snow - spub) / 86400.0);
+                    auto ie = ws[i].tepochs.find(sep);
+                    if (ie != ws[i].tepochs.end() && snow - ie->second < ws[i].revisit * std::max(1.0, age - 1.0)) continue;
+                    ws[i].tepochs[sep] = snow;
+                }
+
+                /* only the product of the schedule is downloaded */
+                SelectProduct(&fopt_i, ws[i].name, ws[i].from);
+                if (ws[i].name == "obs") fopt_i.hhobs.assign(1, hh);
+                else if (ws[i].name == "nav") fopt_i.hhnav.assign(1, hh);
+                else if (ws[i].name == "orbclk")
                 {
-                    /* If the directory does not exist, creat it */
+                    /* the sessions of the ultra-rapid products in the chain of 'best' are kept as configured */
+                    if (ws[i].from != "best") fopt_i.hhorbclk.assign(4, std::vector<int>());
+                    if (ws[i].from == "esa_u") fopt_i.hhorbclk[0].push_back(hh);
+                    else if (ws[i].from == "gfz_u") fopt_i.hhorbclk[1].push_back(hh);
+                    else if (ws[i].from == "igs_u") fopt_i.hhorbclk[2].push_back(hh);
+                    else if (ws[i].from == "whu_u") fopt_i.hhorbclk[3].push_back(hh);
+                }
+                else if (ws[i].name == "eop") fopt_i.hheop.assign(1, hh);
+
+                gtime_t tep = GTime::TimeAdd(popt_i.ts, hh * 3600.0);
+                Logger::Trace(TINFO, "*** INFO(Config::watch): polling " + ws[i].name + (ws[i].from.empty() ? "" : " (" + ws[i].from + ")") +
+                    " of " + GTime::time2str(tep));
+                GetDay(ftp, popt_i, fopt_i);
+            }
+
+            /* the epochs out of the polling window are forgotten */
+            while (!ws[i].tepochs.empty() && snow - ws[i].tepochs.begin()->first > ws[i].window + ws[i].step)
+            {
+                ws[i].tepochs.erase(ws[i].tepochs.begin());
+            }
+        }
+        /* the profile is reported after each polling cycle, since the watch mode never ends */
+        ProfUtil::Report();
+        MetricsUtil::Write(true);
+        ManifestUtil::Write();
+
 #ifdef _WIN32   /* for Windows */
-                    std::string cmd = "mkdir " + dir;
+        Sleep((DWORD)(popt->pollintvl * 1000));
 #else           /* for Linux or Mac */
-                    std::string cmd = "mkdir -p " + dir;
+        sleep((unsigned int)popt->pollintvl);
 #endif
-                    std::system(cmd.c_str());
-                }
+    }
+} /* end of watch */
+
+/**
+* @brief   : backfill - to download all the days of 'procTime' as one global queue of jobs (one product of one day each),
+*              which are run in parallel processes within the per-host concurrency cap, and checkpointed to the journal. The
+*              jobs are ordered by their estimated sizes, the longest first
+* @param[I]: ftp (FTP downloader)
+* @param[I]: popt (processing options)
+* @param[I]: fopt (FTP options)
+* @return  : none
+* @note    : the jobs committed in the journal 'backfill.journal' (or 'backfill_shard0of4.journal', ...) of 'logDir' are
+*              skipped after a restart, except those of the products and days of the local files moved aside by the input
+*              manifest or '--verify' (see IsFileOf), while the jobs with any file failed are journaled as failed and
+*              run again. On Windows, the jobs are run one by one in the process itself, because there
+*              is no 'fork'
+**/
+void Config::backfill(FtpUtil* ftp, const prcopt_t* popt, const ftpopt_t* fopt)
+{
+    std::string sep;
+    sep.push_back((char)FILEPATHSEP);
+
+    /* the size of each product is estimated once, i.e., the observations by the listing of the first day */
+    std::vector<std::pair<std::string, std::string>> prods = GetProducts(fopt);
+    std::vector<double> psizes(prods.size(), 0.0);
+    for (size_t j = 0; j < prods.size(); j++)
+    {
+        if (prods[j].first == "obs") psizes[j] = ftp->GetListedSize(popt->ts, fopt);
+        if (psizes[j] <= 0.0) psizes[j] = SizeOf(prods[j].first, prods[j].second, fopt);
+    }
+
+    /* the whole range is planned, the products of one day are spread over the hosts */
+    std::vector<job_t> jobs;
+    for (int i = 0; i < popt->ndays; i++)
+    {
+        gtime_t ts = GTime::TimeAdd(popt->ts, i * 86400.0);
+        for (size_t j = 0; j < prods.size(); j++)
+        {
+            if (!IsOwned(ts, prods[j].first, prods[j].second, fopt)) continue;
+            job_t job = { ts, prods[j].first, prods[j].second, HostOf(prods[j].first, prods[j].second, fopt), "", psizes[j] };
+            job.key = JobKey(ts, job.name, job.from);
+            jobs.push_back(job);
+        }
+    }
+
+    if (access(popt->logdir.c_str(), 0) == -1)
+    {
+#ifdef _WIN32   /* for Windows */
+        std::string cmd = "mkdir " + popt->logdir;
+#else           /* for Linux or Mac */
+        std::string cmd = "mkdir -p " + popt->logdir;
+#endif
+        ProfUtil::System(cmd);
+    }
+    JournalUtil journal;
+    if (!journal.Open(popt->logdir + sep + "backfill" + FtpUtil::ShardTag(fopt) + ".journal")) return;
+    /* the committed jobs of the products and days of the files moved aside (to be fetched again) are run again */
+    const std::vector<std::string>& moved = ManifestUtil::Moved();
+    std::list<size_t> queue;
+    size_t nredo = 0;
+    for (size_t i = 0; i < jobs.size(); i++)
+    {
+        if (journal.GetState(jobs[i].key) == JOB_COMMITTED)
+        {
+            bool isredo = false;
+            for (size_t k = 0; k < moved.size() && !isredo; k++) isredo = IsFileOf(moved[k], jobs[i].ts, jobs[i].name, popt);
+            if (!isredo) continue;
+            nredo++;
+        }
+        journal.SetState(jobs[i].key, JOB_PLANNED);
+        queue.push_back(i);
+    }
+    size_t ntodo = queue.size(), ndone = 0, nfail = 0;
+    Logger::Trace(TINFO, "*** INFO(Config::backfill): " + std::to_string(jobs.size()) + " jobs planned, " +
+        std::to_string(jobs.size() - ntodo + nredo) + " committed in the last runs (" + std::to_string(nredo) +
+        " of them run again for " + std::to_string(moved.size()) + " files moved aside), " + std::to_string(ntodo) + " to be run");
+
+    /* longest processing time first, so that the huge jobs do NOT stretch the tail and the tiny ones fill the gaps */
+    queue.sort([&](size_t a, size_t b) { return jobs[a].size > jobs[b].size; });
+    std::vector<double> sizes;
+    std::vector<std::string> hosts;
+    for (auto it = queue.begin(); it != queue.end(); ++it)
+    {
+        sizes.push_back(jobs[*it].size);
+        hosts.push_back(jobs[*it].host);
+        ProgressUtil::Plan(FamilyOf(jobs[*it].name, jobs[*it].from), jobs[*it].size);
+    }
+    /* the busy time (s) of the processes and the size (bytes) of the jobs done, for the transfer rate achieved */
+    double tbusy = 0.0, sizedone = 0.0;
+    auto tstart = std::chrono::steady_clock::now();
+    auto elapsed = [](std::chrono::steady_clock::time_point t0) -> double {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    };
+
+    /* the queue depth and the running jobs per host in the metrics */
+    auto gauges = [&](std::map<std::string, int>& nrun) {
+        if (!MetricsUtil::IsOn()) return;
+        std::map<std::string, int> nqueue;
+        for (size_t i = 0; i < jobs.size(); i++) nqueue[jobs[i].host] += 0;
+        for (auto it = queue.begin(); it != queue.end(); ++it) nqueue[jobs[*it].host]++;
+        for (auto it = nqueue.begin(); it != nqueue.end(); ++it)
+        {
+            MetricsUtil::Set(MetricsUtil::Series("good_queue_depth", { { "host", it->first } }), (double)it->second);
+            MetricsUtil::Set(MetricsUtil::Series("good_running_jobs", { { "host", it->first } }), (double)nrun[it->first]);
+        }
+        MetricsUtil::Write();
+    };
+
+    /* one job in the process itself, the number of files failed is returned */
+    auto runjob = [&](const job_t& job) -> int {
+        prcopt_t popt_i = *popt;
+        ftpopt_t fopt_i = *fopt;
+        popt_i.ts = job.ts;
+        SelectProduct(&fopt_i, job.name, job.from);
+        return GetDay(ftp, popt_i, fopt_i);
+    };
+
+    /* the job is committed only if all its files are got, otherwise it is run again in the next run */
+    auto endjob = [&](const job_t& job, bool isok) {
+        if (isok)
+        {
+            sizedone += job.size;
+            journal.SetState(job.key, JOB_COMMITTED);
+            ProgressUtil::Done(FamilyOf(job.name, job.from), job.size, true);
+            ndone++;
+            Logger::Trace(TINFO, "*** INFO(Config::backfill): " + job.key + " committed (" + std::to_string(ndone) + "/" +
+                std::to_string(ntodo) + ")");
+        }
+        else
+        {
+            journal.SetState(job.key, JOB_FAILED);
+            ProgressUtil::Done(FamilyOf(job.name, job.from), job.size, false);
+            nfail++;
+            Logger::Trace(TWARNING, "*** WARNING(Config::backfill): " + job.key + " failed, it is retried in the next run");
+        }
+    };
+
+#ifdef _WIN32   /* for Windows */
+    std::map<std::string, int> nhost;
+    while (!queue.empty())
+    {
+        const job_t& job = jobs[queue.front()];
+        queue.pop_front();
+        journal.SetState(job.key, JOB_FETCHING);
+        nhost[job.host] = 1;
+        gauges(nhost);
+        auto tjob = std::chrono::steady_clock::now();
+        int nbad = runjob(job);
+        nhost[job.host] = 0;
+        tbusy += elapsed(tjob);
+        endjob(job, nbad == 0);
+    }
+#else           /* for Linux or Mac */
+    std::map<pid_t, std::pair<size_t, std::chrono::steady_clock::time_point>> running;
+    std::map<std::string, int> nhost;
+    while (!queue.empty() || !running.empty())
+    {
+        /* the first jobs in the queue whose hosts are below the cap are started */
+        for (auto it = queue.begin(); it != queue.end() && (int)running.size() < popt->maxprocs; )
+        {
+            const job_t& job = jobs[*it];
+            if (nhost[job.host] >= popt->hostcap)
+            {
+                ++it;
+                continue;
             }
 
-            /* creat new ION sub-directory */
-            if (fopt.getion)
+            /* the buffered output must NOT be inherited by the child */
+            Logger::Flush();
+            pid_t pid = fork();
+            if (pid == 0)
             {
-                dir = iondirmain + sep + syyyy + sep + sdoy;
-                CString::trim(dir);
-                popt.iondir = dir;
-                if (access(dir.c_str(), 0) == -1)
-                {
-                    /* If the directory does not exist, creat it */
+                /* the child must NOT draw the same jitter as its parent and its siblings */
+                ftp->Reseed();
+                int nbad = runjob(job);
+                ProfUtil::Spill();
+                Logger::Flush();
+                _exit(nbad > 0 ? 1 : 0);
+            }
+
+            journal.SetState(job.key, JOB_FETCHING);
+            if (pid < 0)
+            {
+                /* no more process is available, so the job is run in the process itself */
+                auto tjob = std::chrono::steady_clock::now();
+                int nbad = runjob(job);
+                tbusy += elapsed(tjob);
+                endjob(job, nbad == 0);
+            }
+            else
+            {
+                running[pid] = { *it, std::chrono::steady_clock::now() };
+                nhost[job.host]++;
+            }
+            it = queue.erase(it);
+        }
+        gauges(nhost);
+        if (running.empty()) continue;
+
+        int status = 0;
+        pid_t pid = waitpid(-1, &status, 0);
+        auto it = running.find(pid);
+        if (it == running.end()) continue;
+        const job_t& job = jobs[it->second.first];
+        tbusy += elapsed(it->second.second);
+        nhost[job.host]--;
+        running.erase(it);
+        endjob(job, WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+#endif
+
+    std::map<std::string, int> nidle;
+    gauges(nidle);
+    Logger::Trace(TINFO, "*** INFO(Config::backfill): " + std::to_string(ndone) + " jobs committed, " + std::to_string(nfail) +
+        " failed");
+
+    /* the projected makespan is the one of the order above at the transfer rate achieved per process */
+    if (ndone > 0 && tbusy > 0.0)
+    {
 #ifdef _WIN32   /* for Windows */
-                    std::string cmd = "mkdir " + dir;
+        int nproc = 1;
 #else           /* for Linux or Mac */
-                    std::string cmd = "mkdir -p " + dir;
+        int nproc = popt->maxprocs;
 #endif
-                    std::system(cmd.c_str());
-                }
-            }
+        double rate = sizedone / tbusy, tproj = Makespan(sizes, hosts, rate, nproc, popt->hostcap);
+        std::ostringstream ss;
+        ss << std::fixed << std::setprecision(1) << "projected makespan " << tproj << "s, achieved " << elapsed(tstart) <<
+            "s (" << sizedone / 1024.0 / 1024.0 << " MB estimated, " << rate / 1024.0 / 1024.0 << " MB/s per process)";
+        Logger::Trace(TINFO, "*** INFO(Config::backfill): " + ss.str());
+    }
+} /* end of backfill */
 
-            /* creat new ZTD sub-directory */
-            if (fopt.gettrp)
+/**
+* @brief   : merge - to merge the logs, journals and manifests written by the shards of one run split by '--shard'
+* @param[I]: cfgfile (configure file with full path)
+* @param[I]: nshard (number of shards)
+* @param[O]: none
+* @return  : none
+* @note    : the files of the shards are kept, so that it can be run again after any shard is rerun
+**/
+void Config::merge(std::string cfgfile, int nshard)
+{
+    prcopt_t popt;
+    ftpopt_t fopt;
+    init(&popt, &fopt);
+    if (!ReadCfgYaml(cfgfile, &popt, &fopt)) return;
+
+    std::string sep;
+    sep.push_back((char)FILEPATHSEP);
+    std::vector<std::string> tiers = { "real-time", "ultra-rapid", "rapid", "final" };
+    std::ofstream fplog((popt.logdir + sep + "log.jsonl").c_str());
+    std::map<std::string, std::string> states;  /* the last state of each job */
+    std::map<std::string, std::string> best;  /* the best 'yyyy doy tier ac orbit_file' of each day */
+    std::string manifest = popt.orbdir + sep + "best_orbclk.manifest", line;
+    std::ifstream fpmft(manifest.c_str());
+    while (fpmft.is_open() && getline(fpmft, line))
+    {
+        if (line.size() > 8) best[line.substr(0, 8)] = line;
+    }
+    if (fpmft.is_open()) fpmft.close();
+
+    int nlog = 0, njob = 0, nday = 0, nfile = 0;
+    std::vector<std::string> mftfiles = { popt.logdir + sep + "run.manifest" };  /* the run manifests, the shards replace it */
+    for (int i = 0; i < nshard; i++)
+    {
+        fopt.ishard = i;
+        fopt.nshard = nshard;
+        std::string tag = FtpUtil::ShardTag(&fopt);
+        mftfiles.push_back(popt.logdir + sep + "run" + tag + ".manifest");
+
+        /* the logs are concatenated in the order of the shards */
+        std::ifstream fpin((popt.logdir + sep + "log" + tag + ".jsonl").c_str());
+        if (fpin.is_open())
+        {
+            while (getline(fpin, line)) fplog << line << "\n";
+            fpin.close();
+            nlog++;
+        }
+
+        /* the states of the jobs in the journals are united, and the jobs run site-by-site by all the shards are committed
+           only if they are committed by every shard */
+        std::string jfile = popt.logdir + sep + "backfill" + tag + ".journal";
+        JournalUtil jshard;
+        if (access(jfile.c_str(), 0) == 0 && jshard.Open(jfile))
+        {
+            const std::map<std::string, std::string>& shardstates = jshard.GetStates();
+            for (auto it = shardstates.begin(); it != shardstates.end(); ++it)
             {
-                dir = ztddirmain + sep + syyyy + sep + sdoy;
-                CString::trim(dir);
-                popt.ztddir = dir;
-                if (access(dir.c_str(), 0) == -1)
-                {
-                    /* If the directory does not exist, creat it */
+                if (states.find(it->first) == states.end() || states[it->first] == JOB_COMMITTED) states[it->first] = it->second;
+            }
+        }
+
+        /* the better tier of each day is kept in the manifests */
+        std::ifstream fpsft((popt.orbdir + sep + "best_orbclk" + tag + ".manifest").c_str());
+        while (fpsft.is_open() && getline(fpsft, line))
+        {
+            if (line.size() <= 8) continue;
+            std::string sday = line.substr(0, 8);
+            std::vector<std::string> snow = CString::split(line, " "), slast = CString::split(best[sday], " ");
+            int inow = snow.size() >= 3 ? (int)(std::find(tiers.begin(), tiers.end(), snow[2]) - tiers.begin()) : -1;
+            int ilast = slast.size() >= 3 ? (int)(std::find(tiers.begin(), tiers.end(), slast[2]) - tiers.begin()) : -1;
+            if (ilast >= (int)tiers.size()) ilast = -1;
+            if (inow < (int)tiers.size() && inow >= ilast) best[sday] = line;
+        }
+        if (fpsft.is_open()) fpsft.close();
+    }
+    fplog.close();
+
+    JournalUtil journal;
+    if (!states.empty() && journal.Open(popt.logdir + sep + "backfill.journal"))
+    {
+        for (auto it = states.begin(); it != states.end(); ++it)
+        {
+            if (journal.GetState(it->first) != it->second) journal.SetState(it->first, it->second);
+            njob++;
+        }
+    }
+
+    for (auto it = best.begin(); it != best.end(); ++it)
+    {
+        if (!it->second.empty()) nday++;
+    }
+    if (nday > 0)
+    {
+        std::string tmpfile = manifest + ".tmp";
+        std::ofstream fpout(tmpfile.c_str());
+        for (auto it = best.begin(); it != best.end(); ++it)
+        {
+            if (!it->second.empty()) fpout << it->second << std::endl;
+        }
+        fpout.close();
+        std::remove(manifest.c_str());
+        std::rename(tmpfile.c_str(), manifest.c_str());
+    }
+    nfile = ManifestUtil::Merge(mftfiles, popt.logdir + sep + "run.manifest");
+
+    Logger::Trace(TINFO, "*** INFO(Config::merge): " + std::to_string(nlog) + " logs, " + std::to_string(njob) + " jobs, " +
+        std::to_string(nday) + " days of the best precise orbit and clock products and " + std::to_string(nfile) +
+        " files of the run manifests are merged from " + std::to_string(nshard) + " shards");
+} /* end of merge */
+
+/**
+* @brief   : verify - to verify the local files against the run manifest in parallel, without any network access
+* @param[I]: cfgfile (configure file with full path)
+* @param[I]: ishard (index of this shard)
+* @param[I]: nshard (number of shards, 1: NOT split)
+* @param[O]: none
+* @return  : none
+* @note    : the files mismatched are moved to '*.old', and they are fetched again by the next run, i.e., the jobs of the
+*              backfill mode committed in the last runs for their products and days are run again (see backfill)
+**/
+void Config::verify(std::string cfgfile, int ishard, int nshard)
+{
+    prcopt_t popt;
+    ftpopt_t fopt;
+    init(&popt, &fopt);
+    if (!ReadCfgYaml(cfgfile, &popt, &fopt)) return;
+    fopt.ishard = ishard;
+    fopt.nshard = nshard;
+
+    std::string sep;
+    sep.push_back((char)FILEPATHSEP);
+    std::string mftfile = popt.logdir + sep + "run" + FtpUtil::ShardTag(&fopt) + ".manifest";
+    if (access(mftfile.c_str(), 0) == -1)
+    {
+        Logger::Trace(TWARNING, "*** WARNING(Config::verify): the run manifest " + mftfile + " is NOT found, please check it");
+        return;
+    }
+    ManifestUtil::Open(popt.logdir, FtpUtil::ShardTag(&fopt), popt.maindir, "");
+    ManifestUtil::Verify(0);
+} /* end of verify */
+
+/**
+* @brief   : run - start GOOD processing
+* @param[I]: cfgFile (configure file with full path)
+* @param[I]: ishard (index of this shard)
+* @param[I]: nshard (number of shards, 1: NOT split)
+* @param[I]: profile (true: the time spent per product family and stage is reported in 'logDir', see ProfUtil)
+* @param[O]: none
+* @return  : none
+* @note    : the shards share 'mainDir' safely, because each writes its own logs, journal, manifest and site lists, and the
+*              downloaded files of one job are owned by only one shard
+**/
+void Config::run(std::string cfgfile, int ishard, int nshard, bool profile)
+{
+    prcopt_t popt;
+    ftpopt_t fopt;
+    /* initialization */
+    init(&popt, &fopt);
+
+    /* read configure file to get processing information */
+    bool stat = false;
+    stat = ReadCfgYaml(cfgfile, &popt, &fopt);
+    if (!stat) return;
+
+    /* the site lists are split, and the other jobs are split by the hashes of their keys */
+    fopt.ishard = ishard;
+    fopt.nshard = nshard;
+    if (fopt.nshard > 1)
+    {
+        if (access(popt.logdir.c_str(), 0) == -1)
+        {
+#ifdef _WIN32   /* for Windows */
+            std::string cmd = "mkdir " + popt.logdir;
+#else           /* for Linux or Mac */
+            std::string cmd = "mkdir -p " + popt.logdir;
+#endif
+            ProfUtil::System(cmd);
+        }
+        std::string sep;
+        sep.push_back((char)FILEPATHSEP);
+        popt.logfil = popt.logdir + sep + "log" + FtpUtil::ShardTag(&fopt) + ".jsonl";
+        if (fopt.getobs) fopt.obslist = ShardSiteList(fopt.obslist, popt.logdir, &fopt);
+        if (fopt.getnav && fopt.navtype == "hourly") fopt.navlist = ShardSiteList(fopt.navlist, popt.logdir, &fopt);
+        if (fopt.gettrp && fopt.trpfrom == "igs") fopt.trplist = ShardSiteList(fopt.trplist, popt.logdir, &fopt);
+        Logger::Trace(TINFO, "*** INFO(Config::run): this is shard " + std::to_string(fopt.ishard) + " of " +
+            std::to_string(fopt.nshard));
+    }
+    if (profile)
+    {
+        if (access(popt.logdir.c_str(), 0) == -1)
+        {
 #ifdef _WIN32   /* for Windows */
-                    std::string cmd = "mkdir " + dir;
+            std::string cmd = "mkdir " + popt.logdir;
 #else           /* for Linux or Mac */
-                    std::string cmd = "mkdir -p " + dir;
+            std::string cmd = "mkdir -p " + popt.logdir;
 #endif
-                    std::system(cmd.c_str());
+            ProfUtil::System(cmd);
+        }
+        ProfUtil::Open(popt.logdir, FtpUtil::ShardTag(&fopt));
+    }
+    /* the progress reads the counters of the metrics, which are shared with the child processes of the backfill mode, and
+       it is off in the watch mode, which never ends */
+    popt.progress = popt.progress && !popt.watchmode && fopt.ftpdownloading;
+    if (popt.metrics)
+    {
+        if (access(popt.logdir.c_str(), 0) == -1)
+        {
+#ifdef _WIN32   /* for Windows */
+            std::string cmd = "mkdir " + popt.logdir;
+#else           /* for Linux or Mac */
+            std::string cmd = "mkdir -p " + popt.logdir;
+#endif
+            ProfUtil::System(cmd);
+        }
+        std::string sep;
+        sep.push_back((char)FILEPATHSEP);
+        MetricsUtil::Open(popt.logdir + sep + "good" + FtpUtil::ShardTag(&fopt) + ".prom", (double)popt.metricsintvl);
+    }
+    if (popt.progress)
+    {
+        MetricsUtil::Open("", (double)popt.metricsintvl);
+        ProgressUtil::Start((double)popt.progressintvl);
+    }
+    if (popt.manifest && fopt.ftpdownloading)
+    {
+        if (access(popt.logdir.c_str(), 0) == -1)
+        {
+#ifdef _WIN32   /* for Windows */
+            std::string cmd = "mkdir " + popt.logdir;
+#else           /* for Linux or Mac */
+            std::string cmd = "mkdir -p " + popt.logdir;
+#endif
+            ProfUtil::System(cmd);
+        }
+        ManifestUtil::Open(popt.logdir, FtpUtil::ShardTag(&fopt), popt.maindir, popt.manifestin);
+    }
+
+    /* data downloading for GNSS further processing */
+    if (fopt.ftpdownloading)
+    {
+        FtpUtil ftp;
+        ftp.Resume(&popt, &fopt);
+        if (popt.watchmode) watch(&ftp, &popt, &fopt);
+        else if (popt.backfill) backfill(&ftp, &popt, &fopt);
+        else
+        {
+            std::vector<std::pair<std::string, std::string>> prods = GetProducts(&fopt);
+
+            /* each product of one day is one job of the progress */
+            std::vector<double> psizes(prods.size(), 0.0);
+            for (size_t j = 0; j < prods.size(); j++) psizes[j] = SizeOf(prods[j].first, prods[j].second, &fopt);
+            for (int i = 0; i < popt.ndays; i++)
+            {
+                gtime_t ts = GTime::TimeAdd(popt.ts, i * 86400.0);
+                for (size_t j = 0; j < prods.size(); j++)
+                {
+                    if (!IsOwned(ts, prods[j].first, prods[j].second, &fopt)) continue;
+                    ProgressUtil::Plan(FamilyOf(prods[j].first, prods[j].second), psizes[j]);
                 }
             }
+            for (int i = 0; i < popt.ndays; i++)
+            {
+                /* only the products of the day owned by this shard */
+                ftpopt_t fopt_i = fopt;
+                SelectProduct(&fopt_i, "", "");
+                bool isowned = false;
+                for (size_t j = 0; j < prods.size(); j++)
+                {
+                    if (!IsOwned(popt.ts, prods[j].first, prods[j].second, &fopt)) continue;
+                    AddProduct(&fopt_i, prods[j].first, prods[j].second);
+                    isowned = true;
+                }
+                int nfailed = isowned ? GetDay(&ftp, popt, fopt.nshard > 1 ? fopt_i : fopt) : 0;
+                for (size_t j = 0; j < prods.size(); j++)
+                {
+                    if (!IsOwned(popt.ts, prods[j].first, prods[j].second, &fopt)) continue;
+                    ProgressUtil::Done(FamilyOf(prods[j].first, prods[j].second), psizes[j], nfailed == 0);
+                }
 
-            /* the main entry of FTP downloader */
-            ftp.FtpDownload(&popt, &fopt);
-
-            popt.ts = GTime::TimeAdd(popt.ts, 86400.0);
+                popt.ts = GTime::TimeAdd(popt.ts, 86400.0);
+            }
         }
     }
-} /* end of run */
\ No newline at end of file
+
+    ProgressUtil::Stop();
+    ProfUtil::Report();
+    MetricsUtil::Write(true);
+    ManifestUtil::Write();
+} /* end of run */
@@ -3,6 +3,8 @@
 *-----------------------------------------------------------------------------*/
 #pragma once
 
+class FtpUtil;
+
 class Config
 {
 private:
@@ -26,6 +28,164 @@ private:
     **/
     static bool ReadCfgYaml(std::string cfgfile, prcopt_t *popt, ftpopt_t *fopt);
 
+    /**
+    * @brief   : GetDay - to create the sub-directories of one day and download the data and products of the day
+    * @param[I]: ftp (FTP downloader)
+    * @param[I]: popt (processing options, the time is the day to be downloaded)
+    * @param[I]: fopt (FTP options)
+    * @return  : number of files failed
+    * @note    : the options are copied, because the sub-directories of the day are set to them
+    **/
+    static int GetDay(FtpUtil* ftp, prcopt_t popt, ftpopt_t fopt);
+
+    /**
+    * @brief   : GetProducts - to get the products to be downloaded, one item per analysis center for the precise orbit and clock
+    * @param[I]: fopt (FTP options)
+    * @return  : products, i.e., {"obs", "igs"}, {"orbclk", "cod"}, {"orbclk", "gfz_m"}, ...
+    * @note    :
+    **/
+    static std::vector<std::pair<std::string, std::string>> GetProducts(const ftpopt_t* fopt);
+
+    /**
+    * @brief   : SelectProduct - to switch off all the products but one
+    * @param[I]: name (product, see watch_t)
+    * @param[I]: from (analysis center, valid only for "orbclk")
+    * @param[O]: fopt (FTP options)
+    * @return  : none
+    * @note    :
+    **/
+    static void SelectProduct(ftpopt_t* fopt, std::string name, std::string from);
+
+    /**
+    * @brief   : AddProduct - to switch on one more product
+    * @param[I]: name (product, see watch_t)
+    * @param[I]: from (analysis center, valid only for "orbclk")
+    * @param[O]: fopt (FTP options)
+    * @return  : none
+    * @note    : the analysis centers of "orbclk" are accumulated, i.e., "cod" + "gfz" -> "cod+gfz"
+    **/
+    static void AddProduct(ftpopt_t* fopt, std::string name, std::string from);
+
+    /**
+    * @brief   : HostOf - to get the host (or archive) one product is downloaded from
+    * @param[I]: name (product, see watch_t)
+    * @param[I]: from (analysis center or data center of the product)
+    * @param[I]: fopt (FTP options)
+    * @return  : host, i.e., "CDDIS", "aiub", "esa", ...
+    * @note    :
+    **/
+    static std::string HostOf(std::string name, std::string from, const ftpopt_t* fopt);
+
+    /**
+    * @brief   : FamilyOf - to get the product family of one product, the same as the profile and the metrics
+    * @param[I]: name (product, see watch_t)
+    * @param[I]: from (analysis center or data center of the product)
+    * @return  : product family, i.e., "obs_igs", "nav", "orbclk_cod"
+    * @note    :
+    **/
+    static std::string FamilyOf(std::string name, std::string from);
+
+    /**
+    * @brief   : SizeOf - to estimate the size of the files of one product of one day, i.e., the typical sizes of the
+    *              products at CDDIS scaled by the numbers of sites, hours, sessions and analysis centers
+    * @param[I]: name (product, see watch_t)
+    * @param[I]: from (analysis center or data center of the product)
+    * @param[I]: fopt (FTP options)
+    * @return  : size (bytes)
+    * @note    :
+    **/
+    static double SizeOf(std::string name, std::string from, const ftpopt_t* fopt);
+
+    /**
+    * @brief   : Makespan - to project the wall-clock time of the jobs in one order, i.e., the scheduler of the backfill mode
+    *              is simulated with the jobs taking their sizes over one transfer rate
+    * @param[I]: sizes (sizes (bytes) of the jobs, in order)
+    * @param[I]: hosts (hosts of the jobs, in order)
+    * @param[I]: rate (transfer rate (bytes/s) of one process)
+    * @param[I]: maxprocs (maximum number of processes)
+    * @param[I]: hostcap (maximum number of processes per host)
+    * @return  : makespan (s)
+    * @note    :
+    **/
+    static double Makespan(const std::vector<double>& sizes, const std::vector<std::string>& hosts, double rate, int maxprocs,
+        int hostcap);
+
+    /**
+    * @brief   : IsSiteList - to check if one list option is the full path of a site list file rather than 'all'
+    * @param[I]: list (list option with full path)
+    * @return  : true: site list file, false: 'all'
+    * @note    :
+    **/
+    static bool IsSiteList(std::string list);
+
+    /**
+    * @brief   : IsOwned - to check if one job (one product of one day) is run by this shard
+    * @param[I]: ts (the day)
+    * @param[I]: name (product, see watch_t)
+    * @param[I]: from (analysis center or data center of the product)
+    * @param[I]: fopt (FTP options)
+    * @return  : true: run by this shard, false: by the other one
+    * @note    : the jobs downloaded site-by-site are run by all the shards, each with its own part of the site list
+    **/
+    static bool IsOwned(gtime_t ts, std::string name, std::string from, const ftpopt_t* fopt);
+
+    /**
+    * @brief   : JobKey - to get the key of one job (one product of one day), i.e., "2024 001 orbclk igs"
+    * @param[I]: ts (the day)
+    * @param[I]: name (product, see watch_t)
+    * @param[I]: from (analysis center or data center of the product)
+    * @return  : key of the job
+    * @note    :
+    **/
+    static std::string JobKey(gtime_t ts, std::string name, std::string from);
+
+    /**
+    * @brief   : IsFileOf - to check whether one local file may be got by the job of one product of one day
+    * @param[I]: file (local file with full path)
+    * @param[I]: ts (the day)
+    * @param[I]: name (product, see watch_t)
+    * @param[I]: popt (processing options)
+    * @return  : true: it may be got by the job, false: NOT
+    * @note    :
+    **/
+    static bool IsFileOf(std::string file, gtime_t ts, std::string name, const prcopt_t* popt);
+
+    /**
+    * @brief   : ShardSiteList - to write the part of one site list owned by this shard
+    * @param[I]: list (site list file with full path)
+    * @param[I]: dir (directory of the new site list, i.e., 'logDir')
+    * @param[I]: fopt (FTP options)
+    * @return  : the new site list file with full path, or the old one if it is NOT a site list file
+    * @note    :
+    **/
+    static std::string ShardSiteList(std::string list, std::string dir, const ftpopt_t* fopt);
+
+    /**
+    * @brief   : watch - to keep running and poll the data and products around the current time, each according to its
+    *              publication latency
+    * @param[I]: ftp (FTP downloader)
+    * @param[I]: popt (processing options)
+    * @param[I]: fopt (FTP options)
+    * @return  : none
+    * @note    : it never returns, and the process is stopped by the user (i.e., Ctrl+C). The days of 'best' that can NOT
+    *              be upgraded any more are skipped, see 'best_orbclk.manifest'
+    **/
+    static void watch(FtpUtil* ftp, const prcopt_t* popt, const ftpopt_t* fopt);
+
+    /**
+    * @brief   : backfill - to download all the days of 'procTime' as one global queue of jobs (one product of one day each),
+    *              which are run in parallel processes within the per-host concurrency cap, and checkpointed to the journal. The
+    *              jobs are ordered by their estimated sizes, the longest first
+    * @param[I]: ftp (FTP downloader)
+    * @param[I]: popt (processing options)
+    * @param[I]: fopt (FTP options)
+    * @return  : none
+    * @note    : the jobs committed in the journal 'backfill.journal' of 'logDir' are skipped after a restart, except those
+    *              of the local files moved aside (see IsFileOf), while the jobs with any file failed are journaled as failed
+    *              and run again
+    **/
+    static void backfill(FtpUtil* ftp, const prcopt_t* popt, const ftpopt_t* fopt);
+
 public:
     Config() = default;
     ~Config() = default;
@@ -33,9 +193,33 @@ public:
     /**
     * @brief   : run - start GOOD processing
     * @param[I]: cfgfile (configure file with full path)
+    * @param[I]: ishard (index of this shard)
+    * @param[I]: nshard (number of shards, 1: NOT split)
+    * @param[I]: profile (true: the time spent per product family and stage is reported in 'logDir', see ProfUtil)
     * @param[O]: none
     * @return  : none
     * @note    :
     **/
-    static void run(std::string cfgfile);
+    static void run(std::string cfgfile, int ishard = 0, int nshard = 1, bool profile = false);
+
+    /**
+    * @brief   : merge - to merge the logs, journals and manifests written by the shards of one run split by '--shard'
+    * @param[I]: cfgfile (configure file with full path)
+    * @param[I]: nshard (number of shards)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the files of the shards are kept, so that it can be run again after any shard is rerun
+    **/
+    static void merge(std::string cfgfile, int nshard);
+
+    /**
+    * @brief   : verify - to verify the local files against the run manifest in parallel, without any network access
+    * @param[I]: cfgfile (configure file with full path)
+    * @param[I]: ishard (index of this shard)
+    * @param[I]: nshard (number of shards, 1: NOT split)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the files mismatched are moved to '*.old', and they are fetched again by the next run
+    **/
+    static void verify(std::string cfgfile, int ishard = 0, int nshard = 1);
 };
\ No newline at end of file
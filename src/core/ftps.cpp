@@ -111,6 +111,12 @@
 #include "../common/gtime.h"
 #include "../common/cstring.h"
 #include "../common/logger.h"
+#include "../common/digest.h"
+#include "cache.h"
+#include "journal.h"
+#include "profile.h"
+#include "metrics.h"
+#include "manifest.h"
 #include "ftps.h"
 
 /* constants/macros ----------------------------------------------------------*/
@@ -140,17 +146,31 @@
 #define PROD_FINAL_IGS   4   /* index for IGS final orbit and clock products downloading */
 #define PROD_FINAL_MGEX  5   /* index for MGEX final orbit and clock products downloading */
 
+#define XFER_OK          0   /* the transfer is successful */
+#define XFER_NOTFOUND    1   /* the remote file is NOT found (i.e., HTTP 404, FTP 550), permanent and NOT retried */
+#define XFER_AUTH        2   /* authentication or certificate failure (i.e., HTTP 401/403, FTP 530), permanent and NOT retried */
+#define XFER_THROTTLED   3   /* the server is busy (i.e., HTTP 429/503, FTP 421), retried with four times longer backoff */
+#define XFER_TRANSIENT   4   /* transient network failure (i.e., timeout, connection reset, HTTP 5xx), retried */
+#define XFER_CORRUPT     5   /* the payload is corrupt (i.e., truncated '*.gz' or '*.Z'), retried */
+#define XFER_ERROR       6   /* the other failures (i.e., local file I/O, interrupted), NOT retried */
+
 /* function definition -------------------------------------------------------*/
 
 /**
-* @brief   : init - Get FTP archive for CDDIS, IGN, or WHU
-* @param[I]: none
+* @brief   : init - Get FTP archive for CDDIS, IGN, WHU, or LOCAL
+* @param[I]: fopt (FTP options)
 * @param[O]: none
 * @return  : none
 * @note    :
 **/
-void FtpUtil::init()
+void FtpUtil::init(const ftpopt_t* fopt)
 {
+    /* it is called once per day */
+    ftparchive_.CDDIS.clear();
+    ftparchive_.IGN.clear();
+    ftparchive_.WHU.clear();
+    ftparchive_.LOCAL.clear();
+
     /* FTP archive for CDDIS */
     ftparchive_.CDDIS.push_back("ftps://gdc.cddis.eosdis.nasa.gov/pub/gnss/data/daily");                /* IGS daily observation (30s) files */
     ftparchive_.CDDIS.push_back("ftps://gdc.cddis.eosdis.nasa.gov/pub/gnss/data/hourly");               /* IGS hourly observation (30s) files */
@@ -172,48 +192,1679 @@ void FtpUtil::init()
     ftparchive_.CDDIS.push_back("ftps://gdc.cddis.eosdis.nasa.gov/pub/gnss/products/ionex");            /* Rate of TEC index (ROTI) files */
     ftparchive_.CDDIS.push_back("ftps://gdc.cddis.eosdis.nasa.gov/pub/gnss/products/troposphere/zpd");  /* IGS final tropospheric product files */
 
-    /* FTP archive for IGN */
-    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/data");                                         /* IGS daily observation (30s) files */
-    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/data/hourly");                                  /* IGS hourly observation (30s) files */
-    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/data/highrate");                                /* IGS high-rate observation (1s) files */
-    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/data");                                         /* MGEX daily observation (30s) files */
-    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/data/hourly");                                  /* MGEX hourly observation (30s) files */
-    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/data/highrate");                                /* MGEX high-rate observation (1s) files */
-    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/data");                                         /* broadcast ephemeris files */
-    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/products");                                     /* IGS SP3 files */
-    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/products");                                     /* IGS CLK files */
-    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/products");                                     /* IGS EOP files */
-    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/products");                                     /* IGS weekly SINEX files */
-    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/products/mgex");                                /* MGEX SP3 files */
-    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/products/mgex");                                /* MGEX CLK files */
-    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/products/mgex");                                /* MGEX ORBEX files */
-    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/products/mgex/dcb");                            /* MGEX DSB files */
-    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/products/mgex");                                /* MGEX OSB files */
-    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/products/ionosphere");                          /* global ionosphere map (GIM) files */
-    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/products/ionosphere");                          /* Rate of TEC index (ROTI) files */
-    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/products/troposphere");                         /* IGS final tropospheric product files */
+    /* FTP archive for IGN */
+    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/data");                                         /* IGS daily observation (30s) files */
+    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/data/hourly");                                  /* IGS hourly observation (30s) files */
+    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/data/highrate");                                /* IGS high-rate observation (1s) files */
+    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/data");                                         /* MGEX daily observation (30s) files */
+    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/data/hourly");                                  /* MGEX hourly observation (30s) files */
+    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/data/highrate");                                /* MGEX high-rate observation (1s) files */
+    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/data");                                         /* broadcast ephemeris files */
+    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/products");                                     /* IGS SP3 files */
+    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/products");                                     /* IGS CLK files */
+    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/products");                                     /* IGS EOP files */
+    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/products");                                     /* IGS weekly SINEX files */
+    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/products/mgex");                                /* MGEX SP3 files */
+    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/products/mgex");                                /* MGEX CLK files */
+    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/products/mgex");                                /* MGEX ORBEX files */
+    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/products/mgex/dcb");                            /* MGEX DSB files */
+    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/products/mgex");                                /* MGEX OSB files */
+    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/products/ionosphere");                          /* global ionosphere map (GIM) files */
+    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/products/ionosphere");                          /* Rate of TEC index (ROTI) files */
+    ftparchive_.IGN.push_back("ftp://igs.ign.fr/pub/igs/products/troposphere");                         /* IGS final tropospheric product files */
+
+    /* FTP archive for WHU */
+    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/data/daily");                               /* IGS daily observation (30s) files */
+    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/data/hourly");                              /* IGS hourly observation (30s) files */
+    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/highrate");                                     /* IGS high-rate observation (1s) files */
+    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/data/daily");                               /* MGEX daily observation (30s) files */
+    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/data/hourly");                              /* MGEX hourly observation (30s) files */
+    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/highrate");                                     /* MGEX high-rate observation (1s) files */
+    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/data/daily");                               /* broadcast ephemeris files */
+    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products");                                 /* IGS SP3 files */
+    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products");                                 /* IGS CLK files */
+    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products");                                 /* IGS EOP files */
+    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products");                                 /* IGS weekly SINEX files */
+    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products/mgex");                            /* MGEX SP3 files */
+    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products/mgex");                            /* MGEX CLK files */
+    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products/mgex");                            /* MGEX ORBEX files */
+    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products/mgex/dcb");                        /* MGEX DSB files */
+    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products/mgex");                            /* MGEX OSB files */
+    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products/ionex");                           /* global ionosphere map (GIM) files */
+    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products/ionex");                           /* Rate of TEC index (ROTI) files */
+    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products/troposphere/new");                 /* IGS final tropospheric product files */
+
+    /* local mirror of CDDIS archive, i.e., 'ftps://gdc.cddis.eosdis.nasa.gov/pub/gnss/data/daily' -> 'file://<mirrorDir>/gnss/data/daily' */
+    std::string cddisroot = "ftps://gdc.cddis.eosdis.nasa.gov/pub", mirrordir = fopt->mirrordir;
+    CString::trim(mirrordir);
+    while (mirrordir.size() > 1 && (mirrordir.back() == '/' || mirrordir.back() == '\\')) mirrordir.pop_back();
+    for (size_t i = 0; i < ftparchive_.CDDIS.size(); i++)
+    {
+        ftparchive_.LOCAL.push_back("file://" + mirrordir + ftparchive_.CDDIS[i].substr(cddisroot.size()));
+    }
+
+    /* the local mirror follows the directory layout of CDDIS, so it is resolved through the (default) branches of CDDIS */
+    std::string ftpname = fopt->ftpfrom;
+    CString::trim(ftpname);
+    CString::ToUpper(ftpname);
+    if (ftpname == "LOCAL") ftparchive_.CDDIS = ftparchive_.LOCAL;
+} /* end of init */
+
+/**
+* @brief   : RunWget - to run one 'wget' command, i.e., from the local mirror, the shared cache, or the remote server with
+*              the retry policy
+* @param[I]: cmd ('wget' command line)
+* @param[I]: fopt (FTP options)
+* @param[I]: xfile (local file to be tested for integrity after the transfer, empty: NOT tested)
+* @param[I]: cacheable (false: the shared cache is NOT used, i.e., for the mutable products)
+* @param[O]: none
+* @return  : class of the transfer outcome (XFER_*)
+* @note    : only the transfer of one exactly-known file (i.e., one URL without wildcard) is cached and journaled, and the
+*              file is saved in the current directory
+**/
+int FtpUtil::RunWget(std::string cmd, const ftpopt_t* fopt, std::string xfile, bool cacheable)
+{
+    std::string url, accept;
+    ParseWget(cmd, url, accept);
+    std::string localfile = url.substr(url.find_last_of('/') + 1);
+    bool isexact = accept.empty() && !localfile.empty() && localfile.find_first_of("*?") == std::string::npos &&
+        cmd.find(" -O ") == std::string::npos && cmd.find("://") == cmd.rfind("://");
+
+    /* the state transitions of one exactly-known file are journaled for the resumption after a crash */
+    std::string key = isexact ? GetCwdFile(localfile) : "";
+    if (!key.empty()) journal_.SetState(key, JOB_FETCHING);
+    int xstat = XFER_OK, nretry0 = nretry_;
+    auto tstart = std::chrono::steady_clock::now();
+    xfer_.url = url;
+    xfer_.source = "remote";
+    if (cmd.find(" file://") != std::string::npos)
+    {
+        /* the local mirror is read directly */
+        xfer_.source = "mirror";
+        std::string active = MetricsUtil::Series("good_active_transfers", { { "host", "mirror" } });
+        ProfUtil::tick_t t0 = ProfUtil::Tic();
+        MetricsUtil::Add(active, 1.0);
+        xstat = GetLocalFile(cmd);
+        MetricsUtil::Add(active, -1.0);
+        ProfUtil::Toc(PROF_TRANSFER, t0, url);
+    }
+    else
+    {
+        std::string cachefile = (cacheable && accept.empty()) ? cache_.GetPath(url) : "";
+        if (cachefile.empty()) xstat = PartWget(cmd, fopt, xfile, isexact ? localfile : "");
+        else
+        {
+            /* the other instances requesting the same file wait here until it is downloaded and cached */
+            cache_.Lock(cachefile);
+            ProfUtil::tick_t t0 = ProfUtil::Tic();
+            bool ishit = access(cachefile.c_str(), 0) == 0 && LinkFile(cachefile, localfile);
+            MetricsUtil::Add(MetricsUtil::Series("good_cache_requests_total", { { "result", ishit ? "hit" : "miss" } }), 1.0);
+            if (ishit)
+            {
+                xfer_.source = "cache";
+                cache_.Touch(cachefile);
+                ProfUtil::Toc(PROF_FS, t0, cachefile);
+            }
+            else
+            {
+                xstat = PartWget(cmd, fopt, xfile, isexact ? localfile : "");
+                if (xstat == XFER_OK && access(localfile.c_str(), 0) == 0)
+                {
+                    /* the file is published into the cache atomically */
+                    std::string tmpfile = cachefile + ".tmp";
+                    cache_.Prepare(cachefile);
+                    if (LinkFile(localfile, tmpfile) && std::rename(tmpfile.c_str(), cachefile.c_str()) != 0) std::remove(tmpfile.c_str());
+                }
+            }
+            cache_.Unlock();
+        }
+    }
+
+    /* the metrics are accumulated until the file is recorded in the log file, see LogXfer */
+    xfer_.tend = std::chrono::steady_clock::now();
+    double xfersec = std::chrono::duration<double>(xfer_.tend - tstart).count();
+    xfer_.xfersec += xfersec;
+    xfer_.retries += nretry_ - nretry0;
+    xfer_.xstat = xstat;
+    struct stat st;
+    bool isgot = isexact && xstat == XFER_OK && stat(localfile.c_str(), &st) == 0;
+    if (isgot && xfer_.source == "remote") xfer_.wirebytes += (double)st.st_size;
+
+    /* the bytes per second of each host (or the mirror) is the ratio of the two counters */
+    std::vector<std::pair<std::string, std::string>> labels = { { "host", xfer_.source == "mirror" ? "mirror" : GetHost(url) },
+        { "source", xfer_.source } };
+    if (isgot) MetricsUtil::Add(MetricsUtil::Series("good_transfer_bytes_total", labels), (double)st.st_size);
+    MetricsUtil::Add(MetricsUtil::Series("good_transfer_seconds_total", labels), xfersec);
+
+    if (!key.empty())
+    {
+        if (xstat == XFER_OK && access(localfile.c_str(), 0) == 0)
+        {
+            journal_.SetState(key, JOB_FETCHED);
+            fetched_.push_back(key);
+        }
+        else journal_.SetState(key, JOB_PLANNED);
+    }
+
+    return xstat;
+} /* end of RunWget */
+
+/**
+* @brief   : PartWget - to run one 'wget' command of one exactly-known file into the '*.part' file, which is renamed to the
+*              file only when the transfer is complete, so that the interrupted transfer is resumed by 'wget -c' next time
+* @param[I]: cmd ('wget' command line)
+* @param[I]: fopt (FTP options)
+* @param[I]: xfile (local file to be tested for integrity after the transfer, empty: NOT tested)
+* @param[I]: localfile (local file in the current directory, empty: the 'wget' command is run as it is)
+* @param[O]: none
+* @return  : class of the transfer outcome (XFER_*)
+* @note    : the recursive retrieval is run in a directory prefix of this process, see MoveOut. The '*.part' file is NOT
+*              resumed if the validators of the remote file differ from those stored for it, see GetValidators
+**/
+int FtpUtil::PartWget(std::string cmd, const ftpopt_t* fopt, std::string xfile, std::string localfile)
+{
+    if (localfile.empty())
+    {
+        if ((" " + cmd + " ").find(" -r ") == std::string::npos) return RetryWget(cmd, fopt, xfile);
+
+        std::string sep;
+        sep.push_back((char)FILEPATHSEP);
+        std::string tmpdir = ".wget." + std::to_string(getpid()) + ".d";
+        int xstat = RetryWget(cmd + " -P " + tmpdir, fopt, xfile.empty() ? "" : tmpdir + sep + xfile);
+        MoveOut(tmpdir, "");
+
+        return xstat;
+    }
+
+    /* the validators of the remote file are stored for the partial payload, i.e., 'igs20.atx.part' */
+    std::string partfile = localfile + ".part", url, accept, vlds;
+    ParseWget(cmd, url, accept);
+    struct stat st;
+    if (stat(partfile.c_str(), &st) == 0)
+    {
+        std::string vlds0 = GetStoredValidators(partfile);
+
+        /* the partial payload of a remote file changed since (or shorter than it) is NOT resumed, see GetValidators */
+        bool isstale = false;
+        if (GetValidators(url, fopt, vlds))
+        {
+            std::string::size_type ipos = vlds.find("Size: ");
+            double size = (ipos == std::string::npos) ? -1.0 : atof(vlds.c_str() + ipos + 6);
+            isstale = vlds0.empty() ? (size >= 0.0 && size < (double)st.st_size) : vlds != vlds0;
+        }
+        if (isstale)
+        {
+            Logger::Trace(TINFO, "*** INFO(FtpUtil::PartWget): " + localfile + " has been changed on the remote server, restart the transfer");
+            std::remove(partfile.c_str());
+        }
+        else Logger::Trace(TINFO, "*** INFO(FtpUtil::PartWget): resume the transfer of " + partfile);
+    }
+    /* the file is got by one direct GET, i.e., without the recursive retrieval ('-r') of the options of 'wget' */
+    std::string gcmd = " " + cmd + " ", sumurl = fopt->checksum ? url : "";
+    for (std::string::size_type ipos = gcmd.find(" -r "); ipos != std::string::npos; ipos = gcmd.find(" -r ")) gcmd.erase(ipos, 3);
+    CString::trim(gcmd);
+    int xstat = RetryWget(gcmd + " -c -O " + partfile, fopt, xfile.empty() ? "" : partfile, sumurl.empty() ? "" : partfile, sumurl);
+
+    bool ispart = stat(partfile.c_str(), &st) == 0;
+    if (xstat == XFER_OK && ispart)
+    {
+        std::remove(localfile.c_str());
+        if (std::rename(partfile.c_str(), localfile.c_str()) != 0) xstat = XFER_ERROR;
+    }
+    /* 'wget -O' leaves an empty file if the remote file is NOT found, and only the partial payload is kept for resuming */
+    else if (ispart && (xstat == XFER_NOTFOUND || xstat == XFER_AUTH || st.st_size == 0)) std::remove(partfile.c_str());
+    else if (ispart && (!vlds.empty() || GetValidators(url, fopt, vlds))) StoreValidators(partfile, vlds);
+    if (access(partfile.c_str(), 0) == -1 && !GetStoredValidators(partfile).empty()) StoreValidators(partfile, "");
+
+    return xstat;
+} /* end of PartWget */
+
+/**
+* @brief   : MoveOut - to move the files retrieved into one directory prefix ('-P') of 'wget' to the current directory with
+*              their relative paths, and remove the directory prefix with the '.listing' files in it
+* @param[I]: dir (directory prefix, relative to the current directory)
+* @param[I]: sub (relative path under the directory prefix, empty: the top)
+* @param[O]: none
+* @return  : none
+* @note    : the name of '.listing' is fixed by 'wget', so the processes working in the same directory (i.e., the jobs of
+*              the backfill mode) run 'wget' in directory prefixes of their own to NOT overwrite each other's listing
+**/
+void FtpUtil::MoveOut(std::string dir, std::string sub)
+{
+    std::string sep;
+    sep.push_back((char)FILEPATHSEP);
+    std::string path = sub.empty() ? dir : dir + sep + sub;
+#ifdef _WIN32   /* for Windows */
+    WIN32_FIND_DATAA fd;
+    HANDLE hfind = FindFirstFileA((path + "\\*").c_str(), &fd);
+    if (hfind != INVALID_HANDLE_VALUE)
+    {
+        do
+        {
+            std::string name = fd.cFileName;
+            if (name == "." || name == "..") continue;
+            std::string rel = sub.empty() ? name : sub + sep + name, src = dir + sep + rel;
+            if (fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+            {
+                if (access(rel.c_str(), 0) == -1) _mkdir(rel.c_str());
+                MoveOut(dir, rel);
+                _rmdir(src.c_str());
+            }
+            else if (name == ".listing") std::remove(src.c_str());
+            else
+            {
+                std::remove(rel.c_str());
+                if (std::rename(src.c_str(), rel.c_str()) != 0) std::remove(src.c_str());
+            }
+        } while (FindNextFileA(hfind, &fd));
+        FindClose(hfind);
+    }
+    if (sub.empty()) _rmdir(dir.c_str());
+#else           /* for Linux or Mac */
+    DIR* dp = opendir(path.c_str());
+    if (dp != NULL)
+    {
+        struct dirent* ep;
+        while ((ep = readdir(dp)) != NULL)
+        {
+            std::string name = ep->d_name;
+            if (name == "." || name == "..") continue;
+            std::string rel = sub.empty() ? name : sub + sep + name, src = dir + sep + rel;
+            struct stat st;
+            if (lstat(src.c_str(), &st) != 0) continue;
+            if (S_ISDIR(st.st_mode))
+            {
+                if (access(rel.c_str(), 0) == -1) mkdir(rel.c_str(), 0775);
+                MoveOut(dir, rel);
+                rmdir(src.c_str());
+            }
+            else if (name == ".listing") std::remove(src.c_str());
+            else if (std::rename(src.c_str(), rel.c_str()) != 0) std::remove(src.c_str());
+        }
+        closedir(dp);
+    }
+    if (sub.empty()) rmdir(dir.c_str());
+#endif
+} /* end of MoveOut */
+
+/**
+* @brief   : GetCwdFile - to get the full path of one file in the current directory
+* @param[I]: file (file name)
+* @param[O]: none
+* @return  : file with full path
+* @note    :
+**/
+std::string FtpUtil::GetCwdFile(std::string file)
+{
+    char cwd[MAXSTRPATH] = { '\0' };
+#ifdef _WIN32   /* for Windows */
+    if (_getcwd(cwd, MAXSTRPATH) == NULL) return file;
+#else           /* for Linux or Mac */
+    if (getcwd(cwd, MAXSTRPATH) == NULL) return file;
+#endif
+
+    return std::string(cwd) + (char)FILEPATHSEP + file;
+} /* end of GetCwdFile */
+
+/**
+* @brief   : IsCommitted - to check whether one file has been committed in the file journal by the last runs
+* @param[I]: localfile (local file with full path, as it is recorded by LogXfer)
+* @param[O]: none
+* @return  : true: committed, i.e., it is skipped without any existence check or remote access, false: NOT committed
+* @note    : the file moved aside by the run manifest is planned again by Resume
+**/
+bool FtpUtil::IsCommitted(std::string localfile)
+{
+    return journal_.GetState(localfile) == JOB_COMMITTED;
+} /* end of IsCommitted */
+
+/**
+* @brief   : GetStateDir - to get one directory of the states kept across the runs in 'logDir', which is created if needed
+* @param[I]: name (name of the directory, i.e., "listings")
+* @param[O]: none
+* @return  : the directory with full path
+* @note    : the product directories hold only the products
+**/
+std::string FtpUtil::GetStateDir(std::string name)
+{
+    std::string statedir = logdir_ + (char)FILEPATHSEP + name;
+    if (access(statedir.c_str(), 0) == -1)
+    {
+        /* If the directory does not exist, creat it */
+#ifdef _WIN32   /* for Windows */
+        std::string cmd = "mkdir " + statedir;
+#else           /* for Linux or Mac */
+        std::string cmd = "mkdir -p " + statedir;
+#endif
+        ProfUtil::System(cmd);
+    }
+
+    return statedir;
+} /* end of GetStateDir */
+
+/**
+* @brief   : GetFile - to get the full name of a specific file from one directory, see CString::GetFile
+* @param[I]: dir (the directory)
+* @param[I]: str (string to match)
+* @param[O]: filename (the full name of a specific file)
+* @return  : true: found, false: NOT found
+* @note    : the scan is counted in the file system operations of the profile
+**/
+bool FtpUtil::GetFile(std::string dir, std::string str, std::string& filename)
+{
+    ProfUtil::tick_t t0 = ProfUtil::Tic();
+    bool stat = CString::GetFile(dir, str, filename);
+    ProfUtil::Toc(PROF_FS, t0, "*" + str + "*");
+
+    return stat;
+} /* end of GetFile */
+
+/**
+* @brief   : GetFilesAll - to get the name list of all the files from one directory, see CString::GetFilesAll
+* @param[I]: dir (the directory)
+* @param[I]: str (string to match)
+* @param[O]: files (the name list of all the files)
+* @return  : none
+* @note    : the scan is counted in the file system operations of the profile
+**/
+void FtpUtil::GetFilesAll(std::string dir, std::string str, std::vector<std::string>& files)
+{
+    ProfUtil::tick_t t0 = ProfUtil::Tic();
+    CString::GetFilesAll(dir, str, files);
+    ProfUtil::Toc(PROF_FS, t0, dir + "/*" + str + "*");
+} /* end of GetFilesAll */
+
+/**
+* @brief   : LogXfer - to record the outcome of one file in the log file, with the metrics of its transfers
+* @param[I]: func (function, i.e., "GetOrbClk")
+* @param[I]: url (URL, or the other source of the file)
+* @param[I]: localfile (local file with full path)
+* @param[I]: isok (true: got, false: failed)
+* @param[I]: note (the other information, empty: none)
+* @param[O]: none
+* @return  : none
+* @note    : one JSON object per line (JSON Lines), i.e., the time, the host and source ("remote", "cache", "mirror", or
+*              "none" if nothing is transferred), the bytes on the wire and decoded, the transfer and decompression/conversion
+*              times (s), the retries, and the outcomes of the last transfer and the file. The records are buffered, and
+*              only the whole lines are written, so that the records of the concurrent processes are NOT interleaved
+**/
+void FtpUtil::LogXfer(std::string func, std::string url, std::string localfile, bool isok, std::string note)
+{
+    std::vector<std::string> xnames = { "OK", "not-found", "authentication failure", "throttled", "transient network failure",
+        "corrupt payload", "error" };
+    bool isxfer = xfer_.xstat >= 0;
+    double decsec = isxfer ? std::chrono::duration<double>(std::chrono::steady_clock::now() - xfer_.tend).count() : 0.0;
+    struct stat st;
+    double decbytes = (isok && stat(localfile.c_str(), &st) == 0) ? (double)st.st_size : 0.0;
+
+    /* the remote host, i.e., 'gdc.cddis.eosdis.nasa.gov' */
+    std::string host = GetHost(isxfer ? xfer_.url : url);
+
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    ss << "{\"time\":\"" << GTime::time2str(GTime::now()).substr(0, 19) << "\",\"func\":\"" << func << "\",\"url\":\"" <<
+        CString::EscapeJson(url) << "\",\"host\":\"" << CString::EscapeJson(host) << "\",\"source\":\"" <<
+        (isxfer ? xfer_.source : "none") << "\",\"local\":\"" << CString::EscapeJson(localfile) << "\",\"wire_bytes\":" <<
+        std::setprecision(0) << xfer_.wirebytes << ",\"decoded_bytes\":" << decbytes << std::setprecision(3) <<
+        ",\"xfer_s\":" << xfer_.xfersec << ",\"decode_s\":" << decsec << ",\"retries\":" << xfer_.retries <<
+        ",\"xfer_status\":\"" << (isxfer ? xnames[xfer_.xstat] : "none") << "\",\"status\":\"" << (isok ? "ok" : "failed") << "\"";
+    if (!xfer_.checksum.empty()) ss << ",\"checksum\":\"" << xfer_.checksum << "\"";
+    if (!note.empty()) ss << ",\"note\":\"" << CString::EscapeJson(note) << "\"";
+    ss << "}\n";
+
+    logbuf_ += ss.str();
+    if (logbuf_.size() >= 65536) FlushLog();
+    if (!isok) nfailed_++;
+
+    /* the file fetched is decoded once its product is recorded as OK, i.e., right after the uncompress and convert step */
+    if (isok && url.find_first_of("*?") == std::string::npos)
+    {
+        std::string key = GetCwdFile(url.substr(url.find_last_of('/') + 1));
+        if (journal_.GetState(key) == JOB_FETCHED) journal_.SetState(key, JOB_DECODED);
+    }
+    /* the product is committed with the files fetched, so that it is skipped by the next runs, see IsCommitted */
+    if (isok && journal_.GetState(localfile) != JOB_COMMITTED)
+    {
+        journal_.SetState(localfile, JOB_DECODED);
+        fetched_.push_back(localfile);
+    }
+
+    /* the file materialized from one source is recorded in the run manifest */
+    std::string family = ProfUtil::Family();
+    if (isok && (isxfer || url.find("://") != std::string::npos))
+    {
+        ManifestUtil::Add(localfile, url, xfer_.source == "mirror" ? "mirror" : host, isxfer ? xfer_.source : "none",
+            TierOf(family, localfile));
+    }
+    xfer_ = xfer_t();
+
+    MetricsUtil::Add(MetricsUtil::Series("good_files_total", { { "family", family }, { "status", isok ? "ok" : "failed" } }), 1.0);
+    if (isok) MetricsUtil::Max(MetricsUtil::Series("good_newest_product_timestamp_seconds", { { "family", family } }), tprod_);
+    MetricsUtil::Write();
+} /* end of LogXfer */
+
+/**
+* @brief   : TierOf - to get the product tier of one file for the run manifest
+* @param[I]: family (product family, i.e., "obs_igs", "nav", "orbclk_cod")
+* @param[I]: localfile (local file with full path)
+* @param[O]: none
+* @return  : "final", "rapid", "ultra-rapid", "real-time", "data" (observations and broadcast ephemerides), or "unknown"
+* @note    : the tier of the long file names is the content type (i.e., 'FIN' of 'IGS0OPSFIN_20240010000_01D_15M_ORB.SP3'),
+*              and the one of the short names of the precise orbit and clock products is the one of the analysis center
+**/
+std::string FtpUtil::TierOf(std::string family, std::string localfile)
+{
+    std::vector<std::string> tiers = { "unknown", "real-time", "ultra-rapid", "rapid", "final", "final" };
+    if (family.compare(0, 4, "obs_") == 0 || family == "nav") return "data";
+
+    std::string name = localfile.substr(localfile.find_last_of("/\\") + 1);
+    if (name.size() > 22 && name[10] == '_' && name[22] == '_')
+    {
+        std::string type = name.substr(7, 3);
+        CString::ToUpper(type);
+        if (type == "FIN") return "final";
+        if (type == "RAP") return "rapid";
+        if (type == "ULT") return "ultra-rapid";
+        if (type == "RTS" || type == "NRT") return "real-time";
+    }
+    if (family.compare(0, 7, "orbclk_") == 0) return tiers[GetProdType(family.substr(7))];
+    if (family == "general") return "unknown";
+
+    return "final";
+} /* end of TierOf */
+
+/**
+* @brief   : FlushLog - to write the buffered records to the log file
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void FtpUtil::FlushLog()
+{
+    if (fplog_.is_open() && !logbuf_.empty())
+    {
+        fplog_.write(logbuf_.c_str(), logbuf_.size());
+        fplog_.flush();
+    }
+    logbuf_.clear();
+} /* end of FlushLog */
+
+/**
+* @brief   : RetryWget - to run one 'wget' command with the retry policy, i.e., the failure is classified, and only the
+*              transient, throttled or corrupt ones are retried with jittered exponential backoff within the retry budget
+* @param[I]: cmd ('wget' command line)
+* @param[I]: fopt (FTP options)
+* @param[I]: xfile (local file to be tested for integrity after the transfer, empty: NOT tested)
+* @param[I]: sumfile (local file to be verified against the checksum after the transfer, empty: NOT verified)
+* @param[I]: sumurl (URL of the remote file whose checksum is published, see GetChecksum)
+* @param[O]: none
+* @return  : class of the transfer outcome (XFER_*)
+* @note    : 'wget' itself is run with '--tries=1' so that all retries are counted in the retry budget. The file mismatching
+*              its checksum is removed and retried as a corrupt payload, and the file without any checksum published is
+*              accepted as before
+**/
+int FtpUtil::RetryWget(std::string cmd, const ftpopt_t* fopt, std::string xfile, std::string sumfile, std::string sumurl)
+{
+    /* the output of 'wget' is kept in a log file for the classification of failures */
+    std::string wgetlog = ".wget." + std::to_string(getpid()) + ".log";
+    cmd = Redirect(cmd, fopt) + " --tries=1 -o " + wgetlog;
+
+    std::vector<std::string> xnames = { "OK", "not-found", "authentication failure", "throttled", "transient network failure",
+        "corrupt payload", "error" };
+    std::string url, accept;
+    ParseWget(cmd, url, accept);
+    std::string active = MetricsUtil::Series("good_active_transfers", { { "host", GetHost(url) } });
+    int xstat = XFER_OK;
+    for (int itry = 0; ; itry++)
+    {
+        MetricsUtil::Add(active, 1.0);
+        int stat = ProfUtil::System(cmd);
+        MetricsUtil::Add(active, -1.0);
+
+        std::string msg, line;
+        std::ifstream fp(wgetlog.c_str());
+        while (fp.is_open() && getline(fp, line)) msg += line + "\n";
+        if (fp.is_open()) fp.close();
+        std::remove(wgetlog.c_str());
+        if (fopt->printinfo4wget) std::cout << msg;
+
+        xstat = ClassifyWget(stat, msg);
+        std::string cfile = sumfile.empty() ? xfile : sumfile;
+        if (xstat == XFER_OK && !cfile.empty() && access(cfile.c_str(), 0) == 0)
+        {
+            /* the checksum file is fetched only when one file of its directory is got */
+            std::string sum = sumfile.empty() ? "" : GetChecksum(sumurl, fopt, false), digest;
+            std::string::size_type ipos = sum.find(':');
+            int algo = ipos == std::string::npos ? -1 : Digest::Algo(sum.substr(0, ipos));
+            bool isok = CheckFile(cfile, !xfile.empty(), algo, fopt, digest), ismatch = true;
+            if (isok && algo >= 0 && digest != sum.substr(ipos + 1))
+            {
+                /* the checksum file kept by the last runs may be older than the file republished */
+                ismatch = GetChecksum(sumurl, fopt, true) == sum.substr(0, ipos + 1) + digest;
+                if (!ismatch) Logger::Trace(TWARNING, "*** WARNING(FtpUtil::RetryWget): the " + sum.substr(0, ipos) +
+                    " checksum of " + sumurl + " mismatches the one published");
+            }
+            if (!sumfile.empty())
+            {
+                std::string result = algo < 0 ? "unpublished" : (!isok ? "corrupt" : (ismatch ? "ok" : "mismatch"));
+                MetricsUtil::Add(MetricsUtil::Series("good_checksum_total", { { "result", result } }), 1.0);
+            }
+            if (!isok || !ismatch)
+            {
+                xstat = XFER_CORRUPT;
+                std::remove(cfile.c_str());
+            }
+            else if (algo >= 0) xfer_.checksum = sum.substr(0, ipos);
+        }
+
+        /* the permanent failures are dropped immediately */
+        if (xstat == XFER_OK || xstat == XFER_NOTFOUND || xstat == XFER_AUTH || xstat == XFER_ERROR) break;
+        if (itry >= fopt->retrymax) break;
+        if (nretry_ >= fopt->retrybudget)
+        {
+            if (!budgetout_) Logger::Trace(TWARNING, "*** WARNING(FtpUtil::RetryWget): the retry budget (" +
+                std::to_string(fopt->retrybudget) + ") of this run is used up, no more retries");
+            budgetout_ = true;
+            break;
+        }
+
+        /* jittered exponential backoff, i.e., a random waiting time in [0.5, 1.0] * base * 2^itry (four times longer if throttled) */
+        double wait = fopt->retrywait * (double)(1 << std::min(itry, 10));
+        if (xstat == XFER_THROTTLED) wait *= 4.0;
+        wait = std::min(wait, 600.0) * std::uniform_real_distribution<double>(0.5, 1.0)(rng_);
+        nretry_++;
+
+        std::ostringstream ss;
+        ss << std::fixed << std::setprecision(1) << wait;
+        Logger::Trace(TWARNING, "*** WARNING(FtpUtil::RetryWget): " + xnames[xstat] + ", retry " + std::to_string(itry + 1) +
+            "/" + std::to_string(fopt->retrymax) + " in " + ss.str() + "s");
+#ifdef _WIN32   /* for Windows */
+        Sleep((DWORD)(wait * 1000.0));
+#else           /* for Linux or Mac */
+        usleep((useconds_t)(wait * 1.0e6));
+#endif
+    }
+
+    return xstat;
+} /* end of RetryWget */
+
+/**
+* @brief   : CheckFile - to test the integrity of one file transferred and get its digest in one pass of reading
+* @param[I]: file (local file)
+* @param[I]: istest (true: tested by 'gzip -t')
+* @param[I]: algo (algorithm of the digest, DIGEST_*, -1: no digest)
+* @param[I]: fopt (FTP options)
+* @param[O]: digest (digest in lowercase hexadecimal, empty if NOT computed)
+* @return  : true: intact, false: corrupt or NOT readable
+* @note    : the bytes read for the digest are fed to 'gzip -t' through a pipe, so the file just transferred is read only
+*              once (while it is still in the page cache) for both the test and the checksum
+**/
+bool FtpUtil::CheckFile(std::string file, bool istest, int algo, const ftpopt_t* fopt, std::string& digest)
+{
+    digest.clear();
+    if (algo < 0)
+    {
+        if (!istest) return true;
+
+        /* through the standard input, so that the '*.part' file is tested regardless of its suffix */
+        std::string xcmd = fopt->gzipfull + " -t < " + file;
+        return ProfUtil::System(xcmd) == 0;
+    }
+
+    FILE* fp = fopen(file.c_str(), "rb");
+    if (fp == NULL) return false;
+    ProfUtil::tick_t t0 = ProfUtil::Tic();
+    FILE* fpz = NULL;
+    if (istest)
+    {
+        std::string xcmd = fopt->gzipfull + " -t";
+        Logger::Flush();
+#ifdef _WIN32   /* for Windows */
+        fpz = _popen(xcmd.c_str(), "wb");
+#else           /* for Linux or Mac */
+        fpz = popen(xcmd.c_str(), "w");
+#endif
+    }
+#ifndef _WIN32
+    /* 'gzip' exits at the first error, and the broken pipe must NOT kill this process */
+    void (*sigpipe)(int) = signal(SIGPIPE, SIG_IGN);
+#endif
+
+    Digest::hash_t st;
+    Digest::Init(st, algo);
+    std::vector<char> buff(DIGEST_BUFSIZE);
+    size_t n;
+    bool isok = !istest || fpz != NULL;
+    while ((n = fread(buff.data(), 1, buff.size(), fp)) > 0)
+    {
+        Digest::Update(st, buff.data(), n);
+        if (fpz != NULL && isok && fwrite(buff.data(), 1, n, fpz) != n) isok = false;
+    }
+    if (ferror(fp) != 0) isok = false;
+    fclose(fp);
+    if (fpz != NULL)
+    {
+#ifdef _WIN32   /* for Windows */
+        if (_pclose(fpz) != 0) isok = false;
+#else           /* for Linux or Mac */
+        if (pclose(fpz) != 0) isok = false;
+#endif
+    }
+#ifndef _WIN32
+    signal(SIGPIPE, sigpipe);
+#endif
+    digest = Digest::Final(st);
+    ProfUtil::Toc(PROF_VERIFY, t0, file);
+
+    return isok;
+} /* end of CheckFile */
+
+/**
+* @brief   : GetChecksum - to get the checksum of one remote file from the checksum file published in its directory
+* @param[I]: url (URL of the remote file)
+* @param[I]: fopt (FTP options)
+* @param[I]: isfresh (true: the checksum file is fetched again unless it has been fetched by this process)
+* @param[O]: none
+* @return  : checksum, i.e., 'sha512:<hex>' or 'md5:<hex>', empty if it is NOT published
+* @note    : the checksums of each remote directory are kept in 'checksums' of 'logDir' (NOT in the product directory),
+*              so the checksum file is fetched once for all the files of the directory, and again only for the file NOT
+*              listed in it (i.e., published later) or mismatching it
+**/
+std::string FtpUtil::GetChecksum(std::string url, const ftpopt_t* fopt, bool isfresh)
+{
+    std::string::size_type ipos = url.find_last_of('/');
+    if (ipos == std::string::npos || url.find("://") == std::string::npos) return "";
+    std::string dir = url.substr(0, ipos), name = url.substr(ipos + 1);
+
+    std::ostringstream sname;
+    sname << GetStateDir("checksums") << (char)FILEPATHSEP << "sums_" << std::hex << std::hash<std::string>()(dir);
+    std::string sumsfile = sname.str();
+    if (sums_.find(dir) == sums_.end())
+    {
+        /* the checksums kept in the product directory by the older versions are taken over */
+        std::ostringstream soldname;
+        soldname << ".sums_" << std::hex << std::hash<std::string>()(dir);
+        std::string oldfile = soldname.str();
+        if (access(sumsfile.c_str(), 0) == -1 && access(oldfile.c_str(), 0) == 0) std::rename(oldfile.c_str(), sumsfile.c_str());
+        std::remove(oldfile.c_str());
+
+        std::map<std::string, std::string>& sums = sums_[dir];
+        std::ifstream fp(sumsfile.c_str());
+        std::string file, sum;
+        while (fp.is_open() && fp >> file >> sum) sums[file] = sum;
+        if (fp.is_open()) fp.close();
+    }
+
+    std::map<std::string, std::string>& sums = sums_[dir];
+    if ((isfresh || sums.find(name) == sums.end()) && sumdirs_.find(dir) == sumdirs_.end())
+    {
+        sumdirs_.insert(dir);
+        std::map<std::string, std::string> fresh;
+        if (FetchChecksums(dir, fopt, fresh))
+        {
+            sums.swap(fresh);
+
+            /* the checksums are replaced atomically, since the other processes may fetch them meanwhile */
+            std::string tmpfile = sumsfile + "." + std::to_string(getpid()) + ".tmp";
+            std::ofstream fpout(tmpfile.c_str());
+            for (auto it = sums.begin(); it != sums.end(); ++it) fpout << it->first << " " << it->second << "\n";
+            fpout.close();
+#ifdef _WIN32   /* for Windows */
+            std::remove(sumsfile.c_str());
+#endif
+            if (std::rename(tmpfile.c_str(), sumsfile.c_str()) != 0) std::remove(tmpfile.c_str());
+        }
+    }
+
+    auto it = sums.find(name);
+    return it == sums.end() ? "" : it->second;
+} /* end of GetChecksum */
+
+/**
+* @brief   : FetchChecksums - to fetch and parse the checksum file of one remote directory, i.e., 'SHA512SUMS' or 'MD5SUMS'
+* @param[I]: dir (remote directory)
+* @param[I]: fopt (FTP options)
+* @param[O]: sums (checksum per file name, i.e., 'sha512:<hex>')
+* @return  : true: got, false: NOT published or NOT reachable
+* @note    : one '<hex>  <file>' (or '<hex> *<file>') per line, as written by 'sha512sum' or 'md5sum'. The retries of the
+*              checksum file are NOT counted in the retry budget nor in the record of the file it verifies
+**/
+bool FtpUtil::FetchChecksums(std::string dir, const ftpopt_t* fopt, std::map<std::string, std::string>& sums)
+{
+    sums.clear();
+    std::vector<std::pair<std::string, std::string>> names = { { "SHA512SUMS", "sha512" }, { "MD5SUMS", "md5" } };
+    std::string tmpfile = GetStateDir("checksums") + (char)FILEPATHSEP + "sums." + std::to_string(getpid()) + ".tmp";
+    for (size_t i = 0; i < names.size() && sums.empty(); i++)
+    {
+        std::remove(tmpfile.c_str());
+        std::string cmd = fopt->wgetfull + " -nv -O " + tmpfile + " " + dir + "/" + names[i].first;
+        xfer_t xfer0 = xfer_;
+        int nretry0 = nretry_;
+        int xstat = RetryWget(cmd, fopt, "");
+        xfer_ = xfer0;
+        nretry_ = nretry0;
+
+        size_t nhex = names[i].second == "md5" ? 32 : 128;
+        std::ifstream fp(tmpfile.c_str());
+        std::string line;
+        while (xstat == XFER_OK && fp.is_open() && getline(fp, line))
+        {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.size() < nhex + 2 || line.find_first_not_of("0123456789abcdefABCDEF") != nhex) continue;
+            std::string hex = line.substr(0, nhex), file = line.substr(nhex);
+            CString::trim(file);
+            if (!file.empty() && file[0] == '*') file = file.substr(1);
+            file = file.substr(file.find_last_of('/') + 1);
+            CString::ToLower(hex);
+            if (!file.empty()) sums[file] = names[i].second + ":" + hex;
+        }
+        if (fp.is_open()) fp.close();
+
+        /* the other checksum file is NOT tried if the server can NOT be reached */
+        if (xstat != XFER_OK && xstat != XFER_NOTFOUND) break;
+    }
+    std::remove(tmpfile.c_str());
+
+    return !sums.empty();
+} /* end of FetchChecksums */
+
+/**
+* @brief   : ParseWget - to get the URL and the accept list of one 'wget' command
+* @param[I]: cmd ('wget' command line)
+* @param[O]: url (URL)
+* @param[O]: accept (accept list of '-A', empty if the URL is the file itself)
+* @return  : none
+* @note    :
+**/
+void FtpUtil::ParseWget(std::string cmd, std::string& url, std::string& accept)
+{
+    url.clear();
+    accept.clear();
+    std::vector<std::string> args = CString::split(cmd, " ");
+    for (size_t i = 0; i < args.size(); i++)
+    {
+        if (args[i].find("://") != std::string::npos && args[i][0] != '"') url = args[i];
+        else if (args[i] == "-A" && i + 1 < args.size()) accept = args[i + 1];
+    }
+} /* end of ParseWget */
+
+/**
+* @brief   : GetHost - to get the host of one URL, i.e., 'ftps://gdc.cddis.eosdis.nasa.gov/pub/x.gz' -> 'gdc.cddis.eosdis.nasa.gov'
+* @param[I]: url (URL)
+* @param[O]: none
+* @return  : host, empty if it is NOT a URL
+* @note    :
+**/
+std::string FtpUtil::GetHost(std::string url)
+{
+    std::string::size_type ipos = url.find("://");
+    if (ipos == std::string::npos) return "";
+    url = url.substr(ipos + 3);
+
+    return url.substr(0, url.find('/'));
+} /* end of GetHost */
+
+/**
+* @brief   : Redirect - to redirect the URLs of one 'wget' command to the servers of 'redirect', i.e.,
+*              'ftp://igs.ign.fr/pub/x' -> 'ftp://127.0.0.1:2121/igs.ign.fr/pub/x'
+* @param[I]: cmd ('wget' command line)
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : 'wget' command line redirected
+* @note    : the original host becomes the first directory on the redirected server, so '--cut-dirs' is increased by one
+*              for the recursive retrieval. The URLs are redirected only here, so the shared cache, the journal and the log
+*              still see the original ones
+**/
+std::string FtpUtil::Redirect(std::string cmd, const ftpopt_t* fopt)
+{
+    if (fopt->redirect.empty()) return cmd;
+
+    std::map<std::string, std::string> servers;
+    std::vector<std::string> rules = CString::split(fopt->redirect, " ");
+    for (size_t i = 0; i < rules.size(); i++)
+    {
+        std::string::size_type ipos = rules[i].find('=');
+        if (ipos != std::string::npos) servers[rules[i].substr(0, ipos)] = rules[i].substr(ipos + 1);
+    }
+
+    std::vector<std::string> args = CString::split(cmd, " ");
+    bool isredirected = false;
+    for (size_t i = 0; i < args.size(); i++)
+    {
+        std::string::size_type ipos = args[i].find("://");
+        if (ipos == std::string::npos || args[i][0] == '"') continue;
+        auto it = servers.find(args[i].substr(0, ipos));
+        if (it == servers.end()) continue;
+        args[i] = it->first + "://" + it->second + "/" + args[i].substr(ipos + 3);
+        isredirected = true;
+    }
+    if (!isredirected) return cmd;
+
+    bool iscut = false;
+    for (size_t i = 0; i < args.size(); i++)
+    {
+        if (args[i].compare(0, 11, "--cut-dirs=") != 0) continue;
+        args[i] = "--cut-dirs=" + std::to_string(atoi(args[i].substr(11).c_str()) + 1);
+        iscut = true;
+    }
+    std::string xcmd;
+    for (size_t i = 0; i < args.size(); i++) xcmd += (i == 0 ? "" : " ") + args[i];
+    if (!iscut && std::find(args.begin(), args.end(), "-r") != args.end() && std::find(args.begin(), args.end(), "-nH") != args.end())
+    {
+        xcmd += " --cut-dirs=1";
+    }
+
+    return xcmd;
+} /* end of Redirect */
+
+/**
+* @brief   : GetLocalFile - to materialize the file(s) of one 'wget' command from the local mirror (file://) into the
+*              current directory, instead of running 'wget'
+* @param[I]: cmd ('wget' command line with 'file://' URL)
+* @param[O]: none
+* @return  : class of the transfer outcome (XFER_*)
+* @note    : the accept list of '-A' is matched in the mirror directory, otherwise the URL is the file itself
+**/
+int FtpUtil::GetLocalFile(std::string cmd)
+{
+    std::string path, accept;
+    ParseWget(cmd, path, accept);
+    if (path.compare(0, 7, "file://") != 0) return XFER_ERROR;
+    path = path.substr(7);
+
+    std::vector<std::string> srcs;
+    if (accept.empty()) srcs.push_back(path);
+    else
+    {
+        std::vector<std::string> pats = CString::split(accept, ",");
+#ifdef _WIN32   /* for Windows */
+        for (size_t i = 0; i < pats.size(); i++)
+        {
+            WIN32_FIND_DATAA fd;
+            HANDLE hfind = FindFirstFileA((path + "\\" + pats[i]).c_str(), &fd);
+            if (hfind == INVALID_HANDLE_VALUE) continue;
+            do
+            {
+                if (!(fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) srcs.push_back(path + "\\" + fd.cFileName);
+            } while (FindNextFileA(hfind, &fd));
+            FindClose(hfind);
+        }
+#else           /* for Linux or Mac */
+        DIR* dp = opendir(path.c_str());
+        if (dp == NULL) return XFER_NOTFOUND;
+        struct dirent* ep;
+        while ((ep = readdir(dp)) != NULL)
+        {
+            for (size_t i = 0; i < pats.size(); i++)
+            {
+                if (fnmatch(pats[i].c_str(), ep->d_name, 0) == 0)
+                {
+                    srcs.push_back(path + "/" + ep->d_name);
+                    break;
+                }
+            }
+        }
+        closedir(dp);
+#endif
+    }
+
+    int nok = 0;
+    for (size_t i = 0; i < srcs.size(); i++)
+    {
+        std::string dst = srcs[i].substr(srcs[i].find_last_of("/\\") + 1);
+        if (access(srcs[i].c_str(), 0) == -1) continue;
+        if (LinkFile(srcs[i], dst)) nok++;
+        else Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetLocalFile): failed to materialize " + srcs[i] + " from the local mirror");
+    }
+
+    if (nok > 0 || (!accept.empty() && srcs.empty())) return XFER_OK;
+
+    return srcs.empty() || access(srcs[0].c_str(), 0) == -1 ? XFER_NOTFOUND : XFER_ERROR;
+} /* end of GetLocalFile */
+
+/**
+* @brief   : LinkFile - to materialize one file by hardlink, reflink, 'copy_file_range' or plain copy, in that order
+* @param[I]: src (source file)
+* @param[I]: dst (destination file)
+* @param[O]: none
+* @return  : true: successful, false: failed
+* @note    : the materialized file must NOT be modified in place, because it may share the data with the mirror
+**/
+bool FtpUtil::LinkFile(std::string src, std::string dst)
+{
+    /* the leftover of the last run is replaced */
+    if (access(dst.c_str(), 0) == 0) std::remove(dst.c_str());
+
+#ifdef _WIN32   /* for Windows */
+    if (CreateHardLinkA(dst.c_str(), src.c_str(), NULL)) return true;
+
+    return CopyFileA(src.c_str(), dst.c_str(), FALSE) != 0;
+#else           /* for Linux or Mac */
+    /* hardlink, only metadata is written if the mirror is on the same file system */
+    if (link(src.c_str(), dst.c_str()) == 0) return true;
+
+    int fdin = open(src.c_str(), O_RDONLY);
+    if (fdin < 0) return false;
+    struct stat st;
+    if (fstat(fdin, &st) != 0)
+    {
+        close(fdin);
+        return false;
+    }
+    int fdout = open(dst.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fdout < 0)
+    {
+        close(fdin);
+        return false;
+    }
+
+    bool stat = false;
+#ifdef FICLONE
+    /* reflink, the data blocks are shared on copy-on-write file systems (i.e., Btrfs, XFS) */
+    stat = ioctl(fdout, FICLONE, fdin) == 0;
+#endif
+#if defined(__linux__) && defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 27))
+    /* 'copy_file_range', the data is copied in kernel (or on the server for NFS 4.2) */
+    if (!stat)
+    {
+        off_t left = st.st_size;
+        while (left > 0)
+        {
+            ssize_t n = copy_file_range(fdin, NULL, fdout, NULL, (size_t)left, 0);
+            if (n <= 0) break;
+            left -= n;
+        }
+        stat = left == 0;
+        if (!stat)
+        {
+            lseek(fdin, 0, SEEK_SET);
+            lseek(fdout, 0, SEEK_SET);
+            if (ftruncate(fdout, 0) != 0) stat = false;
+        }
+    }
+#endif
+    /* plain copy */
+    if (!stat)
+    {
+        std::vector<char> buff(1 << 20);
+        ssize_t n = 0;
+        stat = true;
+        while ((n = read(fdin, buff.data(), buff.size())) > 0)
+        {
+            if (write(fdout, buff.data(), (size_t)n) != n)
+            {
+                stat = false;
+                break;
+            }
+        }
+        if (n < 0) stat = false;
+    }
+    close(fdin);
+    close(fdout);
+    if (!stat) std::remove(dst.c_str());
+
+    return stat;
+#endif
+} /* end of LinkFile */
+
+/**
+* @brief   : LongToShort - to produce the file with short name from the one with long name already downloaded and
+*              decoded, i.e., by renaming it (l2s4 = 1) or by hardlinking it (l2s4 = 2), so that the data are NOT copied
+* @param[I]: lfile (file with long name)
+* @param[I]: sfile (file with short name)
+* @param[I]: l2s4 (0: long name, 1: short name, 2: long and short name)
+* @param[O]: none
+* @return  : true: successful, false: failed
+* @note    : both names share the same data for 'l2s4 = 2' (unless the hardlink is NOT supported and a copy is made), so
+*              neither of them must be modified in place
+**/
+bool FtpUtil::LongToShort(std::string lfile, std::string sfile, int l2s4)
+{
+    ProfUtil::tick_t t0 = ProfUtil::Tic();
+    bool stat = true;
+    if (l2s4 == 2) stat = LinkFile(lfile, sfile);
+    else if (l2s4 == 1)
+    {
+        /* the leftover of the last run is replaced, because 'rename' fails on Windows if it exists */
+        if (access(sfile.c_str(), 0) == 0) std::remove(sfile.c_str());
+
+        stat = std::rename(lfile.c_str(), sfile.c_str()) == 0;
+    }
+    if (l2s4 == 1 || l2s4 == 2) ProfUtil::Toc(PROF_FS, t0, sfile);
+
+    return stat;
+} /* end of LongToShort */
+
+/**
+* @brief   : DecodeCrx - to decode one MGEX observation file (long name) fetched, i.e., to extract it, convert it from
+*              'crx' file to 'rnx' file, and produce the file with short name (i.e., 'abcd0990.26o') from it
+* @param[I]: xfile (file fetched, i.e., '*.crx.gz', '*.crx.Z' or '*.crx', with full path or in the current directory)
+* @param[I]: gzipfull (full path of 'gzip')
+* @param[I]: crx2rnxfull (full path of 'crx2rnx')
+* @param[I]: l2s4obs (0: long name, 1: short name, 2: long and short name)
+* @param[O]: none
+* @return  : the final local file ('rnx' file, or the file with short name for 'l2s4obs = 1'), empty if failed
+* @note    : the short name is derived from the long one 'SSSSMRCCC_R_YYYYDDDHHMM_01D_30S_MO.crx', i.e., the session is
+*              '0' for the daily file, and 'a' to 'x' (with the minutes for the high-rate file) otherwise. It is shared by
+*              the getters and Resume, so that the files decoded again after a crash are the same as the ones of a clean run
+**/
+std::string FtpUtil::DecodeCrx(std::string xfile, std::string gzipfull, std::string crx2rnxfull, int l2s4obs)
+{
+    /* extract it */
+    std::string crxfile = xfile;
+    if (crxfile.size() > 3 && crxfile.substr(crxfile.size() - 3) == ".gz") crxfile.erase(crxfile.size() - 3);
+    else if (crxfile.size() > 2 && crxfile.substr(crxfile.size() - 2) == ".Z") crxfile.erase(crxfile.size() - 2);
+    if (crxfile != xfile && access(xfile.c_str(), 0) == 0) ProfUtil::System(gzipfull + " -d -f " + xfile);
+    if (access(crxfile.c_str(), 0) == -1) return "";
+
+    /* convert from 'crx' file to 'rnx' file */
+    std::string rnxfile = crxfile.substr(0, (int)crxfile.find_last_of('.')) + ".rnx";
+#ifdef _WIN32  /* for Windows */
+    std::string cmd = crx2rnxfull + " " + crxfile + " -f - > " + rnxfile;
+#else          /* for Linux or Mac */
+    std::string cmd = "cat " + crxfile + " | " + crx2rnxfull + " -f - > " + rnxfile;
+#endif
+    ProfUtil::System(cmd);
+
+    /* delete 'crx' file */
+#ifdef _WIN32   /* for Windows */
+    cmd = "del " + crxfile;
+#else           /* for Linux or Mac */
+    cmd = "rm -rf " + crxfile;
+#endif
+    ProfUtil::System(cmd);
+    if (access(rnxfile.c_str(), 0) == -1) return "";
+
+    /* the file with short name is in the same directory */
+    std::string::size_type ipos = rnxfile.find_last_of("/\\") + 1;
+    std::string lname = rnxfile.substr(ipos);
+    if (l2s4obs <= 0 || lname.size() < 27) return rnxfile;
+    std::string site = lname.substr(0, 4);
+    CString::ToLower(site);
+    std::string sfile = rnxfile.substr(0, ipos) + site + lname.substr(16, 3);
+    int hh = atoi(lname.substr(19, 2).c_str());
+    if (lname[26] == 'D') sfile += "0";
+    else sfile += std::string(1, (char)('a' + hh)) + (lname[26] == 'M' ? lname.substr(21, 2) : "");
+    sfile += "." + lname.substr(14, 2) + "o";
+
+    if (!LongToShort(rnxfile, sfile, l2s4obs)) return "";
+
+    return l2s4obs == 1 ? sfile : rnxfile;
+} /* end of DecodeCrx */
+
+/**
+* @brief   : ClassifyWget - to classify the outcome of 'wget' by its exit status and output
+* @param[I]: stat (return value of std::system)
+* @param[I]: msg (output of 'wget')
+* @param[O]: none
+* @return  : class of the transfer outcome (XFER_*)
+* @note    : exit status of 'wget': 0 OK, 1 generic error, 2 parse error, 3 file I/O error, 4 network failure, 5 SSL
+*              verification failure, 6 authentication failure, 7 protocol error, 8 error response of server
+**/
+int FtpUtil::ClassifyWget(int stat, std::string msg)
+{
+#ifdef _WIN32   /* for Windows */
+    int code = stat;
+#else           /* for Linux or Mac */
+    int code = WIFEXITED(stat) ? WEXITSTATUS(stat) : -1;
+#endif
+
+    if (code == 0) return XFER_OK;
+    else if (code == 4 || code == 7) return XFER_TRANSIENT;
+    else if (code == 5 || code == 6) return XFER_AUTH;
+    else if (code == 8)
+    {
+        if (msg.find("ERROR 401") != std::string::npos || msg.find("ERROR 403") != std::string::npos ||
+            msg.find("Login incorrect") != std::string::npos) return XFER_AUTH;
+        else if (msg.find("ERROR 429") != std::string::npos || msg.find("ERROR 503") != std::string::npos ||
+            msg.find(" 421 ") != std::string::npos) return XFER_THROTTLED;
+        else if (msg.find("ERROR 5") != std::string::npos) return XFER_TRANSIENT;
+
+        return XFER_NOTFOUND;
+    }
+
+    return XFER_ERROR;
+} /* end of ClassifyWget */
+
+/**
+* @brief   : GetExactFile - to download one file whose remote name is exactly known by a direct GET/RETR, i.e., without
+*              the listing of the whole remote directory
+* @param[I]: url (remote directory)
+* @param[I]: file (remote file name without compression suffix)
+* @param[I]: fopt (FTP options)
+* @param[I]: cacheable (false: the shared cache is NOT used, i.e., for the mutable products)
+* @param[O]: none
+* @return  : local name of the downloaded compressed file, empty if it is NOT found on the remote server
+* @note    : the compression suffix ('.gz' or '.Z') found last time in the same directory (or on the same host) is tried first
+**/
+std::string FtpUtil::GetExactFile(std::string url, std::string file, const ftpopt_t* fopt, bool cacheable)
+{
+    /* the remote host, i.e., 'ftps://gdc.cddis.eosdis.nasa.gov' */
+    std::string host = url;
+    std::string::size_type ipos = url.find("://");
+    if (ipos != std::string::npos)
+    {
+        ipos = url.find('/', ipos + 3);
+        if (ipos != std::string::npos) host = url.substr(0, ipos);
+    }
+
+    /* the suffix found last time is tried first, and then the other one */
+    std::vector<std::string> sfxs = { ".gz", ".Z" };
+    std::string sfx0;
+    if (sfxcache_.find(url) != sfxcache_.end()) sfx0 = sfxcache_[url];
+    else if (sfxcache_.find(host) != sfxcache_.end()) sfx0 = sfxcache_[host];
+    if (sfx0 == ".Z") std::swap(sfxs[0], sfxs[1]);
+
+    std::string q = fopt->printinfo4wget ? "" : " -nv";
+    for (size_t i = 0; i < sfxs.size(); i++)
+    {
+        std::string xfile = file + sfxs[i];
+        /* the leftover of the last (interrupted) run would make 'wget' save the new one as '*.1' */
+        if (access(xfile.c_str(), 0) == 0) std::remove(xfile.c_str());
+
+        std::string cmd = fopt->wgetfull + q + " " + url + "/" + xfile;
+        int xstat = RunWget(cmd, fopt, xfile, cacheable);
+        if (xstat == XFER_OK && access(xfile.c_str(), 0) == 0)
+        {
+            sfxcache_[url] = sfxs[i];
+            sfxcache_[host] = sfxs[i];
+
+            return xfile;
+        }
+        /* the other suffix is NOT tried if the server can NOT be reached */
+        if (xstat != XFER_NOTFOUND) break;
+    }
+
+    return "";
+} /* end of GetExactFile */
+
+/**
+* @brief   : GetValidators - to get the validators of a remote file without moving its payload, i.e., 'ETag', 'Last-Modified'
+*              and 'Content-Length' in the HEAD response of HTTP(S), or the file size in the 'SIZE' reply of FTP
+* @param[I]: url (full URL of the remote file)
+* @param[I]: fopt (FTP options)
+* @param[O]: vlds (validators, one 'key: value' per line)
+* @return  : true: the remote file is found, false: NOT found
+* @note    : 'wget' does not issue 'MDTM', so only the file size is compared for FTP
+**/
+bool FtpUtil::GetValidators(std::string url, const ftpopt_t* fopt, std::string& vlds)
+{
+    vlds.clear();
+
+    /* '--spider' sends HEAD for HTTP(S) and SIZE for FTP, and '-S' prints the HTTP response headers */
+    std::string hdrfile = ".validators." + std::to_string(getpid()) + ".tmp";
+    std::string cmd = Redirect(fopt->wgetfull + " --spider -S " + url, fopt) + " > " + hdrfile + " 2>&1";
+    int stat = ProfUtil::System(cmd);
+
+    std::ifstream fp(hdrfile.c_str());
+    std::string line, key, etag, lastmod, size, name = url.substr(url.find_last_of('/') + 1);
+    bool isfound = stat == 0, issize = false;
+    while (fp.is_open() && getline(fp, line))
+    {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        CString::trim(line);
+        if (line.empty()) continue;
+        std::string::size_type ipos = line.find(':');
+        key = (ipos == std::string::npos) ? "" : line.substr(0, ipos);
+        CString::ToLower(key);
+        std::string value = (ipos == std::string::npos) ? "" : line.substr(ipos + 1);
+        CString::trim(value);
+        if (line.compare(0, 5, "HTTP/") == 0)
+        {
+            /* the headers of the last response are used if redirected */
+            etag.clear();
+            lastmod.clear();
+            size.clear();
+        }
+        else if (key == "etag") etag = value;
+        else if (key == "last-modified") lastmod = value;
+        else if (key == "content-length") size = value;
+        else if (line.compare(0, 8, "==> SIZE") == 0)
+        {
+            /* i.e., '==> SIZE igu22000_00.sp3.Z ... 123456' */
+            ipos = line.find_last_of(' ');
+            if (ipos != std::string::npos && line.find("done") == std::string::npos) size = line.substr(ipos + 1);
+        }
+        else if (issize && line.compare(0, 4, "213 ") == 0) size = line.substr(4);
+        else if (line == "File '" + name + "' exists.") isfound = true;
+        /* i.e., '--> SIZE igu22000_00.sp3.Z' followed by the reply '213 123456' with '-S' */
+        issize = line.compare(0, 8, "--> SIZE") == 0;
+    }
+    if (fp.is_open()) fp.close();
+    std::remove(hdrfile.c_str());
+
+    /* 'wget --spider' exits with 8 for the FTP file found as well, so the verdict it prints is taken */
+    if (!isfound) return false;
+
+    if (!etag.empty()) vlds += "ETag: " + etag + "\n";
+    if (!lastmod.empty()) vlds += "Last-Modified: " + lastmod + "\n";
+    if (!size.empty()) vlds += "Size: " + size + "\n";
+
+    return true;
+} /* end of GetValidators */
+
+/**
+* @brief   : GetStoredValidators - to get the validators stored for one local file in the validator journal of 'logDir'
+* @param[I]: localfile (local file name in the current directory, i.e., 'igs20.atx' or 'igs20.atx.part')
+* @param[O]: none
+* @return  : validators, one 'key: value' per line, empty if none
+* @note    : the validators are kept in one line of the journal (keyed by the local file with full path), so the line
+*              breaks are escaped. The hidden '.<file>.vld' left in the product directory by the older versions is taken over
+**/
+std::string FtpUtil::GetStoredValidators(std::string localfile)
+{
+    std::string vlds = vldjournal_.GetState(GetCwdFile(localfile));
+    for (std::string::size_type ipos = vlds.find("\\n"); ipos != std::string::npos; ipos = vlds.find("\\n", ipos + 1))
+    {
+        vlds.replace(ipos, 2, "\n");
+    }
+
+    std::string vldfile = "." + localfile + ".vld";
+    if (!vlds.empty() || access(vldfile.c_str(), 0) == -1) return vlds;
+    std::ifstream fp(vldfile.c_str());
+    std::string line;
+    while (fp.is_open() && getline(fp, line)) vlds += line + "\n";
+    if (fp.is_open()) fp.close();
+    std::remove(vldfile.c_str());
+    if (!vlds.empty()) StoreValidators(localfile, vlds);
+
+    return vlds;
+} /* end of GetStoredValidators */
+
+/**
+* @brief   : StoreValidators - to store the validators of one local file in the validator journal of 'logDir'
+* @param[I]: localfile (local file name in the current directory)
+* @param[I]: vlds (validators, one 'key: value' per line, empty to remove them)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void FtpUtil::StoreValidators(std::string localfile, std::string vlds)
+{
+    std::string line;
+    for (size_t i = 0; i < vlds.size(); i++)
+    {
+        if (vlds[i] == '\n') line += "\\n";
+        else if (vlds[i] != '\t' && vlds[i] != '\r') line += vlds[i];
+    }
+    vldjournal_.SetState(GetCwdFile(localfile), line);
+} /* end of StoreValidators */
+
+/**
+* @brief   : IsMutableToGet - to check whether a mutable product (i.e., ANTEX, ultra-rapid and CNES real-time files) needs
+*              to be (re-)fetched, by comparing the validators of the remote file with those stored for the local file
+* @param[I]: url (full URL of the remote file, empty to use the one stored for the local file)
+* @param[I]: localfile (local file name in the current directory)
+* @param[I]: fopt (FTP options)
+* @param[O]: vlds (validators of the remote file got in this check)
+* @return  : true: to be (re-)fetched, false: NOT
+* @note    : the old local file is moved to '*.old' if it is to be re-fetched, see also EndMutableGet
+**/
+bool FtpUtil::IsMutableToGet(std::string url, std::string localfile, const ftpopt_t* fopt, std::string& vlds)
+{
+    vlds.clear();
+    if (access(localfile.c_str(), 0) == -1)
+    {
+        if (fopt->refresh_mutable && !url.empty()) GetValidators(url, fopt, vlds);
+
+        return true;
+    }
+    if (!fopt->refresh_mutable) return false;
+
+    /* the validators stored last time */
+    std::string vlds0, line;
+    std::istringstream ss(GetStoredValidators(localfile));
+    while (getline(ss, line))
+    {
+        if (line.compare(0, 5, "URL: ") == 0)
+        {
+            if (url.empty()) url = line.substr(5);
+        }
+        else vlds0 += line + "\n";
+    }
+
+    /* the local file is kept if it can NOT be validated at the moment */
+    if (url.empty()) return false;
+    if (!GetValidators(url, fopt, vlds)) return false;
+    if (!vlds0.empty() && vlds == vlds0) return false;
+
+    Logger::Trace(TINFO, "*** INFO(FtpUtil::IsMutableToGet): " + localfile + " has been changed on the remote server, re-fetch it");
+    std::string oldfile = localfile + ".old";
+    std::remove(oldfile.c_str());
+    std::rename(localfile.c_str(), oldfile.c_str());
+
+    return true;
+} /* end of IsMutableToGet */
+
+/**
+* @brief   : EndMutableGet - to store the validators of the newly fetched mutable product, or restore the old local
+*              file if the re-fetching failed
+* @param[I]: url (full URL of the remote file)
+* @param[I]: localfile (local file name in the current directory)
+* @param[I]: vlds (validators got in IsMutableToGet, empty to get them here)
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void FtpUtil::EndMutableGet(std::string url, std::string localfile, std::string vlds, const ftpopt_t* fopt)
+{
+    std::string oldfile = localfile + ".old";
+    if (access(localfile.c_str(), 0) == -1)
+    {
+        if (access(oldfile.c_str(), 0) == 0) std::rename(oldfile.c_str(), localfile.c_str());
+
+        return;
+    }
+    if (access(oldfile.c_str(), 0) == 0) std::remove(oldfile.c_str());
+
+    /* the validators can NOT be got from the URL with wildcard */
+    if (!fopt->refresh_mutable || url.find('*') != std::string::npos) return;
+    if (vlds.empty() && !GetValidators(url, fopt, vlds)) return;
+
+    StoreValidators(localfile, "URL: " + url + "\n" + vlds);
+} /* end of EndMutableGet */
+
+/**
+* @brief   : MatchWild - to match one file name against a wildcard pattern with '*' and '?'
+* @param[I]: pattern (wildcard pattern)
+* @param[I]: name (file name)
+* @param[O]: none
+* @return  : true: matched, false: NOT matched
+* @note    :
+**/
+bool FtpUtil::MatchWild(const char* pattern, const char* name)
+{
+    if (*pattern == '\0') return *name == '\0';
+    if (*pattern == '*') return MatchWild(pattern + 1, name) || (*name != '\0' && MatchWild(pattern, name + 1));
+    if (*name == '\0') return false;
+    if (*pattern == '?' || *pattern == *name) return MatchWild(pattern + 1, name + 1);
+
+    return false;
+} /* end of MatchWild */
+
+/**
+* @brief   : ListRemote - to list one remote directory with the size and modification time of each file, i.e., the raw
+*              'LIST' reply of FTP(S), or the directory itself of the local mirror
+* @param[I]: url (remote directory)
+* @param[I]: fopt (FTP options)
+* @param[O]: entries (file name -> (size in bytes, modification time in seconds since 1970/01/01 UTC))
+* @return  : true: the listing is got and fully parsed, false: NOT
+* @note    : HTTP(S) is NOT supported because its index pages carry no reliable modification time, and the modification
+*              time of 'LIST' is in minutes
+**/
+bool FtpUtil::ListRemote(std::string url, const ftpopt_t* fopt, std::map<std::string, std::pair<double, double>>& entries)
+{
+    entries.clear();
+
+    /* the local mirror is listed directly */
+    if (url.compare(0, 7, "file://") == 0)
+    {
+        std::string path = url.substr(7);
+#ifdef _WIN32   /* for Windows */
+        WIN32_FIND_DATAA fd;
+        HANDLE hfind = FindFirstFileA((path + "\\*").c_str(), &fd);
+        if (hfind == INVALID_HANDLE_VALUE) return false;
+        do
+        {
+            if (fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) continue;
+            ULARGE_INTEGER size, time;
+            size.LowPart = fd.nFileSizeLow;
+            size.HighPart = fd.nFileSizeHigh;
+            time.LowPart = fd.ftLastWriteTime.dwLowDateTime;
+            time.HighPart = fd.ftLastWriteTime.dwHighDateTime;
+            /* 100-nanosecond intervals since 1601/01/01 */
+            entries[fd.cFileName] = { (double)size.QuadPart, (double)time.QuadPart * 1.0e-7 - 11644473600.0 };
+        } while (FindNextFileA(hfind, &fd));
+        FindClose(hfind);
+#else           /* for Linux or Mac */
+        DIR* dp = opendir(path.c_str());
+        if (dp == NULL) return false;
+        struct dirent* ep;
+        while ((ep = readdir(dp)) != NULL)
+        {
+            struct stat st;
+            std::string file = path + "/" + ep->d_name;
+            if (stat(file.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) continue;
+            entries[ep->d_name] = { (double)st.st_size, (double)st.st_mtime };
+        }
+        closedir(dp);
+#endif
+        return true;
+    }
+    if (url.compare(0, 6, "ftp://") != 0 && url.compare(0, 7, "ftps://") != 0) return false;
+
+    /* the raw 'LIST' reply is kept in '.listing' by '--no-remove-listing', and the generated index page is dropped. The name
+       of '.listing' is fixed by 'wget', so it is written into a directory prefix of this process, see MoveOut */
+    std::string sep;
+    sep.push_back((char)FILEPATHSEP);
+    std::string lstdir = ".listing." + std::to_string(getpid()) + ".d", lstfile = lstdir + sep + ".listing";
+    std::string idxfile = ".index." + std::to_string(getpid()) + ".tmp";
+    std::string cmd = fopt->wgetfull + " -nv --no-remove-listing -P " + lstdir + " -O " + idxfile + " " + url + "/";
+    int xstat = RetryWget(cmd, fopt, "");
+    std::remove(idxfile.c_str());
+    bool stat = xstat == XFER_OK && access(lstfile.c_str(), 0) == 0;
+    if (stat)
+    {
+        gtime_t tnow = GTime::now();
+        stat = ParseListing(lstfile, (tnow.mjd - 40587) * 86400.0 + tnow.sod, entries);
+    }
+    MoveOut(lstdir, "");
+
+    return stat;
+} /* end of ListRemote */
+
+/**
+* @brief   : ParseListing - to parse the raw 'LIST' reply of FTP(S) in the Unix style
+* @param[I]: lstfile (file of the 'LIST' reply, i.e., '.listing' of 'wget')
+* @param[I]: snow (time now in seconds since 1970/01/01 UTC, for the year omitted of the recent files)
+* @param[O]: entries (file name -> (size in bytes, modification time in seconds since 1970/01/01 UTC))
+* @return  : true: fully parsed, false: NOT (i.e., the MS-DOS style)
+* @note    : the directories and the links are skipped
+**/
+bool FtpUtil::ParseListing(std::string lstfile, double snow, std::map<std::string, std::pair<double, double>>& entries)
+{
+    /* i.e., '-rw-r--r--   1 ftp  ftp   1234567 Oct 19 01:05 abmf2920.24d.gz', the year is omitted for the recent files */
+    const std::string months = "JanFebMarAprMayJunJulAugSepOctNovDec";
+    gtime_t tnow = { 40587 + (int)(snow / 86400.0), 0.0 };
+    double ep[6];
+    GTime::time2ymdhms(tnow, ep);
+    int year = (int)ep[0];
+    bool stat = true;
+    std::ifstream fp(lstfile.c_str());
+    std::string line;
+    while (fp.is_open() && getline(fp, line))
+    {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line.compare(0, 5, "total") == 0 || line[0] == 'd' || line[0] == 'l') continue;
+
+        /* the first eight fields are split in place, and the rest of the line is the file name */
+        const char* fields[8];
+        size_t lens[8], nfield = 0;
+        const char* p = line.c_str();
+        while (nfield < 8)
+        {
+            while (*p == ' ' || *p == '\t') p++;
+            if (*p == '\0') break;
+            fields[nfield] = p;
+            while (*p != '\0' && *p != ' ' && *p != '\t') p++;
+            lens[nfield] = p - fields[nfield];
+            nfield++;
+        }
+        std::string name(p);
+        CString::trim(name);
+        char* pend = NULL;
+        double size = nfield == 8 ? strtod(fields[4], &pend) : 0.0;
+        std::string::size_type imon = std::string::npos;
+        if (line[0] == '-' && nfield == 8 && pend == fields[4] + lens[4] && lens[5] == 3)
+            imon = months.find(fields[5], 0, 3);
+        if (imon == std::string::npos || imon % 3 != 0 || name.empty())
+        {
+            /* the other listing formats (i.e., MS-DOS style) are NOT supported */
+            stat = false;
+            break;
+        }
+
+        double ep[6] = { (double)year, (double)(imon / 3 + 1), (double)atoi(fields[6]), 0.0, 0.0, 0.0 };
+        const char* pcolon = (const char*)memchr(fields[7], ':', lens[7]);
+        if (pcolon == NULL) ep[0] = atoi(fields[7]);
+        else
+        {
+            ep[3] = atoi(fields[7]);
+            ep[4] = atoi(pcolon + 1);
+        }
+        gtime_t tt = GTime::ymdhms2time(ep);
+        double smod = (tt.mjd - 40587) * 86400.0 + tt.sod;
+        /* the time without year is within the last six months */
+        if (pcolon != NULL && smod > snow + 86400.0)
+        {
+            ep[0] -= 1.0;
+            tt = GTime::ymdhms2time(ep);
+            smod = (tt.mjd - 40587) * 86400.0 + tt.sod;
+        }
+        entries[name] = { size, smod };
+    }
+    if (fp.is_open()) fp.close();
+
+    return stat;
+} /* end of ParseListing */
+
+/**
+* @brief   : GetListingDiff - to fetch only the files newly appeared (or changed) in one remote directory since its last
+*              listing, and convert each file as soon as it is on the local disk
+* @param[I]: url (remote directory)
+* @param[I]: pattern (wildcard pattern of the files)
+* @param[I]: fopt (FTP options)
+* @param[I]: convert (to decompress and convert one downloaded file, returning the final local file, empty if failed)
+* @param[O]: none
+* @return  : true: done by the listing diff, false: the listing is NOT available, and the caller falls back
+* @note    : the last listing is kept in 'listings' of 'logDir' (NOT in the product directory), keyed by the current directory,
+*              the remote directory and the pattern, and the files failed are retried in the next call. The latency from the
+*              publication (i.e., the modification time on the remote server) to the final local file is logged
+**/
+bool FtpUtil::GetListingDiff(std::string url, std::string pattern, const ftpopt_t* fopt, std::function<std::string(std::string)> convert)
+{
+    std::map<std::string, std::pair<double, double>> entries;
+    if (!ListRemote(url, fopt, entries)) return false;
+
+    /* the last listing of the same remote directory and pattern, one 'name size mtime' per line */
+    std::ostringstream sname;
+    sname << GetStateDir("listings") << (char)FILEPATHSEP << "listing_" << std::hex << std::hash<std::string>()(GetCwdFile("") + " " + url + " " + pattern);
+    std::string lastfile = sname.str();
+    /* the listing kept in the product directory by the older versions is taken over */
+    std::ostringstream soldname;
+    soldname << ".listing_" << std::hex << std::hash<std::string>()(url + " " + pattern);
+    std::string oldfile = soldname.str();
+    if (access(lastfile.c_str(), 0) == -1 && access(oldfile.c_str(), 0) == 0) std::rename(oldfile.c_str(), lastfile.c_str());
+    std::remove(oldfile.c_str());
+    std::map<std::string, std::pair<double, double>> lasts, keeps;
+    std::ifstream fp(lastfile.c_str());
+    std::string name;
+    double size, mtime;
+    while (fp.is_open() && fp >> name >> size >> mtime) lasts[name] = { size, mtime };
+    if (fp.is_open()) fp.close();
+
+    /* the newly appeared or changed files, the earliest published first */
+    std::vector<std::pair<double, std::string>> news;
+    for (auto it = entries.begin(); it != entries.end(); ++it)
+    {
+        if (!MatchWild(pattern.c_str(), it->first.c_str())) continue;
+        auto il = lasts.find(it->first);
+        if (il != lasts.end() && il->second == it->second) keeps[it->first] = it->second;
+        else news.push_back({ it->second.second, it->first });
+    }
+    std::sort(news.begin(), news.end());
+
+    std::string q = fopt->printinfo4wget ? "" : " -nv";
+    int nok = 0;
+    double latmax = 0.0;
+    for (size_t i = 0; i < news.size(); i++)
+    {
+        std::string xfile = news[i].second, ofile;
+        /* the leftover of the last (interrupted) run would make 'wget' save the new one as '*.1' */
+        if (access(xfile.c_str(), 0) == 0) std::remove(xfile.c_str());
+        std::string cmd = fopt->wgetfull + q + " " + url + "/" + xfile;
+        if (RunWget(cmd, fopt, xfile) == XFER_OK && access(xfile.c_str(), 0) == 0) ofile = convert(xfile);
+        if (ofile.empty() || access(ofile.c_str(), 0) == -1)
+        {
+            LogXfer("GetListingDiff", url + "/" + xfile, xfile, false);
+
+            continue;
+        }
+
+        gtime_t tnow = GTime::now();
+        double latency = (tnow.mjd - 40587) * 86400.0 + tnow.sod - news[i].first;
+        latmax = std::max(latmax, latency);
+        keeps[xfile] = entries[xfile];
+        nok++;
+        LogXfer("GetListingDiff", url + "/" + xfile, ofile, true, "latency " + std::to_string((int)(latency + 0.5)) + "s");
+    }
+
+    /* the listing is replaced atomically */
+    std::string tmpfile = lastfile + "." + std::to_string(getpid()) + ".tmp";
+    std::ofstream fpout(tmpfile.c_str());
+    for (auto it = keeps.begin(); it != keeps.end(); ++it)
+        fpout << it->first << " " << std::fixed << std::setprecision(0) << it->second.first << " " << it->second.second << '\n';
+    fpout.close();
+    std::remove(lastfile.c_str());
+    std::rename(tmpfile.c_str(), lastfile.c_str());
+
+    if (!news.empty())
+    {
+        std::ostringstream ss;
+        ss << std::fixed << std::setprecision(0) << latmax;
+        Logger::Trace(TINFO, "*** INFO(FtpUtil::GetListingDiff): " + std::to_string(nok) + "/" + std::to_string(news.size()) +
+            " new files are fetched from " + url + ", the maximum latency from publication is " + ss.str() + "s");
+    }
 
-    /* FTP archive for WHU */
-    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/data/daily");                               /* IGS daily observation (30s) files */
-    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/data/hourly");                              /* IGS hourly observation (30s) files */
-    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/highrate");                                     /* IGS high-rate observation (1s) files */
-    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/data/daily");                               /* MGEX daily observation (30s) files */
-    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/data/hourly");                              /* MGEX hourly observation (30s) files */
-    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/highrate");                                     /* MGEX high-rate observation (1s) files */
-    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/data/daily");                               /* broadcast ephemeris files */
-    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products");                                 /* IGS SP3 files */
-    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products");                                 /* IGS CLK files */
-    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products");                                 /* IGS EOP files */
-    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products");                                 /* IGS weekly SINEX files */
-    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products/mgex");                            /* MGEX SP3 files */
-    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products/mgex");                            /* MGEX CLK files */
-    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products/mgex");                            /* MGEX ORBEX files */
-    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products/mgex/dcb");                        /* MGEX DSB files */
-    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products/mgex");                            /* MGEX OSB files */
-    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products/ionex");                           /* global ionosphere map (GIM) files */
-    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products/ionex");                           /* Rate of TEC index (ROTI) files */
-    ftparchive_.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products/troposphere/new");                 /* IGS final tropospheric product files */
-} /* end of init */
+    return true;
+} /* end of GetListingDiff */
+
+/**
+* @brief   : GetIgmPlan - to plan the IGS observation files complementary to the MGEX ones actually obtained, i.e., the IGS
+*              files listed whose RINEX observation files (i.e., 'abcd0990.26o') are NOT converted from MGEX ones yet, so
+*              that the IGS files of the sites already covered by MGEX are NOT downloaded at all, while the ones of the MGEX
+*              transfers failed are
+* @param[I]: urli (remote directory of IGS observation files)
+* @param[I]: pati (wildcard pattern of IGS observation files)
+* @param[I]: fopt (FTP options)
+* @param[O]: ifiles (the exact names of the complementary IGS files without compression suffix)
+* @return  : true: planned, false: the listing is NOT available, and the caller falls back to all the IGS files
+* @note    : it is called in the directory of the observation files after the MGEX pass, and the IGS files planned are
+*              fetched by direct GETs without listing the remote directory again
+**/
+bool FtpUtil::GetIgmPlan(std::string urli, std::string pati, const ftpopt_t* fopt, std::vector<std::string>& ifiles)
+{
+    ifiles.clear();
+    std::map<std::string, std::pair<double, double>> ientries;
+    if (!ListRemote(urli, fopt, ientries)) return false;
+
+    int nskip = 0;
+    for (auto it = ientries.begin(); it != ientries.end(); ++it)
+    {
+        if (!MatchWild(pati.c_str(), it->first.c_str())) continue;
+        /* 'ABCD0990.26d.gz' -> 'abcd0990.26d' -> 'abcd0990.26o' */
+        std::string::size_type ipos = it->first.find_last_of('.');
+        std::string dfile = it->first.substr(0, ipos), ofile = dfile;
+        CString::ToLower(ofile);
+        ofile.back() = 'o';
+        if (access(ofile.c_str(), 0) == 0)
+        {
+            nskip++;
+            continue;
+        }
+        /* the suffix listed is tried first by GetExactFile */
+        if (ifiles.empty()) sfxcache_[urli] = it->first.substr(ipos);
+        ifiles.push_back(dfile);
+    }
+
+    Logger::Trace(TINFO, "*** INFO(FtpUtil::GetIgmPlan): " + std::to_string(ifiles.size()) +
+        " complementary IGS observation files in " + urli + ", " + std::to_string(nskip) +
+        " redundant IGS files skipped for the MGEX ones obtained");
+
+    return true;
+} /* end of GetIgmPlan */
 
 /**
 * @brief   : GetDailyObsIgs - download IGS RINEX daily observation (30s) files (short name "d") according to 'site.list' file
@@ -238,7 +1889,7 @@ void FtpUtil::GetDailyObsIgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
         std::string cmd = "mkdir -p " + subdir;
 #endif
-        std::system(cmd.c_str());
+        ProfUtil::System(cmd);
     }
 
     /* change directory */
@@ -280,19 +1931,19 @@ void FtpUtil::GetDailyObsIgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
         std::string dfile = "*" + sdoy + "0." + syy + "d";
         std::string dxfile = dfile + ".*";
         std::string cmd = wgetfull + " " + qr + " -nH -A " + dxfile + cutdirs + url;
-        std::system(cmd.c_str());
+        RunWget(cmd, fopt);
 
         /* get the file list */
         std::string suffix = "." + syy + "d";
         std::vector<std::string> dfiles;
-        CString::GetFilesAll(subdir, suffix, dfiles);
+        GetFilesAll(subdir, suffix, dfiles);
         for (size_t i = 0; i < dfiles.size(); i++)
         {
             if (access(dfiles[i].c_str(), 0) == 0)
             {
                 /* extract it */
                 cmd = gzipfull + " -d -f " + dfiles[i];
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
 
                 std::string site = dfiles[i].substr(0, 4);
                 CString::ToLower(site);
@@ -305,7 +1956,7 @@ void FtpUtil::GetDailyObsIgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else          /* for Linux or Mac */
                 cmd = "cat " + dfile + " | " + crx2rnxfull + " -f - > " + ofile;
 #endif
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
 
                 /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
@@ -313,7 +1964,7 @@ void FtpUtil::GetDailyObsIgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                 cmd = "rm -rf " + dfile;
 #endif
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
             }
         }
     }
@@ -340,30 +1991,24 @@ void FtpUtil::GetDailyObsIgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                 CString::ToLower(sitname);
                 std::string ofile = sitname + sdoy + "0." + syy + "o";
                 std::string dfile = sitname + sdoy + "0." + syy + "d";
-                if (access(ofile.c_str(), 0) == -1 && access(dfile.c_str(), 0) == -1)
+                if (!IsCommitted(subdir + sep + ofile) && access(ofile.c_str(), 0) == -1 && access(dfile.c_str(), 0) == -1)
                 {
-                    std::string url, cutdirs = " --cut-dirs=7 ";
+                    std::string url;
                     if (ftpname == "CDDIS") url = ftparchive_.CDDIS[IDX_OBSD] + "/" + syyyy + "/" + sdoy + "/" + syy + "d";
-                    else if (ftpname == "IGN")
-                    {
-                        url = ftparchive_.IGN[IDX_OBSD] + "/" + syyyy + "/" + sdoy;
-                        cutdirs = " --cut-dirs=5 ";
-                    }
+                    else if (ftpname == "IGN") url = ftparchive_.IGN[IDX_OBSD] + "/" + syyyy + "/" + sdoy;
                     else if (ftpname == "WHU") url = ftparchive_.WHU[IDX_OBSD] + "/" + syyyy + "/" + sdoy + "/" + syy + "d";
                     else url = ftparchive_.CDDIS[IDX_OBSD] + "/" + syyyy + "/" + sdoy + "/" + syy + "d";
 
-                    /* it is OK for '*.Z' or '*.gz' format */
-                    std::string dxfile = dfile + ".*";
-                    std::string cmd = wgetfull + " " + qr + " -nH -A " + dxfile + cutdirs + url;
-                    std::system(cmd.c_str());
+                    /* it is OK for '*.Z' or '*.gz' format, and the exact file is fetched without listing the remote directory */
+                    GetExactFile(url, dfile, fopt);
 
-                    std::string dgzfile = dfile + ".gz", dzfile = dfile + ".Z";
+                    std::string cmd, dgzfile = dfile + ".gz", dzfile = dfile + ".Z";
                     bool isgz = false;
                     if (access(dgzfile.c_str(), 0) == 0)
                     {
                         /* extract '*.gz' */
                         cmd = gzipfull + " -d -f " + dgzfile;
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                         isgz = true;
 
                         if (access(dfile.c_str(), 0) == 0 && access(dzfile.c_str(), 0) == 0)
@@ -374,14 +2019,14 @@ void FtpUtil::GetDailyObsIgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                             cmd = "rm -rf " + dzfile;
 #endif
-                            std::system(cmd.c_str());
+                            ProfUtil::System(cmd);
                         }
                     }
                     if (access(dfile.c_str(), 0) == -1 && access(dzfile.c_str(), 0) == 0)
                     {
                         /* extract '*.Z' */
                         cmd = gzipfull + " -d -f " + dzfile;
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                         isgz = false;
                     }
 
@@ -393,9 +2038,8 @@ void FtpUtil::GetDailyObsIgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                     {
                         Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetDailyObsIgs): failed to download IGS daily observation file " + ofile);
 
-                        std::string url0 = url + '/' + dxfile;
-                        if (fplog_.is_open()) fplog_ << "* WARNING(GetDailyObsIgs): " << url0 << "  ->  " << localfile <<
-                            "  failed" << std::endl;
+                        std::string url0 = url + '/' + dfile + ".*";
+                        LogXfer("GetDailyObsIgs", url0, localfile, false);
 
                         continue;
                     }
@@ -405,17 +2049,14 @@ void FtpUtil::GetDailyObsIgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else          /* for Linux or Mac */
                     cmd = "cat " + dfile + " | " + crx2rnxfull + " -f - > " + ofile;
 #endif
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
 
                     if (access(ofile.c_str(), 0) == 0)
                     {
                         Logger::Trace(TINFO, "*** INFO(FtpUtil::GetDailyObsIgs): successfully download IGS daily observation file " + ofile);
 
-                        if (isgz) dxfile = dgzfile;
-                        else dxfile = dzfile;
-                        std::string url0 = url + '/' + dxfile;
-                        if (fplog_.is_open()) fplog_ << "* INFO(GetDailyObsIgs): " << url0 << "  ->  " << localfile <<
-                            "  OK" << std::endl;
+                        std::string url0 = url + '/' + (isgz ? dgzfile : dzfile);
+                        LogXfer("GetDailyObsIgs", url0, localfile, true);
 
                         /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
@@ -423,7 +2064,7 @@ void FtpUtil::GetDailyObsIgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                         cmd = "rm -rf " + dfile;
 #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                     }
                 }
                 else Logger::Trace(TINFO, "*** INFO(FtpUtil::GetDailyObsIgs): IGS daily observation file " + ofile +
@@ -459,7 +2100,7 @@ void FtpUtil::GetHourlyObsIgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
         std::string cmd = "mkdir -p " + subdir;
 #endif
-        std::system(cmd.c_str());
+        ProfUtil::System(cmd);
     }
 
     /* compute day of year */
@@ -495,7 +2136,7 @@ void FtpUtil::GetHourlyObsIgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                 std::string cmd = "mkdir -p " + shhdir;
 #endif
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
             }
 
             /* change directory */
@@ -520,45 +2161,53 @@ void FtpUtil::GetHourlyObsIgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
             char ch = ii;
             std::string sch;
             sch.push_back(ch);
+
+            /* to extract one downloaded file and convert it from 'd' file to 'o' file */
+            auto convert = [&](std::string xfile) -> std::string {
+                /* the file list of 'GetFilesAll' is with full path in Linux, while the current directory is 'shhdir' */
+                xfile = xfile.substr(xfile.find_last_of("/\\") + 1);
+                std::string cmd = gzipfull + " -d -f " + xfile;
+                ProfUtil::System(cmd);
+
+                std::string site = xfile.substr(0, 4);
+                CString::ToLower(site);
+                std::string dfile = site + sdoy + sch + "." + syy + "d";
+                if (access(dfile.c_str(), 0) == -1) return "";
+                std::string ofile = site + sdoy + sch + "." + syy + "o";
+#ifdef _WIN32  /* for Windows */
+                cmd = crx2rnxfull + " " + dfile + " -f - > " + ofile;
+#else          /* for Linux or Mac */
+                cmd = "cat " + dfile + " | " + crx2rnxfull + " -f - > " + ofile;
+#endif
+                ProfUtil::System(cmd);
+
+                /* delete 'd' file */
+#ifdef _WIN32   /* for Windows */
+                cmd = "del " + dfile;
+#else           /* for Linux or Mac */
+                cmd = "rm -rf " + dfile;
+#endif
+                ProfUtil::System(cmd);
+
+                return ofile;
+            };
+
             /* it is OK for '*.Z' or '*.gz' format */
             std::string dfile = "*" + sdoy + sch + "." + syy + "d";
             std::string dxfile = dfile + ".*";
+            /* only the newly published files since the last listing are fetched */
+            if (fopt->hourly_diff && GetListingDiff(url, dxfile, fopt, convert)) continue;
+
             std::string cmd = wgetfull + " " + qr + " -nH -A " + dxfile + cutdirs + url;
-            std::system(cmd.c_str());
+            RunWget(cmd, fopt);
 
             /* get the file list */
             std::string suffix = "." + syy + "d";
             std::vector<std::string> dfiles;
-            CString::GetFilesAll(shhdir, suffix, dfiles);
+            GetFilesAll(shhdir, suffix, dfiles);
             for (size_t i = 0; i < dfiles.size(); i++)
             {
-                if (access(dfiles[i].c_str(), 0) == 0)
-                {
-                    /* extract it */
-                    cmd = gzipfull + " -d -f " + dfiles[i];
-                    std::system(cmd.c_str());
-
-                    std::string site = dfiles[i].substr(0, 4);
-                    CString::ToLower(site);
-                    dfile = site + sdoy + sch + "." + syy + "d";
-                    if (access(dfile.c_str(), 0) == -1) continue;
-                    std::string ofile = site + sdoy + sch + "." + syy + "o";
-                    /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxfull + " " + dfile + " -f - > " + ofile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + dfile + " | " + crx2rnxfull + " -f - > " + ofile;
-#endif
-                    std::system(cmd.c_str());
-
-                    /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                    cmd = "del " + dfile;
-#else           /* for Linux or Mac */
-                    cmd = "rm -rf " + dfile;
-#endif
-                    std::system(cmd.c_str());
-                }
+                if (access(dfiles[i].c_str(), 0) == 0) convert(dfiles[i]);
             }
         }
     }
@@ -597,7 +2246,7 @@ void FtpUtil::GetHourlyObsIgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                         std::string cmd = "mkdir -p " + shhdir;
 #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                     }
 
                     /* change directory */
@@ -615,30 +2264,24 @@ void FtpUtil::GetHourlyObsIgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                     CString::ToLower(sitname);
                     std::string ofile = sitname + sdoy + sch + "." + syy + "o";
                     std::string dfile = sitname + sdoy + sch + "." + syy + "d";
-                    if (access(ofile.c_str(), 0) == -1 && access(dfile.c_str(), 0) == -1)
+                    if (!IsCommitted(shhdir + sep + ofile) && access(ofile.c_str(), 0) == -1 && access(dfile.c_str(), 0) == -1)
                     {
-                        std::string url, cutdirs = " --cut-dirs=7 ";
+                        std::string url;
                         if (ftpname == "CDDIS") url = ftparchive_.CDDIS[IDX_OBSH] + "/" + syyyy + "/" + sdoy + "/" + shh;
-                        else if (ftpname == "IGN")
-                        {
-                            url = ftparchive_.IGN[IDX_OBSH] + "/" + syyyy + "/" + sdoy;
-                            cutdirs = " --cut-dirs=6 ";
-                        }
+                        else if (ftpname == "IGN") url = ftparchive_.IGN[IDX_OBSH] + "/" + syyyy + "/" + sdoy;
                         else if (ftpname == "WHU") url = ftparchive_.WHU[IDX_OBSH] + "/" + syyyy + "/" + sdoy + "/" + shh;
                         else url = ftparchive_.CDDIS[IDX_OBSH] + "/" + syyyy + "/" + sdoy + "/" + shh;
 
-                        /* it is OK for '*.Z' or '*.gz' format */
-                        std::string dxfile = dfile + ".*";
-                        std::string cmd = wgetfull + " " + qr + " -nH -A " + dxfile + cutdirs + url;
-                        std::system(cmd.c_str());
+                        /* it is OK for '*.Z' or '*.gz' format, and the exact file is fetched without listing the remote directory */
+                        GetExactFile(url, dfile, fopt);
 
-                        std::string dgzfile = dfile + ".gz", dzfile = dfile + ".Z";
+                        std::string cmd, dgzfile = dfile + ".gz", dzfile = dfile + ".Z";
                         bool isgz = false;
                         if (access(dgzfile.c_str(), 0) == 0)
                         {
                             /* extract '*.gz' */
                             cmd = gzipfull + " -d -f " + dgzfile;
-                            std::system(cmd.c_str());
+                            ProfUtil::System(cmd);
                             isgz = true;
 
                             if (access(dfile.c_str(), 0) == 0 && access(dzfile.c_str(), 0) == 0)
@@ -649,14 +2292,14 @@ void FtpUtil::GetHourlyObsIgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                                 cmd = "rm -rf " + dzfile;
 #endif
-                                std::system(cmd.c_str());
+                                ProfUtil::System(cmd);
                             }
                         }
                         if (access(dfile.c_str(), 0) == -1 && access(dzfile.c_str(), 0) == 0)
                         {
                             /* extract '*.Z' */
                             cmd = gzipfull + " -d -f " + dzfile;
-                            std::system(cmd.c_str());
+                            ProfUtil::System(cmd);
                             isgz = false;
                         }
 
@@ -668,9 +2311,8 @@ void FtpUtil::GetHourlyObsIgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                         {
                             Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetHourlyObsIgs): failed to download IGS Hourly observation file " + ofile);
 
-                            std::string url0 = url + '/' + dxfile;
-                            if (fplog_.is_open()) fplog_ << "* WARNING(GetHourlyObsIgs): " << url0 << "  ->  " <<
-                                localfile << "  failed" << std::endl;
+                            std::string url0 = url + '/' + dfile + ".*";
+                            LogXfer("GetHourlyObsIgs", url0, localfile, false);
 
                             continue;
                         }
@@ -680,17 +2322,14 @@ void FtpUtil::GetHourlyObsIgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else          /* for Linux or Mac */
                         cmd = "cat " + dfile + " | " + crx2rnxfull + " -f - > " + ofile;
 #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
 
                         if (access(ofile.c_str(), 0) == 0)
                         {
                             Logger::Trace(TINFO, "*** INFO(FtpUtil::GetHourlyObsIgs): successfully download IGS hourly observation file " + ofile);
 
-                            if (isgz) dxfile = dgzfile;
-                            else dxfile = dzfile;
-                            std::string url0 = url + '/' + dxfile;
-                            if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetHourlyObsIgs): " << url0 << "  ->  " <<
-                                localfile << "  OK" << std::endl;
+                            std::string url0 = url + '/' + (isgz ? dgzfile : dzfile);
+                            LogXfer("GetHourlyObsIgs", url0, localfile, true);
 
                             /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
@@ -698,7 +2337,7 @@ void FtpUtil::GetHourlyObsIgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                             cmd = "rm -rf " + dfile;
 #endif
-                            std::system(cmd.c_str());
+                            ProfUtil::System(cmd);
                         }
                     }
                     else Logger::Trace(TINFO, "*** INFO(FtpUtil::GetHourlyObsIgs): IGS hourly observation file " +
@@ -735,7 +2374,7 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
         std::string cmd = "mkdir -p " + subdir;
 #endif
-        std::system(cmd.c_str());
+        ProfUtil::System(cmd);
     }
 
     /* compute day of year */
@@ -771,7 +2410,7 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                 std::string cmd = "mkdir -p " + shhdir;
 #endif
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
             }
 
             /* change directory */
@@ -803,7 +2442,7 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
             std::string dfile = "*" + sdoy + sch + "*." + syy + "d";
             std::string dxfile = dfile + ".*";
             std::string cmd = wgetfull + " " + qr + " -nH -A " + dxfile + cutdirs + url;
-            std::system(cmd.c_str());
+            RunWget(cmd, fopt);
 
             std::vector<std::string> smin = { "00", "15", "30", "45" };
             for (size_t i = 0; i < smin.size(); i++)
@@ -811,14 +2450,14 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                 /* get the file list */
                 std::string suffix = smin[i] + "." + syy + "d";
                 std::vector<std::string> dfiles;
-                CString::GetFilesAll(shhdir, suffix, dfiles);
+                GetFilesAll(shhdir, suffix, dfiles);
                 for (size_t j = 0; j < dfiles.size(); j++)
                 {
                     if (access(dfiles[j].c_str(), 0) == 0)
                     {
                         /* extract it */
                         cmd = gzipfull + " -d -f " + dfiles[j];
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
 
                         std::string site = dfiles[j].substr(0, 4);
                         CString::ToLower(site);
@@ -831,7 +2470,7 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else          /* for Linux or Mac */
                         cmd = "cat " + dfile + " | " + crx2rnxfull + " -f - > " + ofile;
 #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
 
                         /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
@@ -839,7 +2478,7 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                         cmd = "rm -rf " + dfile;
 #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                     }
                 }
             }
@@ -880,7 +2519,7 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                         std::string cmd = "mkdir -p " + shhdir;
 #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                     }
 
                     /* change directory */
@@ -901,35 +2540,26 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                         CString::ToLower(sitname);
                         std::string ofile = sitname + sdoy + sch + smin[i] + "." + syy + "o";
                         std::string dfile = sitname + sdoy + sch + smin[i] + "." + syy + "d";
-                        if (access(ofile.c_str(), 0) == -1 && access(dfile.c_str(), 0) == -1)
+                        if (!IsCommitted(shhdir + sep + ofile) && access(ofile.c_str(), 0) == -1 && access(dfile.c_str(), 0) == -1)
                         {
-                            std::string url, cutdirs = " --cut-dirs=8 ";
+                            std::string url;
                             if (ftpname == "CDDIS") url = ftparchive_.CDDIS[IDX_OBSHR] + "/" + syyyy + "/" + sdoy + "/" +
                                 syy + "d" + "/" + shh;
-                            else if (ftpname == "IGN")
-                            {
-                                url = ftparchive_.IGN[IDX_OBSHR] + "/" + syyyy + "/" + sdoy;
-                                cutdirs = " --cut-dirs=6 ";
-                            }
-                            else if (ftpname == "WHU")
-                            {
-                                url = ftparchive_.WHU[IDX_OBSHR] + "/" + syyyy + "/" + sdoy + "/" + syy + "d" + "/" + shh;
-                                cutdirs = " --cut-dirs=6 ";
-                            }
+                            else if (ftpname == "IGN") url = ftparchive_.IGN[IDX_OBSHR] + "/" + syyyy + "/" + sdoy;
+                            else if (ftpname == "WHU") url = ftparchive_.WHU[IDX_OBSHR] + "/" + syyyy + "/" + sdoy +
+                                "/" + syy + "d" + "/" + shh;
                             else url = ftparchive_.CDDIS[IDX_OBSHR] + "/" + syyyy + "/" + sdoy + "/" + syy + "d" + "/" + shh;
 
-                            /* it is OK for '*.Z' or '*.gz' format */
-                            std::string dxfile = dfile + ".*";
-                            std::string cmd = wgetfull + " " + qr + " -nH -A " + dxfile + cutdirs + url;
-                            std::system(cmd.c_str());
+                            /* it is OK for '*.Z' or '*.gz' format, and the exact file is fetched without listing the remote directory */
+                            GetExactFile(url, dfile, fopt);
 
-                            std::string dgzfile = dfile + ".gz", dzfile = dfile + ".Z";
+                            std::string cmd, dgzfile = dfile + ".gz", dzfile = dfile + ".Z";
                             bool isgz = false;
                             if (access(dgzfile.c_str(), 0) == 0)
                             {
                                 /* extract '*.gz' */
                                 cmd = gzipfull + " -d -f " + dgzfile;
-                                std::system(cmd.c_str());
+                                ProfUtil::System(cmd);
                                 isgz = true;
                                 if (access(dfile.c_str(), 0) == 0 && access(dzfile.c_str(), 0) == 0)
                                 {
@@ -939,14 +2569,14 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                                     cmd = "rm -rf " + dzfile;
 #endif
-                                    std::system(cmd.c_str());
+                                    ProfUtil::System(cmd);
                                 }
                             }
                             if (access(dfile.c_str(), 0) == -1 && access(dzfile.c_str(), 0) == 0)
                             {
                                 /* extract '*.Z' */
                                 cmd = gzipfull + " -d -f " + dzfile;
-                                std::system(cmd.c_str());
+                                ProfUtil::System(cmd);
                                 isgz = false;
                             }
 
@@ -958,9 +2588,8 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                             {
                                 Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetHrObsIgs): failed to download IGS high-rate observation file " + ofile);
 
-                                std::string url0 = url + '/' + dxfile;
-                                if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetHrObsIgs): " << url0 << "  ->  " <<
-                                    localfile << "  failed" << std::endl;
+                                std::string url0 = url + '/' + dfile + ".*";
+                                LogXfer("GetHrObsIgs", url0, localfile, false);
 
                                 continue;
                             }
@@ -970,17 +2599,14 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else          /* for Linux or Mac */
                             cmd = "cat " + dfile + " | " + crx2rnxfull + " -f - > " + ofile;
 #endif
-                            std::system(cmd.c_str());
+                            ProfUtil::System(cmd);
 
                             if (access(ofile.c_str(), 0) == 0)
                             {
                                 Logger::Trace(TINFO, "*** INFO(FtpUtil::GetHrObsIgs): successfully download IGS high-rate observation file " + ofile);
 
-                                if (isgz) dxfile = dgzfile;
-                                else dxfile = dzfile;
-                                std::string url0 = url + '/' + dxfile;
-                                if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetHrObsIgs): " << url0 << "  ->  " <<
-                                    localfile << "  OK" << std::endl;
+                                std::string url0 = url + '/' + (isgz ? dgzfile : dzfile);
+                                LogXfer("GetHrObsIgs", url0, localfile, true);
 
                                 /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
@@ -988,7 +2614,7 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                                 cmd = "rm -rf " + dfile;
 #endif
-                                std::system(cmd.c_str());
+                                ProfUtil::System(cmd);
                             }
                         }
                         else Logger::Trace(TINFO, "*** INFO(FtpUtil::GetHrObsIgs): IGS high-rate observation file " +
@@ -1026,7 +2652,7 @@ void FtpUtil::GetDailyObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
         std::string cmd = "mkdir -p " + subdir;
 #endif
-        std::system(cmd.c_str());
+        ProfUtil::System(cmd);
     }
 
     /* change directory */
@@ -1068,56 +2694,18 @@ void FtpUtil::GetDailyObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt)
         std::string crxfile = "*" + syyyy + sdoy + "0000_01D_30S_MO.crx";
         std::string crxxfile = crxfile + ".*";
         std::string cmd = wgetfull + " " + qr + " -nH -A " + crxxfile + cutdirs + url;
-        std::system(cmd.c_str());
+        RunWget(cmd, fopt);
 
         /* get the file list */
         std::string suffix = ".crx";
         std::vector<std::string> crxfiles;
-        CString::GetFilesAll(subdir, suffix, crxfiles);
+        GetFilesAll(subdir, suffix, crxfiles);
         for (size_t i = 0; i < crxfiles.size(); i++)
         {
             if (access(crxfiles[i].c_str(), 0) == 0)
             {
-                /* extract it */
-                cmd = gzipfull + " -d -f " + crxfiles[i];
-                std::system(cmd.c_str());
-
-                crxfile = crxfiles[i].substr(0, (int)crxfiles[i].find_last_of('.'));
-                if (access(crxfile.c_str(), 0) == -1) continue;
-                std::string rnxfile = crxfile.substr(0, (int)crxfile.find_last_of('.')) + ".rnx";
-                /* convert from 'crx' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxfull + " " + crxfile + " -f - > " + rnxfile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + crxfile + " | " + crx2rnxfull + " -f - > " + rnxfile;
-#endif
-                std::system(cmd.c_str());
-
-                /* delete 'crx' file */
-#ifdef _WIN32   /* for Windows */
-                cmd = "del " + crxfile;
-#else           /* for Linux or Mac */
-                cmd = "rm -rf " + crxfile;
-#endif
-                std::system(cmd.c_str());
-
-                if (fopt->l2s4obs > 0)
-                {
-                    std::string site = crxfile.substr(0, 4);
-                    CString::ToLower(site);
-                    std::string ofile = site + sdoy + "0." + syy + "o";
-
-                    std::string change_filename;
-#ifdef _WIN32  /* for Windows */
-                    if (fopt->l2s4obs == 1) change_filename = "rename";
-                    else if (fopt->l2s4obs == 2) change_filename = "copy";
-#else          /* for Linux or Mac */
-                    if (fopt->l2s4obs == 1) change_filename = "mv";
-                    else if (fopt->l2s4obs == 2) change_filename = "cp";
-#endif
-                    cmd = change_filename + " " + rnxfile + " " + ofile;
-                    std::system(cmd.c_str());
-                }
+                /* extract it, convert it, and produce the file with short name */
+                DecodeCrx(crxfiles[i], gzipfull, crx2rnxfull, fopt->l2s4obs);
             }
         }
     }
@@ -1144,9 +2732,10 @@ void FtpUtil::GetDailyObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                 CString::ToLower(sitname);
                 std::string ofile = sitname + sdoy + "0." + syy + "o";
                 CString::ToUpper(sitname);
+                bool iscommitted = IsCommitted(subdir + sep + ofile);
                 std::string longfile;
-                CString::GetFile(subdir, sitname, longfile);
-                if (access(ofile.c_str(), 0) == -1 && access(longfile.c_str(), 0) == -1)
+                if (!iscommitted) GetFile(subdir, sitname, longfile);
+                if (!iscommitted && access(ofile.c_str(), 0) == -1 && access(longfile.c_str(), 0) == -1)
                 {
                     std::string url, cutdirs = " --cut-dirs=7 ";
                     if (ftpname == "CDDIS") url = ftparchive_.CDDIS[IDX_OBMD] + "/" + syyyy + "/" + sdoy + "/" + syy + "d";
@@ -1163,7 +2752,7 @@ void FtpUtil::GetDailyObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                     std::string crxfile = sitname + "*" + syyyy + sdoy + "0000_01D_30S_MO.crx";
                     std::string crxxfile = crxfile + ".*";
                     std::string cmd = wgetfull + " " + qr + " -nH -A " + crxxfile + cutdirs + url;
-                    std::system(cmd.c_str());
+                    RunWget(cmd, fopt);
 
                     std::string sep;
                     sep.push_back((char)FILEPATHSEP);
@@ -1171,57 +2760,21 @@ void FtpUtil::GetDailyObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                     /* extract '*.gz' */
                     std::string crxgzfile = crxfile + ".gz";
                     cmd = gzipfull + " -d -f " + crxgzfile;
-                    std::system(cmd.c_str());
-                    CString::GetFile(subdir, sitname, crxfile);
-                    if (access(crxfile.c_str(), 0) == 0)
+                    ProfUtil::System(cmd);
+                    GetFile(subdir, sitname, crxfile);
+                    if (access(crxfile.c_str(), 0) == 0 && !DecodeCrx(crxfile, gzipfull, crx2rnxfull, fopt->l2s4obs).empty())
                     {
-                        longfile = crxfile.substr(0, (int)crxfile.find_last_of('.'));
-                        std::string rnxfile = longfile + ".rnx";
-#ifdef _WIN32  /* for Windows */
-                        cmd = crx2rnxfull + " " + crxfile + " -f - > " + rnxfile;
-#else          /* for Linux or Mac */
-                        cmd = "cat " + crxfile + " | " + crx2rnxfull + " -f - > " + rnxfile;
-#endif
-                        std::system(cmd.c_str());
-
-                        /* delete 'crx' file */
-#ifdef _WIN32   /* for Windows */
-                        cmd = "del " + crxfile;
-#else           /* for Linux or Mac */
-                        cmd = "rm -rf " + crxfile;
-#endif
-                        std::system(cmd.c_str());
-
-                        if (access(rnxfile.c_str(), 0) == 0)
-                        {
-                            Logger::Trace(TINFO, "*** INFO(FtpUtil::GetDailyObsMgex): successfully download MGEX daily observation file " + ofile);
+                        Logger::Trace(TINFO, "*** INFO(FtpUtil::GetDailyObsMgex): successfully download MGEX daily observation file " + ofile);
 
-                            std::string url0 = url + '/' + crxgzfile;
-                            if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetDailyObsMgex): " << url0 << "  ->  " <<
-                                localfile << "  OK" << std::endl;
-
-                            if (fopt->l2s4obs > 0)
-                            {
-                                std::string change_filename;
-#ifdef _WIN32  /* for Windows */
-                                if (fopt->l2s4obs == 1) change_filename = "rename";
-                                else if (fopt->l2s4obs == 2) change_filename = "copy";
-#else          /* for Linux or Mac */
-                                if (fopt->l2s4obs == 1) change_filename = "mv";
-                                else if (fopt->l2s4obs == 2) change_filename = "cp";
-#endif
-                                cmd = change_filename + " " + rnxfile + " " + ofile;
-                                std::system(cmd.c_str());
-                            }
-                        }
+                        std::string url0 = url + '/' + crxgzfile;
+                        LogXfer("GetDailyObsMgex", url0, localfile, true);
                     }
                     else
                     {
                         Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetDailyObsMgex): failed to download MGEX daily observation file " + ofile);
 
                         std::string url0 = url + '/' + crxgzfile;
-                        if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetDailyObsMgex): " << url0 << "  ->  " <<
-                            localfile << "  failed" << std::endl;
+                        LogXfer("GetDailyObsMgex", url0, localfile, false);
 
                         continue;
                     }
@@ -1258,7 +2811,7 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt
 #else           /* for Linux or Mac */
         std::string cmd = "mkdir -p " + subdir;
 #endif
-        std::system(cmd.c_str());
+        ProfUtil::System(cmd);
     }
 
     /* compute day of year */
@@ -1294,7 +2847,7 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt
 #else           /* for Linux or Mac */
                 std::string cmd = "mkdir -p " + shhdir;
 #endif
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
             }
 
             /* change directory */
@@ -1314,68 +2867,30 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt
             else if (ftpname == "WHU") url = ftparchive_.WHU[IDX_OBMH] + "/" + syyyy + "/" + sdoy + "/" + shh;
             else url = ftparchive_.CDDIS[IDX_OBMH] + "/" + syyyy + "/" + sdoy + "/" + shh;
 
+            /* to extract one downloaded file and convert it from 'crx' file to 'rnx' file */
+            auto convert = [&](std::string xfile) -> std::string {
+                /* the file list of 'GetFilesAll' is with full path in Linux, while the current directory is 'shhdir' */
+                xfile = xfile.substr(xfile.find_last_of("/\\") + 1);
+
+                return DecodeCrx(xfile, gzipfull, crx2rnxfull, fopt->l2s4obs);
+            };
+
             /* it is OK for '*.Z' or '*.gz' format */
             std::string crxfile = "*" + syyyy + sdoy + shh + "00_01H_30S_MO.crx";
             std::string crxxfile = crxfile + ".*";
-            std::string cmd = wgetfull + " " + qr + " -nH -A " + crxxfile + cutdirs + url;
-            std::system(cmd.c_str());
+            /* only the newly published files since the last listing are fetched */
+            if (fopt->hourly_diff && GetListingDiff(url, crxxfile, fopt, convert)) continue;
 
-            /* 'a' = 97, 'b' = 98, ... */
-            int ii = fopt->hhobs[i] + 97;
-            char ch = ii;
-            std::string sch;
-            sch.push_back(ch);
+            std::string cmd = wgetfull + " " + qr + " -nH -A " + crxxfile + cutdirs + url;
+            RunWget(cmd, fopt);
 
             /* get the file list */
             std::string suffix = ".crx";
             std::vector<std::string> crxfiles;
-            CString::GetFilesAll(shhdir, suffix, crxfiles);
-            std::string sitname;
+            GetFilesAll(shhdir, suffix, crxfiles);
             for (size_t i = 0; i < crxfiles.size(); i++)
             {
-                if (access(crxfiles[i].c_str(), 0) == 0)
-                {
-                    /* extract it */
-                    cmd = gzipfull + " -d -f " + crxfiles[i];
-                    std::system(cmd.c_str());
-
-                    crxfile = crxfiles[i].substr(0, (int)crxfiles[i].find_last_of('.'));
-                    if (access(crxfile.c_str(), 0) == -1) continue;
-                    std::string rnxfile = crxfile.substr(0, (int)crxfile.find_last_of('.')) + ".rnx";
-                    /* convert from 'crx' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxfull + " " + crxfile + " -f - > " + rnxfile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + crxfile + " | " + crx2rnxfull + " -f - > " + rnxfile;
-#endif
-                    std::system(cmd.c_str());
-
-                    /* delete 'crx' file */
-#ifdef _WIN32   /* for Windows */
-                    cmd = "del " + crxfile;
-#else           /* for Linux or Mac */
-                    cmd = "rm -rf " + crxfile;
-#endif
-                    std::system(cmd.c_str());
-
-                    if (fopt->l2s4obs > 0)
-                    {
-                        std::string site = crxfile.substr(0, 4);
-                        CString::ToLower(site);
-                        std::string ofile = site + sdoy + "0." + syy + "o";
-
-                        std::string change_filename;
-#ifdef _WIN32  /* for Windows */
-                        if (fopt->l2s4obs == 1) change_filename = "rename";
-                        else if (fopt->l2s4obs == 2) change_filename = "copy";
-#else          /* for Linux or Mac */
-                     if (fopt->l2s4obs == 1) change_filename = "mv";
-                        else if (fopt->l2s4obs == 2) change_filename = "cp";
-#endif
-                        cmd = change_filename + " " + rnxfile + " " + ofile;
-                        std::system(cmd.c_str());
-                    }
-                }
+                if (access(crxfiles[i].c_str(), 0) == 0) convert(crxfiles[i]);
             }
         }
     }
@@ -1414,7 +2929,7 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt
 #else           /* for Linux or Mac */
                         std::string cmd = "mkdir -p " + shhdir;
 #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                     }
 
                     /* change directory */
@@ -1432,7 +2947,7 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt
                     CString::ToLower(sitname);
                     std::string ofile = sitname + sdoy + sch + "." + syy + "o";
                     std::string dfile = sitname + sdoy + sch + "." + syy + "d";
-                    if (access(ofile.c_str(), 0) == -1 && access(dfile.c_str(), 0) == -1)
+                    if (!IsCommitted(shhdir + sep + ofile) && access(ofile.c_str(), 0) == -1 && access(dfile.c_str(), 0) == -1)
                     {
                         std::string url, cutdirs = " --cut-dirs=7 ";
                         if (ftpname == "CDDIS") url = ftparchive_.CDDIS[IDX_OBMH] + "/" + syyyy + "/" + sdoy + "/" + shh;
@@ -1449,12 +2964,12 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt
                         std::string crxfile = sitname + "*" + syyyy + sdoy + shh + "00_01H_30S_MO.crx";
                         std::string crxxfile = crxfile + ".*";
                         std::string cmd = wgetfull + " " + qr + " -nH -A " + crxxfile + cutdirs + url;
-                        std::system(cmd.c_str());
+                        RunWget(cmd, fopt);
 
                         /* extract '*.gz' */
                         std::string crxgzFile = crxfile + ".gz";
                         cmd = gzipfull + " -d -f " + crxgzFile;
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                         std::string change_filename;
 #ifdef _WIN32  /* for Windows */
                         change_filename = "rename";
@@ -1462,7 +2977,7 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt
                         change_filename = "mv";
 #endif
                         cmd = change_filename + " " + crxfile + " " + dfile;
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                         bool isgz = true;
                         std::string crxzFile;
                         char tmpfile[MAXSTRPATH] = { '\0' };
@@ -1474,17 +2989,16 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt
                             /* extract '*.Z' */
                             crxzFile = crxfile + ".Z";
                             cmd = gzipfull + " -d -f " + crxzFile;
-                            std::system(cmd.c_str());
+                            ProfUtil::System(cmd);
 
                             cmd = change_filename + " " + crxfile + " " + dfile;
-                            std::system(cmd.c_str());
+                            ProfUtil::System(cmd);
                             if (access(dfile.c_str(), 0) == -1)
                             {
                                 Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetDailyObsMgex): failed to download MGEX daily observation file " + ofile);
 
                                 std::string url0 = url + '/' + crxxfile;
-                                if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::): " << url0 << "  ->  " << localfile <<
-                                    "  failed" << std::endl;
+                                LogXfer("GetHourlyObsMgex", url0, localfile, false);
 
                                 continue;
                             }
@@ -1495,7 +3009,7 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt
 #else          /* for Linux or Mac */
                         cmd = "cat " + dfile + " | " + crx2rnxfull + " -f - > " + ofile;
 #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
 
                         if (access(ofile.c_str(), 0) == 0)
                         {
@@ -1504,8 +3018,7 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt
                             if (isgz) crxxfile = crxgzFile;
                             else crxxfile = crxzFile;
                             std::string url0 = url + '/' + crxxfile;
-                            if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetHourlyObsMgex): " << url0 << "  ->  " <<
-                                localfile << "  OK" << std::endl;
+                            LogXfer("GetHourlyObsMgex", url0, localfile, true);
 
                             /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
@@ -1513,7 +3026,7 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt
 #else           /* for Linux or Mac */
                             cmd = "rm -rf " + dfile;
 #endif
-                            std::system(cmd.c_str());
+                            ProfUtil::System(cmd);
                         }
                     }
                     else Logger::Trace(TINFO, "*** INFO(FtpUtil::GetHourlyObsMgex): MGEX hourly observation file " +
@@ -1550,7 +3063,7 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
         std::string cmd = "mkdir -p " + subdir;
 #endif
-        std::system(cmd.c_str());
+        ProfUtil::System(cmd);
     }
 
     /* compute day of year */
@@ -1586,7 +3099,7 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                 std::string cmd = "mkdir -p " + shhdir;
 #endif
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
             }
 
             /* change directory */
@@ -1614,7 +3127,7 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt)
             std::string crxfile = "*_15M_01S_MO.crx";
             std::string crxxfile = crxfile + ".*";
             std::string cmd = wgetfull + " " + qr + " -nH -A " + crxxfile + cutdirs + url;
-            std::system(cmd.c_str());
+            RunWget(cmd, fopt);
 
             /* 'a' = 97, 'b' = 98, ... */
             int ii = fopt->hhobs[i] + 97;
@@ -1628,7 +3141,7 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                 /* get the file list */
                 std::string suffix = smin[i] + "_15M_01S_MO.crx";
                 std::vector<std::string> crxfiles;
-                CString::GetFilesAll(shhdir, suffix, crxfiles);
+                GetFilesAll(shhdir, suffix, crxfiles);
                 std::string sitname;
                 for (size_t j = 0; j < crxfiles.size(); j++)
                 {
@@ -1636,7 +3149,7 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                     {
                         /* extract it */
                         cmd = gzipfull + " -d -f " + crxfiles[j];
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
 
                         crxfile = crxfiles[j].substr(0, (int)crxfiles[j].find_last_of('.'));
                         if (access(crxfile.c_str(), 0) == -1) continue;
@@ -1649,7 +3162,7 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else          /* for Linux or Mac */
                         cmd = "cat " + crxfile + " | " + crx2rnxfull + " -f - > " + ofile;
 #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
 
                         /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
@@ -1657,7 +3170,7 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                         cmd = "rm -rf " + crxfile;
 #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                     }
                 }
             }
@@ -1698,7 +3211,7 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                         std::string cmd = "mkdir -p " + shhdir;
 #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                     }
 
                     /* change directory */
@@ -1720,7 +3233,7 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                         CString::ToLower(sitname);
                         std::string ofile = sitname + sdoy + sch + smin[i] + "." + syy + "o";
                         std::string dfile = sitname + sdoy + sch + smin[i] + "." + syy + "d";
-                        if (access(ofile.c_str(), 0) == -1 && access(dfile.c_str(), 0) == -1)
+                        if (!IsCommitted(shhdir + sep + ofile) && access(ofile.c_str(), 0) == -1 && access(dfile.c_str(), 0) == -1)
                         {
                             std::string url, cutdirs = " --cut-dirs=8 ";
                             if (ftpname == "CDDIS") url = ftparchive_.CDDIS[IDX_OBMHR] + "/" + syyyy + "/" + sdoy + "/" +
@@ -1743,12 +3256,12 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                             std::string crxfile = sitname + "*" + syyyy + sdoy + shh + smin[i] + "_15M_01S_MO.crx";
                             std::string crxxfile = crxfile + ".*";
                             std::string cmd = wgetfull + " " + qr + " -nH -A " + crxxfile + cutdirs + url;
-                            std::system(cmd.c_str());
+                            RunWget(cmd, fopt);
 
                             /* extract '*.gz' */
                             std::string crxgzFile = crxfile + ".gz";
                             cmd = gzipfull + " -d -f " + crxgzFile;
-                            std::system(cmd.c_str());
+                            ProfUtil::System(cmd);
                             std::string change_filename;
 #ifdef _WIN32  /* for Windows */
                             change_filename = "rename";
@@ -1756,7 +3269,7 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                             change_filename = "mv";
 #endif
                             cmd = change_filename + " " + crxfile + " " + dfile;
-                            std::system(cmd.c_str());
+                            ProfUtil::System(cmd);
                             bool isgz = true;
                             std::string crxzFile;
                             char tmpfile[MAXSTRPATH] = { '\0' };
@@ -1768,18 +3281,17 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                                 /* extract '*.Z' */
                                 crxzFile = crxfile + ".Z";
                                 cmd = gzipfull + " -d -f " + crxzFile;
-                                std::system(cmd.c_str());
+                                ProfUtil::System(cmd);
 
                                 cmd = change_filename + " " + crxfile + " " + dfile;
-                                std::system(cmd.c_str());
+                                ProfUtil::System(cmd);
                                 isgz = false;
                                 if (access(dfile.c_str(), 0) == -1)
                                 {
                                     Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetHrObsMgex): failed to download MGEX high-rate observation file " + ofile);
 
                                     std::string url0 = url + '/' + crxxfile;
-                                    if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetHrObsMgex): " << url0 << "  ->  " <<
-                                        localfile << "  failed" << std::endl;
+                                    LogXfer("GetHrObsMgex", url0, localfile, false);
 
                                     continue;
                                 }
@@ -1790,7 +3302,7 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else          /* for Linux or Mac */
                             cmd = "cat " + dfile + " | " + crx2rnxfull + " -f - > " + ofile;
 #endif
-                            std::system(cmd.c_str());
+                            ProfUtil::System(cmd);
 
                             if (access(ofile.c_str(), 0) == 0)
                             {
@@ -1799,8 +3311,7 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                                 if (isgz) crxxfile = crxgzFile;
                                 else crxxfile = crxzFile;
                                 std::string url0 = url + '/' + crxxfile;
-                                if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetHrObsMgex): " << url0 << "  ->  " <<
-                                    localfile << "  OK" << std::endl;
+                                LogXfer("GetHrObsMgex", url0, localfile, true);
 
                                 /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
@@ -1808,7 +3319,7 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                                 cmd = "rm -rf " + dfile;
 #endif
-                                std::system(cmd.c_str());
+                                ProfUtil::System(cmd);
                             }
                         }
                         else Logger::Trace(TINFO, "*** INFO(FtpUtil::GetHrObsMgex): MGEX high-rate observation file " +
@@ -1847,7 +3358,7 @@ void FtpUtil::GetDailyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
         std::string cmd = "mkdir -p " + subdir;
 #endif
-        std::system(cmd.c_str());
+        ProfUtil::System(cmd);
     }
 
     /* change directory */
@@ -1889,12 +3400,12 @@ void FtpUtil::GetDailyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
         std::string crxfile = "*" + syyyy + sdoy + "0000_01D_30S_MO.crx";
         std::string crxxfile = crxfile + ".*";
         std::string cmd = wgetfull + " " + qr + " -nH -A " + crxxfile + cutdirs + url;
-        std::system(cmd.c_str());
+        RunWget(cmd, fopt);
 
         /* get the file list */
         std::string suffix = ".crx";
         std::vector<std::string> crxfiles;
-        CString::GetFilesAll(subdir, suffix, crxfiles);
+        GetFilesAll(subdir, suffix, crxfiles);
         std::string sitname;
         for (size_t i = 0; i < crxfiles.size(); i++)
         {
@@ -1902,11 +3413,11 @@ void FtpUtil::GetDailyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
             {
                 /* extract it */
                 cmd = gzipfull + " -d -f " + crxfiles[i];
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
 
                 crxfile = crxfiles[i].substr(0, (int)crxfiles[i].find_last_of('.'));
                 if (access(crxfile.c_str(), 0) == -1) continue;
-                std::string site = crxfiles[i].substr(0, 4);
+                std::string site = crxfiles[i].substr(crxfiles[i].find_last_of("/\\") + 1, 4);
                 CString::ToLower(site);
                 std::string ofile = site + sdoy + "0." + syy + "o";
                 /* convert from 'd' file to 'o' file */
@@ -1915,7 +3426,7 @@ void FtpUtil::GetDailyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else          /* for Linux or Mac */
                 cmd = "cat " + crxfile + " | " + crx2rnxfull + " -f - > " + ofile;
 #endif
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
 
                 /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
@@ -1923,7 +3434,7 @@ void FtpUtil::GetDailyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                 cmd = "rm -rf " + crxfile;
 #endif
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
             }
         }
 
@@ -1940,22 +3451,31 @@ void FtpUtil::GetDailyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
         /* it is OK for '*.Z' or '*.gz' format */
         std::string dfile = "*" + sdoy + "0." + syy + "d";
         std::string dxfile = dfile + ".*";
-        cmd = wgetfull + " " + qr + " -nH -A " + dxfile + cutdirs + url;
-        std::system(cmd.c_str());
+        /* only the IGS files of the sites NOT obtained from MGEX are downloaded, by direct GETs of the names listed */
+        std::vector<std::string> ifiles;
+        if (GetIgmPlan(url, dxfile, fopt, ifiles))
+        {
+            for (size_t i = 0; i < ifiles.size(); i++) GetExactFile(url, ifiles[i], fopt);
+        }
+        else
+        {
+            cmd = wgetfull + " " + qr + " -nH -A " + dxfile + cutdirs + url;
+            RunWget(cmd, fopt);
+        }
 
         /* get the file list */
         suffix = "." + syy + "d";
         std::vector<std::string> dfiles;
-        CString::GetFilesAll(subdir, suffix, dfiles);
+        GetFilesAll(subdir, suffix, dfiles);
         for (size_t i = 0; i < dfiles.size(); i++)
         {
             if (access(dfiles[i].c_str(), 0) == 0)
             {
                 /* extract it */
                 cmd = gzipfull + " -d -f " + dfiles[i];
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
 
-                std::string site = dfiles[i].substr(0, 4);
+                std::string site = dfiles[i].substr(dfiles[i].find_last_of("/\\") + 1, 4);
                 CString::ToLower(site);
                 dfile = site + sdoy + "0." + syy + "d";
                 if (access(dfile.c_str(), 0) == -1) continue;
@@ -1968,7 +3488,7 @@ void FtpUtil::GetDailyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                     cmd = "rm -rf " + dfile;
 #endif
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
 
                     continue;
                 }
@@ -1978,7 +3498,7 @@ void FtpUtil::GetDailyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else          /* for Linux or Mac */
                 cmd = "cat " + dfile + " | " + crx2rnxfull + " -f - > " + ofile;
 #endif
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
 
                 /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
@@ -1986,7 +3506,7 @@ void FtpUtil::GetDailyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                 cmd = "rm -rf " + dfile;
 #endif
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
             }
         }
     }
@@ -2012,7 +3532,7 @@ void FtpUtil::GetDailyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                 CString::ToLower(sitname);
                 std::string ofile = sitname + sdoy + "0." + syy + "o";
                 std::string dfile = sitname + sdoy + "0." + syy + "d";
-                if (access(ofile.c_str(), 0) == -1 && access(dfile.c_str(), 0) == -1)
+                if (!IsCommitted(subdir + sep + ofile) && access(ofile.c_str(), 0) == -1 && access(dfile.c_str(), 0) == -1)
                 {
                     /* download the MGEX observation file site-by-site */
                     std::string url, cutdirs = " --cut-dirs=7 ";
@@ -2032,12 +3552,12 @@ void FtpUtil::GetDailyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                     std::string crxfile = sitname + "*" + syyyy + sdoy + "0000_01D_30S_MO.crx";
                     std::string crxxfile = crxfile + ".*";
                     std::string cmd = wgetfull + " " + qr + " -nH -A " + crxxfile + cutdirs + url;
-                    std::system(cmd.c_str());
+                    RunWget(cmd, fopt);
 
                     /* extract '*.gz' */
                     std::string crxgzFile = crxfile + ".gz";
                     cmd = gzipfull + " -d -f " + crxgzFile;
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
                     std::string change_filename;
 #ifdef _WIN32  /* for Windows */
                     change_filename = "rename";
@@ -2045,7 +3565,7 @@ void FtpUtil::GetDailyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                     change_filename = "mv";
 #endif
                     cmd = change_filename + " " + crxfile + " " + dfile;
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
 
                     char tmpfile[MAXSTRPATH] = { '\0' };
                     char sep = (char)FILEPATHSEP;
@@ -2056,35 +3576,29 @@ void FtpUtil::GetDailyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                         /* extract '*.Z' */
                         std::string crxzFile = crxfile + ".Z";
                         cmd = gzipfull + " -d -f " + crxzFile;
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
 
                         cmd = change_filename + " " + crxfile + " " + dfile;
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                         if (access(dfile.c_str(), 0) == -1)
                         {
                             /* download the IGS observation file site-by-site */
                             if (ftpname == "CDDIS") url = ftparchive_.CDDIS[IDX_OBSD] + "/" +
                                 syyyy + "/" + sdoy + "/" + syy + "d";
-                            else if (ftpname == "IGN")
-                            {
-                                url = ftparchive_.IGN[IDX_OBSD] + "/" + syyyy + "/" + sdoy;
-                                cutdirs = " --cut-dirs=5 ";
-                            }
+                            else if (ftpname == "IGN") url = ftparchive_.IGN[IDX_OBSD] + "/" + syyyy + "/" + sdoy;
                             else if (ftpname == "WHU") url = ftparchive_.WHU[IDX_OBSD] + "/" +
                                 syyyy + "/" + sdoy + "/" + syy + "d";
                             else url = ftparchive_.CDDIS[IDX_OBSD] + "/" + syyyy + "/" + sdoy + "/" + syy + "d";
 
-                            /* it is OK for '*.Z' or '*.gz' format */
-                            std::string dxfile = dfile + ".*";
-                            std::string cmd = wgetfull + " " + qr + " -nH -A " + dxfile + cutdirs + url;
-                            std::system(cmd.c_str());
+                            /* it is OK for '*.Z' or '*.gz' format, and the exact file is fetched without listing the remote directory */
+                            GetExactFile(url, dfile, fopt);
 
-                            std::string dgzfile = dfile + ".gz", dzfile = dfile + ".Z";
+                            std::string cmd, dgzfile = dfile + ".gz", dzfile = dfile + ".Z";
                             if (access(dgzfile.c_str(), 0) == 0)
                             {
                                 /* extract '*.gz' */
                                 cmd = gzipfull + " -d -f " + dgzfile;
-                                std::system(cmd.c_str());
+                                ProfUtil::System(cmd);
 
                                 if (access(dfile.c_str(), 0) == 0 && access(dzfile.c_str(), 0) == 0)
                                 {
@@ -2094,25 +3608,23 @@ void FtpUtil::GetDailyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                                     cmd = "rm -rf " + dzfile;
 #endif
-                                    std::system(cmd.c_str());
+                                    ProfUtil::System(cmd);
                                 }
                             }
                             if (access(dfile.c_str(), 0) == -1 && access(dzfile.c_str(), 0) == 0)
                             {
                                 /* extract '*.Z' */
                                 cmd = gzipfull + " -d -f " + dzfile;
-                                std::system(cmd.c_str());
+                                ProfUtil::System(cmd);
                             }
                             if (access(dfile.c_str(), 0) == -1)
                             {
                                 Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetDailyObsIgm): failed to download IGM daily observation file " + ofile);
 
                                 std::string url0 = url + '/' + crxxfile;
-                                if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetDailyObsIgm): " << url0 << "  ->  " <<
-                                    localfile << "  failed" << std::endl;
-                                url0 = url + '/' + dxfile;
-                                if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetDailyObsIgm): " << url0 << "  ->  " <<
-                                    localfile << "  failed" << std::endl;
+                                LogXfer("GetDailyObsIgm", url0, localfile, false);
+                                url0 = url + '/' + dfile + ".*";
+                                LogXfer("GetDailyObsIgm", url0, localfile, false);
 
                                 continue;
                             }
@@ -2124,14 +3636,13 @@ void FtpUtil::GetDailyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else          /* for Linux or Mac */
                     cmd = "cat " + dfile + " | " + crx2rnxfull + " -f - > " + ofile;
 #endif
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
 
                     if (access(ofile.c_str(), 0) == 0)
                     {
                         Logger::Trace(TINFO, "*** INFO(FtpUtil::GetDailyObsIgm): successfully download IGM daily observation file " + ofile);
 
-                        if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetDailyObsIgm): " << ofile << "  ->  " <<
-                            localfile << "  OK" << std::endl;
+                        LogXfer("GetDailyObsIgm", ofile, localfile, true);
 
                         /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
@@ -2139,7 +3650,7 @@ void FtpUtil::GetDailyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                         cmd = "rm -rf " + dfile;
 #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                     }
                 }
                 else Logger::Trace(TINFO, "*** INFO(FtpUtil::GetDailyObsIgm): IGM daily observation file " + ofile + " or " +
@@ -2176,7 +3687,7 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
         std::string cmd = "mkdir -p " + subdir;
 #endif
-        std::system(cmd.c_str());
+        ProfUtil::System(cmd);
     }
 
     /* compute day of year */
@@ -2211,7 +3722,7 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                 std::string cmd = "mkdir -p " + shhdir;
 #endif
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
             }
 
             /* change directory */
@@ -2238,7 +3749,7 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
             std::string crxfile = "*" + syyyy + sdoy + shh + "00_01H_30S_MO.crx";
             std::string crxxfile = crxfile + ".*";
             std::string cmd = wgetfull + " " + qr + " -nH -A " + crxxfile + cutdirs + url;
-            std::system(cmd.c_str());
+            RunWget(cmd, fopt);
 
             /* 'a' = 97, 'b' = 98, ... */
             int ii = fopt->hhobs[i] + 97;
@@ -2249,7 +3760,7 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
             /* get the file list */
             std::string suffix = ".crx";
             std::vector<std::string> crxfiles;
-            CString::GetFilesAll(shhdir, suffix, crxfiles);
+            GetFilesAll(shhdir, suffix, crxfiles);
             std::string sitname;
             for (size_t i = 0; i < crxfiles.size(); i++)
             {
@@ -2257,11 +3768,11 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                 {
                     /* extract it */
                     cmd = gzipfull + " -d -f " + crxfiles[i];
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
 
                     crxfile = crxfiles[i].substr(0, (int)crxfiles[i].find_last_of('.'));
                     if (access(crxfile.c_str(), 0) == -1) continue;
-                    std::string site = crxfiles[i].substr(0, 4);
+                    std::string site = crxfiles[i].substr(crxfiles[i].find_last_of("/\\") + 1, 4);
                     CString::ToLower(site);
                     std::string ofile = site + sdoy + sch + "." + syy + "o";
                     /* convert from 'd' file to 'o' file */
@@ -2270,7 +3781,7 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else          /* for Linux or Mac */
                     cmd = "cat " + crxfile + " | " + crx2rnxfull + " -f - > " + ofile;
 #endif
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
 
                     /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
@@ -2278,7 +3789,7 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                     cmd = "rm -rf " + crxfile;
 #endif
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
                 }
             }
 
@@ -2297,22 +3808,31 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
             /* it is OK for '*.Z' or '*.gz' format */
             std::string dfile = "*" + sdoy + sch + "." + syy + "d";
             std::string dxfile = dfile + ".*";
-            cmd = wgetfull + " " + qr + " -nH -A " + dxfile + cutdirs + url;
-            std::system(cmd.c_str());
+            /* only the IGS files of the sites NOT obtained from MGEX are downloaded, by direct GETs of the names listed */
+            std::vector<std::string> ifiles;
+            if (GetIgmPlan(url, dxfile, fopt, ifiles))
+            {
+                for (size_t j = 0; j < ifiles.size(); j++) GetExactFile(url, ifiles[j], fopt);
+            }
+            else
+            {
+                cmd = wgetfull + " " + qr + " -nH -A " + dxfile + cutdirs + url;
+                RunWget(cmd, fopt);
+            }
 
             /* get the file list */
             suffix = "." + syy + "d";
             std::vector<std::string> dfiles;
-            CString::GetFilesAll(shhdir, suffix, dfiles);
+            GetFilesAll(shhdir, suffix, dfiles);
             for (size_t i = 0; i < dfiles.size(); i++)
             {
                 if (access(dfiles[i].c_str(), 0) == 0)
                 {
                     /* extract it */
                     cmd = gzipfull + " -d -f " + dfiles[i];
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
 
-                    std::string site = dfiles[i].substr(0, 4);
+                    std::string site = dfiles[i].substr(dfiles[i].find_last_of("/\\") + 1, 4);
                     CString::ToLower(site);
                     dfile = site + sdoy + sch + "." + syy + "d";
                     if (access(dfile.c_str(), 0) == -1) continue;
@@ -2325,7 +3845,7 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                         cmd = "rm -rf " + dfile;
 #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
 
                         continue;
                     }
@@ -2335,7 +3855,7 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else          /* for Linux or Mac */
                     cmd = "cat " + dfile + " | " + crx2rnxfull + " -f - > " + ofile;
 #endif
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
 
                     /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
@@ -2343,7 +3863,7 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                     cmd = "rm -rf " + dfile;
 #endif
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
                 }
             }
         }
@@ -2382,7 +3902,7 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                         std::string cmd = "mkdir -p " + shhdir;
 #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                     }
 
                     /* change directory */
@@ -2400,7 +3920,7 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                     CString::ToLower(sitname);
                     std::string ofile = sitname + sdoy + sch + "." + syy + "o";
                     std::string dfile = sitname + sdoy + sch + "." + syy + "d";
-                    if (access(ofile.c_str(), 0) == -1 && access(dfile.c_str(), 0) == -1)
+                    if (!IsCommitted(shhdir + sep + ofile) && access(ofile.c_str(), 0) == -1 && access(dfile.c_str(), 0) == -1)
                     {
                         /* download the MGEX observation file site-by-site */
                         std::string url, cutdirs = " --cut-dirs=7 ";
@@ -2420,12 +3940,12 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                         std::string crxfile = sitname + "*" + syyyy + sdoy + shh + "00_01H_30S_MO.crx";
                         std::string crxxfile = crxfile + ".*";
                         std::string cmd = wgetfull + " " + qr + " -nH -A " + crxxfile + cutdirs + url;
-                        std::system(cmd.c_str());
+                        RunWget(cmd, fopt);
 
                         /* extract '*.gz' */
                         std::string crxgzFile = crxfile + ".gz";
                         cmd = gzipfull + " -d -f " + crxgzFile;
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                         std::string change_filename;
 #ifdef _WIN32  /* for Windows */
                         change_filename = "rename";
@@ -2433,7 +3953,7 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                         change_filename = "mv";
 #endif
                         cmd = change_filename + " " + crxfile + " " + dfile;
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
 
                         char tmpfile[MAXSTRPATH] = { '\0' };
                         char sep = (char)FILEPATHSEP;
@@ -2444,35 +3964,29 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                             /* extract '*.Z' */
                             std::string crxzFile = crxfile + ".Z";
                             cmd = gzipfull + " -d -f " + crxzFile;
-                            std::system(cmd.c_str());
+                            ProfUtil::System(cmd);
 
                             cmd = change_filename + " " + crxfile + " " + dfile;
-                            std::system(cmd.c_str());
+                            ProfUtil::System(cmd);
                             if (access(dfile.c_str(), 0) == -1)
                             {
                                 /* download the IGS observation file site-by-site */
                                 if (ftpname == "CDDIS") url = ftparchive_.CDDIS[IDX_OBSH] + "/" +
                                     syyyy + "/" + sdoy + "/" + shh;
-                                else if (ftpname == "IGN")
-                                {
-                                    url = ftparchive_.IGN[IDX_OBSH] + "/" + syyyy + "/" + sdoy;
-                                    cutdirs = " --cut-dirs=6 ";
-                                }
+                                else if (ftpname == "IGN") url = ftparchive_.IGN[IDX_OBSH] + "/" + syyyy + "/" + sdoy;
                                 else if (ftpname == "WHU") url = ftparchive_.WHU[IDX_OBSH] + "/" +
                                     syyyy + "/" + sdoy + "/" + shh;
                                 else url = ftparchive_.CDDIS[IDX_OBSH] + "/" + syyyy + "/" + sdoy + "/" + shh;
 
-                                /* it is OK for '*.Z' or '*.gz' format */
-                                std::string dxfile = dfile + ".*";
-                                std::string cmd = wgetfull + " " + qr + " -nH -A " + dxfile + cutdirs + url;
-                                std::system(cmd.c_str());
+                                /* it is OK for '*.Z' or '*.gz' format, and the exact file is fetched without listing the remote directory */
+                                GetExactFile(url, dfile, fopt);
 
-                                std::string dgzfile = dfile + ".gz", dzfile = dfile + ".Z";
+                                std::string cmd, dgzfile = dfile + ".gz", dzfile = dfile + ".Z";
                                 if (access(dgzfile.c_str(), 0) == 0)
                                 {
                                     /* extract '*.gz' */
                                     cmd = gzipfull + " -d -f " + dgzfile;
-                                    std::system(cmd.c_str());
+                                    ProfUtil::System(cmd);
 
                                     if (access(dfile.c_str(), 0) == 0 && access(dzfile.c_str(), 0) == 0)
                                     {
@@ -2482,25 +3996,23 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                                         cmd = "rm -rf " + dzfile;
 #endif
-                                        std::system(cmd.c_str());
+                                        ProfUtil::System(cmd);
                                     }
                                 }
                                 if (access(dfile.c_str(), 0) == -1 && access(dzfile.c_str(), 0) == 0)
                                 {
                                     /* extract '*.Z' */
                                     cmd = gzipfull + " -d -f " + dzfile;
-                                    std::system(cmd.c_str());
+                                    ProfUtil::System(cmd);
                                 }
                                 if (access(dfile.c_str(), 0) == -1)
                                 {
                                     Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetHourlyObsIgm): failed to download IGM Hourly observation file " + ofile);
 
                                     std::string url0 = url + '/' + crxxfile;
-                                    if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetHourlyObsIgm): " << url0 <<
-                                        "  ->  " << localfile << "  failed" << std::endl;
-                                    url0 = url + '/' + dxfile;
-                                    if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetHourlyObsIgm): " << url0 <<
-                                        "  ->  " << localfile << "  failed" << std::endl;
+                                    LogXfer("GetHourlyObsIgm", url0, localfile, false);
+                                    url0 = url + '/' + dfile + ".*";
+                                    LogXfer("GetHourlyObsIgm", url0, localfile, false);
 
                                     continue;
                                 }
@@ -2512,14 +4024,13 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else          /* for Linux or Mac */
                         cmd = "cat " + dfile + " | " + crx2rnxfull + " -f - > " + ofile;
 #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
 
                         if (access(ofile.c_str(), 0) == 0)
                         {
                             Logger::Trace(TINFO, "*** INFO(FtpUtil::GetHourlyObsIgm ): successfully download IGM hourly observation file " + ofile);
 
-                            if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetHourlyObsIgm): " << ofile << "  ->  " <<
-                                localfile << "  OK" << std::endl;
+                            LogXfer("GetHourlyObsIgm", ofile, localfile, true);
 
                             /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
@@ -2527,7 +4038,7 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                             cmd = "rm -rf " + dfile;
 #endif
-                            std::system(cmd.c_str());
+                            ProfUtil::System(cmd);
                         }
                     }
                     else Logger::Trace(TINFO, "*** INFO(FtpUtil::GetHourlyObsIgm ): IGM hourly observation file " + ofile +
@@ -2565,7 +4076,7 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
         std::string cmd = "mkdir -p " + subdir;
 #endif
-        std::system(cmd.c_str());
+        ProfUtil::System(cmd);
     }
 
     /* compute day of year */
@@ -2600,7 +4111,7 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                 std::string cmd = "mkdir -p " + shhdir;
 #endif
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
             }
 
             /* change directory */
@@ -2630,7 +4141,7 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
             std::string crxfile = "*_15M_01S_MO.crx";
             std::string crxxfile = crxfile + ".*";
             std::string cmd = wgetfull + " " + qr + " -nH -A " + crxxfile + cutdirs + url;
-            std::system(cmd.c_str());
+            RunWget(cmd, fopt);
 
             /* 'a' = 97, 'b' = 98, ... */
             int ii = fopt->hhobs[i] + 97;
@@ -2644,7 +4155,7 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                 /* get the file list */
                 std::string suffix = smin[i] + "_15M_01S_MO.crx";
                 std::vector<std::string> crxfiles;
-                CString::GetFilesAll(shhdir, suffix, crxfiles);
+                GetFilesAll(shhdir, suffix, crxfiles);
                 std::string sitname;
                 for (size_t j = 0; j < crxfiles.size(); j++)
                 {
@@ -2652,11 +4163,11 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                     {
                         /* extract it */
                         cmd = gzipfull + " -d -f " + crxfiles[j];
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
 
                         crxfile = crxfiles[j].substr(0, (int)crxfiles[j].find_last_of('.'));
                         if (access(crxfile.c_str(), 0) == -1) continue;
-                        std::string site = crxfiles[j].substr(0, 4);
+                        std::string site = crxfiles[j].substr(crxfiles[j].find_last_of("/\\") + 1, 4);
                         CString::ToLower(site);
                         std::string ofile = site + sdoy + sch + smin[i] + "." + syy + "o";
                         /* convert from 'd' file to 'o' file */
@@ -2665,7 +4176,7 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else          /* for Linux or Mac */
                         cmd = "cat " + crxfile + " | " + crx2rnxfull + " -f - > " + ofile;
 #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
 
                         /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
@@ -2673,7 +4184,7 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                         cmd = "rm -rf " + crxfile;
 #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                     }
                 }
             }
@@ -2696,15 +4207,25 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
             /* it is OK for '*.Z' or '*.gz' format */
             std::string dfile = "*" + sdoy + sch + "*." + syy + "d";
             std::string dxfile = dfile + ".*";
-            cmd = wgetfull + " " + qr + " -nH -A " + dxfile + cutdirs + url;
-            std::system(cmd.c_str());
+            /* only the IGS files of the sites NOT obtained from MGEX in this quarter are downloaded, by direct GETs of the
+               names listed */
+            std::vector<std::string> ifiles;
+            if (GetIgmPlan(url, dxfile, fopt, ifiles))
+            {
+                for (size_t j = 0; j < ifiles.size(); j++) GetExactFile(url, ifiles[j], fopt);
+            }
+            else
+            {
+                cmd = wgetfull + " " + qr + " -nH -A " + dxfile + cutdirs + url;
+                RunWget(cmd, fopt);
+            }
 
             for (size_t i = 0; i < smin.size(); i++)
             {
                 /* get the file list */
                 std::string suffix = smin[i] + "." + syy + "d";
                 std::vector<std::string> dfiles;
-                CString::GetFilesAll(shhdir, suffix, dfiles);
+                GetFilesAll(shhdir, suffix, dfiles);
                 std::string sitname;
                 for (size_t j = 0; j < dfiles.size(); j++)
                 {
@@ -2712,20 +4233,32 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                     {
                         /* extract it */
                         cmd = gzipfull + " -d -f " + dfiles[j];
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
 
-                        std::string site = dfiles[j].substr(0, 4);
+                        std::string site = dfiles[j].substr(dfiles[j].find_last_of("/\\") + 1, 4);
                         CString::ToLower(site);
                         dfile = site + sdoy + sch + smin[i] + "." + syy + "d";
                         if (access(dfile.c_str(), 0) == -1) continue;
                         std::string ofile = site + sdoy + sch + smin[i] + "." + syy + "o";
+                        if (access(ofile.c_str(), 0) == 0)
+                        {
+                            /* delete 'd' file, MGEX takes priority */
+#ifdef _WIN32   /* for Windows */
+                            cmd = "del " + dfile;
+#else           /* for Linux or Mac */
+                            cmd = "rm -rf " + dfile;
+#endif
+                            ProfUtil::System(cmd);
+
+                            continue;
+                        }
                         /* convert from 'd' file to 'o' file */
 #ifdef _WIN32  /* for Windows */
                         cmd = crx2rnxfull + " " + dfile + " -f - > " + ofile;
 #else          /* for Linux or Mac */
                         cmd = "cat " + dfile + " | " + crx2rnxfull + " -f - > " + ofile;
 #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
 
                         /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
@@ -2733,7 +4266,7 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                         cmd = "rm -rf " + dfile;
 #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                     }
                 }
             }
@@ -2775,7 +4308,7 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                         std::string cmd = "mkdir -p " + shhdir;
 #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                     }
 
                     /* change directory */
@@ -2797,7 +4330,7 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                         CString::ToLower(sitname);
                         std::string ofile = sitname + sdoy + sch + smin[i] + "." + syy + "o";
                         std::string dfile = sitname + sdoy + sch + smin[i] + "." + syy + "d";
-                        if (access(ofile.c_str(), 0) == -1 && access(dfile.c_str(), 0) == -1)
+                        if (!IsCommitted(shhdir + sep + ofile) && access(ofile.c_str(), 0) == -1 && access(dfile.c_str(), 0) == -1)
                         {
                             std::string url, cutdirs = " --cut-dirs=8 ";
                             if (ftpname == "CDDIS") url = ftparchive_.CDDIS[IDX_OBMHR] + "/" +
@@ -2820,12 +4353,12 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                             std::string crxfile = sitname + "*" + syyyy + sdoy + shh + smin[i] + "_15M_01S_MO.crx";
                             std::string crxxfile = crxfile + ".*";
                             std::string cmd = wgetfull + " " + qr + " -nH -A " + crxxfile + cutdirs + url;
-                            std::system(cmd.c_str());
+                            RunWget(cmd, fopt);
 
                             /* extract '*.gz' */
                             std::string crxgzFile = crxfile + ".gz";
                             cmd = gzipfull + " -d -f " + crxgzFile;
-                            std::system(cmd.c_str());
+                            ProfUtil::System(cmd);
                             std::string change_filename;
 #ifdef _WIN32  /* for Windows */
                             change_filename = "rename";
@@ -2833,7 +4366,7 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                             change_filename = "mv";
 #endif
                             cmd = change_filename + " " + crxfile + " " + dfile;
-                            std::system(cmd.c_str());
+                            ProfUtil::System(cmd);
 
                             char tmpfile[MAXSTRPATH] = { '\0' };
                             char sep = (char)FILEPATHSEP;
@@ -2844,39 +4377,30 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                                 /* extract '*.Z' */
                                 std::string crxzFile = crxfile + ".Z";
                                 cmd = gzipfull + " -d -f " + crxzFile;
-                                std::system(cmd.c_str());
+                                ProfUtil::System(cmd);
 
                                 cmd = change_filename + " " + crxfile + " " + dfile;
-                                std::system(cmd.c_str());
+                                ProfUtil::System(cmd);
                                 if (access(dfile.c_str(), 0) == -1)
                                 {
                                     if (ftpname == "CDDIS") url = ftparchive_.CDDIS[IDX_OBSHR] + "/" +
                                         syyyy + "/" + sdoy + "/" + syy + "d" + "/" + shh;
-                                    else if (ftpname == "IGN")
-                                    {
-                                        url = ftparchive_.IGN[IDX_OBSHR] + "/" + syyyy + "/" + sdoy;
-                                        cutdirs = " --cut-dirs=6 ";
-                                    }
-                                    else if (ftpname == "WHU")
-                                    {
-                                        url = ftparchive_.WHU[IDX_OBSHR] + "/" + syyyy + "/" + sdoy + "/" + syy +
-                                            "d" + "/" + shh;
-                                        cutdirs = " --cut-dirs=6 ";
-                                    }
+                                    else if (ftpname == "IGN") url = ftparchive_.IGN[IDX_OBSHR] + "/" + syyyy + "/" +
+                                        sdoy;
+                                    else if (ftpname == "WHU") url = ftparchive_.WHU[IDX_OBSHR] + "/" + syyyy + "/" +
+                                        sdoy + "/" + syy + "d" + "/" + shh;
                                     else url = ftparchive_.CDDIS[IDX_OBSHR] + "/" + syyyy + "/" + sdoy + "/" + syy +
                                         "d" + "/" + shh;
 
-                                    /* it is OK for '*.Z' or '*.gz' format */
-                                    std::string dxfile = dfile + ".*";
-                                    cmd = wgetfull + " " + qr + " -nH -A " + dxfile + cutdirs + url;
-                                    std::system(cmd.c_str());
+                                    /* it is OK for '*.Z' or '*.gz' format, and the exact file is fetched without listing the remote directory */
+                                    GetExactFile(url, dfile, fopt);
 
                                     std::string dgzfile = dfile + ".gz", dzfile = dfile + ".Z";
                                     if (access(dgzfile.c_str(), 0) == 0)
                                     {
                                         /* extract '*.gz' */
                                         cmd = gzipfull + " -d -f " + dgzfile;
-                                        std::system(cmd.c_str());
+                                        ProfUtil::System(cmd);
 
                                         if (access(dfile.c_str(), 0) == 0 && access(dzfile.c_str(), 0) == 0)
                                         {
@@ -2886,25 +4410,23 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                                             cmd = "rm -rf " + dzfile;
 #endif
-                                            std::system(cmd.c_str());
+                                            ProfUtil::System(cmd);
                                         }
                                     }
                                     if (access(dfile.c_str(), 0) == -1 && access(dzfile.c_str(), 0) == 0)
                                     {
                                         /* extract '*.Z' */
                                         cmd = gzipfull + " -d -f " + dzfile;
-                                        std::system(cmd.c_str());
+                                        ProfUtil::System(cmd);
                                     }
                                     if (access(dfile.c_str(), 0) == -1)
                                     {
                                         Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetHrObsIgm): failed to download IGM high-rate observation file " + ofile);
 
                                         std::string url0 = url + '/' + crxxfile;
-                                        if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetHrObsIgm): " << url0 <<
-                                            "  ->  " << localfile << "  failed" << std::endl;
-                                        url0 = url + '/' + dxfile;
-                                        if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetHrObsIgm): " << url0 <<
-                                            "  ->  " << localfile << "  failed" << std::endl;
+                                        LogXfer("GetHrObsIgm", url0, localfile, false);
+                                        url0 = url + '/' + dfile + ".*";
+                                        LogXfer("GetHrObsIgm", url0, localfile, false);
 
                                         continue;
                                     }
@@ -2916,14 +4438,13 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else          /* for Linux or Mac */
                             cmd = "cat " + dfile + " | " + crx2rnxfull + " -f - > " + ofile;
 #endif
-                            std::system(cmd.c_str());
+                            ProfUtil::System(cmd);
 
                             if (access(ofile.c_str(), 0) == 0)
                             {
                                 Logger::Trace(TINFO, "*** INFO(FtpUtil::GetHrObsIgm): successfully download IGM high-rate observation file " + ofile);
 
-                                if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetHrObsIgm): " << ofile << "  ->  " <<
-                                    localfile << "  OK" << std::endl;
+                                LogXfer("GetHrObsIgm", ofile, localfile, true);
 
                                 /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
@@ -2931,7 +4452,7 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                                 cmd = "rm -rf " + dfile;
 #endif
-                                std::system(cmd.c_str());
+                                ProfUtil::System(cmd);
                             }
                         }
                         else Logger::Trace(TINFO, "*** INFO(FtpUtil::GetHrObsIgm): IGM high-rate observation file " + ofile +
@@ -2970,7 +4491,7 @@ void FtpUtil::GetDailyObsCut(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
         std::string cmd = "mkdir -p " + subdir;
 #endif
-        std::system(cmd.c_str());
+        ProfUtil::System(cmd);
     }
 
     /* change directory */
@@ -3010,18 +4531,18 @@ void FtpUtil::GetDailyObsCut(gtime_t ts, std::string dir, const ftpopt_t* fopt)
             sitname = site.substr(0, 4);
             CString::ToLower(sitname);
             std::string ofile = sitname + sdoy + "0." + syy + "o";
-            if (access(ofile.c_str(), 0) == -1)
+            if (!IsCommitted(subdir + sep + ofile) && access(ofile.c_str(), 0) == -1)
             {
                 /* it is OK for '*.gz' format */
                 CString::ToUpper(sitname);
                 std::string crxfile = sitname + "00AUS_R_" + syyyy + sdoy + "0000_01D_30S_MO.crx";
                 std::string crxgzFile = crxfile + ".gz";
                 std::string cmd = wgetfull + " " + qr + " -nH " + cutdirs + url + "/" + crxgzFile;
-                std::system(cmd.c_str());
+                RunWget(cmd, fopt);
 
                 /* extract '*.gz' */
                 cmd = gzipfull + " -d -f " + crxgzFile;
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
 
                 char tmpfile[MAXSTRPATH] = { '\0' };
                 char sep = (char)FILEPATHSEP;
@@ -3032,8 +4553,7 @@ void FtpUtil::GetDailyObsCut(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                     Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetDailyObsCut): failed to download CUT daily observation file " + ofile);
 
                     std::string url0 = url + '/' + crxgzFile;
-                    if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetDailyObsCut): " << url0 << "  ->  " <<
-                        localfile << "  failed" << std::endl;
+                    LogXfer("GetDailyObsCut", url0, localfile, false);
 
                     continue;
                 }
@@ -3043,15 +4563,14 @@ void FtpUtil::GetDailyObsCut(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else          /* for Linux or Mac */
                 cmd = "cat " + crxfile + " | " + crx2rnxfull + " -f - > " + ofile;
 #endif
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
 
                 if (access(ofile.c_str(), 0) == 0)
                 {
                     Logger::Trace(TINFO, "*** INFO(FtpUtil::GetDailyObsCut): successfully download CUT daily observation file " + ofile);
 
                     std::string url0 = url + '/' + crxgzFile;
-                    if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetDailyObsCut): " << url0 << "  ->  " <<
-                        localfile << "  OK" << std::endl;
+                    LogXfer("GetDailyObsCut", url0, localfile, true);
 
                     /* delete 'crx' file */
 #ifdef _WIN32   /* for Windows */
@@ -3059,7 +4578,7 @@ void FtpUtil::GetDailyObsCut(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                     cmd = "rm -rf " + crxfile;
 #endif
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
                 }
             }
             else Logger::Trace(TINFO, "*** INFO(FtpUtil::GetDailyObsCut): CUT daily observation file " +
@@ -3095,7 +4614,7 @@ void FtpUtil::Get30sObsHk(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
         std::string cmd = "mkdir -p " + subdir;
 #endif
-        std::system(cmd.c_str());
+        ProfUtil::System(cmd);
     }
 
     /* change directory */
@@ -3137,18 +4656,18 @@ void FtpUtil::Get30sObsHk(gtime_t ts, std::string dir, const ftpopt_t* fopt)
             CString::ToLower(sitname);
             std::string ofile = sitname + sdoy + "0." + syy + "o";
             std::string url = url0 + "/" + sitname + "/30s";
-            if (access(ofile.c_str(), 0) == -1)
+            if (!IsCommitted(subdir + sep + ofile) && access(ofile.c_str(), 0) == -1)
             {
                 /* it is OK for '*.gz' format */
                 CString::ToUpper(sitname);
                 std::string crxfile = sitname + "00HKG_R_" + syyyy + sdoy + "0000_01D_30S_MO.crx";
                 std::string crxgzFile = crxfile + ".gz";
                 std::string cmd = wgetfull + " " + qr + " -nH " + cutdirs + url + "/" + crxgzFile;
-                std::system(cmd.c_str());
+                RunWget(cmd, fopt);
 
                 /* extract '*.gz' */
                 cmd = gzipfull + " -d -f " + crxgzFile;
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
 
                 char tmpfile[MAXSTRPATH] = { '\0' };
                 char sep = (char)FILEPATHSEP;
@@ -3159,8 +4678,7 @@ void FtpUtil::Get30sObsHk(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                     Logger::Trace(TWARNING, "*** WARNING(FtpUtil::Get30sObsHk): failed to download HK CORS 30s observation file " + ofile);
 
                     std::string url0 = url + '/' + crxgzFile;
-                    if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::Get30sObsHk): " << url0 << "  ->  " <<
-                        localfile << "  failed" << std::endl;
+                    LogXfer("Get30sObsHk", url0, localfile, false);
 
                     continue;
                 }
@@ -3170,15 +4688,14 @@ void FtpUtil::Get30sObsHk(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else          /* for Linux or Mac */
                 cmd = "cat " + crxfile + " | " + crx2rnxfull + " -f - > " + ofile;
 #endif
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
 
                 if (access(ofile.c_str(), 0) == 0)
                 {
                     Logger::Trace(TINFO, "*** INFO(FtpUtil::Get30sObsHk): successfully download HK CORS 30s observation file " + ofile);
 
                     std::string url0 = url + '/' + crxgzFile;
-                    if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::Get30sObsHk): " << url0 << "  ->  " <<
-                        localfile << "  OK" << std::endl;
+                    LogXfer("Get30sObsHk", url0, localfile, true);
 
                     /* delete 'crx' file */
 #ifdef _WIN32   /* for Windows */
@@ -3186,7 +4703,7 @@ void FtpUtil::Get30sObsHk(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                     cmd = "rm -rf " + crxfile;
 #endif
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
                 }
             }
             else Logger::Trace(TINFO, "*** INFO(FtpUtil::Get30sObsHk): HK CORS 30s observation file " +
@@ -3222,7 +4739,7 @@ void FtpUtil::Get5sObsHk(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
         std::string cmd = "mkdir -p " + subdir;
 #endif
-        std::system(cmd.c_str());
+        ProfUtil::System(cmd);
     }
 
     /* change directory */
@@ -3277,7 +4794,7 @@ void FtpUtil::Get5sObsHk(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                     std::string cmd = "mkdir -p " + shhdir;
 #endif
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
                 }
 
                 /* change directory */
@@ -3295,18 +4812,18 @@ void FtpUtil::Get5sObsHk(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                 CString::ToLower(sitname);
                 std::string ofile = sitname + sdoy + sch + "." + syy + "o";
                 std::string url = url0 + "/" + sitname + "/5s";
-                if (access(ofile.c_str(), 0) == -1)
+                if (!IsCommitted(shhdir + sep + ofile) && access(ofile.c_str(), 0) == -1)
                 {
                     /* it is OK for '*.gz' format */
                     CString::ToUpper(sitname);
                     std::string crxfile = sitname + "00HKG_R_" + syyyy + sdoy + shh + "00_01H_05S_MO.crx";
                     std::string crxgzFile = crxfile + ".gz";
                     std::string cmd = wgetfull + " " + qr + " -nH " + cutdirs + url + "/" + crxgzFile;
-                    std::system(cmd.c_str());
+                    RunWget(cmd, fopt);
 
                     /* extract '*.gz' */
                     cmd = gzipfull + " -d -f " + crxgzFile;
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
 
                     char tmpfile[MAXSTRPATH] = { '\0' };
                     char sep = (char)FILEPATHSEP;
@@ -3317,8 +4834,7 @@ void FtpUtil::Get5sObsHk(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                         Logger::Trace(TWARNING, "*** WARNING(FtpUtil::Get5sObsHk): failed to download HK CORS 5s observation file " + ofile);
 
                         std::string url0 = url + '/' + crxgzFile;
-                        if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::Get5sObsHk): " << url0 << "  ->  " <<
-                            localfile << "  failed" << std::endl;
+                        LogXfer("Get5sObsHk", url0, localfile, false);
 
                         continue;
                     }
@@ -3328,15 +4844,14 @@ void FtpUtil::Get5sObsHk(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else          /* for Linux or Mac */
                     cmd = "cat " + crxfile + " | " + crx2rnxfull + " -f - > " + ofile;
 #endif
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
 
                     if (access(ofile.c_str(), 0) == 0)
                     {
                         Logger::Trace(TINFO, "*** INFO(FtpUtil::Get5sObsHk): successfully download HK CORS 5s observation file " + ofile);
 
                         std::string url0 = url + '/' + crxgzFile;
-                        if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::Get5sObsHk): " << url0 << "  ->  " <<
-                            localfile << "  OK" << std::endl;
+                        LogXfer("Get5sObsHk", url0, localfile, true);
 
                         /* delete 'crx' file */
 #ifdef _WIN32   /* for Windows */
@@ -3344,7 +4859,7 @@ void FtpUtil::Get5sObsHk(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                         cmd = "rm -rf " + crxfile;
 #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                     }
                 }
                 else Logger::Trace(TINFO, "*** INFO(FtpUtil::Get5sObsHk): HK CORS 5s observation file " + ofile + " has existed!");
@@ -3380,7 +4895,7 @@ void FtpUtil::Get1sObsHk(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
         std::string cmd = "mkdir -p " + subdir;
 #endif
-        std::system(cmd.c_str());
+        ProfUtil::System(cmd);
     }
 
     /* change directory */
@@ -3434,7 +4949,7 @@ void FtpUtil::Get1sObsHk(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                     std::string cmd = "mkdir -p " + shhdir;
 #endif
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
                 }
 
                 /* change directory */
@@ -3452,18 +4967,18 @@ void FtpUtil::Get1sObsHk(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                 CString::ToLower(sitname);
                 std::string ofile = sitname + sdoy + sch + "." + syy + "o";
                 std::string url = url0 + "/" + sitname + "/1s";
-                if (access(ofile.c_str(), 0) == -1)
+                if (!IsCommitted(shhdir + sep + ofile) && access(ofile.c_str(), 0) == -1)
                 {
                     /* it is OK for '*.gz' format */
                     CString::ToUpper(sitname);
                     std::string crxfile = sitname + "00HKG_R_" + syyyy + sdoy + shh + "00_01H_01S_MO.crx";
                     std::string crxgzFile = crxfile + ".gz";
                     std::string cmd = wgetfull + " " + qr + " -nH " + cutdirs + url + "/" + crxgzFile;
-                    std::system(cmd.c_str());
+                    RunWget(cmd, fopt);
 
                     /* extract '*.gz' */
                     cmd = gzipfull + " -d -f " + crxgzFile;
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
 
                     char tmpfile[MAXSTRPATH] = { '\0' };
                     char sep = (char)FILEPATHSEP;
@@ -3474,8 +4989,7 @@ void FtpUtil::Get1sObsHk(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                         Logger::Trace(TWARNING, "*** WARNING(FtpUtil::Get1sObsHk): failed to download HK CORS 1s observation file " + ofile);
 
                         std::string url0 = url + '/' + crxgzFile;
-                        if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::Get1sObsHk): " << url0 << "  ->  " <<
-                            localfile << "  failed" << std::endl;
+                        LogXfer("Get1sObsHk", url0, localfile, false);
 
                         continue;
                     }
@@ -3485,15 +4999,14 @@ void FtpUtil::Get1sObsHk(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else          /* for Linux or Mac */
                     cmd = "cat " + crxfile + " | " + crx2rnxfull + " -f - > " + ofile;
 #endif
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
 
                     if (access(ofile.c_str(), 0) == 0)
                     {
                         Logger::Trace(TINFO, "*** INFO(FtpUtil::Get1sObsHk): successfully download HK CORS 1s observation file " + ofile);
 
                         std::string url0 = url + '/' + crxgzFile;
-                        if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::Get1sObsHk): " << url0 << "  ->  " <<
-                            localfile << "  failed" << std::endl;
+                        LogXfer("Get1sObsHk", url0, localfile, false);
 
                         /* delete 'crx' file */
 #ifdef _WIN32   /* for Windows */
@@ -3501,7 +5014,7 @@ void FtpUtil::Get1sObsHk(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                         cmd = "rm -rf " + crxfile;
 #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                     }
                 }
                 else Logger::Trace(TINFO, "*** INFO(FtpUtil::Get1sObsHk): HK CORS 1s observation file " +
@@ -3538,7 +5051,7 @@ void FtpUtil::GetDailyObsNgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
         std::string cmd = "mkdir -p " + subdir;
 #endif
-        std::system(cmd.c_str());
+        ProfUtil::System(cmd);
     }
 
     /* change directory */
@@ -3579,17 +5092,17 @@ void FtpUtil::GetDailyObsNgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
             sitname = site.substr(0, 4);
             CString::ToLower(sitname);
             std::string ofile = sitname + sdoy + "0." + syy + "o";
-            if (access(ofile.c_str(), 0) == -1)
+            if (!IsCommitted(subdir + sep + ofile) && access(ofile.c_str(), 0) == -1)
             {
                 /* it is OK for '*.gz' format */
                 std::string dfile = sitname + sdoy + "0." + syy + "d";
                 std::string dgzfile = dfile + ".gz";
                 std::string cmd = wgetfull + " " + qr + " -nH " + cutdirs + url + "/" + sitname + "/" + dgzfile;
-                std::system(cmd.c_str());
+                RunWget(cmd, fopt);
 
                 /* extract '*.gz' */
                 cmd = gzipfull + " -d -f " + dgzfile;
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
 
                 char tmpfile[MAXSTRPATH] = { '\0' };
                 char sep = (char)FILEPATHSEP;
@@ -3600,8 +5113,7 @@ void FtpUtil::GetDailyObsNgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                     Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetDailyObsNgs): failed to download NGS/NOAA CORS daily observation file " + ofile);
 
                     std::string url0 = url + '/' + dgzfile;
-                    if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetDailyObsNgs): " << url0 << "  ->  " <<
-                        localfile << "  failed" << std::endl;
+                    LogXfer("GetDailyObsNgs", url0, localfile, false);
 
                     continue;
                 }
@@ -3611,15 +5123,14 @@ void FtpUtil::GetDailyObsNgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else          /* for Linux or Mac */
                 cmd = "cat " + dfile + " | " + crx2rnxfull + " -f - > " + ofile;
 #endif
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
 
                 if (access(ofile.c_str(), 0) == 0)
                 {
                     Logger::Trace(TINFO, "*** INFO(FtpUtil::GetDailyObsNgs): successfully download NGS/NOAA CORS daily observation file " + ofile);
 
                     std::string url0 = url + '/' + dgzfile;
-                    if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetDailyObsNgs): " << url0 << "  ->  " <<
-                        localfile << "  OK" << std::endl;
+                    LogXfer("GetDailyObsNgs", url0, localfile, true);
 
                     /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
@@ -3627,7 +5138,7 @@ void FtpUtil::GetDailyObsNgs(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                     cmd = "rm -rf " + dfile;
 #endif
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
                 }
             }
             else Logger::Trace(TINFO, "*** INFO(FtpUtil::GetDailyObsNgs): NGS/NOAA CORS daily observation file " +
@@ -3663,7 +5174,7 @@ void FtpUtil::GetDailyObsEpn(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
         std::string cmd = "mkdir -p " + subdir;
 #endif
-        std::system(cmd.c_str());
+        ProfUtil::System(cmd);
     }
 
     /* change directory */
@@ -3692,12 +5203,12 @@ void FtpUtil::GetDailyObsEpn(gtime_t ts, std::string dir, const ftpopt_t* fopt)
         std::string crxfile = "*" + syyyy + sdoy + "0000_01D_30S_MO.crx";
         std::string crxgzFile = crxfile + ".gz";
         std::string cmd = wgetfull + " " + qr + " -nH -A " + crxgzFile + cutdirs + url;
-        std::system(cmd.c_str());
+        RunWget(cmd, fopt);
 
         /* get the file list */
         std::string suffix = ".crx";
         std::vector<std::string> crxfiles;
-        CString::GetFilesAll(subdir, suffix, crxfiles);
+        GetFilesAll(subdir, suffix, crxfiles);
         std::string sitname;
         for (size_t i = 0; i < crxfiles.size(); i++)
         {
@@ -3705,7 +5216,7 @@ void FtpUtil::GetDailyObsEpn(gtime_t ts, std::string dir, const ftpopt_t* fopt)
             {
                 /* extract it */
                 cmd = gzipfull + " -d -f " + crxfiles[i];
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
 
                 crxfile = crxfiles[i].substr(0, (int)crxfiles[i].find_last_of('.'));
                 if (access(crxfile.c_str(), 0) == -1) continue;
@@ -3718,7 +5229,7 @@ void FtpUtil::GetDailyObsEpn(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else          /* for Linux or Mac */
                 cmd = "cat " + crxfile + " | " + crx2rnxfull + " -f - > " + ofile;
 #endif
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
 
                 /* delete crxfile */
 #ifdef _WIN32   /* for Windows */
@@ -3726,7 +5237,7 @@ void FtpUtil::GetDailyObsEpn(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                 cmd = "rm -rf " + crxfile;
 #endif
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
             }
         }
     }
@@ -3753,18 +5264,18 @@ void FtpUtil::GetDailyObsEpn(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                 CString::ToLower(sitname);
                 std::string ofile = sitname + sdoy + "0." + syy + "o";
                 std::string dfile = sitname + sdoy + "0." + syy + "d";
-                if (access(ofile.c_str(), 0) == -1)
+                if (!IsCommitted(subdir + sep + ofile) && access(ofile.c_str(), 0) == -1)
                 {
                     /* it is OK for '*.gz' format */
                     CString::ToUpper(sitname);
                     std::string crxfile = sitname + "*" + syyyy + sdoy + "0000_01D_30S_MO.crx";
                     std::string crxgzFile = crxfile + ".gz";
                     std::string cmd = wgetfull + " " + qr + " -nH -A " + crxgzFile + cutdirs + url;
-                    std::system(cmd.c_str());
+                    RunWget(cmd, fopt);
 
                     /* extract '*.gz' */
                     cmd = gzipfull + " -d -f " + crxgzFile;
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
                     std::string change_filename;
 #ifdef _WIN32  /* for Windows */
                     change_filename = "rename";
@@ -3772,7 +5283,7 @@ void FtpUtil::GetDailyObsEpn(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                     change_filename = "mv";
 #endif
                     cmd = change_filename + " " + crxfile + " " + dfile;
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
 
                     char tmpfile[MAXSTRPATH] = { '\0' };
                     char sep = (char)FILEPATHSEP;
@@ -3783,8 +5294,7 @@ void FtpUtil::GetDailyObsEpn(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                         Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetDailyObsEpn): failed to download EPN daily observation file " + ofile);
 
                         std::string url0 = url + '/' + crxgzFile;
-                        if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetDailyObsEpn): " << url0 << "  ->  " <<
-                            localfile << "  failed" << std::endl;
+                        LogXfer("GetDailyObsEpn", url0, localfile, false);
 
                         continue;
                     }
@@ -3794,15 +5304,14 @@ void FtpUtil::GetDailyObsEpn(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else          /* for Linux or Mac */
                     cmd = "cat " + dfile + " | " + crx2rnxfull + " -f - > " + ofile;
 #endif
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
 
                     if (access(ofile.c_str(), 0) == 0)
                     {
                         Logger::Trace(TINFO, "*** INFO(FtpUtil::GetDailyObsEpn): successfully download EPN daily observation file " + ofile);
 
                         std::string url0 = url + '/' + crxgzFile;
-                        if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetDailyObsEpn): " << url0 << "  ->  " <<
-                            localfile << "  OK" << std::endl;
+                        LogXfer("GetDailyObsEpn", url0, localfile, true);
 
                         /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
@@ -3810,7 +5319,7 @@ void FtpUtil::GetDailyObsEpn(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                         cmd = "rm -rf " + dfile;
 #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                     }
                 }
                 else Logger::Trace(TINFO, "*** INFO(FtpUtil::GetDailyObsEpn): EPN daily observation file " +
@@ -3847,7 +5356,7 @@ void FtpUtil::GetDailyObsPbo(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
         std::string cmd = "mkdir -p " + subdir;
 #endif
-        std::system(cmd.c_str());
+        ProfUtil::System(cmd);
     }
 
     /* change directory */
@@ -3892,7 +5401,7 @@ void FtpUtil::GetDailyObsPbo(gtime_t ts, std::string dir, const ftpopt_t* fopt)
             CString::ToLower(sitname);
             std::string ofile = sitname + sdoy + "0." + syy + "o";
             std::string dfile = sitname + sdoy + "0." + syy + "d";
-            if (access(ofile.c_str(), 0) == -1 && access(dfile.c_str(), 0) == -1)
+            if (!IsCommitted(subdir + sep + ofile) && access(ofile.c_str(), 0) == -1 && access(dfile.c_str(), 0) == -1)
             {
                 /* it is OK for '*.gz' format */
                 CString::ToUpper(sitname);
@@ -3900,11 +5409,11 @@ void FtpUtil::GetDailyObsPbo(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                 std::string crxgzfile = crxfile + ".gz";
                 std::string cmd = wgetfull + " " + url + "/" + crxgzfile + auth;
                 std::cout << cmd << std::endl;
-                std::system(cmd.c_str());
+                RunWget(cmd, fopt);
 
                 /* extract '*.gz' */
                 cmd = gzipfull + " -d -f " + crxgzfile;
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
 
                 std::string sep;
                 sep.push_back((char)FILEPATHSEP);
@@ -3914,8 +5423,7 @@ void FtpUtil::GetDailyObsPbo(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                     Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetDailyObsPbo3): failed to download PBO daily observation file " + ofile);
 
                     std::string url0 = url + '/' + crxgzfile;
-                    if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetDailyObsPbo3): " << url0 << "  ->  " <<
-                        localfile << "  failed" << std::endl;
+                    LogXfer("GetDailyObsPbo3", url0, localfile, false);
                 }
                 else
                 {
@@ -3926,22 +5434,21 @@ void FtpUtil::GetDailyObsPbo(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                     change_filename = "mv";
 #endif
                     cmd = change_filename + " " + crxfile + " " + dfile;
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
 
 #ifdef _WIN32  /* for Windows */
                     cmd = crx2rnxfull + " " + dfile + " -f - > " + ofile;
 #else          /* for Linux or Mac */
                     cmd = "cat " + dfile + " | " + crx2rnxfull + " -f - > " + ofile;
 #endif
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
 
                     if (access(ofile.c_str(), 0) == 0)
                     {
                         Logger::Trace(TINFO, "*** INFO(FtpUtil::GetDailyObsPbo3): successfully download PBO daily observation file " + ofile);
 
                         std::string url0 = url + '/' + crxgzfile;
-                        if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetDailyObsPbo3): " << url0 << "  ->  " <<
-                            localfile << "  OK" << std::endl;
+                        LogXfer("GetDailyObsPbo3", url0, localfile, true);
 
                         /* delete 'd' file */
     #ifdef _WIN32   /* for Windows */
@@ -3949,7 +5456,7 @@ void FtpUtil::GetDailyObsPbo(gtime_t ts, std::string dir, const ftpopt_t* fopt)
     #else           /* for Linux or Mac */
                         cmd = "rm -rf " + dfile;
     #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                     }
                 }
             }
@@ -3986,7 +5493,7 @@ void FtpUtil::GetDailyObsChi(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
         std::string cmd = "mkdir -p " + subdir;
 #endif
-        std::system(cmd.c_str());
+        ProfUtil::System(cmd);
     }
 
     /* change directory */
@@ -4017,12 +5524,12 @@ void FtpUtil::GetDailyObsChi(gtime_t ts, std::string dir, const ftpopt_t* fopt)
         std::string dfile = "*" + sdoy + "0." + syy + "d";
         std::string dxfile = dfile + ".*";
         std::string cmd = wgetfull + " " + qr + " -nH -A " + dxfile + cutdirs + url;
-        std::system(cmd.c_str());
+        RunWget(cmd, fopt);
 
         /* get the file list */
         std::string suffix = "." + syy + "d";
         std::vector<std::string> dfiles;
-        CString::GetFilesAll(subdir, suffix, dfiles);
+        GetFilesAll(subdir, suffix, dfiles);
         std::string sitname;
         for (size_t i = 0; i < dfiles.size(); i++)
         {
@@ -4030,7 +5537,7 @@ void FtpUtil::GetDailyObsChi(gtime_t ts, std::string dir, const ftpopt_t* fopt)
             {
                 /* extract it */
                 cmd = gzipfull + " -d -f " + dfiles[i];
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
 
                 std::string site = dfiles[i].substr(0, 4);
                 dfile = site + sdoy + "0." + syy + "d";
@@ -4042,7 +5549,7 @@ void FtpUtil::GetDailyObsChi(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else          /* for Linux or Mac */
                 cmd = "cat " + dfile + " | " + crx2rnxfull + " -f - > " + ofile;
 #endif
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
 
                 /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
@@ -4050,7 +5557,7 @@ void FtpUtil::GetDailyObsChi(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                 cmd = "rm -rf " + dfile;
 #endif
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
             }
         }
     }
@@ -4077,20 +5584,18 @@ void FtpUtil::GetDailyObsChi(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                 CString::ToLower(sitname);
                 std::string ofile = sitname + sdoy + "0." + syy + "o";
                 std::string dfile = sitname + sdoy + "0." + syy + "d";
-                if (access(ofile.c_str(), 0) == -1 && access(dfile.c_str(), 0) == -1)
+                if (!IsCommitted(subdir + sep + ofile) && access(ofile.c_str(), 0) == -1 && access(dfile.c_str(), 0) == -1)
                 {
-                    /* it is OK for '*.Z' or '*.gz' format */
-                    std::string dxfile = dfile + ".*";
-                    std::string cmd = wgetfull + " " + qr + " -nH -A " + dxfile + cutdirs + url;
-                    std::system(cmd.c_str());
+                    /* it is OK for '*.Z' or '*.gz' format, and the exact file is fetched without listing the remote directory */
+                    GetExactFile(url, dfile, fopt);
 
-                    std::string dgzfile = dfile + ".gz", dzfile = dfile + ".Z";
+                    std::string cmd, dgzfile = dfile + ".gz", dzfile = dfile + ".Z";
                     bool isgz = false;
                     if (access(dgzfile.c_str(), 0) == 0)
                     {
                         /* extract '*.gz' */
                         cmd = gzipfull + " -d -f " + dgzfile;
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                         isgz = true;
 
                         if (access(dfile.c_str(), 0) == 0 && access(dzfile.c_str(), 0) == 0)
@@ -4101,7 +5606,7 @@ void FtpUtil::GetDailyObsChi(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                             cmd = "rm -rf " + dzfile;
 #endif
-                            std::system(cmd.c_str());
+                            ProfUtil::System(cmd);
                         }
                     }
 
@@ -4109,7 +5614,7 @@ void FtpUtil::GetDailyObsChi(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                     {
                         /* extract '*.Z' */
                         cmd = gzipfull + " -d -f " + dzfile;
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                         isgz = false;
                     }
 
@@ -4121,9 +5626,8 @@ void FtpUtil::GetDailyObsChi(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                     {
                         Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetDailyObsChi): failed to download CHI daily observation file " + ofile);
 
-                        std::string url0 = url + '/' + dxfile;
-                        if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetDailyObsChi): " << url0 << "  ->  " <<
-                            localfile << "  failed" << std::endl;
+                        std::string url0 = url + '/' + dfile + ".*";
+                        LogXfer("GetDailyObsChi", url0, localfile, false);
 
                         continue;
                     }
@@ -4133,17 +5637,14 @@ void FtpUtil::GetDailyObsChi(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else          /* for Linux or Mac */
                     cmd = "cat " + dfile + " | " + crx2rnxfull + " -f - > " + ofile;
 #endif
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
 
                     if (access(ofile.c_str(), 0) == 0)
                     {
                         Logger::Trace(TINFO, "*** INFO(FtpUtil::GetDailyObsChi): successfully download CHI daily observation file " + ofile);
 
-                        if (isgz) dxfile = dgzfile;
-                        else dxfile = dzfile;
-                        std::string url0 = url + '/' + dxfile;
-                        if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetDailyObsChi): " << url0 << "  ->  " <<
-                            localfile << "  OK" << std::endl;
+                        std::string url0 = url + '/' + (isgz ? dgzfile : dzfile);
+                        LogXfer("GetDailyObsChi", url0, localfile, true);
 
                         /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
@@ -4151,7 +5652,7 @@ void FtpUtil::GetDailyObsChi(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                         cmd = "rm -rf " + dfile;
 #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                     }
                 }
                 else Logger::Trace(TINFO, "*** INFO(FtpUtil::GetDailyObsChi): CHI daily observation file " +
@@ -4259,9 +5760,9 @@ void FtpUtil::GetNav(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                 if (navFrom == "DLR")
                 {
                     navfile = "BRDM00" + navFrom + "_S_" + syyyy + sdoy + "0000_01D_MN.rnx";
-                    if (ftpname != "CDDIS" && ftpname != "WHU")
+                    if (ftpname != "CDDIS" && ftpname != "WHU" && ftpname != "LOCAL")
                     {
-                        Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetNav): DLR mixed broadcast ephemeris file is ONLY downloaded from CDDIS or WHU FTP!");
+                        Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetNav): DLR mixed broadcast ephemeris file is ONLY downloaded from CDDIS (or its local mirror) or WHU FTP!");
                         return;
                     }
                 }
@@ -4295,11 +5796,12 @@ void FtpUtil::GetNav(gtime_t ts, std::string dir, const ftpopt_t* fopt)
             }
             else
             {
+                /* the exact file is fetched without listing the remote directory (i.e., the whole year of 'brdc') */
                 navxFile = navfile + ".*";
-                cmd = wgetfull + " " + qr + " -nH -A " + navxFile + cutdirs + url;
                 url0 = url + "/" + navxFile;
             }
-            std::system(cmd.c_str());
+            if (navFrom == "WRD") RunWget(cmd, fopt);
+            else GetExactFile(url, navfile, fopt);
 
             std::string navgzfile = navfile + ".gz", navzfile = navfile + ".Z";
             bool isgz = false;
@@ -4307,14 +5809,14 @@ void FtpUtil::GetNav(gtime_t ts, std::string dir, const ftpopt_t* fopt)
             {
                 /* extract '*.gz' */
                 cmd = gzipfull + " -d -f " + navgzfile;
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
                 isgz = true;
             }
             else if (access(navzfile.c_str(), 0) == 0)
             {
                 /* extract '*.Z' */
                 cmd = gzipfull + " -d -f " + navzfile;
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
                 isgz = false;
             }
 
@@ -4326,24 +5828,11 @@ void FtpUtil::GetNav(gtime_t ts, std::string dir, const ftpopt_t* fopt)
             {
                 Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetNav): failed to download broadcast ephemeris file " + navfile);
 
-                if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetNav): " << url0 << "  ->  " <<
-                    localfile << "  failed" << std::endl;
+                LogXfer("GetNav", url0, localfile, false);
             }
 
             /* to check if it needs to convert broadcast ehemeris files with long name to those with short name */
-            if (fopt->l2s4nav > 0 && (navSys == "mixed3" || navSys == "mixed4"))
-            {
-                std::string change_filename;
-#ifdef _WIN32  /* for Windows */
-                if (fopt->l2s4nav == 1) change_filename = "rename";
-                else if (fopt->l2s4nav == 2) change_filename = "copy";
-#else          /* for Linux or Mac */
-                if (fopt->l2s4nav == 1) change_filename = "mv";
-                else if (fopt->l2s4nav == 2) change_filename = "cp";
-#endif
-                cmd = change_filename + " " + navfile + " " + nav0File;
-                std::system(cmd.c_str());
-            }
+            if (fopt->l2s4nav > 0 && (navSys == "mixed3" || navSys == "mixed4")) LongToShort(navfile, nav0File, fopt->l2s4nav);
 
             if (navFrom == "GOP")
             {
@@ -4356,7 +5845,7 @@ void FtpUtil::GetNav(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else          /* for Linux or Mac */
                     cmd = "rm -rf " + tmpdir;
 #endif
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
                 }
             }
 
@@ -4367,8 +5856,7 @@ void FtpUtil::GetNav(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                 if (isgz) navxFile = navgzfile;
                 else navxFile = navzfile;
                 std::string url0 = url + '/' + navxFile;
-                if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetNav): " << url0 << "  ->  " <<
-                    localfile << "  OK" << std::endl;
+                LogXfer("GetNav", url0, localfile, true);
             }
         }
         else Logger::Trace(TINFO, "*** INFO(FtpUtil::GetNav): broadcast ephemeris file " + navfile +
@@ -4409,7 +5897,7 @@ void FtpUtil::GetNav(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                         std::string cmd = "mkdir -p " + shhdir;
 #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                     }
 
                     /* change directory */
@@ -4522,12 +6010,12 @@ void FtpUtil::GetNav(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                         std::string wgetfull = fopt->wgetfull, gzipfull = fopt->gzipfull, qr = fopt->qr;
                         std::string navxFile = navfiles[i] + ".*";
                         std::string cmd = wgetfull + " " + qr + " -nH -A " + navxFile + cutdirs + url;
-                        std::system(cmd.c_str());
+                        RunWget(cmd, fopt);
 
                         /* extract '*.gz' */
                         std::string navgzfile = navfiles[i] + ".gz";
                         cmd = gzipfull + " -d -f " + navgzfile;
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                         std::string change_filename;
 #ifdef _WIN32  /* for Windows */
                         change_filename = "rename";
@@ -4535,7 +6023,7 @@ void FtpUtil::GetNav(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                         change_filename = "mv";
 #endif
                         cmd = change_filename + " " + navfiles[i] + " " + nav0Files[i];
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                         bool isgz = true;
                         std::string navzfile;
                         char tmpfile[MAXSTRPATH] = { '\0' };
@@ -4547,10 +6035,10 @@ void FtpUtil::GetNav(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                             /* extract '*.Z' */
                             navzfile = navfiles[i] + ".Z";
                             cmd = gzipfull + " -d -f " + navzfile;
-                            std::system(cmd.c_str());
+                            ProfUtil::System(cmd);
 
                             cmd = change_filename + " " + navfiles[i] + " " + nav0Files[i];
-                            std::system(cmd.c_str());
+                            ProfUtil::System(cmd);
                             isgz = false;
                             if (access(nav0Files[i].c_str(), 0) == 0)
                             {
@@ -4559,8 +6047,7 @@ void FtpUtil::GetNav(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                                 if (isgz) navxFile = navgzfile;
                                 else navxFile = navzfile;
                                 std::string url0 = url + '/' + navxFile;
-                                if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetNav): " << url0 << "  ->  " <<
-                                    localfile << "  OK" << std::endl;
+                                LogXfer("GetNav", url0, localfile, true);
 
                                 continue;
                             }
@@ -4569,8 +6056,7 @@ void FtpUtil::GetNav(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                                 Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetNav): failed to download hourly broadcast ephemeris file " + navfiles[i]);
 
                                 std::string url0 = url + '/' + navxFile;
-                                if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetNav): " << url0 << "  ->  " <<
-                                    localfile << "  failed" << std::endl;
+                                LogXfer("GetNav", url0, localfile, false);
                             }
                         }
                         else
@@ -4580,8 +6066,7 @@ void FtpUtil::GetNav(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                             if (isgz) navxFile = navgzfile;
                             else navxFile = navzfile;
                             std::string url0 = url + '/' + navxFile;
-                            if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetNav): " << url0 << "  ->  " <<
-                                localfile << "  OK" << std::endl;
+                            LogXfer("GetNav", url0, localfile, true);
 
                             continue;
                         }
@@ -4642,15 +6127,15 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<std::string> dirs, int prodType,
             chdir(dirs[i].c_str());
 #endif
 
-            if (access(sp3clkfiles[i].c_str(), 0) == -1)
+            std::string url = "http://www.ppp-wizard.net/products/REAL_TIME/" + sp3clkgzfiles[i], vlds;
+            if (IsMutableToGet(url, sp3clkfiles[i], fopt, vlds))
             {
-                std::string url = "http://www.ppp-wizard.net/products/REAL_TIME/" + sp3clkgzfiles[i];
                 std::string cmd = wgetfull + " " + qr + " -nH --cut-dirs=2 " + url;
-                std::system(cmd.c_str());
+                RunWget(cmd, fopt, "", false);
 
                 /* extract '*.gz' */
                 cmd = gzipfull + " -d -f " + sp3clkgzfiles[i];
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
 
                 std::string localfile = dirs[i] + sep + sp3clkfiles[i];
                 if (access(sp3clkfiles[i].c_str(), 0) == 0)
@@ -4659,17 +6144,16 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<std::string> dirs, int prodType,
                     else if (i == 1) Logger::Trace(TINFO, "*** INFO(FtpUtil::GetOrbClk): successfully download CNES real-time precise clock file " + sp3clkfiles[i]);
 
 
-                    if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetOrbClk): " << url << "  ->  " <<
-                        localfile << "  OK" << std::endl;
+                    LogXfer("GetOrbClk", url, localfile, true);
                 }
                 else
                 {
                     if (i == 0) Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetOrbClk): failed to download CNES real-time precise orbit file " + sp3clkfiles[i]);
                     else if (i == 1) Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetOrbClk): failed to download CNES real-time precise clock file " + sp3clkfiles[i]);
 
-                    if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetOrbClk): " << url << "  ->  " <<
-                        localfile << "  failed" << std::endl;
+                    LogXfer("GetOrbClk", url, localfile, false);
                 }
+                EndMutableGet(url, sp3clkfiles[i], vlds, fopt);
 
                 /* delete some temporary directories */
                 std::vector<std::string> tmpdir = { "FORMAT_BIAIS_OFFI1", "FORMATBIAS_OFF_v1" };
@@ -4682,7 +6166,7 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<std::string> dirs, int prodType,
 #else          /* for Linux or Mac */
                         cmd = "rm -rf " + tmpdir[i];
 #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                     }
                 }
             }
@@ -4745,11 +6229,17 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<std::string> dirs, int prodType,
             idx = 3;
         }
 
-        for (size_t i = 0; i < fopt->hhorbclk[idx].size(); i++)
+        /* only the newest issued session is fetched for 'ocLatest', otherwise all the sessions configured */
+        std::vector<int> hhs = fopt->hhorbclk[idx];
+        if (fopt->ultralatest) hhs = GetLatestSessions(ts, url, ac, fopt);
+        bool islatest = false;
+        for (size_t i = 0; i < hhs.size() && !islatest; i++)
         {
-            std::string shh = CString::int2str(fopt->hhorbclk[idx][i], 2);
+            std::string shh = CString::int2str(hhs[i], 2);
             std::string sp3fileshort = acFile + swwww + sdow + "_" + shh + ".sp3";
-            if (access(sp3fileshort.c_str(), 0) == -1)
+            /* the remote file with '.gz' or '.Z' is not known beforehand, so the URL stored last time is validated */
+            std::string vlds;
+            if (IsMutableToGet("", sp3fileshort, fopt, vlds))
             {
                 std::string cmd, url0, sp3zfile, sp3gzfile, sp3xfile;
                 bool isgz = false;
@@ -4758,13 +6248,13 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<std::string> dirs, int prodType,
                     sp3zfile = sp3fileshort + ".Z";
                     url0 = url + "/" + sp3zfile;
                     cmd = wgetfull + " " + qr + " -nH " + cutdirs + url0;
-                    std::system(cmd.c_str());
+                    RunWget(cmd, fopt, "", false);
 
                     if (access(sp3zfile.c_str(), 0) == 0)
                     {
                         /* extract '*.Z' */
                         cmd = gzipfull + " -d -f " + sp3zfile;
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                         isgz = false;
                     }
                     else
@@ -4772,13 +6262,13 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<std::string> dirs, int prodType,
                         sp3gzfile = sp3fileshort + ".gz";
                         url0 = url + "/" + sp3gzfile;
                         cmd = wgetfull + " " + qr + " -nH " + cutdirs + url0;
-                        std::system(cmd.c_str());
+                        RunWget(cmd, fopt, "", false);
 
                         if (access(sp3gzfile.c_str(), 0) == 0)
                         {
                             /* extract '*.gz' */
                             cmd = gzipfull + " -d -f " + sp3gzfile;
-                            std::system(cmd.c_str());
+                            ProfUtil::System(cmd);
                             isgz = true;
                         }
                     }
@@ -4789,12 +6279,12 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<std::string> dirs, int prodType,
                     /* it is OK for '*.Z' or '*.gz' format */
                     sp3xfile = sp30File + ".*";
                     cmd = wgetfull + " " + qr + " -nH -A " + sp3xfile + cutdirs + url;
-                    std::system(cmd.c_str());
+                    RunWget(cmd, fopt);
 
                     /* extract '*.gz' */
                     sp3gzfile = sp30File + ".gz";
                     cmd = gzipfull + " -d -f " + sp3gzfile;
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
                     std::string change_filename;
 #ifdef _WIN32  /* for Windows */
                     change_filename = "rename";
@@ -4802,17 +6292,17 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<std::string> dirs, int prodType,
                     change_filename = "mv";
 #endif
                     cmd = change_filename + " " + sp30File + " " + sp3fileshort;
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
                     isgz = true;
                     if (access(sp3fileshort.c_str(), 0) == -1)
                     {
                         /* extract '*.Z' */
                         sp3zfile = sp30File + ".Z";
                         cmd = gzipfull + " -d -f " + sp3zfile;
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
 
                         cmd = change_filename + " " + sp30File + " " + sp3fileshort;
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                         isgz = false;
                     }
 
@@ -4820,10 +6310,9 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<std::string> dirs, int prodType,
                 }
                 else
                 {
-                    /* it is OK for '*.Z' or '*.gz' format */
+                    /* it is OK for '*.Z' or '*.gz' format, and the exact file is fetched without listing the remote directory */
                     sp3xfile = sp3fileshort + ".*";
-                    cmd = wgetfull + " " + qr + " -nH -A " + sp3xfile + cutdirs + url;
-                    std::system(cmd.c_str());
+                    GetExactFile(url, sp3fileshort, fopt, false);
 
                     sp3gzfile = sp3fileshort + ".gz";
                     sp3zfile = sp3fileshort + ".Z";
@@ -4831,14 +6320,14 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<std::string> dirs, int prodType,
                     {
                         /* extract '*.gz' */
                         cmd = gzipfull + " -d -f " + sp3gzfile;
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                         isgz = true;
                     }
                     if (access(sp3fileshort.c_str(), 0) == -1 && access(sp3zfile.c_str(), 0) == 0)
                     {
                         /* extract '*.Z' */
                         cmd = gzipfull + " -d -f " + sp3zfile;
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                         isgz = false;
                     }
 
@@ -4854,17 +6343,16 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<std::string> dirs, int prodType,
                     if (isgz) sp3xfile = sp3gzfile;
                     else sp3xfile = sp3zfile;
                     url0 = url + '/' + sp3xfile;
-                    if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetOrbClk): " << url0 << "  ->  " <<
-                        localfile << "  OK" << std::endl;
+                    LogXfer("GetOrbClk", url0, localfile, true);
                 }
                 else
                 {
                     Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetOrbClk): failed to download " + acname +
                         " ultra-rapid precise orbit file " + sp3fileshort);
 
-                    if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetOrbClk): " << url0 << "  ->  " <<
-                        localfile << "  failed" << std::endl;
+                    LogXfer("GetOrbClk", url0, localfile, false);
                 }
+                EndMutableGet(url0, sp3fileshort, vlds, fopt);
 
                 if (ac == "igs_u")
                 {
@@ -4877,13 +6365,25 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<std::string> dirs, int prodType,
 #else          /* for Linux or Mac */
                         cmd = "rm -rf " + tmpdir;
 #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                     }
                 }
             }
             else Logger::Trace(TINFO, "*** INFO(FtpUtil::GetOrbClk): " + acname + " ultra-rapid precise orbit file " +
                 sp3fileshort + " has existed!");
+
+            if (fopt->ultralatest && access(sp3fileshort.c_str(), 0) == 0)
+            {
+                /* the sessions older than the newest issued one are NOT needed */
+                islatest = true;
+                std::string latestfile = "latest_" + acFile + ".sp3";
+                if (SetLatestLink(latestfile, sp3fileshort)) Logger::Trace(TINFO, "*** INFO(FtpUtil::GetOrbClk): " +
+                    latestfile + " -> " + sp3fileshort);
+                else Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetOrbClk): failed to update " + latestfile);
+            }
         }
+        if (fopt->ultralatest && !islatest) Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetOrbClk): no " + acname +
+            " ultra-rapid precise orbit file of " + syyyy + "/" + sdoy + " has been issued yet");
     }
     else if (prodType == PROD_RAPID)  /* for rapid orbit and clock products  */
     {
@@ -4957,41 +6457,40 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<std::string> dirs, int prodType,
                 {
                     url0 = url + "/" + sp3clkzfiles[i];
                     cmd = wgetfull + " " + qr + " -nH " + cutdirs + url0;
-                    std::system(cmd.c_str());
+                    RunWget(cmd, fopt);
 
                     if (access(sp3zfile.c_str(), 0) == 0)
                     {
                         /* extract '*.Z' */
                         cmd = gzipfull + " -d -f " + sp3clkzfiles[i];
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                         isgz = false;
                     }
                     else
                     {
                         url0 = url + "/" + sp3clkgzfiles[i];
                         cmd = wgetfull + " " + qr + " -nH " + cutdirs + url0;
-                        std::system(cmd.c_str());
+                        RunWget(cmd, fopt);
 
                         if (access(sp3clkgzfiles[i].c_str(), 0) == 0)
                         {
                             /* extract '*.gz' */
                             cmd = gzipfull + " -d -f " + sp3clkgzfiles[i];
-                            std::system(cmd.c_str());
+                            ProfUtil::System(cmd);
                             isgz = true;
                         }
                     }
                 }
                 else
                 {
-                    /* it is OK for '*.Z' or '*.gz' format */
-                    cmd = wgetfull + " " + qr + " -nH -A " + sp3clkxfiles[i] + cutdirs + url;
-                    std::system(cmd.c_str());
+                    /* it is OK for '*.Z' or '*.gz' format, and the exact file is fetched without listing the remote directory */
+                    GetExactFile(url, sp3clkfiles[i], fopt);
 
                     if (access(sp3clkgzfiles[i].c_str(), 0) == 0)
                     {
                         /* extract '*.gz' */
                         cmd = gzipfull + " -d -f " + sp3clkgzfiles[i];
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                         isgz = true;
 
                         if (access(sp3clkfiles[i].c_str(), 0) == 0 && access(sp3clkzfiles[i].c_str(), 0) == 0)
@@ -5002,14 +6501,14 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<std::string> dirs, int prodType,
 #else           /* for Linux or Mac */
                             cmd = "rm -rf " + sp3clkzfiles[i];
 #endif
-                            std::system(cmd.c_str());
+                            ProfUtil::System(cmd);
                         }
                     }
                     if (access(sp3clkfiles[i].c_str(), 0) == -1 && access(sp3clkzfiles[i].c_str(), 0) == 0)
                     {
                         /* extract '*.Z' */
                         cmd = gzipfull + " -d -f " + sp3clkzfiles[i];
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                         isgz = false;
                     }
 
@@ -5028,8 +6527,7 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<std::string> dirs, int prodType,
                     if (isgz) sp3clkxfile = sp3clkgzfiles[i];
                     else sp3clkxfile = sp3clkzfiles[i];
                     std::string url0 = url + '/' + sp3clkxfile;
-                    if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetOrbClk): " << url0 << "  ->  " <<
-                        localfile << "  OK" << std::endl;
+                    LogXfer("GetOrbClk", url0, localfile, true);
                 }
                 else
                 {
@@ -5038,8 +6536,7 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<std::string> dirs, int prodType,
                     else if (i == 1) Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetOrbClk): failed to download " +
                         acname + " rapid precise clock file " + sp3clkfiles[i]);
 
-                    if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetOrbClk): " << url0 << "  ->  " <<
-                        localfile << "  failed" << std::endl;
+                    LogXfer("GetOrbClk", url0, localfile, false);
                 }
 
                 if (ac == "emr_r" || ac == "igs_r")
@@ -5055,7 +6552,7 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<std::string> dirs, int prodType,
 #else          /* for Linux or Mac */
                         cmd = "rm -rf " + tmpdir;
 #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                     }
                 }
             }
@@ -5145,11 +6642,9 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<std::string> dirs, int prodType,
         }
 
         std::vector<std::string> sp3clkfilelong = { sp3filelong, clkfilelong };
-        std::vector<std::string> sp3clkxfilelong = { sp3filelong + ".*", clkfilelong + ".*" };
         std::vector<std::string> sp3clkfileshort = { sp3fileshort, clkfileshort };
-        std::vector<std::string> sp3clkxfileshort = { sp3fileshort + ".*", clkfileshort + ".*" };
 
-        std::string url, cutdirs = " --cut-dirs=4 ";
+        std::string url;
         if (ftpname == "CDDIS") url = ftparchive_.CDDIS[IDX_SP3] + "/" + swwww;
         else if (ftpname == "IGN") url = ftparchive_.IGN[IDX_SP3] + "/" + swwww;
         else if (ftpname == "WHU") url = ftparchive_.WHU[IDX_SP3] + "/" + swwww;
@@ -5166,12 +6661,11 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<std::string> dirs, int prodType,
             int isfound = 0;  /* 1: long file name; 2: short filename */
             if (access(sp3clkfilelong[i].c_str(), 0) == -1 && access(sp3clkfileshort[i].c_str(), 0) == -1)
             {
-                /* it is OK for '*.Z' or '*.gz' format */
-                std::string cmd = wgetfull + " " + qr + " -nH -A " + sp3clkxfilelong[i] + cutdirs + url;
-                std::system(cmd.c_str());
+                /* it is OK for '*.Z' or '*.gz' format, and the exact file is fetched without listing the remote directory */
+                GetExactFile(url, sp3clkfilelong[i], fopt);
 
-                std::string sp3clkxfile, sp3clkfile;
-                CString::GetFile(dirs[i], sp3clkfilelong[i], sp3clkxfile);
+                std::string cmd, sp3clkxfile, sp3clkfile;
+                GetFile(dirs[i], sp3clkfilelong[i], sp3clkxfile);
                 if (access(sp3clkxfile.c_str(), 0) == 0)
                 {
                     sp3clkfile = sp3clkfilelong[i];
@@ -5180,10 +6674,9 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<std::string> dirs, int prodType,
                 else
                 {
                     /* it is OK for '*.Z' or '*.gz' format */
-                    cmd = wgetfull + " " + qr + " -nH -A " + sp3clkxfileshort[i] + cutdirs + url;
-                    std::system(cmd.c_str());
+                    GetExactFile(url, sp3clkfileshort[i], fopt);
 
-                    CString::GetFile(dirs[i], sp3clkfileshort[i], sp3clkxfile);
+                    GetFile(dirs[i], sp3clkfileshort[i], sp3clkxfile);
                     if (access(sp3clkxfile.c_str(), 0) == 0)
                     {
                         sp3clkfile = sp3clkfileshort[i];
@@ -5200,14 +6693,13 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<std::string> dirs, int prodType,
 
                     std::string localfile = dirs[i] + sep + sp3clkfile;
                     std::string url0 = url + '/' + sp3clkfile;
-                    if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetOrbClk): " << url0 << "  ->  " <<
-                        localfile << "  failed" << std::endl;
+                    LogXfer("GetOrbClk", url0, localfile, false);
                 }
                 else
                 {
                     /* extract '*.gz' or '*.Z' */
                     cmd = gzipfull + " -d -f " + sp3clkxfile;
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
                     if (access(sp3clkfile.c_str(), 0) == 0)
                     {
                         std::string localfile = dirs[i] + sep + sp3clkfile;
@@ -5217,23 +6709,10 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<std::string> dirs, int prodType,
                             acname + " final precise clock file " + sp3clkfile);
 
                         std::string url0 = url + '/' + sp3clkxfile;
-                        if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetOrbClk): " << url0 << "  ->  " <<
-                            localfile << "  OK" << std::endl;
+                        LogXfer("GetOrbClk", url0, localfile, true);
 
                         /* to check if it needs to convert precise orbit and clock files with long name to those with short name */
-                        if (isfound == 1 && fopt->l2s4oc > 0)
-                        {
-                            std::string change_filename;
-#ifdef _WIN32  /* for Windows */
-                            if (fopt->l2s4oc == 1) change_filename = "rename";
-                            else if (fopt->l2s4oc == 2) change_filename = "copy";
-#else          /* for Linux or Mac */
-                            if (fopt->l2s4oc == 1) change_filename = "mv";
-                            else if (fopt->l2s4oc == 2) change_filename = "cp";
-#endif
-                            cmd = change_filename + " " + sp3clkfilelong[i] + " " + sp3clkfileshort[i];
-                            std::system(cmd.c_str());
-                        }
+                        if (isfound == 1 && fopt->l2s4oc > 0) LongToShort(sp3clkfilelong[i], sp3clkfileshort[i], fopt->l2s4oc);
                     }
                 }
 
@@ -5246,7 +6725,7 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<std::string> dirs, int prodType,
 #else          /* for Linux or Mac */
                     cmd = "rm -rf " + tmpdir;
 #endif
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
                 }
             }
             else
@@ -5344,16 +6823,16 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<std::string> dirs, int prodType,
             chdir(dirs[i].c_str());
 #endif
             std::string sp3clkfilelong;
-            CString::GetFile(dirs[i], substr, sp3clkfilelong);
+            GetFile(dirs[i], substr, sp3clkfilelong);
             if (access(sp3clkfilelong.c_str(), 0) == -1 && access(sp3clkfileshort[i].c_str(), 0) == -1)
             {
                 /* it is OK for '*.Z' or '*.gz' format */
                 std::string cmd = wgetfull + " " + qr + " -nH -A " + sp3clkxfilelong[i] + cutdirs + url;
-                std::system(cmd.c_str());
+                RunWget(cmd, fopt);
 
                 /* the option of 'igsdepot.ign.fr' was added by fzhou @ SDUST, 2022/11/20 22:01:05 */
                 std::string sp3clkxfile;
-                CString::GetFile(dirs[i], substr, sp3clkxfile);
+                GetFile(dirs[i], substr, sp3clkxfile);
                 if (access(sp3clkxfile.c_str(), 0) == -1)
                 {
                     cutdirs = " --cut-dirs=4 ";
@@ -5364,20 +6843,20 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<std::string> dirs, int prodType,
 
                     /* it is OK for '*.Z' or '*.gz' format */
                     cmd = wgetfull + " " + qr + " -nH -A " + sp3clkxfilelong[i] + cutdirs + url;
-                    std::system(cmd.c_str());
+                    RunWget(cmd, fopt);
                 }
 
-                CString::GetFile(dirs[i], substr, sp3clkxfile);
+                GetFile(dirs[i], substr, sp3clkxfile);
                 if (access(sp3clkxfile.c_str(), 0) == -1)
                 {
                     cutdirs = " --cut-dirs=5 ";
                     std::string urlx = "ftp://igsdepot.ign.fr/pub/igs/products/mgex/" + swwww;
                     /* it is OK for '*.Z' or '*.gz' format */
                     cmd = wgetfull + " " + qr + " -nH -A " + sp3clkxfilelong[i] + cutdirs + urlx;
-                    std::system(cmd.c_str());
+                    RunWget(cmd, fopt);
                 }
 
-                CString::GetFile(dirs[i], substr, sp3clkxfile);
+                GetFile(dirs[i], substr, sp3clkxfile);
                 if (access(sp3clkxfile.c_str(), 0) == -1)
                 {
                     if (i == 0) Logger::Trace(TWARNING, "*** ERROR(FtpUtil::GetOrbClk): failed to download " +
@@ -5387,17 +6866,16 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<std::string> dirs, int prodType,
 
                     std::string localfile = dirs[i] + sep + sp3clkfilelong[i];
                     std::string url0 = url + '/' + sp3clkxfilelong[i];
-                    if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetOrbClk): " << url0 << "  ->  " <<
-                        localfile << "  failed" << std::endl;
+                    LogXfer("GetOrbClk", url0, localfile, false);
                 }
                 else
                 {
                     /* extract '*.gz' or '*.Z' */
                     cmd = gzipfull + " -d -f " + sp3clkxfile;
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
 
                     std::string sp3clkfile;
-                    CString::GetFile(dirs[i], substr, sp3clkfile);
+                    GetFile(dirs[i], substr, sp3clkfile);
                     std::string localfile = dirs[i] + sep + sp3clkfile;
                     if (access(sp3clkfile.c_str(), 0) == 0)
                     {
@@ -5407,23 +6885,10 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<std::string> dirs, int prodType,
                             acname + " final precise clock file " + sp3clkfile);
 
                         std::string url0 = url + '/' + sp3clkxfile;
-                        if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetOrbClk): " << url0 << "  ->  " <<
-                            localfile << "  OK" << std::endl;
+                        LogXfer("GetOrbClk", url0, localfile, true);
 
                         /* to check if it needs to convert precise orbit and clock files with long name to those with short name */
-                        if (fopt->l2s4oc > 0)
-                        {
-                            std::string change_filename;
-#ifdef _WIN32  /* for Windows */
-                            if (fopt->l2s4oc == 1) change_filename = "rename";
-                            else if (fopt->l2s4oc == 2) change_filename = "copy";
-#else          /* for Linux or Mac */
-                            if (fopt->l2s4oc == 1) change_filename = "mv";
-                            else if (fopt->l2s4oc == 2) change_filename = "cp";
-#endif
-                            cmd = change_filename + " " + sp3clkfile + " " + sp3clkfileshort[i];
-                            std::system(cmd.c_str());
-                        }
+                        if (fopt->l2s4oc > 0) LongToShort(sp3clkfile, sp3clkfileshort[i], fopt->l2s4oc);
                     }
                 }
             }
@@ -5438,6 +6903,309 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<std::string> dirs, int prodType,
     }
 } /* end of GetOrbClk */
 
+/**
+* @brief   : GetProdType - to get the product type of one analysis center of precise orbit and clock products
+* @param[I]: ac (analysis center, i.e., 'igs', 'igs_r', 'igs_u', 'cod_m', 'cnt', et al.)
+* @param[O]: none
+* @return  : product type (PROD_*), 0 if unknown
+* @note    :
+**/
+int FtpUtil::GetProdType(std::string ac)
+{
+    CString::trim(ac);
+    CString::ToLower(ac);
+    int prodtype = 0;
+
+    /* cnt: CNES real-time orbit and clock products from CNES offline files */
+    if (ac == "cnt") prodtype = PROD_REALTIME;
+
+    /* esa_u: ESA ultra-rapid orbit and clock products
+       gfz_u: GFZ ultra-rapid orbit and clock products
+       igs_u: IGS ultra-rapid orbit and clock products
+       whu_u: WHU ultra-rapid orbit and clock products
+    */
+    std::vector<std::string> ultra_ac = { "esa_u", "gfz_u", "igs_u", "whu_u" };
+    auto isfound = std::find(ultra_ac.begin(), ultra_ac.end(), ac);
+    if (isfound != ultra_ac.end()) prodtype = PROD_ULTRA_RAPID;
+
+    /* cod_r: CODE rapid orbit and clock products
+       emr_r: NRCan rapid orbit and clock products
+       esa_r: ESA rapid orbit and clock products
+       gfz_r: GFZ rapid orbit and clock products
+       igs_r: IGS rapid orbit and clock products
+    */
+    std::vector<std::string> rapid_ac = { "cod_r", "emr_r", "esa_r", "gfz_r", "igs_r" };
+    isfound = std::find(rapid_ac.begin(), rapid_ac.end(), ac);
+    if (isfound != rapid_ac.end()) prodtype = PROD_RAPID;
+
+    /* cod: CODE final orbit and clock products
+       emr: NRCan final orbit and clock products
+       esa: ESA final orbit and clock products
+       gfz: GFZ final orbit and clock products
+       grg: CNES final orbit and clock products
+       igs: IGS final orbit and clock products
+       jpl: JPL final orbit and clock products
+       mit: MIT final orbit and clock products
+    */
+    std::vector<std::string> final_ac_IGS = { "cod", "emr", "esa", "gfz", "grg", "igs", "jgx", "jpl", "mit" };
+    isfound = std::find(final_ac_IGS.begin(), final_ac_IGS.end(), ac);
+    if (isfound != final_ac_IGS.end()) prodtype = PROD_FINAL_IGS;
+
+    /* cod_m: CODE multi-GNSS final orbit and clock products
+       gfz_m: GFZ multi-GNSS final orbit and clock products
+       grg_m: CNES multi-GNSS final orbit and clock products
+       iac_m: Russia Information and Analysis Center (IAC) multi-GNSS final orbit and clock products
+       jax_m: Japan Aerospace Exploration Agency (JAXA) multi-GNSS final orbit and clock products
+       sha_m: Shanghai Observatory (SHAO) multi-GNSS final orbit and clock products
+       whu_m: Wuhan University (WHU) multi-GNSS final orbit and clock products
+    */
+    std::vector<std::string> final_ac_MGEX = { "cod_m", "gfz_m", "grg_m", "iac_m", "jax_m", "sha_m", "whu_m" };
+    isfound = std::find(final_ac_MGEX.begin(), final_ac_MGEX.end(), ac);
+    if (isfound != final_ac_MGEX.end()) prodtype = PROD_FINAL_MGEX;
+
+    return prodtype;
+} /* end of GetProdType */
+
+/**
+* @brief   : FindOrbClk - to find the local precise orbit file of one analysis center at one day
+* @param[I]: ts (time of the day)
+* @param[I]: dir (orbit directory)
+* @param[I]: ac (analysis center, i.e., 'igs', 'igs_r', 'igs_u', 'cod_m', 'cnt', et al.)
+* @param[O]: none
+* @return  : local orbit file (long or short name) without path, empty if NOT found
+* @note    : any session of the ultra-rapid products is accepted
+**/
+std::string FtpUtil::FindOrbClk(gtime_t ts, std::string dir, std::string ac)
+{
+    int wwww = 0;
+    double sow = 0.0;
+    int dow = GTime::time2gpst(ts, wwww, sow);
+    std::string swwwwd = CString::int2str(wwww, 4) + std::to_string(dow);
+    int yyyy, doy;
+    GTime::time2yrdoy(ts, yyyy, doy);
+    std::string syyyydoy = CString::int2str(yyyy, 4) + CString::int2str(doy, 3);
+    CString::trim(ac);
+    CString::ToLower(ac);
+
+    /* the local file names written by GetOrbClk */
+    std::vector<std::string> pats;
+    int prodtype = GetProdType(ac);
+    if (prodtype == PROD_REALTIME) pats.push_back(ac + swwwwd + ".sp3");
+    else if (prodtype == PROD_ULTRA_RAPID)
+    {
+        std::map<std::string, std::string> acfiles = { { "esa_u", "esu" }, { "gfz_u", "gfu" }, { "igs_u", "igu" }, { "whu_u", "wuu" } };
+        pats.push_back(acfiles[ac] + swwwwd + "_??.sp3");
+    }
+    else if (prodtype == PROD_RAPID)
+    {
+        std::map<std::string, std::string> acfiles = { { "cod_r", "COD" }, { "emr_r", "emr" }, { "esa_r", "esr" }, { "gfz_r", "gfz" },
+            { "igs_r", "igr" } };
+        pats.push_back(acfiles[ac] + swwwwd + (ac == "cod_r" ? ".EPH_M" : ".sp3"));
+    }
+    else if (prodtype == PROD_FINAL_IGS)
+    {
+        std::string acu = ac;
+        CString::ToUpper(acu);
+        pats.push_back(acu + "0OPS???_" + syyyydoy + "0000_01D_*_ORB.SP3");
+        pats.push_back(ac + swwwwd + (ac == "cod" ? ".eph" : ".sp3"));
+    }
+    else if (prodtype == PROD_FINAL_MGEX)
+    {
+        std::map<std::string, std::pair<std::string, std::string>> acfiles = { { "cod_m", { "COD", "com" } }, { "gfz_m", { "GFZ", "gbm" } },
+            { "grg_m", { "GRG", "grm" } }, { "iac_m", { "IAC", "iac" } }, { "jax_m", { "JAX", "jax" } }, { "sha_m", { "SHA", "sha" } },
+            { "whu_m", { "WUM", "whu" } } };
+        pats.push_back(acfiles[ac].first + "0MGX???_" + syyyydoy + "0000_01D_*_ORB.SP3");
+        pats.push_back(acfiles[ac].second + swwwwd + ".sp3");
+    }
+
+    std::map<std::string, std::pair<double, double>> files;
+    ListRemote("file://" + dir, nullptr, files);
+    for (auto it = files.begin(); it != files.end(); ++it)
+    {
+        if (it->second.first <= 0.0) continue;
+        for (size_t i = 0; i < pats.size(); i++)
+        {
+            if (MatchWild(pats[i].c_str(), it->first.c_str())) return it->first;
+        }
+    }
+
+    return "";
+} /* end of FindOrbClk */
+
+/**
+* @brief   : GetOrbClkBest - to download the best precise orbit and clock products currently available at one day, i.e.,
+*              the analysis centers of 'ocBest' (final, rapid, ultra-rapid and real-time by default) are tried in order
+* @param[I]: ts (time of the day)
+* @param[I]: dirs (orbit and clock directories)
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : none
+* @note    : the tier got is recorded in the manifest 'best_orbclk.manifest' (or 'best_orbclk_shard0of4.manifest', ...) of
+*              the orbit directory, and only the better tiers are tried if the products of the day are got again, so that they
+*              are upgraded as soon as published
+**/
+void FtpUtil::GetOrbClkBest(gtime_t ts, std::vector<std::string> dirs, const ftpopt_t* fopt)
+{
+    int yyyy, doy;
+    GTime::time2yrdoy(ts, yyyy, doy);
+    std::string sday = CString::int2str(yyyy, 4) + " " + CString::int2str(doy, 3);
+    std::vector<std::string> tiers = { "unknown", "real-time", "ultra-rapid", "rapid", "final", "final" };
+
+    /* the manifest, one 'yyyy doy tier ac orbit_file' per line */
+    std::string sep;
+    sep.push_back((char)FILEPATHSEP);
+    std::string manifest = dirs[0] + sep + "best_orbclk" + ShardTag(fopt) + ".manifest";
+    std::vector<std::string> lines;
+    std::string line, last;
+    std::ifstream fp(manifest.c_str());
+    while (fp.is_open() && getline(fp, line))
+    {
+        if (line.compare(0, sday.size(), sday) == 0) last = line;
+        else if (!line.empty()) lines.push_back(line);
+    }
+    if (fp.is_open()) fp.close();
+
+    std::string chain = fopt->bestchain;
+    CString::trim(chain);
+    CString::ToLower(chain);
+    std::vector<std::string> acs = CString::split(chain, "+");
+    for (size_t i = 0; i < acs.size(); i++)
+    {
+        int prodtype = GetProdType(acs[i]);
+        if (prodtype == 0)
+        {
+            Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetOrbClkBest): unknown analysis center " + acs[i] + " in 'ocBest'");
+            continue;
+        }
+
+        /* the local inventory first, and then the remote server */
+        std::string sp3file = FindOrbClk(ts, dirs[0], acs[i]);
+        if (sp3file.empty())
+        {
+            GetOrbClk(ts, dirs, prodtype, acs[i], fopt);
+            sp3file = FindOrbClk(ts, dirs[0], acs[i]);
+        }
+        if (sp3file.empty()) continue;
+
+        std::string now = sday + " " + tiers[prodtype] + " " + acs[i] + " " + sp3file;
+        if (now != last)
+        {
+            std::vector<std::string> slast = CString::split(last, " ");
+            std::string upgrade = slast.size() >= 4 ? " (upgraded from the " + slast[2] + " ones from " + slast[3] + ")" : "";
+            Logger::Trace(TINFO, "*** INFO(FtpUtil::GetOrbClkBest): the best precise orbit and clock products of " + sday +
+                " are the " + tiers[prodtype] + " ones from " + acs[i] + upgrade);
+            LogXfer("GetOrbClkBest", sday, dirs[0] + sep + sp3file, true, tiers[prodtype]);
+
+            /* the manifest is replaced atomically, and it is read again under the lock, because the other processes of
+               the backfill mode may have updated the other days meanwhile */
+            CacheUtil mftlock;
+            mftlock.Lock(manifest);
+            lines.clear();
+            std::ifstream fpin(manifest.c_str());
+            while (fpin.is_open() && getline(fpin, line))
+            {
+                if (line.compare(0, sday.size(), sday) != 0 && !line.empty()) lines.push_back(line);
+            }
+            if (fpin.is_open()) fpin.close();
+            lines.push_back(now);
+            std::sort(lines.begin(), lines.end());
+            std::string tmpfile = manifest + ".tmp";
+            std::ofstream fpout(tmpfile.c_str());
+            for (size_t j = 0; j < lines.size(); j++) fpout << lines[j] << std::endl;
+            fpout.close();
+            std::remove(manifest.c_str());
+            std::rename(tmpfile.c_str(), manifest.c_str());
+        }
+
+        return;
+    }
+
+    Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetOrbClkBest): no precise orbit and clock products of " + sday +
+        " are available from " + chain);
+    LogXfer("GetOrbClkBest", sday, chain, false);
+} /* end of GetOrbClkBest */
+
+/**
+* @brief   : GetLatestSessions - to get the candidate sessions of the ultra-rapid precise orbit products at one day for
+*              the newest issued one, i.e., the weekly directory is listed once and only the newest session published is
+*              kept, or all the sessions issued so far are probed newest first if the directory can NOT be listed
+* @param[I]: ts (time of the day)
+* @param[I]: url (weekly directory of the ultra-rapid products)
+* @param[I]: ac (analysis center, i.e., 'esa_u', 'gfz_u', 'igs_u', 'whu_u')
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : sessions (hours) newest first, empty if none is issued
+* @note    :
+**/
+std::vector<int> FtpUtil::GetLatestSessions(gtime_t ts, std::string url, std::string ac, const ftpopt_t* fopt)
+{
+    int step = 1;
+    std::string acFile;
+    if (ac == "esa_u") { step = 6; acFile = "esu"; }
+    else if (ac == "gfz_u") { step = 3; acFile = "gfu"; }
+    else if (ac == "igs_u") { step = 6; acFile = "igu"; }
+    else if (ac == "whu_u") { step = 1; acFile = "wuu"; }
+
+    /* only the sessions issued before now */
+    gtime_t tnow = GTime::now();
+    int hhmax = 23;
+    if (ts.mjd > tnow.mjd) return std::vector<int>();
+    else if (ts.mjd == tnow.mjd) hhmax = (int)(tnow.sod / 3600.0);
+    std::vector<int> hhs;
+    for (int hh = hhmax - hhmax % step; hh >= 0; hh -= step) hhs.push_back(hh);
+
+    std::map<std::string, std::pair<double, double>> entries;
+    if (!ListRemote(url, fopt, entries)) return hhs;
+
+    int wwww = 0;
+    double sow = 0.0;
+    int dow = GTime::time2gpst(ts, wwww, sow);
+    int yyyy, doy;
+    GTime::time2yrdoy(ts, yyyy, doy);
+    for (size_t i = 0; i < hhs.size(); i++)
+    {
+        std::string shh = CString::int2str(hhs[i], 2), pattern;
+        if (ac == "whu_u") pattern = "WUM0MGXULA_" + CString::int2str(yyyy, 4) + CString::int2str(doy, 3) + shh +
+            "00_01D_*_ORB.SP3.*";
+        else pattern = acFile + CString::int2str(wwww, 4) + std::to_string(dow) + "_" + shh + ".sp3.*";
+        for (auto it = entries.begin(); it != entries.end(); ++it)
+        {
+            if (MatchWild(pattern.c_str(), it->first.c_str())) return std::vector<int>(1, hhs[i]);
+        }
+    }
+
+    return std::vector<int>();
+} /* end of GetLatestSessions */
+
+/**
+* @brief   : SetLatestLink - to point the link of the latest product (i.e., 'latest_igu.sp3') to one file atomically
+* @param[I]: link (link file)
+* @param[I]: target (target file in the same directory)
+* @param[O]: none
+* @return  : true: successful, false: failed
+* @note    : the new link is made aside and renamed over the old one, so that the downstream processes always see a
+*              complete file. On Windows, a hardlink is used because the symbolic link needs the privilege
+**/
+bool FtpUtil::SetLatestLink(std::string link, std::string target)
+{
+    std::string tmplink = link + ".tmp";
+    std::remove(tmplink.c_str());
+
+#ifdef _WIN32   /* for Windows */
+    if (!LinkFile(target, tmplink)) return false;
+    if (!MoveFileExA(tmplink.c_str(), link.c_str(), MOVEFILE_REPLACE_EXISTING))
+#else           /* for Linux or Mac */
+    if (symlink(target.c_str(), tmplink.c_str()) != 0) return false;
+    if (rename(tmplink.c_str(), link.c_str()) != 0)
+#endif
+    {
+        std::remove(tmplink.c_str());
+        return false;
+    }
+
+    return true;
+} /* end of SetLatestLink */
+
 /**
 * @brief   : GetEop - download earth rotation parameter files
 * @param[I]: ts (start time)
@@ -5556,13 +7324,13 @@ void FtpUtil::GetEop(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                     eopzfile = eopfile + ".Z";
                     url0 = url + "/" + eopzfile;
                     cmd = wgetfull + " " + qr + " -nH " + cutdirs + url0;
-                    std::system(cmd.c_str());
+                    RunWget(cmd, fopt);
 
                     if (access(eopzfile.c_str(), 0) == 0)
                     {
                         /* extract '*.Z' */
                         cmd = gzipfull + " -d -f " + eopzfile;
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                         isgz = false;
                     }
                     else
@@ -5570,23 +7338,22 @@ void FtpUtil::GetEop(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                         eopgzfile = eopfile + ".gz";
                         url0 = url + "/" + eopgzfile;
                         cmd = wgetfull + " " + qr + " -nH " + cutdirs + url0;
-                        std::system(cmd.c_str());
+                        RunWget(cmd, fopt);
 
                         if (access(eopgzfile.c_str(), 0) == 0)
                         {
                             /* extract '*.gz' */
                             cmd = gzipfull + " -d -f " + eopgzfile;
-                            std::system(cmd.c_str());
+                            ProfUtil::System(cmd);
                             isgz = true;
                         }
                     }
                 }
                 else
                 {
-                    /* it is OK for '*.Z' or '*.gz' format */
+                    /* it is OK for '*.Z' or '*.gz' format, and the exact file is fetched without listing the remote directory */
                     eopxfile = eopfile + ".*";
-                    cmd = wgetfull + " " + qr + " -nH -A " + eopxfile + cutdirs + url;
-                    std::system(cmd.c_str());
+                    GetExactFile(url, eopfile, fopt);
 
                     eopgzfile = eopfile + ".gz";
                     eopzfile = eopfile + ".Z";
@@ -5594,14 +7361,14 @@ void FtpUtil::GetEop(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                     {
                         /* extract '*.gz' */
                         cmd = gzipfull + " -d -f " + eopgzfile;
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                         isgz = true;
                     }
                     if (access(eopfile.c_str(), 0) == -1 && access(eopzfile.c_str(), 0) == 0)
                     {
                         /* extract '*.Z' */
                         cmd = gzipfull + " -d -f " + eopzfile;
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                         isgz = false;
                     }
 
@@ -5620,16 +7387,14 @@ void FtpUtil::GetEop(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                     if (isgz) eopxfile = eopgzfile;
                     else eopxfile = eopzfile;
                     std::string url0 = url + '/' + eopxfile;
-                    if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetEop): " << url0 << "  ->  " <<
-                        localfile << "  OK" << std::endl;
+                    LogXfer("GetEop", url0, localfile, true);
                 }
                 else
                 {
                     Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetEop): failed to download " + acname +
                         " ultra-rapid EOP file " + eopfile);
 
-                    if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetEop): " << url0 << "  ->  " <<
-                        localfile << "  failed" << std::endl;
+                    LogXfer("GetEop", url0, localfile, false);
                 }
 
                 if (ac == "igs_u")
@@ -5643,7 +7408,7 @@ void FtpUtil::GetEop(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else          /* for Linux or Mac */
                         cmd = "rm -rf " + tmpdir;
 #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                     }
                 }
             }
@@ -5670,19 +7435,17 @@ void FtpUtil::GetEop(gtime_t ts, std::string dir, const ftpopt_t* fopt)
         if (access(eopfilelong.c_str(), 0) == -1 && access(eopfileshort.c_str(), 0) == -1)
         {
             /* download the EOP file */
-            std::string url, cutdirs = " --cut-dirs=4 ";
+            std::string url;
             if (ftpname == "CDDIS") url = ftparchive_.CDDIS[IDX_EOP] + "/" + swwww;
             else if (ftpname == "IGN") url = ftparchive_.IGN[IDX_EOP] + "/" + swwww;
             else if (ftpname == "WHU") url = ftparchive_.WHU[IDX_EOP] + "/" + swwww;
             else url = ftparchive_.CDDIS[IDX_EOP] + "/" + swwww;
 
-            /* it is OK for '*.Z' or '*.gz' format */
-            std::string eopxfilelong = eopfilelong + ".*";
-            std::string cmd = wgetfull + " " + qr + " -nH -A " + eopxfilelong + cutdirs + url;
-            std::system(cmd.c_str());
+            /* it is OK for '*.Z' or '*.gz' format, and the exact file is fetched without listing the remote directory */
+            GetExactFile(url, eopfilelong, fopt);
 
-            std::string eopxfile, eopfile;
-            CString::GetFile(dir, eopfilelong, eopxfile);
+            std::string cmd, eopxfile, eopfile;
+            GetFile(dir, eopfilelong, eopxfile);
             if (access(eopxfile.c_str(), 0) == 0)
             {
                 eopfile = eopfilelong;
@@ -5691,11 +7454,9 @@ void FtpUtil::GetEop(gtime_t ts, std::string dir, const ftpopt_t* fopt)
             else
             {
                 /* it is OK for '*.Z' or '*.gz' format */
-                std::string eopxfileshort = eopfileshort + ".*";
-                cmd = wgetfull + " " + qr + " -nH -A " + eopxfileshort + cutdirs + url;
-                std::system(cmd.c_str());
+                GetExactFile(url, eopfileshort, fopt);
 
-                CString::GetFile(dir, eopfileshort, eopxfile);
+                GetFile(dir, eopfileshort, eopxfile);
                 if (access(eopxfile.c_str(), 0) == 0)
                 {
                     eopfile = eopfileshort;
@@ -5712,15 +7473,14 @@ void FtpUtil::GetEop(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 
                 sprintf(tmpfile, "%s%c%s", dir.c_str(), sep, eopfile.c_str());
                 std::string localfile = tmpfile;
-                std::string url0 = url + '/' + eopxfilelong;
-                if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetEop): " << url0 << "  ->  " <<
-                    localfile << "  failed" << std::endl;
+                std::string url0 = url + '/' + eopfilelong + ".*";
+                LogXfer("GetEop", url0, localfile, false);
             }
             else
             {
                 /* extract '*.gz' or '*.Z' */
                 cmd = gzipfull + " -d -f " + eopxfile;
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
 
                 sprintf(tmpfile, "%s%c%s", dir.c_str(), sep, eopfile.c_str());
                 std::string localfile = tmpfile;
@@ -5730,23 +7490,10 @@ void FtpUtil::GetEop(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                         " final EOP file " + eopfile);
 
                     std::string url0 = url + '/' + eopxfile;
-                    if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetEop): " << url0 << "  ->  " <<
-                        localfile << "  OK" << std::endl;
+                    LogXfer("GetEop", url0, localfile, true);
 
                     /* to check if it needs to convert precise orbit and clock files with long name to those with short name */
-                    if (fopt->l2s4eop > 0)
-                    {
-                        std::string change_filename;
-#ifdef _WIN32  /* for Windows */
-                        if (fopt->l2s4eop == 1) change_filename = "rename";
-                        else if (fopt->l2s4eop == 2) change_filename = "copy";
-#else          /* for Linux or Mac */
-                        if (fopt->l2s4eop == 1) change_filename = "mv";
-                        else if (fopt->l2s4eop == 2) change_filename = "cp";
-#endif
-                        cmd = change_filename + " " + eopfilelong + " " + eopfileshort;
-                        std::system(cmd.c_str());
-                    }
+                    if (fopt->l2s4eop > 0) LongToShort(eopfilelong, eopfileshort, fopt->l2s4eop);
                 }
 
                 /* delete some temporary directories */
@@ -5758,7 +7505,7 @@ void FtpUtil::GetEop(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else          /* for Linux or Mac */
                     cmd = "rm -rf " + tmpdir;
 #endif
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
                 }
             }
         }
@@ -5823,33 +7570,32 @@ void FtpUtil::GetObx(gtime_t ts, std::string dir, const ftpopt_t* fopt)
         if (ac_i == "cnt")  /* for CNES real-time ORBEX files */
         {
             std::string obxfile = ac + swwww + sdow + ".obx";
-            if (access(obxfile.c_str(), 0) == -1)
+            std::string obxgzFile = obxfile + ".gz";
+            std::string url = "http://www.ppp-wizard.net/products/REAL_TIME/" + obxgzFile, vlds;
+            if (IsMutableToGet(url, obxfile, fopt, vlds))
             {
-                std::string obxgzFile = obxfile + ".gz";
-                std::string url = "http://www.ppp-wizard.net/products/REAL_TIME/" + obxgzFile;
                 std::string cmd = wgetfull + " " + qr + " -nH --cut-dirs=2 " + url;
-                std::system(cmd.c_str());
+                RunWget(cmd, fopt, "", false);
 
                 /* extract '*.gz' */
                 cmd = gzipfull + " -d -f " + obxgzFile;
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
 
                 std::string localfile = dir + sep + obxfile;
                 if (access(obxfile.c_str(), 0) == 0)
                 {
                     Logger::Trace(TINFO, "*** INFO(FtpUtil::GetObx): successfully download CNES real-time ORBEX file " + obxfile);
 
-                    if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetObx): " << url << "  ->  " <<
-                        localfile << "  OK" << std::endl;
+                    LogXfer("GetObx", url, localfile, true);
                 }
                 else
                 {
                     Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetObx): failed to download CNES real-time ORBEX file " + obxfile);
 
-                    if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetObx): " << url << "  ->  " <<
-                        localfile << "  failed" << std::endl;
+                    LogXfer("GetObx", url, localfile, false);
 
                 }
+                EndMutableGet(url, obxfile, vlds, fopt);
 
                 /* delete some temporary directories */
                 std::vector<std::string> tmpdir = { "FORMAT_BIAIS_OFFI1", "FORMATBIAS_OFF_v1" };
@@ -5862,7 +7608,7 @@ void FtpUtil::GetObx(gtime_t ts, std::string dir, const ftpopt_t* fopt)
     #else          /* for Linux or Mac */
                         cmd = "rm -rf " + tmpdir[i];
     #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                     }
                 }
             }
@@ -5897,7 +7643,7 @@ void FtpUtil::GetObx(gtime_t ts, std::string dir, const ftpopt_t* fopt)
             }
 
             std::string obx0file;
-            CString::GetFile(dir, substr, obx0file);
+            GetFile(dir, substr, obx0file);
             if (access(obx0file.c_str(), 0) == -1)
             {
                 std::string cmd, url, cutdirs = " --cut-dirs=5 ";
@@ -5909,9 +7655,9 @@ void FtpUtil::GetObx(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                 /* it is OK for '*.Z' or '*.gz' format */
                 std::string obxxfile = obxfile + ".*";
                 cmd = wgetfull + " " + qr + " -nH -A " + obxxfile + cutdirs + url;
-                std::system(cmd.c_str());
+                RunWget(cmd, fopt);
 
-                CString::GetFile(dir, substr, obxxfile);
+                GetFile(dir, substr, obxxfile);
                 if (access(obxxfile.c_str(), 0) == -1)
                 {
                     cutdirs = " --cut-dirs=4 ";
@@ -5922,9 +7668,9 @@ void FtpUtil::GetObx(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 
                     obxxfile = obxfile + ".*";
                     cmd = wgetfull + " " + qr + " -nH -A " + obxxfile + cutdirs + url;
-                    std::system(cmd.c_str());
+                    RunWget(cmd, fopt);
 
-                    CString::GetFile(dir, substr, obxxfile);
+                    GetFile(dir, substr, obxxfile);
                     if (access(obxxfile.c_str(), 0) == -1)
                     {
                         cutdirs = " --cut-dirs=5 ";
@@ -5932,12 +7678,12 @@ void FtpUtil::GetObx(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                         /* it is OK for '*.Z' or '*.gz' format */
                         obxxfile = obxfile + ".*";
                         cmd = wgetfull + " " + qr + " -nH -A " + obxxfile + cutdirs + urlx;
-                        std::system(cmd.c_str());
+                        RunWget(cmd, fopt);
                     }
                 }
 
                 std::string localfile;
-                CString::GetFile(dir, substr, obxxfile);
+                GetFile(dir, substr, obxxfile);
                 if (access(obxxfile.c_str(), 0) == -1)
                 {
                     Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetObx): failed to download " +
@@ -5945,15 +7691,14 @@ void FtpUtil::GetObx(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 
                     localfile = dir + sep + obxfile;
                     std::string url0 = url + '/' + obxfile;
-                    if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetObx): " << url0 << "  ->  " <<
-                        localfile << "  failed" << std::endl;
+                    LogXfer("GetObx", url0, localfile, false);
                 }
                 else
                 {
                     cmd = gzipfull + " -d -f " + obxxfile;
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
 
-                    CString::GetFile(dir, substr, obx0file);
+                    GetFile(dir, substr, obx0file);
                     if (access(obx0file.c_str(), 0) == 0)
                     {
                         Logger::Trace(TINFO, "*** INFO(FtpUtil::GetObx): successfully download " +
@@ -5961,8 +7706,7 @@ void FtpUtil::GetObx(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 
                         localfile = dir + sep + obx0file;
                         std::string url0 = url + '/' + obxxfile;
-                        if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetObx): " << url0 << "  ->  " <<
-                            localfile << "  OK" << std::endl;
+                        LogXfer("GetObx", url0, localfile, true);
                     }
                 }
             }
@@ -6038,29 +7782,27 @@ void FtpUtil::GetDsb(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                 /* it is OK for '*.Z' or '*.gz' format */
                 std::string dsbxfile = dsbfile + ".*";
                 std::string cmd = wgetfull + " " + qr + " -nH -A " + dsbxfile + cutdirs + url;
-                std::system(cmd.c_str());
+                RunWget(cmd, fopt);
 
                 std::string localfile = dir + sep + dsbfile;
-                CString::GetFile(dir, dsbfile, dsbxfile);
+                GetFile(dir, dsbfile, dsbxfile);
                 if (access(dsbxfile.c_str(), 0) == -1)
                 {
                     Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetDsb): failed to download multi-GNSS DSB file " + dsbfile);
 
                     std::string url0 = url + '/' + dsbxfile;
-                    if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetDsb): " << url0 << "  ->  " <<
-                        localfile << "  failed" << std::endl;
+                    LogXfer("GetDsb", url0, localfile, false);
                 }
                 else
                 {
                     /* extract '*.gz' or '*.Z' */
                     cmd = gzipfull + " -d -f " + dsbxfile;
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
 
                     Logger::Trace(TINFO, "*** INFO(FtpUtil::GetDsb): successfully download multi-GNSS DSB file " + dsbfile);
 
                     std::string url0 = url + '/' + dsbxfile;
-                    if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetDsb): " << url0 << "  ->  " <<
-                        localfile << "  OK" << std::endl;
+                    LogXfer("GetDsb", url0, localfile, true);
                 }
             }
             else Logger::Trace(TINFO, "*** INFO(FtpUtil::GetDsb): multi-GNSS DSB file " + dsbfile + " has existed!");
@@ -6088,23 +7830,22 @@ void FtpUtil::GetDsb(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                     /* it is OK for '*.Z' or '*.gz' format */
                     std::string dcbxfile = dcbfile + ".*";
                     std::string cmd = wgetfull + " " + qr + " -nH -A " + dcbxfile + " --cut-dirs=2 " + url;
-                    std::system(cmd.c_str());
+                    RunWget(cmd, fopt);
 
                     std::string localfile = dir + sep + dcb0file;
-                    CString::GetFile(dir, dcbfile, dcbxfile);
+                    GetFile(dir, dcbfile, dcbxfile);
                     if (access(dcbxfile.c_str(), 0) == -1)
                     {
                         Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetDsb): failed to download CODE DCB file " + dcbfile);
 
                         std::string url0 = url + '/' + dcbxfile;
-                        if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetDsb): " << url0 << "  ->  " <<
-                            localfile << "  failed" << std::endl;
+                        LogXfer("GetDsb", url0, localfile, false);
                     }
                     else
                     {
                         /* extract '*.gz' or '*.Z' */
                         cmd = gzipfull + " -d -f " + dcbxfile;
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
 
                         if (dcbtype[i] == "P2C2")
                         {
@@ -6115,7 +7856,7 @@ void FtpUtil::GetDsb(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                             change_filename = "mv";
 #endif
                             cmd = change_filename + " " + dcbfile + " " + dcb0file;
-                            std::system(cmd.c_str());
+                            ProfUtil::System(cmd);
                         }
 
                         if (access(dcb0file.c_str(), 0) == 0)
@@ -6123,8 +7864,7 @@ void FtpUtil::GetDsb(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                             Logger::Trace(TINFO, "*** INFO(FtpUtil::GetDsb): successfully download CODE DCB file " + dcb0file);
 
                             std::string url0 = url + '/' + dcbxfile;
-                            if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetDsb): " << url0 << "  ->  " <<
-                                localfile << "  OK" << std::endl;
+                            LogXfer("GetDsb", url0, localfile, true);
                         }
                     }
                 }
@@ -6191,32 +7931,31 @@ void FtpUtil::GetOsb(gtime_t ts, std::string dir, const ftpopt_t* fopt)
         if (ac_i == "cnt")  /* CNES real-time OSB from CNES offline files */
         {
             std::string osbfile = ac + swwww + sdow + ".bia";
-            if (access(osbfile.c_str(), 0) == -1)
+            std::string osbgzfile = osbfile + ".gz";
+            std::string url = "http://www.ppp-wizard.net/products/REAL_TIME/" + osbgzfile, vlds;
+            if (IsMutableToGet(url, osbfile, fopt, vlds))
             {
-                std::string osbgzfile = osbfile + ".gz";
-                std::string url = "http://www.ppp-wizard.net/products/REAL_TIME/" + osbgzfile;
                 std::string cmd = wgetfull + " " + qr + " -nH --cut-dirs=2 " + url;
-                std::system(cmd.c_str());
+                RunWget(cmd, fopt, "", false);
 
                 /* extract '*.gz' */
                 cmd = gzipfull + " -d -f " + osbgzfile;
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
 
                 std::string localfile = dir + sep + osbfile;
                 if (access(osbfile.c_str(), 0) == 0)
                 {
                     Logger::Trace(TINFO, "*** INFO(FtpUtil::GetOsb): successfully download CNES real-time OSB file " + osbfile);
 
-                    if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetOsb): " << url << "  ->  " <<
-                        localfile << "  OK" << std::endl;
+                    LogXfer("GetOsb", url, localfile, true);
                 }
                 else
                 {
                     Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetOsb): failed to download CNES real-time OSB file " + osbfile);
 
-                    if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetOsb): " << url << "  ->  " <<
-                        localfile << "  failed" << std::endl;
+                    LogXfer("GetOsb", url, localfile, false);
                 }
+                EndMutableGet(url, osbfile, vlds, fopt);
 
                 /* delete some temporary directories */
                 std::vector<std::string> tmpdir = { "FORMAT_BIAIS_OFFI1", "FORMATBIAS_OFF_v1" };
@@ -6229,7 +7968,7 @@ void FtpUtil::GetOsb(gtime_t ts, std::string dir, const ftpopt_t* fopt)
     #else          /* for Linux or Mac */
                         cmd = "rm -rf " + tmpdir[i];
     #endif
-                        std::system(cmd.c_str());
+                        ProfUtil::System(cmd);
                     }
                 }
             }
@@ -6251,7 +7990,7 @@ void FtpUtil::GetOsb(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                     std::string url0 = "ftp://ftp.gipp.org.cn/product/dcb/mgex/" + syyyy;
                     std::string cutdirs0 = " --cut-dirs=4 ";
                     cmd = wgetfull + " " + qr + " -nH -A " + osbxfile + cutdirs0 + url0;
-                    std::system(cmd.c_str());
+                    RunWget(cmd, fopt);
                 }
                 else
                 {
@@ -6262,9 +8001,9 @@ void FtpUtil::GetOsb(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                     else url = ftparchive_.CDDIS[IDX_OSBM] + "/" + swwww;
 
                     cmd = wgetfull + " " + qr + " -nH -A " + osbxfile + cutdirs + url;
-                    std::system(cmd.c_str());
+                    RunWget(cmd, fopt);
 
-                    CString::GetFile(dir, osbfile, osbxfile);
+                    GetFile(dir, osbfile, osbxfile);
                     if (access(osbxfile.c_str(), 0) == -1)
                     {
                         cutdirs = " --cut-dirs=4 ";
@@ -6275,9 +8014,9 @@ void FtpUtil::GetOsb(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 
                         osbxfile = osbfile + ".*";
                         cmd = wgetfull + " " + qr + " -nH -A " + osbxfile + cutdirs + url;
-                        std::system(cmd.c_str());
+                        RunWget(cmd, fopt);
 
-                        CString::GetFile(dir, osbfile, osbxfile);
+                        GetFile(dir, osbfile, osbxfile);
                         if (access(osbxfile.c_str(), 0) == -1)
                         {
                             cutdirs = " --cut-dirs=5 ";
@@ -6285,13 +8024,13 @@ void FtpUtil::GetOsb(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                             /* it is OK for '*.Z' or '*.gz' format */
                             osbxfile = osbfile + ".*";
                             cmd = wgetfull + " " + qr + " -nH -A " + osbxfile + cutdirs + urlx;
-                            std::system(cmd.c_str());
+                            RunWget(cmd, fopt);
                         }
                     }
                 }
 
                 std::string localfile;
-                CString::GetFile(dir, osbfile, osbxfile);
+                GetFile(dir, osbfile, osbxfile);
                 if (access(osbxfile.c_str(), 0) == -1)
                 {
                     Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetOsb): failed to download " +
@@ -6299,13 +8038,12 @@ void FtpUtil::GetOsb(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 
                     localfile = dir + sep + osbfile;
                     std::string url0 = url + '/' + osbfile;
-                    if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetOsb): " << url0 << "  ->  " <<
-                        localfile << "  failed" << std::endl;
+                    LogXfer("GetOsb", url0, localfile, false);
                 }
                 else
                 {
                     cmd = gzipfull + " -d -f " + osbxfile;
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
                     if (access(osbfile.c_str(), 0) == 0)
                     {
                         Logger::Trace(TINFO, "*** INFO(FtpUtil::GetOsb): successfully download " + ac +
@@ -6313,8 +8051,7 @@ void FtpUtil::GetOsb(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 
                         localfile = dir + sep + osbfile;
                         std::string url0 = url + '/' + osbxfile;
-                        if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetOsb): " << url0 << "  ->  " <<
-                            localfile << "  OK" << std::endl;
+                        LogXfer("GetOsb", url0, localfile, true);
                     }
                 }
             }
@@ -6374,10 +8111,10 @@ void FtpUtil::GetSnx(gtime_t ts, std::string dir, const ftpopt_t* fopt)
         /* it is OK for '*.Z' or '*.gz' format */
         std::string snxxfile = snx0filelong + ".*";
         std::string cmd = wgetfull + " " + qr + " -nH -A " + snxxfile + cutdirs + url;
-        std::system(cmd.c_str());
+        RunWget(cmd, fopt);
 
         std::string snxfile;
-        CString::GetFile(dir, snx0filelong, snxxfile);
+        GetFile(dir, snx0filelong, snxxfile);
         if (access(snxxfile.c_str(), 0) == 0)
         {
             snxfile = snx0filelong;
@@ -6388,10 +8125,10 @@ void FtpUtil::GetSnx(gtime_t ts, std::string dir, const ftpopt_t* fopt)
             snxfile = "igs*P" + swwww + ".snx";
             snxxfile = snxfile + ".*";
             cmd = wgetfull + " " + qr + " -nH -A " + snxxfile + cutdirs + url;
-            std::system(cmd.c_str());
+            RunWget(cmd, fopt);
 
             std::string substr = "P" + swwww + ".snx";
-            CString::GetFile(dir, substr, snxxfile);
+            GetFile(dir, substr, snxxfile);
             if (access(snxxfile.c_str(), 0) == 0)
             {
                 snxfile = snxfileshort;
@@ -6408,9 +8145,9 @@ void FtpUtil::GetSnx(gtime_t ts, std::string dir, const ftpopt_t* fopt)
             /* it is OK for '*.Z' or '*.gz' format */
             snxxfile = snx0filelong + ".*";
             cmd = wgetfull + " " + qr + " -nH -A " + snxxfile + cutdirs + url;
-            std::system(cmd.c_str());
+            RunWget(cmd, fopt);
 
-            CString::GetFile(dir, snx0filelong, snxxfile);
+            GetFile(dir, snx0filelong, snxxfile);
             if (access(snxxfile.c_str(), 0) == 0)
             {
                 snxfile = snx0filelong;
@@ -6421,10 +8158,10 @@ void FtpUtil::GetSnx(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                 snxfile = "igs*P" + swwww + sdow + ".snx";
                 snxxfile = snxfile + ".*";
                 cmd = wgetfull + " " + qr + " -nH -A " + snxxfile + cutdirs + url;
-                std::system(cmd.c_str());
+                RunWget(cmd, fopt);
 
                 std::string substr = "P" + swwww + ".snx";
-                CString::GetFile(dir, substr, snxxfile);
+                GetFile(dir, substr, snxxfile);
                 if (access(snxxfile.c_str(), 0) == 0)
                 {
                     snxfile = snxfileshort;
@@ -6442,8 +8179,7 @@ void FtpUtil::GetSnx(gtime_t ts, std::string dir, const ftpopt_t* fopt)
             Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetSnx): failed to download IGS weekly SINEX file " + snxfile);
 
             url0 = url + '/' + snxxfile;
-            if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetSnx): " << url0 << "  ->  " <<
-                localfile << "  failed" << std::endl;
+            LogXfer("GetSnx", url0, localfile, false);
         }
         else if (isfound > 0)
         {
@@ -6451,14 +8187,13 @@ void FtpUtil::GetSnx(gtime_t ts, std::string dir, const ftpopt_t* fopt)
             if (pos != std::string::npos) snxfile = snxxfile.substr(0, pos);
             /* extract '*.gz' or '*.Z' */
             cmd = gzipfull + " -d -f " + snxxfile;
-            std::system(cmd.c_str());
+            ProfUtil::System(cmd);
             if (access(snxfile.c_str(), 0) == 0)
             {
                 Logger::Trace(TINFO, "*** INFO(FtpUtil::GetSnx): successfully download IGS weekly SINEX file " + snxfile);
 
                 url0 = url + '/' + snxxfile;
-                if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetSnx): " << url0 << "  ->  " <<
-                    localfile << "  OK" << std::endl;
+                LogXfer("GetSnx", url0, localfile, true);
 
                 if (isfound == 2)
                 {
@@ -6469,23 +8204,11 @@ void FtpUtil::GetSnx(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                     change_filename = "mv";
 #endif
                     cmd = change_filename + " " + snxfile + " " + snxfileshort;
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
                 }
 
                 /* to check if it needs to convert SINEX file with long name to those with short name */
-                if (fopt->l2s4eop > 0 && isfound == 1)
-                {
-                    std::string change_filename;
-#ifdef _WIN32  /* for Windows */
-                    if (fopt->l2s4oc == 1) change_filename = "rename";
-                    else if (fopt->l2s4oc == 2) change_filename = "copy";
-#else          /* for Linux or Mac */
-                    if (fopt->l2s4oc == 1) change_filename = "mv";
-                    else if (fopt->l2s4oc == 2) change_filename = "cp";
-#endif
-                    cmd = change_filename + " " + snx0filelong + " " + snxfileshort;
-                    std::system(cmd.c_str());
-                }
+                if (fopt->l2s4snx > 0 && isfound == 1) LongToShort(snx0filelong, snxfileshort, fopt->l2s4snx);
             }
         }
 
@@ -6498,7 +8221,7 @@ void FtpUtil::GetSnx(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else          /* for Linux or Mac */
             cmd = "rm -rf " + tmpdir;
 #endif
-            std::system(cmd.c_str());
+            ProfUtil::System(cmd);
         }
     }
     else Logger::Trace(TINFO, "*** INFO(FtpUtil::GetSnx): IGS weekly SINEX file " + snxfileshort + " or " +
@@ -6550,7 +8273,7 @@ void FtpUtil::GetIono(gtime_t ts, std::string dir, const ftpopt_t* fopt)
         CString::ToUpper(acs[i]);
         std::string ionfilelongkey = acs[i] + "0OPSFIN_" + syyyy + sdoy + "0000_01D_";
         std::string ionfilelong, ionfile;
-        CString::GetFile(dir, ionfilelongkey, ionfilelong);
+        GetFile(dir, ionfilelongkey, ionfilelong);
         if (access(ionfileshort.c_str(), 0) == -1 && access(ionfilelong.c_str(), 0) == -1)
         {
             std::string wgetfull = fopt->wgetfull, gzipfull = fopt->gzipfull, qr = fopt->qr;
@@ -6566,10 +8289,10 @@ void FtpUtil::GetIono(gtime_t ts, std::string dir, const ftpopt_t* fopt)
             /* it is OK for '*.Z' or '*.gz' format */
             std::string ionxfile = ionfilelongkey + "*";
             std::string cmd = wgetfull + " " + qr + " -nH -A " + ionxfile + cutdirs + url;
-            std::system(cmd.c_str());
+            RunWget(cmd, fopt);
 
             int isfound = 0;  /* 1: long file name; 2: short filename */
-            CString::GetFile(dir, ionfilelongkey, ionxfile);
+            GetFile(dir, ionfilelongkey, ionxfile);
             if (access(ionxfile.c_str(), 0) == 0)
             {
                 ionfile = ionxfile.substr(0, (int)ionxfile.find_last_of('.'));
@@ -6577,12 +8300,11 @@ void FtpUtil::GetIono(gtime_t ts, std::string dir, const ftpopt_t* fopt)
             }
             else
             {
-                /* it is OK for '*.Z' or '*.gz' format */
+                /* it is OK for '*.Z' or '*.gz' format, and the exact file is fetched without listing the remote directory */
                 ionxfile = ionfileshort + ".*";
-                cmd = wgetfull + " " + qr + " -nH -A " + ionxfile + cutdirs + url;
-                std::system(cmd.c_str());
+                GetExactFile(url, ionfileshort, fopt);
 
-                CString::GetFile(dir, ionfileshort, ionxfile);
+                GetFile(dir, ionfileshort, ionxfile);
                 if (access(ionxfile.c_str(), 0) == 0)
                 {
                     ionfile = ionfileshort;
@@ -6596,36 +8318,22 @@ void FtpUtil::GetIono(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                 Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetIono): failed to download ionopospheric product file " + ionfile);
 
                 url0 = url + '/' + ionxfile;
-                if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetIono): " << url0 << "  ->  " <<
-                    localfile << "  failed" << std::endl;
+                LogXfer("GetIono", url0, localfile, false);
             }
             else
             {
                 /* extract '*.gz' or '*.Z' */
                 cmd = gzipfull + " -d -f " + ionxfile;
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
                 if (access(ionfile.c_str(), 0) == 0)
                 {
                     Logger::Trace(TINFO, "*** INFO(FtpUtil::GetIono): successfully download ionopospheric product file " + ionfile);
 
                     url0 = url + '/' + ionxfile;
-                    if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetIono): " << url0 << "  ->  " <<
-                        localfile << "  OK" << std::endl;
+                    LogXfer("GetIono", url0, localfile, true);
 
                     /* to check if it needs to convert ionoposphere files with long name to those with short name */
-                    if (isfound == 1 && fopt->l2s4ion > 0)
-                    {
-                        std::string change_filename;
-#ifdef _WIN32  /* for Windows */
-                        if (fopt->l2s4ion == 1) change_filename = "rename";
-                        else if (fopt->l2s4ion == 2) change_filename = "copy";
-#else          /* for Linux or Mac */
-                        if (fopt->l2s4ion == 1) change_filename = "mv";
-                        else if (fopt->l2s4ion == 2) change_filename = "cp";
-#endif
-                        cmd = change_filename + " " + ionfile + " " + ionfileshort;
-                        std::system(cmd.c_str());
-                    }
+                    if (isfound == 1 && fopt->l2s4ion > 0) LongToShort(ionfile, ionfileshort, fopt->l2s4ion);
                 }
             }
 
@@ -6638,7 +8346,7 @@ void FtpUtil::GetIono(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else          /* for Linux or Mac */
                 cmd = "rm -rf " + tmpdir;
 #endif
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
             }
         }
         else Logger::Trace(TINFO, "*** INFO(FtpUtil::GetIono): ionopospheric product file " +
@@ -6691,33 +8399,31 @@ void FtpUtil::GetRoti(gtime_t ts, std::string dir, const ftpopt_t* fopt)
         /* it is OK for '*.Z' or '*.gz' format */
         std::string rotxfile = rotfile + ".*";
         std::string cmd = wgetfull + " " + qr + " -nH -A " + rotxfile + cutdirs + url;
-        std::system(cmd.c_str());
+        RunWget(cmd, fopt);
 
         std::string sep;
         sep.push_back((char)FILEPATHSEP);
         std::string localfile = dir + sep + rotfile, url0;
-        CString::GetFile(dir, rotfile, rotxfile);
+        GetFile(dir, rotfile, rotxfile);
         if (access(rotxfile.c_str(), 0) == -1)
         {
             Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetRoti): failed to download ROTI file " + rotfile);
 
             url0 = url + '/' + rotxfile;
-            if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetRoti): " << url0 << "  ->  " <<
-                localfile << "  failed" << std::endl;
+            LogXfer("GetRoti", url0, localfile, false);
         }
         else
         {
             /* extract '*.gz' or '*.Z' */
             cmd = gzipfull + " -d -f " + rotxfile;
-            std::system(cmd.c_str());
+            ProfUtil::System(cmd);
 
             if (access(rotfile.c_str(), 0) == 0)
             {
                 Logger::Trace(TINFO, "*** INFO(FtpUtil::GetRoti): successfully download ROTI file " + rotfile);
 
                 url0 = url + '/' + rotxfile;
-                if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetRoti): " << url0 << "  ->  " <<
-                    localfile << "  OK" << std::endl;
+                LogXfer("GetRoti", url0, localfile, true);
             }
         }
 
@@ -6730,7 +8436,7 @@ void FtpUtil::GetRoti(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else          /* for Linux or Mac */
             cmd = "rm -rf " + tmpdir;
 #endif
-            std::system(cmd.c_str());
+            ProfUtil::System(cmd);
         }
     }
     else Logger::Trace(TINFO, "*** INFO(FtpUtil::GetRoti): ROTI file " + rotfile + " has existed!");
@@ -6785,7 +8491,7 @@ void FtpUtil::GetTrop(gtime_t ts, std::string dir, const ftpopt_t* fopt)
 #else           /* for Linux or Mac */
             std::string cmd = "mkdir -p " + subdir;
 #endif
-            std::system(cmd.c_str());
+            ProfUtil::System(cmd);
         }
 
         /* change directory */
@@ -6819,7 +8525,7 @@ void FtpUtil::GetTrop(gtime_t ts, std::string dir, const ftpopt_t* fopt)
             CString::ToUpper(sitname);
             std::string zpdfilelongkey = "IGS0OPSFIN_" + syyyy + sdoy + "0000_01D_05M_" + sitname;
             std::string zpdfilelong, zpdfile;
-            CString::GetFile(subdir, zpdfilelongkey, zpdfilelong);
+            GetFile(subdir, zpdfilelongkey, zpdfilelong);
             if (access(zpdfileshort.c_str(), 0) == -1 && access(zpdfilelong.c_str(), 0) == -1)
             {
                 std::string url, cutdirs = " --cut-dirs=7 ";
@@ -6836,10 +8542,10 @@ void FtpUtil::GetTrop(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                 /* it is OK for '*.Z' or '*.gz' format */
                 std::string zpdxfile = zpdfilelongkey + "*";
                 std::string cmd = wgetfull + " " + qr + " -nH -A " + zpdxfile + cutdirs + url;
-                std::system(cmd.c_str());
+                RunWget(cmd, fopt);
 
                 int isfound = 0;  /* 1: long file name; 2: short filename */
-                CString::GetFile(subdir, zpdfilelongkey, zpdxfile);
+                GetFile(subdir, zpdfilelongkey, zpdxfile);
                 if (access(zpdxfile.c_str(), 0) == 0)
                 {
                     zpdfile = zpdxfile.substr(0, (int)zpdxfile.find_last_of('.'));
@@ -6850,9 +8556,9 @@ void FtpUtil::GetTrop(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                     /* it is OK for '*.Z' or '*.gz' format */
                     zpdxfile = zpdfileshort + ".*";
                     cmd = wgetfull + " " + qr + " -nH -A " + zpdxfile + cutdirs + url;
-                    std::system(cmd.c_str());
+                    RunWget(cmd, fopt);
 
-                    CString::GetFile(subdir, zpdfileshort, zpdxfile);
+                    GetFile(subdir, zpdfileshort, zpdxfile);
                     if (access(zpdxfile.c_str(), 0) == 0)
                     {
                         zpdfile = zpdfileshort;
@@ -6866,36 +8572,22 @@ void FtpUtil::GetTrop(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                     Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetTrop): failed to download IGS tropospheric product file " + zpdfile);
 
                     url0 = url + '/' + zpdxfile;
-                    if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetTrop): " << url0 << "  ->  " <<
-                        localfile << "  failed" << std::endl;
+                    LogXfer("GetTrop", url0, localfile, false);
                 }
                 else
                 {
                     /* extract '*.gz' or '*.Z' */
                     cmd = gzipfull + " -d -f " + zpdxfile;
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
                     if (access(zpdfile.c_str(), 0) == 0)
                     {
                         Logger::Trace(TINFO, "*** INFO(FtpUtil::GetTrop): successfully download IGS tropospheric product file " + zpdfile);
 
                         url0 = url + '/' + zpdxfile;
-                        if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetTrop): " << url0 << "  ->  " <<
-                            localfile << "  OK" << std::endl;
+                        LogXfer("GetTrop", url0, localfile, true);
 
                         /* to check if it needs to convert troposphere files with long name to those with short name */
-                        if (isfound == 1 && fopt->l2s4trp > 0)
-                        {
-                            std::string change_filename;
-    #ifdef _WIN32  /* for Windows */
-                            if (fopt->l2s4trp == 1) change_filename = "rename";
-                            else if (fopt->l2s4trp == 2) change_filename = "copy";
-    #else          /* for Linux or Mac */
-                            if (fopt->l2s4trp == 1) change_filename = "mv";
-                            else if (fopt->l2s4trp == 2) change_filename = "cp";
-    #endif
-                            cmd = change_filename + " " + zpdfile + " " + zpdfileshort;
-                            std::system(cmd.c_str());
-                        }
+                        if (isfound == 1 && fopt->l2s4trp > 0) LongToShort(zpdfile, zpdfileshort, fopt->l2s4trp);
                     }
                 }
             }
@@ -6917,7 +8609,7 @@ void FtpUtil::GetTrop(gtime_t ts, std::string dir, const ftpopt_t* fopt)
     #else           /* for Linux or Mac */
             std::string cmd = "mkdir -p " + subdir;
     #endif
-            std::system(cmd.c_str());
+            ProfUtil::System(cmd);
         }
 
         /* change directory */
@@ -6938,10 +8630,10 @@ void FtpUtil::GetTrop(gtime_t ts, std::string dir, const ftpopt_t* fopt)
             /* it is OK for '*.Z' or '*.gz' format */
             std::string trpxfile = trpfilelong + ".*";
             std::string cmd = wgetfull + " " + qr + " -nH -A " + trpxfile + cutdirs + url;
-            std::system(cmd.c_str());
+            RunWget(cmd, fopt);
 
             int isfound = 0;  /* 1: long file name; 2: short filename */
-            CString::GetFile(subdir, trpfilelong, trpxfile);
+            GetFile(subdir, trpfilelong, trpxfile);
             if (access(trpxfile.c_str(), 0) == 0)
             {
                 trpfile = trpfilelong;
@@ -6951,9 +8643,9 @@ void FtpUtil::GetTrop(gtime_t ts, std::string dir, const ftpopt_t* fopt)
             {
                 trpxfile = trpfileshort + ".*";
                 cmd = wgetfull + " " + qr + " -nH -A " + trpxfile + cutdirs + url;
-                std::system(cmd.c_str());
+                RunWget(cmd, fopt);
 
-                CString::GetFile(subdir, trpfileshort, trpxfile);
+                GetFile(subdir, trpfileshort, trpxfile);
                 if (access(trpxfile.c_str(), 0) == 0)
                 {
                     trpfile = trpfileshort;
@@ -6967,36 +8659,22 @@ void FtpUtil::GetTrop(gtime_t ts, std::string dir, const ftpopt_t* fopt)
                 Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetTrop): failed to download CODE tropospheric product file " + trpfile);
 
                 url0 = url + '/' + trpxfile;
-                if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetTrop): " << url0 << "  ->  " <<
-                    localfile << "  failed" << std::endl;
+                LogXfer("GetTrop", url0, localfile, false);
             }
             else
             {
                 /* extract '*.gz' or '*.Z' */
                 cmd = gzipfull + " -d -f " + trpxfile;
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
                 if (access(trpfile.c_str(), 0) == 0)
                 {
                     Logger::Trace(TINFO, "*** INFO(FtpUtil::GetTrop): successfully download CODE tropospheric product file " + trpfile);
 
                     url0 = url + '/' + trpxfile;
-                    if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetTrop): " << url0 << "  ->  " <<
-                        localfile << "  OK" << std::endl;
+                    LogXfer("GetTrop", url0, localfile, true);
 
                     /* to check if it needs to convert troposphere files with long name to those with short name */
-                    if (isfound == 1 && fopt->l2s4trp > 0)
-                    {
-                        std::string change_filename;
-#ifdef _WIN32  /* for Windows */
-                        if (fopt->l2s4trp == 1) change_filename = "rename";
-                        else if (fopt->l2s4trp == 2) change_filename = "copy";
-#else          /* for Linux or Mac */
-                        if (fopt->l2s4trp == 1) change_filename = "mv";
-                        else if (fopt->l2s4trp == 2) change_filename = "cp";
-#endif
-                        cmd = change_filename + " " + trpfilelong + " " + trpfileshort;
-                        std::system(cmd.c_str());
-                    }
+                    if (isfound == 1 && fopt->l2s4trp > 0) LongToShort(trpfilelong, trpfileshort, fopt->l2s4trp);
                 }
             }
         }
@@ -7028,12 +8706,13 @@ void FtpUtil::GetAntexIGS(gtime_t ts, std::string dir, const ftpopt_t* fopt)
     for (size_t i = 0; i < atxfiles.size(); i++)
     {
         atxfile = atxfiles[i];
-        if (access(atxfile.c_str(), 0) == -1)
+        /* 'igs20.atx' is updated under the same name, so it is re-fetched only if it is changed on the remote server */
+        std::string url = "https://files.igs.org/pub/station/general/" + atxfile, vlds;
+        if (IsMutableToGet(url, atxfile, fopt, vlds))
         {
             std::string wgetfull = fopt->wgetfull, qr = fopt->qr;
-            std::string url = "https://files.igs.org/pub/station/general/" + atxfile;
             std::string cmd = wgetfull + " " + qr + " -nH --cut-dirs=3 " + url;
-            std::system(cmd.c_str());
+            RunWget(cmd, fopt, "", false);
 
             std::string sep;
             sep.push_back((char)FILEPATHSEP);
@@ -7041,15 +8720,15 @@ void FtpUtil::GetAntexIGS(gtime_t ts, std::string dir, const ftpopt_t* fopt)
             if (access(atxfile.c_str(), 0) == 0)
             {
                 Logger::Trace(TINFO, "*** INFO(FtpUtil::GetAntexIGS): successfully download IGS ANTEX file " + atxfile);
-                if (fplog_.is_open()) fplog_ << "* INFO(FtpUtil::GetAntexIGS): " << url << "  ->  " <<
-                    localfile << "  OK" << std::endl;
+                LogXfer("GetAntexIGS", url, localfile, true);
             }
             else
             {
                 Logger::Trace(TWARNING, "*** WARNING(FtpUtil::GetAntexIGS): failed to download IGS ANTEX file " + atxfile);
-                if (fplog_.is_open()) fplog_ << "* WARNING(FtpUtil::GetAntexIGS): " << url << "  ->  " <<
-                    localfile << "  failed" << std::endl;
+                LogXfer("GetAntexIGS", url, localfile, false);
             }
+
+            EndMutableGet(url, atxfile, vlds, fopt);
         }
         else Logger::Trace(TINFO, "*** INFO(FtpUtil::GetAntexIGS): IGS ANTEX file " + atxfile + " has existed!");
     }
@@ -7105,7 +8784,7 @@ std::string FtpUtil::LoadSp3File(gtime_t ts, std::string dir, std::string ac_s,
         std::vector<std::string> sp3files;
         for (size_t i = 0; i < str.size(); i++)
         {
-            CString::GetFilesAll(dir, str[i], sp3files);
+            GetFilesAll(dir, str[i], sp3files);
             if ((int)sp3files.size() > 0) sp3file = sp3files[0];
             if (access(sp3file.c_str(), 0) == 0)
             {
@@ -7135,10 +8814,11 @@ std::string FtpUtil::LoadSp3File(gtime_t ts, std::string dir, std::string ac_s,
 } /* end of loadSp3File */
 
 /**
-* @brief   :  -
-* @param[I]:
-* @param[O]:
-* @return  :
+* @brief   : Sp3FilesIntoOneFile - to merge the SP3 files of three consecutive days into the file of the middle day, whose
+*              original is kept as '*.orig'
+* @param[I]: sp3files (SP3 files of the day before, the day, and the day after)
+* @param[O]: none
+* @return  : true: merged, false: NOT
 * @note    :
 **/
 bool FtpUtil::Sp3FilesIntoOneFile(std::vector<std::string> sp3files)
@@ -7155,64 +8835,69 @@ bool FtpUtil::Sp3FilesIntoOneFile(std::vector<std::string> sp3files)
         change_filename = "mv";
 #endif
         std::string cmd = change_filename + " " + sp3files[1] + " " + origin_file;
-        std::system(cmd.c_str());
+        ProfUtil::System(cmd);
     }
+    ProfUtil::tick_t t0 = ProfUtil::Tic();
     std::fstream filefp_out, filefp0_in, filefp1_in, filefp2_in;
     std::string sline0, sline1, sline2;
+    /* the lines are written to one large buffer without flushing each of them */
+    std::vector<char> outbuf(1 << 20);
+    filefp_out.rdbuf()->pubsetbuf(outbuf.data(), outbuf.size());
     filefp_out.open(sp3files[1], std::ios_base::out);
     filefp1_in.open(origin_file, std::ios_base::in);
     while (std::getline(filefp1_in, sline1))  /* to read and store the header components of the second SP3 file */
     {
-        if (sline1.substr(0, 2) == "* ")  /* the first record of data block */
+        if (sline1.compare(0, 2, "* ") == 0)  /* the first record of data block */
         {
             break;
         }
-        filefp_out << sline1 << std::endl;
+        filefp_out << sline1 << '\n';
     }
 
     filefp0_in.open(sp3files[0], std::ios_base::in);
     while (std::getline(filefp0_in, sline0))  /* to skip the header components of the first SP3 file */
     {
-        if (sline0.substr(0, 2) == "* ")  /* the first record of data block */
+        if (sline0.compare(0, 2, "* ") == 0)  /* the first record of data block */
         {
             break;
         }
     }
-    filefp_out << sline0 << std::endl;
+    filefp_out << sline0 << '\n';
     while (std::getline(filefp0_in, sline0))  /* to read the data block of the first SP3 file */
     {
         if (filefp0_in.eof()) break;
         if (sline0.find("EOF") != std::string::npos) break;
-        filefp_out << sline0 << std::endl;
+        filefp_out << sline0 << '\n';
     }
 
-    filefp_out << sline1 << std::endl;
+    filefp_out << sline1 << '\n';
     while (std::getline(filefp1_in, sline1))  /* to read the data block of the second SP3 file */
     {
         if (filefp1_in.eof()) break;
         if (sline1.find("EOF") != std::string::npos) break;
-        filefp_out << sline1 << std::endl;
+        filefp_out << sline1 << '\n';
     }
 
     filefp2_in.open(sp3files[2], std::ios_base::in);
     while (std::getline(filefp2_in, sline2))  /* to skip the header components of the third SP3 file */
     {
-        if (sline2.substr(0, 2) == "* ")  /* the first record of data block */
+        if (sline2.compare(0, 2, "* ") == 0)  /* the first record of data block */
         {
             break;
         }
     }
-    filefp_out << sline2 << std::endl;
+    filefp_out << sline2 << '\n';
     while (std::getline(filefp2_in, sline2))  /* to read the data block of the third SP3 file */
     {
         if (filefp2_in.eof()) break;
-        filefp_out << sline2 << std::endl;
+        filefp_out << sline2 << '\n';
     }
 
     filefp_out.close();
     filefp0_in.close();
     filefp1_in.close();
     filefp2_in.close();
+    ProfUtil::Toc(PROF_MERGE, t0, sp3files[1]);
 
     return true;
 } /* end of Sp3FilesIntoOneFile */
@@ -7255,17 +8940,257 @@ void FtpUtil::MergeSp3Files(gtime_t ts, std::string dir, std::string ac)
     this->Sp3FilesIntoOneFile(sp3filesshort);
 } /* end of MergeSp3Files */
 
+/**
+* @brief   : GetListedSize - to get the size of the observation files of one day (or the hours of one day) from the
+*              listings of the archive, i.e., for the size-aware ordering of the jobs in the backfill mode
+* @param[I]: ts (time of the day)
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : size (bytes) of the files to be downloaded, -1 if NOT listed
+* @note    : only the IGS, MGEX and IGM observations of CDDIS (or its local mirror) are listed, and for the hourly and
+*              high-rate ones, only the first hour is listed and scaled to all the hours
+**/
+double FtpUtil::GetListedSize(gtime_t ts, const ftpopt_t* fopt)
+{
+    init(fopt);
+    std::string ftpname = fopt->ftpfrom, obstype = fopt->obstype, obsfrom = fopt->obsfrom;
+    CString::trim(ftpname);
+    CString::ToUpper(ftpname);
+    CString::trim(obstype);
+    CString::ToLower(obstype);
+    CString::trim(obsfrom);
+    CString::ToLower(obsfrom);
+    if (ftpname != "CDDIS" && ftpname != "LOCAL") return -1.0;
+    if (obsfrom != "igs" && obsfrom != "mgex" && obsfrom != "igm") return -1.0;
+
+    int yyyy, doy;
+    GTime::time2yrdoy(ts, yyyy, doy);
+    std::string syyyy = CString::int2str(yyyy, 4), sdoy = CString::int2str(doy, 3), syy = syyyy.substr(2, 2);
+    std::string shh = CString::int2str(fopt->hhobs.empty() ? 0 : fopt->hhobs[0], 2);
+    std::string url, igsptn, mgexptn;
+    double nhour = 1.0;
+    if (obstype == "daily")
+    {
+        url = ftparchive_.CDDIS[IDX_OBSD] + "/" + syyyy + "/" + sdoy + "/" + syy + "d";
+        igsptn = "????" + sdoy + "0." + syy + "d.*";
+        mgexptn = "*_" + syyyy + sdoy + "0000_01D_30S_MO.crx.*";
+    }
+    else if (obstype == "hourly")
+    {
+        url = ftparchive_.CDDIS[IDX_OBSH] + "/" + syyyy + "/" + sdoy + "/" + shh;
+        igsptn = "????" + sdoy + "?." + syy + "d.*";
+        mgexptn = "*_" + syyyy + sdoy + shh + "00_01H_30S_MO.crx.*";
+        nhour = (double)std::max((int)fopt->hhobs.size(), 1);
+    }
+    else if (obstype == "highrate")
+    {
+        url = ftparchive_.CDDIS[IDX_OBSHR] + "/" + syyyy + "/" + sdoy + "/" + syy + "d" + "/" + shh;
+        igsptn = "????" + sdoy + "???." + syy + "d.*";
+        mgexptn = "*_" + syyyy + sdoy + shh + "??_15M_01S_MO.crx.*";
+        nhour = (double)std::max((int)fopt->hhobs.size(), 1);
+    }
+    else return -1.0;
+
+    std::map<std::string, std::pair<double, double>> entries;
+    if (!ListRemote(url, fopt, entries)) return -1.0;
+
+    /* the sites of the site list, or all the sites listed */
+    std::set<std::string> sites;
+    std::string::size_type ipos = fopt->obslist.find_last_of("/\\") + 1;
+    bool islist = fopt->obslist.size() - ipos >= 9;
+    if (islist)
+    {
+        std::ifstream sitlst(fopt->obslist.c_str());
+        std::string site;
+        while (sitlst.is_open() && getline(sitlst, site))
+        {
+            CString::trim(site);
+            if (site.size() < 4 || site[0] == '#') continue;
+            site = site.substr(0, 4);
+            CString::ToLower(site);
+            sites.insert(site);
+        }
+    }
+
+    /* the MGEX files are preferred to the IGS ones of the same site for 'igm' */
+    std::map<std::string, double> sizes;
+    for (int k = 0; k < 2; k++)
+    {
+        std::string ptn = k == 0 ? mgexptn : igsptn;
+        if ((k == 0 && obsfrom == "igs") || (k == 1 && obsfrom == "mgex")) continue;
+        std::map<std::string, double> ksizes;
+        for (auto it = entries.begin(); it != entries.end(); ++it)
+        {
+            if (!MatchWild(ptn.c_str(), it->first.c_str())) continue;
+            std::string site = it->first.substr(0, 4);
+            CString::ToLower(site);
+            if (islist && sites.find(site) == sites.end()) continue;
+            if (k == 1 && sizes.find(site) != sizes.end()) continue;
+            ksizes[site] += it->second.first;
+        }
+        for (auto it = ksizes.begin(); it != ksizes.end(); ++it) sizes[it->first] = it->second;
+    }
+
+    double size = 0.0;
+    for (auto it = sizes.begin(); it != sizes.end(); ++it) size += it->second;
+
+    return size * nhour;
+} /* end of GetListedSize */
+
+/**
+* @brief   : ShardTag - to get the tag of the files written by this shard only, i.e., "_shard0of4"
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : tag, empty if the run is NOT split
+* @note    :
+**/
+std::string FtpUtil::ShardTag(const ftpopt_t* fopt)
+{
+    if (fopt->nshard <= 1) return "";
+
+    return "_shard" + std::to_string(fopt->ishard) + "of" + std::to_string(fopt->nshard);
+} /* end of ShardTag */
+
+/**
+* @brief   : Resume - to replay the file journal of the last runs before downloading, i.e., the files fetched but NOT decoded
+*              are decoded (i.e., decompressed, Hatanaka-decompressed) again, while the '*.part' files of the interrupted
+*              transfers are kept to be resumed when their files are requested again
+* @param[I]: popt (processing options)
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : none
+* @note    : it must be called once before any concurrent download, because the journal is compacted and the files are
+*              decoded. The files failed to be decoded are removed with their decoded files, so that they are NOT taken as
+*              downloaded by the existence checks. The decoded and committed files are NOT examined at all, except the ones
+*              moved aside by the run manifest
+**/
+void FtpUtil::Resume(const prcopt_t* popt, const ftpopt_t* fopt)
+{
+    if (access(popt->logdir.c_str(), 0) == -1) return;
+
+    std::string sep;
+    sep.push_back((char)FILEPATHSEP);
+    JournalUtil journal;
+    if (!journal.Open(popt->logdir + sep + "files" + ShardTag(fopt) + ".journal")) return;
+
+    /* the third-party softwares, see FtpDownload */
+#ifdef _WIN32   /* for Windows */
+    std::string gzipfull = popt->dir3party + sep + "gzip";
+#else           /* for Linux or Mac */
+    std::string gzipfull = "gzip";
+#endif
+    std::string crx2rnxfull = popt->dir3party + sep + "crx2rnx";
+    CString::trim(gzipfull);
+    CString::trim(crx2rnxfull);
+
+    /* the files moved aside by the run manifest are fetched again, see IsCommitted */
+    const std::vector<std::string>& moved = ManifestUtil::Moved();
+    std::set<std::string> movedset(moved.begin(), moved.end());
+
+    int npart = 0, ndecode = 0, nclean = 0;
+    const std::map<std::string, std::string> states = journal.GetStates();
+    for (auto it = states.begin(); it != states.end(); ++it)
+    {
+        std::string file = it->first;
+        if (it->second == JOB_COMMITTED && movedset.count(file) > 0)
+        {
+            journal.SetState(file, JOB_PLANNED);
+            continue;
+        }
+        if (it->second == JOB_FETCHING)
+        {
+            if (access((file + ".part").c_str(), 0) == 0) npart++;
+            continue;
+        }
+        if (it->second == JOB_DECODED) journal.SetState(file, JOB_COMMITTED);
+        if (it->second != JOB_FETCHED) continue;
+
+        /* the fetched file, its decompressed file, and its RINEX file decoded from the Hatanaka-compressed one */
+        std::vector<std::string> files = { file };
+        std::string dfile = file, ofile;
+        if (dfile.size() > 3 && dfile.substr(dfile.size() - 3) == ".gz") dfile.erase(dfile.size() - 3);
+        else if (dfile.size() > 2 && dfile.substr(dfile.size() - 2) == ".Z") dfile.erase(dfile.size() - 2);
+        if (dfile != file) files.push_back(dfile);
+
+        /* the decode step interrupted is run again from the file it was left with, and the MGEX observation file is decoded
+           by the same step as the getters, including its file with short name */
+        bool isdecoded = false;
+        if (dfile.size() > 4 && dfile.substr(dfile.size() - 4) == ".crx")
+        {
+            files.push_back(dfile.substr(0, dfile.size() - 4) + ".rnx");
+            isdecoded = !DecodeCrx(access(file.c_str(), 0) == 0 ? file : dfile, gzipfull, crx2rnxfull, fopt->l2s4obs).empty();
+        }
+        else
+        {
+            if (dfile.size() > 4 && dfile[dfile.size() - 4] == '.' && dfile.back() == 'd')
+            {
+                ofile = dfile.substr(0, dfile.size() - 1) + "o";
+                files.push_back(ofile);
+            }
+            if (dfile != file && access(file.c_str(), 0) == 0) ProfUtil::System(gzipfull + " -d -f " + file);
+            if (!ofile.empty() && access(dfile.c_str(), 0) == 0)
+            {
+#ifdef _WIN32   /* for Windows */
+                ProfUtil::System(crx2rnxfull + " " + dfile + " -f - > " + ofile);
+#else           /* for Linux or Mac */
+                ProfUtil::System("cat " + dfile + " | " + crx2rnxfull + " -f - > " + ofile);
+#endif
+                if (access(ofile.c_str(), 0) == 0) std::remove(dfile.c_str());
+            }
+            isdecoded = access(files.back().c_str(), 0) == 0 && (ofile.empty() || access(dfile.c_str(), 0) == -1);
+        }
+        if (isdecoded)
+        {
+            journal.SetState(file, JOB_COMMITTED);
+            ndecode++;
+            continue;
+        }
+
+        for (size_t i = 0; i < files.size(); i++) std::remove(files[i].c_str());
+        journal.SetState(file, JOB_PLANNED);
+        nclean++;
+    }
+    journal.Close();
+
+    /* the validator journal is compacted before any concurrent download too, see StoreValidators */
+    JournalUtil vldjournal;
+    vldjournal.Open(popt->logdir + sep + "validators" + ShardTag(fopt) + ".journal");
+    vldjournal.Close();
+
+    if (npart > 0 || ndecode > 0 || nclean > 0) Logger::Trace(TINFO, "*** INFO(FtpUtil::Resume): " + std::to_string(npart) +
+        " partial files of the interrupted transfers are kept for resumption, " + std::to_string(ndecode) +
+        " files interrupted while being decoded are decoded again, " + std::to_string(nclean) +
+        " files failed to be decoded are fetched again");
+} /* end of Resume */
+
+/**
+* @brief   : Reseed - to seed the generator of the jitter of the retry backoff by the random device, the process ID and the
+*              time, so that the processes started in the same second do NOT back off in step
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void FtpUtil::Reseed()
+{
+    std::random_device rd;
+    std::seed_seq seq = { (unsigned int)rd(), (unsigned int)getpid(), (unsigned int)time(NULL),
+        (unsigned int)std::chrono::steady_clock::now().time_since_epoch().count() };
+    rng_.seed(seq);
+    isseeded_ = true;
+} /* end of Reseed */
+
 /**
 * @brief     : FtpDownload - GNSS data downloading via FTP
 * @param[I]  : popt (processing options)
 * @param[I/O]: fopt (FTP options)
-* @return    : none
+* @return    : number of files failed, i.e., the records of the log file whose status is "failed"
 * @note      :
 **/
-void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t* fopt)
+int FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t* fopt)
 {
-    /* Get FTP archive for CDDIS, IGN, or WHU */
-    init();
+    /* Get FTP archive for CDDIS, IGN, WHU, or LOCAL */
+    init(fopt);
 
     /* setting of the third-party softwares (.i.e, wget, gzip, crx2rnx etc.) */
     std::string sep;
@@ -7289,9 +9214,16 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t* fopt)
     CString::trim(fopt->crx2rnxfull);
 #endif
 
-    /* "-qr" (printInfoWget == false, not print information of 'wget') or "r" (printInfoWget == true, print information of 'wget') in 'wget' command line */
+    /* "-nv -r" (printInfoWget == false, not print information of 'wget') or "-r" (printInfoWget == true, print information of 'wget') in
+       'wget' command line, and the output of 'wget' is always kept for the classification of failures, see RunWget */
     if (fopt->printinfo4wget) fopt->qr = "-r";
-    else fopt->qr = "-qr";
+    else fopt->qr = "-nv -r";
+
+    /* the shared read-through cache */
+    cache_.Init(fopt);
+
+    /* seed for the jitter of retry backoff, once per process */
+    if (!isseeded_) Reseed();
 
     /* If the directory does not exist, creat it */
     if (access(popt->logdir.c_str(), 0) == -1)
@@ -7301,9 +9233,20 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t* fopt)
 #else           /* for Linux or Mac */
         std::string cmd = "mkdir -p " + popt->logdir;
 #endif
-        std::system(cmd.c_str());
+        ProfUtil::System(cmd);
     }
-    fplog_.open(popt->logfil, std::ios::out);
+    /* the log file is appended in the watch and backfill modes, which call the downloader once per polling cycle or job, and
+       for the days after the first one of one run */
+    fplog_.open(popt->logfil, (popt->watchmode || popt->backfill || islogged_) ? std::ios::app : std::ios::out);
+    islogged_ = true;
+    logdir_ = popt->logdir;
+    xfer_ = xfer_t();
+    /* the file journal is NOT compacted when it is opened, because the jobs of the backfill mode run in parallel processes */
+    journal_.Open(popt->logdir + sep + "files" + ShardTag(fopt) + ".journal", false);
+    vldjournal_.Open(popt->logdir + sep + "validators" + ShardTag(fopt) + ".journal", false);
+    fetched_.clear();
+    nfailed_ = 0;
+    tprod_ = (popt->ts.mjd - 40587) * 86400.0 + popt->ts.sod;
 
     /* IGS observation (short name 'd') downloaded */
     if (fopt->getobs)
@@ -7316,7 +9259,7 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t* fopt)
 #else           /* for Linux or Mac */
             std::string cmd = "mkdir -p " + popt->obsdir;
 #endif
-            std::system(cmd.c_str());
+            ProfUtil::System(cmd);
         }
 
         std::string obstyp = fopt->obstype;
@@ -7332,6 +9275,7 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t* fopt)
             {
                 std::string obsufrom = obsfrom;
                 CString::ToUpper(obsufrom);
+                ProfUtil::Begin("obs_" + obsfrom);
                 /* creation of sub-directory */
                 std::string subobsdir = popt->obsdir + sep + obsufrom;
                 if (access(subobsdir.c_str(), 0) == -1)
@@ -7342,7 +9286,7 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                     std::string cmd = "mkdir -p " + subobsdir;
 #endif
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
                 }
 
                 if (obsfrom == "igs")       /* IGS observation (RINEX version 2.xx, short name "d") */
@@ -7389,6 +9333,7 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t* fopt)
                 {
                     if (obstyp == "daily") GetDailyObsChi(popt->ts, subobsdir, fopt);
                 }
+                ProfUtil::End();
             }
         }
     }
@@ -7404,10 +9349,12 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t* fopt)
 #else           /* for Linux or Mac */
             std::string cmd = "mkdir -p " + popt->navdir;
 #endif
-            std::system(cmd.c_str());
+            ProfUtil::System(cmd);
         }
 
+        ProfUtil::Begin("nav");
         GetNav(popt->ts, popt->navdir.c_str(), fopt);
+        ProfUtil::End();
     }
 
     /* precise orbit and clock product downloaded */
@@ -7431,54 +9378,8 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t* fopt)
         for (int i = 0; i < (int)acs.size(); i++)
         {
             std::string ac_i = acs[i];
-            int prodtype = 0;
-
-            /* cnt: CNES real-time orbit and clock products from CNES offline files */
-            if (ac_i == "cnt") prodtype = PROD_REALTIME;
-
-            /* esa_u: ESA ultra-rapid orbit and clock products
-               gfz_u: GFZ ultra-rapid orbit and clock products
-               igs_u: IGS ultra-rapid orbit and clock products
-               whu_u: WHU ultra-rapid orbit and clock products
-            */
-            std::vector<std::string> ultra_ac = { "esa_u", "gfz_u", "igs_u", "whu_u" };
-            auto isfound = std::find(ultra_ac.begin(), ultra_ac.end(), ac_i);
-            if (isfound != ultra_ac.end()) prodtype = PROD_ULTRA_RAPID;
-
-            /* cod_r: CODE rapid orbit and clock products
-               emr_r: NRCan rapid orbit and clock products
-               esa_r: ESA rapid orbit and clock products
-               gfz_r: GFZ rapid orbit and clock products
-               igs_r: IGS rapid orbit and clock products
-            */
-            std::vector<std::string> rapid_ac = { "cod_r", "emr_r", "esa_r", "gfz_r", "igs_r" };
-            isfound = std::find(rapid_ac.begin(), rapid_ac.end(), ac_i);
-            if (isfound != rapid_ac.end()) prodtype = PROD_RAPID;
-
-            /* cod: CODE final orbit and clock products
-               emr: NRCan final orbit and clock products
-               esa: ESA final orbit and clock products
-               gfz: GFZ final orbit and clock products
-               grg: CNES final orbit and clock products
-               igs: IGS final orbit and clock products
-               jpl: JPL final orbit and clock products
-               mit: MIT final orbit and clock products
-            */
-            std::vector<std::string> final_ac_IGS = { "cod", "emr", "esa", "gfz", "grg", "igs", "jgx", "jpl", "mit" };
-            isfound = std::find(final_ac_IGS.begin(), final_ac_IGS.end(), ac_i);
-            if (isfound != final_ac_IGS.end()) prodtype = PROD_FINAL_IGS;
-
-            /* cod_m: CODE multi-GNSS final orbit and clock products
-               gfz_m: GFZ multi-GNSS final orbit and clock products
-               grg_m: CNES multi-GNSS final orbit and clock products
-               iac_m: Russia Information and Analysis Center (IAC) multi-GNSS final orbit and clock products
-               jax_m: Japan Aerospace Exploration Agency (JAXA) multi-GNSS final orbit and clock products
-               sha_m: Shanghai Observatory (SHAO) multi-GNSS final orbit and clock products
-               whu_m: Wuhan University (WHU) multi-GNSS final orbit and clock products
-            */
-            std::vector<std::string> final_ac_MGEX = { "cod_m", "gfz_m", "grg_m", "iac_m", "jax_m", "sha_m", "whu_m" };
-            isfound = std::find(final_ac_MGEX.begin(), final_ac_MGEX.end(), ac_i);
-            if (isfound != final_ac_MGEX.end()) prodtype = PROD_FINAL_MGEX;
+            int prodtype = GetProdType(ac_i);
+            ProfUtil::Begin("orbclk_" + ac_i);
 
             /* creation of sub-directory */
             std::string suborbdir = popt->orbdir;
@@ -7492,10 +9393,10 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                 std::string cmd = "mkdir -p " + suborbdir;
 #endif
-                std::system(cmd.c_str());
+                ProfUtil::System(cmd);
             }
             /* for clk at a specified day */
-            if (prodtype > 0 && prodtype != PROD_ULTRA_RAPID)
+            if ((prodtype > 0 || ac_i == "best") && prodtype != PROD_ULTRA_RAPID)
             {
                 if (access(subclkdir.c_str(), 0) == -1)
                 {
@@ -7505,10 +9406,22 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t* fopt)
 #else           /* for Linux or Mac */
                     std::string cmd = "mkdir -p " + subclkdir;
 #endif
-                    std::system(cmd.c_str());
+                    ProfUtil::System(cmd);
                 }
             }
             std::vector<std::string> subdirs = { suborbdir, subclkdir };
+            if (ac_i == "best")
+            {
+                /* the best products currently available at each day, and the SP3 files of different tiers are NOT merged */
+                GetOrbClkBest(popt->ts, subdirs, fopt);
+                if (fopt->minus_add_1day)
+                {
+                    GetOrbClkBest(GTime::TimeAdd(popt->ts, -86400.0), subdirs, fopt);
+                    GetOrbClkBest(GTime::TimeAdd(popt->ts, 86400.0), subdirs, fopt);
+                }
+                ProfUtil::End();
+                continue;
+            }
             GetOrbClk(popt->ts, subdirs, prodtype, ac_i, fopt);
 
             if (fopt->minus_add_1day && (prodtype == PROD_FINAL_IGS || prodtype == PROD_FINAL_MGEX))
@@ -7528,6 +9441,7 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t* fopt)
             {
                 this->MergeSp3Files(popt->ts, suborbdir, ac_i);
             }
+            ProfUtil::End();
         }
     }
 
@@ -7542,10 +9456,12 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t* fopt)
 #else           /* for Linux or Mac */
             std::string cmd = "mkdir -p " + popt->eopdir;
 #endif
-            std::system(cmd.c_str());
+            ProfUtil::System(cmd);
         }
 
+        ProfUtil::Begin("eop");
         GetEop(popt->ts, popt->eopdir.c_str(), fopt);
+        ProfUtil::End();
     }
 
     /* ORBEX (ORBit EXchange format) downloaded */
@@ -7559,10 +9475,12 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t* fopt)
 #else           /* for Linux or Mac */
             std::string cmd = "mkdir -p " + popt->obxdir;
 #endif
-            std::system(cmd.c_str());
+            ProfUtil::System(cmd);
         }
 
+        ProfUtil::Begin("obx");
         GetObx(popt->ts, popt->obxdir.c_str(), fopt);
+        ProfUtil::End();
     }
 
 
@@ -7577,10 +9495,12 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t* fopt)
 #else           /* for Linux or Mac */
             std::string cmd = "mkdir -p " + popt->biadir;
 #endif
-            std::system(cmd.c_str());
+            ProfUtil::System(cmd);
         }
 
+        ProfUtil::Begin("dsb");
         GetDsb(popt->ts, popt->biadir.c_str(), fopt);
+        ProfUtil::End();
     }
 
 
@@ -7595,10 +9515,12 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t* fopt)
 #else           /* for Linux or Mac */
             std::string cmd = "mkdir -p " + popt->biadir;
 #endif
-            std::system(cmd.c_str());
+            ProfUtil::System(cmd);
         }
 
+        ProfUtil::Begin("osb");
         GetOsb(popt->ts, popt->biadir.c_str(), fopt);
+        ProfUtil::End();
     }
 
     /* IGS SINEX file downloaded */
@@ -7612,10 +9534,12 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t* fopt)
 #else           /* for Linux or Mac */
             std::string cmd = "mkdir -p " + popt->snxdir;
 #endif
-            std::system(cmd.c_str());
+            ProfUtil::System(cmd);
         }
 
+        ProfUtil::Begin("snx");
         GetSnx(popt->ts, popt->snxdir.c_str(), fopt);
+        ProfUtil::End();
     }
 
     /* global ionosphere map (GIM) downloaded */
@@ -7629,10 +9553,12 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t* fopt)
 #else           /* for Linux or Mac */
             std::string cmd = "mkdir -p " + popt->iondir;
 #endif
-            std::system(cmd.c_str());
+            ProfUtil::System(cmd);
         }
 
+        ProfUtil::Begin("ion");
         GetIono(popt->ts, popt->iondir.c_str(), fopt);
+        ProfUtil::End();
     }
 
     /* Rate of TEC index (ROTI) file downloaded */
@@ -7646,10 +9572,12 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t* fopt)
 #else           /* for Linux or Mac */
             std::string cmd = "mkdir -p " + popt->iondir;
 #endif
-            std::system(cmd.c_str());
+            ProfUtil::System(cmd);
         }
 
+        ProfUtil::Begin("roti");
         GetRoti(popt->ts, popt->iondir.c_str(), fopt);
+        ProfUtil::End();
     }
 
     /* final tropospheric product downloaded */
@@ -7663,10 +9591,12 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t* fopt)
 #else           /* for Linux or Mac */
             std::string cmd = "mkdir -p " + popt->ztddir;
 #endif
-            std::system(cmd.c_str());
+            ProfUtil::System(cmd);
         }
 
+        ProfUtil::Begin("trp");
         GetTrop(popt->ts, popt->ztddir.c_str(), fopt);
+        ProfUtil::End();
     }
 
     /* IGS ANTEX file downloaded */
@@ -7680,11 +9610,32 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t* fopt)
 #else           /* for Linux or Mac */
             std::string cmd = "mkdir -p " + popt->tbldir;
 #endif
-            std::system(cmd.c_str());
+            ProfUtil::System(cmd);
         }
 
+        ProfUtil::Begin("atx");
         GetAntexIGS(popt->ts, popt->tbldir.c_str(), fopt);
+        ProfUtil::End();
     }
 
+    /* only the files decoded are committed, and the others are decoded again by Resume next time */
+    for (size_t i = 0; i < fetched_.size(); i++)
+    {
+        if (journal_.GetState(fetched_[i]) == JOB_DECODED) journal_.SetState(fetched_[i], JOB_COMMITTED);
+    }
+    fetched_.clear();
+    /* the journal appended by each polling cycle of the watch mode is compacted here, unless it is shared by the jobs of
+       the backfill mode running in parallel processes */
+    if (!popt->backfill) journal_.Compact();
+    journal_.Close();
+    if (!popt->backfill) vldjournal_.Compact();
+    vldjournal_.Close();
+
+    /* the shared cache is kept within its size budget */
+    cache_.Prune();
+
+    FlushLog();
     if (fplog_.is_open()) fplog_.close();  /* to close the log file */
+
+    return nfailed_;
 } /* end of FtpDownload */
\ No newline at end of file
@@ -13,21 +13,413 @@ private:
         std::vector<std::string> CDDIS;  /* CDDIS FTP */
         std::vector<std::string> IGN;    /* IGN FTP */
         std::vector<std::string> WHU;    /* WHU FTP */
+        std::vector<std::string> LOCAL;  /* local mirror (file://) of CDDIS archive */
     };
     ftpArchive_t ftparchive_;
 
-    std::ofstream fplog_;                /* ofstream of output log file */
+    struct xfer_t
+    {                                    /* metrics of the transfers of one file since the last record of the log file */
+        std::string url;                 /* URL of the last transfer */
+        std::string source;              /* "remote", "cache" (shared cache), or "mirror" (local mirror) */
+        int xstat = -1;                  /* class of the outcome of the last transfer (XFER_*), -1: no transfer */
+        double wirebytes = 0.0;          /* bytes moved over the network */
+        double xfersec = 0.0;            /* transfer time (s), including the retries */
+        int retries = 0;                 /* number of retries */
+        std::string checksum;            /* algorithm of the checksum the payload is verified against, empty: NOT verified */
+        std::chrono::steady_clock::time_point tend;  /* end of the last transfer, for the decompression/conversion time */
+    };
+    xfer_t xfer_;
+
+    std::ofstream fplog_;                /* ofstream of output log file, one JSON record per file (JSON Lines) */
+    std::string logbuf_;                 /* records NOT written to the log file yet, see LogXfer */
+
+    std::map<std::string, std::string> sfxcache_;  /* compression suffix ('.gz' or '.Z') found last time per remote directory or host */
+    std::map<std::string, std::map<std::string, std::string>> sums_;  /* checksums ('sha512:<hex>' or 'md5:<hex>') per file per
+                                                                          remote directory */
+    std::set<std::string> sumdirs_;      /* remote directories whose checksum files have been fetched by this process */
+
+    int nretry_ = 0;                     /* number of retries used in this run */
+    bool budgetout_ = false;             /* whether the retry budget of this run is used up */
+    std::mt19937 rng_;                   /* generator of the jitter of the retry backoff, see Reseed */
+    bool isseeded_ = false;              /* whether the generator has been seeded by this process */
+
+    CacheUtil cache_;                    /* shared read-through cache */
+
+    JournalUtil journal_;                /* journal of the state transitions of the files fetched, see Resume */
+    JournalUtil vldjournal_;             /* validators of the mutable products and the partial payloads per local file (with
+                                            full path), see GetStoredValidators */
+    std::vector<std::string> fetched_;   /* files fetched and products (with full path) of this call of FtpDownload, NOT
+                                            committed yet */
+    int nfailed_ = 0;                    /* number of files failed in this call of FtpDownload, see LogXfer */
+
+    double tprod_ = 0.0;                 /* epoch (Unix time) of the products of this call of FtpDownload, for the metrics */
+    bool islogged_ = false;              /* true: the log file has been opened by one call of FtpDownload of this run */
+    std::string logdir_;                 /* directory of the log files, where the states kept across the runs are also stored */
 
 private:
 
     /**
-    * @brief   : init - Get FTP archive for CDDIS, IGN, or WHU
+    * @brief   : init - Get FTP archive for CDDIS, IGN, WHU, or LOCAL
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void init(const ftpopt_t* fopt);
+
+    /**
+    * @brief   : RunWget - to run one 'wget' command, i.e., from the local mirror, the shared cache, or the remote server with
+    *              the retry policy
+    * @param[I]: cmd ('wget' command line)
+    * @param[I]: fopt (FTP options)
+    * @param[I]: xfile (local file to be tested for integrity after the transfer, empty: NOT tested)
+    * @param[I]: cacheable (false: the shared cache is NOT used, i.e., for the mutable products)
+    * @param[O]: none
+    * @return  : class of the transfer outcome (XFER_*)
+    * @note    :
+    **/
+    int RunWget(std::string cmd, const ftpopt_t* fopt, std::string xfile = "", bool cacheable = true);
+
+    /**
+    * @brief   : PartWget - to run one 'wget' command of one exactly-known file into the '*.part' file, which is renamed to
+    *              the file only when the transfer is complete, so that the interrupted transfer is resumed by 'wget -c' next time
+    * @param[I]: cmd ('wget' command line)
+    * @param[I]: fopt (FTP options)
+    * @param[I]: xfile (local file to be tested for integrity after the transfer, empty: NOT tested)
+    * @param[I]: localfile (local file in the current directory, empty: the 'wget' command is run as it is)
+    * @param[O]: none
+    * @return  : class of the transfer outcome (XFER_*)
+    * @note    : the recursive retrieval is run in a directory prefix of this process, see MoveOut. The '*.part' file is NOT
+    *              resumed if the validators of the remote file differ from those stored for it, see GetValidators
+    **/
+    int PartWget(std::string cmd, const ftpopt_t* fopt, std::string xfile, std::string localfile);
+
+    /**
+    * @brief   : MoveOut - to move the files retrieved into one directory prefix ('-P') of 'wget' to the current directory
+    *              with their relative paths, and remove the directory prefix with the '.listing' files in it
+    * @param[I]: dir (directory prefix, relative to the current directory)
+    * @param[I]: sub (relative path under the directory prefix, empty: the top)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the name of '.listing' is fixed by 'wget', so the processes working in the same directory (i.e., the jobs
+    *              of the backfill mode) run 'wget' in directory prefixes of their own to NOT overwrite each other's listing
+    **/
+    void MoveOut(std::string dir, std::string sub);
+
+    /**
+    * @brief   : LogXfer - to record the outcome of one file in the log file, with the metrics of its transfers
+    * @param[I]: func (function, i.e., "GetOrbClk")
+    * @param[I]: url (URL, or the other source of the file)
+    * @param[I]: localfile (local file with full path)
+    * @param[I]: isok (true: got, false: failed)
+    * @param[I]: note (the other information, empty: none)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void LogXfer(std::string func, std::string url, std::string localfile, bool isok, std::string note = "");
+
+    /**
+    * @brief   : FlushLog - to write the buffered records to the log file
     * @param[I]: none
     * @param[O]: none
     * @return  : none
     * @note    :
     **/
-    void init();
+    void FlushLog();
+
+    /**
+    * @brief   : GetCwdFile - to get the full path of one file in the current directory
+    * @param[I]: file (file name)
+    * @param[O]: none
+    * @return  : file with full path
+    * @note    :
+    **/
+    std::string GetCwdFile(std::string file);
+
+    /**
+    * @brief   : IsCommitted - to check whether one file has been committed in the file journal by the last runs
+    * @param[I]: localfile (local file with full path, as it is recorded by LogXfer)
+    * @param[O]: none
+    * @return  : true: committed, i.e., it is skipped without any existence check or remote access, false: NOT committed
+    * @note    :
+    **/
+    bool IsCommitted(std::string localfile);
+
+    /**
+    * @brief   : GetStateDir - to get one directory of the states kept across the runs in 'logDir', which is created if needed
+    * @param[I]: name (name of the directory, i.e., "listings")
+    * @param[O]: none
+    * @return  : the directory with full path
+    * @note    :
+    **/
+    std::string GetStateDir(std::string name);
+
+    /**
+    * @brief   : GetFile - to get the full name of a specific file from one directory, see CString::GetFile
+    * @param[I]: dir (the directory)
+    * @param[I]: str (string to match)
+    * @param[O]: filename (the full name of a specific file)
+    * @return  : true: found, false: NOT found
+    * @note    : the scan is counted in the file system operations of the profile
+    **/
+    static bool GetFile(std::string dir, std::string str, std::string& filename);
+
+    /**
+    * @brief   : GetFilesAll - to get the name list of all the files from one directory, see CString::GetFilesAll
+    * @param[I]: dir (the directory)
+    * @param[I]: str (string to match)
+    * @param[O]: files (the name list of all the files)
+    * @return  : none
+    * @note    : the scan is counted in the file system operations of the profile
+    **/
+    static void GetFilesAll(std::string dir, std::string str, std::vector<std::string>& files);
+
+    /**
+    * @brief   : RetryWget - to run one 'wget' command with the retry policy, i.e., the failure is classified, and only the
+    *              transient, throttled or corrupt ones are retried with jittered exponential backoff within the retry budget
+    * @param[I]: cmd ('wget' command line)
+    * @param[I]: fopt (FTP options)
+    * @param[I]: xfile (local file to be tested for integrity after the transfer, empty: NOT tested)
+    * @param[I]: sumfile (local file to be verified against the checksum after the transfer, empty: NOT verified)
+    * @param[I]: sumurl (URL of the remote file whose checksum is published, see GetChecksum)
+    * @param[O]: none
+    * @return  : class of the transfer outcome (XFER_*)
+    * @note    :
+    **/
+    int RetryWget(std::string cmd, const ftpopt_t* fopt, std::string xfile, std::string sumfile = "", std::string sumurl = "");
+
+    /**
+    * @brief   : CheckFile - to test the integrity of one file transferred and get its digest in one pass of reading
+    * @param[I]: file (local file)
+    * @param[I]: istest (true: tested by 'gzip -t')
+    * @param[I]: algo (algorithm of the digest, DIGEST_*, -1: no digest)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: digest (digest in lowercase hexadecimal, empty if NOT computed)
+    * @return  : true: intact, false: corrupt or NOT readable
+    * @note    :
+    **/
+    bool CheckFile(std::string file, bool istest, int algo, const ftpopt_t* fopt, std::string& digest);
+
+    /**
+    * @brief   : GetChecksum - to get the checksum of one remote file from the checksum file published in its directory
+    * @param[I]: url (URL of the remote file)
+    * @param[I]: fopt (FTP options)
+    * @param[I]: isfresh (true: the checksum file is fetched again unless it has been fetched by this process)
+    * @param[O]: none
+    * @return  : checksum, i.e., 'sha512:<hex>' or 'md5:<hex>', empty if it is NOT published
+    * @note    :
+    **/
+    std::string GetChecksum(std::string url, const ftpopt_t* fopt, bool isfresh);
+
+    /**
+    * @brief   : FetchChecksums - to fetch and parse the checksum file of one remote directory, i.e., 'SHA512SUMS' or 'MD5SUMS'
+    * @param[I]: dir (remote directory)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: sums (checksum per file name, i.e., 'sha512:<hex>')
+    * @return  : true: got, false: NOT published or NOT reachable
+    * @note    :
+    **/
+    bool FetchChecksums(std::string dir, const ftpopt_t* fopt, std::map<std::string, std::string>& sums);
+
+    /**
+    * @brief   : ParseWget - to get the URL and the accept list of one 'wget' command
+    * @param[I]: cmd ('wget' command line)
+    * @param[O]: url (URL)
+    * @param[O]: accept (accept list of '-A', empty if the URL is the file itself)
+    * @return  : none
+    * @note    :
+    **/
+    void ParseWget(std::string cmd, std::string& url, std::string& accept);
+
+    /**
+    * @brief   : GetHost - to get the host of one URL, i.e., 'ftps://gdc.cddis.eosdis.nasa.gov/pub/x.gz' -> 'gdc.cddis.eosdis.nasa.gov'
+    * @param[I]: url (URL)
+    * @param[O]: none
+    * @return  : host, empty if it is NOT a URL
+    * @note    :
+    **/
+    std::string GetHost(std::string url);
+
+    /**
+    * @brief   : TierOf - to get the product tier of one file for the run manifest
+    * @param[I]: family (product family, i.e., "obs_igs", "nav", "orbclk_cod")
+    * @param[I]: localfile (local file with full path)
+    * @param[O]: none
+    * @return  : "final", "rapid", "ultra-rapid", "real-time", "data" (observations and broadcast ephemerides), or "unknown"
+    * @note    :
+    **/
+    std::string TierOf(std::string family, std::string localfile);
+
+    /**
+    * @brief   : Redirect - to redirect the URLs of one 'wget' command to the servers of 'redirect', i.e.,
+    *              'ftp://igs.ign.fr/pub/x' -> 'ftp://127.0.0.1:2121/igs.ign.fr/pub/x'
+    * @param[I]: cmd ('wget' command line)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : 'wget' command line redirected
+    * @note    :
+    **/
+    std::string Redirect(std::string cmd, const ftpopt_t* fopt);
+
+    /**
+    * @brief   : GetLocalFile - to materialize the file(s) of one 'wget' command from the local mirror (file://) into the
+    *              current directory, instead of running 'wget'
+    * @param[I]: cmd ('wget' command line with 'file://' URL)
+    * @param[O]: none
+    * @return  : class of the transfer outcome (XFER_*)
+    * @note    :
+    **/
+    int GetLocalFile(std::string cmd);
+
+    /**
+    * @brief   : LinkFile - to materialize one file by hardlink, reflink, 'copy_file_range' or plain copy, in that order
+    * @param[I]: src (source file)
+    * @param[I]: dst (destination file)
+    * @param[O]: none
+    * @return  : true: successful, false: failed
+    * @note    :
+    **/
+    bool LinkFile(std::string src, std::string dst);
+
+    /**
+    * @brief   : LongToShort - to produce the file with short name from the one with long name already downloaded and
+    *              decoded, i.e., by renaming it (l2s4 = 1) or by hardlinking it (l2s4 = 2), so that the data are NOT copied
+    * @param[I]: lfile (file with long name)
+    * @param[I]: sfile (file with short name)
+    * @param[I]: l2s4 (0: long name, 1: short name, 2: long and short name)
+    * @param[O]: none
+    * @return  : true: successful, false: failed
+    * @note    : both names share the same data for 'l2s4 = 2', so neither of them must be modified in place
+    **/
+    bool LongToShort(std::string lfile, std::string sfile, int l2s4);
+
+    /**
+    * @brief   : DecodeCrx - to decode one MGEX observation file (long name) fetched, i.e., to extract it, convert it from
+    *              'crx' file to 'rnx' file, and produce the file with short name (i.e., 'abcd0990.26o') from it
+    * @param[I]: xfile (file fetched, i.e., '*.crx.gz', '*.crx.Z' or '*.crx', with full path or in the current directory)
+    * @param[I]: gzipfull (full path of 'gzip')
+    * @param[I]: crx2rnxfull (full path of 'crx2rnx')
+    * @param[I]: l2s4obs (0: long name, 1: short name, 2: long and short name)
+    * @param[O]: none
+    * @return  : the final local file ('rnx' file, or the file with short name for 'l2s4obs = 1'), empty if failed
+    * @note    :
+    **/
+    std::string DecodeCrx(std::string xfile, std::string gzipfull, std::string crx2rnxfull, int l2s4obs);
+
+    /**
+    * @brief   : ClassifyWget - to classify the outcome of 'wget' by its exit status and output
+    * @param[I]: stat (return value of std::system)
+    * @param[I]: msg (output of 'wget')
+    * @param[O]: none
+    * @return  : class of the transfer outcome (XFER_*)
+    * @note    :
+    **/
+    int ClassifyWget(int stat, std::string msg);
+
+    /**
+    * @brief   : GetExactFile - to download one file whose remote name is exactly known by a direct GET/RETR, i.e., without
+    *              the listing of the whole remote directory
+    * @param[I]: url (remote directory)
+    * @param[I]: file (remote file name without compression suffix)
+    * @param[I]: fopt (FTP options)
+    * @param[I]: cacheable (false: the shared cache is NOT used, i.e., for the mutable products)
+    * @param[O]: none
+    * @return  : local name of the downloaded compressed file, empty if it is NOT found on the remote server
+    * @note    : the compression suffix ('.gz' or '.Z') found last time in the same directory (or on the same host) is tried first
+    **/
+    std::string GetExactFile(std::string url, std::string file, const ftpopt_t* fopt, bool cacheable = true);
+
+    /**
+    * @brief   : GetValidators - to get the validators of a remote file without moving its payload, i.e., 'ETag', 'Last-Modified'
+    *              and 'Content-Length' in the HEAD response of HTTP(S), or the file size in the 'SIZE' reply of FTP
+    * @param[I]: url (full URL of the remote file)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: vlds (validators, one 'key: value' per line)
+    * @return  : true: the remote file is found, false: NOT found
+    * @note    :
+    **/
+    bool GetValidators(std::string url, const ftpopt_t* fopt, std::string& vlds);
+
+    /**
+    * @brief   : GetStoredValidators - to get the validators stored for one local file in the validator journal of 'logDir'
+    * @param[I]: localfile (local file name in the current directory, i.e., 'igs20.atx' or 'igs20.atx.part')
+    * @param[O]: none
+    * @return  : validators, one 'key: value' per line, empty if none
+    * @note    :
+    **/
+    std::string GetStoredValidators(std::string localfile);
+
+    /**
+    * @brief   : StoreValidators - to store the validators of one local file in the validator journal of 'logDir'
+    * @param[I]: localfile (local file name in the current directory)
+    * @param[I]: vlds (validators, one 'key: value' per line, empty to remove them)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void StoreValidators(std::string localfile, std::string vlds);
+
+    /**
+    * @brief   : IsMutableToGet - to check whether a mutable product (i.e., ANTEX, ultra-rapid and CNES real-time files) needs
+    *              to be (re-)fetched, by comparing the validators of the remote file with those stored for the local file
+    * @param[I]: url (full URL of the remote file, empty to use the one stored for the local file)
+    * @param[I]: localfile (local file name in the current directory)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: vlds (validators of the remote file got in this check)
+    * @return  : true: to be (re-)fetched, false: NOT
+    * @note    : the old local file is moved to '*.old' if it is to be re-fetched, see also EndMutableGet
+    **/
+    bool IsMutableToGet(std::string url, std::string localfile, const ftpopt_t* fopt, std::string& vlds);
+
+    /**
+    * @brief   : EndMutableGet - to store the validators of the newly fetched mutable product, or restore the old local
+    *              file if the re-fetching failed
+    * @param[I]: url (full URL of the remote file)
+    * @param[I]: localfile (local file name in the current directory)
+    * @param[I]: vlds (validators got in IsMutableToGet, empty to get them here)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void EndMutableGet(std::string url, std::string localfile, std::string vlds, const ftpopt_t* fopt);
+
+    /**
+    * @brief   : ListRemote - to list one remote directory with the size and modification time of each file, i.e., the raw
+    *              'LIST' reply of FTP(S), or the directory itself of the local mirror
+    * @param[I]: url (remote directory)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: entries (file name -> (size in bytes, modification time in seconds since 1970/01/01 UTC))
+    * @return  : true: the listing is got and fully parsed, false: NOT
+    * @note    : HTTP(S) is NOT supported because its index pages carry no reliable modification time
+    **/
+    bool ListRemote(std::string url, const ftpopt_t* fopt, std::map<std::string, std::pair<double, double>>& entries);
+
+    /**
+    * @brief   : GetListingDiff - to fetch only the files newly appeared (or changed) in one remote directory since its last
+    *              listing, and convert each file as soon as it is on the local disk
+    * @param[I]: url (remote directory)
+    * @param[I]: pattern (wildcard pattern of the files)
+    * @param[I]: fopt (FTP options)
+    * @param[I]: convert (to decompress and convert one downloaded file, returning the final local file, empty if failed)
+    * @param[O]: none
+    * @return  : true: done by the listing diff, false: the listing is NOT available, and the caller falls back
+    * @note    : the last listing is kept in 'listings' of 'logDir', and the files failed are retried in the next call
+    **/
+    bool GetListingDiff(std::string url, std::string pattern, const ftpopt_t* fopt, std::function<std::string(std::string)> convert);
+
+    /**
+    * @brief   : GetIgmPlan - to plan the IGS observation files complementary to the MGEX ones actually obtained, i.e., the
+    *              IGS files listed whose RINEX observation files (i.e., 'abcd0990.26o') are NOT converted from MGEX ones yet
+    * @param[I]: urli (remote directory of IGS observation files)
+    * @param[I]: pati (wildcard pattern of IGS observation files)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: ifiles (the exact names of the complementary IGS files without compression suffix)
+    * @return  : true: planned, false: the listing is NOT available, and the caller falls back to all the IGS files
+    * @note    : it is called in the directory of the observation files after the MGEX pass
+    **/
+    bool GetIgmPlan(std::string urli, std::string pati, const ftpopt_t* fopt, std::vector<std::string>& ifiles);
 
     /**
     * @brief   : GetDailyObsIgs - download IGS RINEX daily observation (30s) files (short name "d") according to 'site.list' file
@@ -251,6 +643,63 @@ private:
     **/
     void GetOrbClk(gtime_t ts, std::vector<std::string> dirs, int prodType, std::string ac, const ftpopt_t* fopt);
 
+    /**
+    * @brief   : GetProdType - to get the product type of one analysis center of precise orbit and clock products
+    * @param[I]: ac (analysis center, i.e., 'igs', 'igs_r', 'igs_u', 'cod_m', 'cnt', et al.)
+    * @param[O]: none
+    * @return  : product type (PROD_*), 0 if unknown
+    * @note    :
+    **/
+    int GetProdType(std::string ac);
+
+    /**
+    * @brief   : FindOrbClk - to find the local precise orbit file of one analysis center at one day
+    * @param[I]: ts (time of the day)
+    * @param[I]: dir (orbit directory)
+    * @param[I]: ac (analysis center, i.e., 'igs', 'igs_r', 'igs_u', 'cod_m', 'cnt', et al.)
+    * @param[O]: none
+    * @return  : local orbit file (long or short name) without path, empty if NOT found
+    * @note    : any session of the ultra-rapid products is accepted
+    **/
+    std::string FindOrbClk(gtime_t ts, std::string dir, std::string ac);
+
+    /**
+    * @brief   : GetOrbClkBest - to download the best precise orbit and clock products currently available at one day, i.e.,
+    *              the analysis centers of 'ocBest' (final, rapid, ultra-rapid and real-time by default) are tried in order
+    * @param[I]: ts (time of the day)
+    * @param[I]: dirs (orbit and clock directories)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the tier got is recorded in the manifest 'best_orbclk.manifest' of the orbit directory, and only the better
+    *              tiers are tried if the products of the day are got again, so that they are upgraded as soon as published
+    **/
+    void GetOrbClkBest(gtime_t ts, std::vector<std::string> dirs, const ftpopt_t* fopt);
+
+    /**
+    * @brief   : GetLatestSessions - to get the candidate sessions of the ultra-rapid precise orbit products at one day for
+    *              the newest issued one, i.e., the weekly directory is listed once and only the newest session published is
+    *              kept, or all the sessions issued so far are probed newest first if the directory can NOT be listed
+    * @param[I]: ts (time of the day)
+    * @param[I]: url (weekly directory of the ultra-rapid products)
+    * @param[I]: ac (analysis center, i.e., 'esa_u', 'gfz_u', 'igs_u', 'whu_u')
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : sessions (hours) newest first, empty if none is issued
+    * @note    :
+    **/
+    std::vector<int> GetLatestSessions(gtime_t ts, std::string url, std::string ac, const ftpopt_t* fopt);
+
+    /**
+    * @brief   : SetLatestLink - to point the link of the latest product (i.e., 'latest_igu.sp3') to one file atomically
+    * @param[I]: link (link file)
+    * @param[I]: target (target file in the same directory)
+    * @param[O]: none
+    * @return  : true: successful, false: failed
+    * @note    : on Windows, a hardlink is used because the symbolic link needs the privilege
+    **/
+    bool SetLatestLink(std::string link, std::string target);
+
     /**
     * @brief   : GetEop - download earth rotation parameter files
     * @param[I]: ts (start time)
@@ -359,15 +808,6 @@ private:
     **/
     std::string LoadSp3File(gtime_t ts, std::string dir, std::string ac_s, bool longname);
 
-    /**
-    * @brief   :  -
-    * @param[I]:
-    * @param[O]:
-    * @return  :
-    * @note    :
-    **/
-    bool Sp3FilesIntoOneFile(std::vector<std::string> sp3files);
-
     /**
     * @brief   : MergeSp3Files - to merge three consecutive sp3 files into one file
     * @param[I]: ts (start time)
@@ -383,14 +823,87 @@ public:
     FtpUtil() = default;
 	~FtpUtil() = default;
 
+    /**
+    * @brief   : MatchWild - to match one file name against a wildcard pattern with '*' and '?'
+    * @param[I]: pattern (wildcard pattern)
+    * @param[I]: name (file name)
+    * @param[O]: none
+    * @return  : true: matched, false: NOT matched
+    * @note    :
+    **/
+    static bool MatchWild(const char* pattern, const char* name);
+
+    /**
+    * @brief   : ParseListing - to parse the raw 'LIST' reply of FTP(S) in the Unix style
+    * @param[I]: lstfile (file of the 'LIST' reply, i.e., '.listing' of 'wget')
+    * @param[I]: snow (time now in seconds since 1970/01/01 UTC, for the year omitted of the recent files)
+    * @param[O]: entries (file name -> (size in bytes, modification time in seconds since 1970/01/01 UTC))
+    * @return  : true: fully parsed, false: NOT (i.e., the MS-DOS style)
+    * @note    : the directories and the links are skipped
+    **/
+    static bool ParseListing(std::string lstfile, double snow, std::map<std::string, std::pair<double, double>>& entries);
+
+    /**
+    * @brief   : Sp3FilesIntoOneFile - to merge the SP3 files of three consecutive days into the file of the middle day, whose
+    *              original is kept as '*.orig'
+    * @param[I]: sp3files (SP3 files of the day before, the day, and the day after)
+    * @param[O]: none
+    * @return  : true: merged, false: NOT
+    * @note    :
+    **/
+    static bool Sp3FilesIntoOneFile(std::vector<std::string> sp3files);
+
+    /**
+    * @brief   : GetListedSize - to get the size of the observation files of one day (or the hours of one day) from the
+    *              listings of the archive, i.e., for the size-aware ordering of the jobs in the backfill mode
+    * @param[I]: ts (time of the day)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : size (bytes) of the files to be downloaded, -1 if NOT listed
+    * @note    :
+    **/
+    double GetListedSize(gtime_t ts, const ftpopt_t* fopt);
+
+    /**
+    * @brief   : ShardTag - to get the tag of the files written by this shard only, i.e., "_shard0of4"
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : tag, empty if the run is NOT split
+    * @note    :
+    **/
+    static std::string ShardTag(const ftpopt_t* fopt);
+
+    /**
+    * @brief   : Resume - to replay the file journal of the last runs before downloading, i.e., the files fetched but NOT
+    *              decoded are decoded again, while the '*.part' files of the interrupted transfers are kept to be resumed when
+    *              their files are requested again
+    * @param[I]: popt (processing options)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : none
+    * @note    : it must be called once before any concurrent download
+    **/
+    void Resume(const prcopt_t* popt, const ftpopt_t* fopt);
+
+    /**
+    * @brief   : Reseed - to seed the generator of the jitter of the retry backoff by the random device, the process ID and
+    *              the time, so that the processes started in the same second do NOT back off in step
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    : it is called once by the first call of FtpDownload, and again by the child after 'fork', which inherits the
+    *              state of the generator of its parent
+    **/
+    void Reseed();
+
     /**
     * @brief     : FtpDownload - GNSS data downloading via FTP
     * @param[I]  : popt (processing options)
     * @param[I/O]: fopt (FTP options)
-    * @return    : none
+    * @return    : number of files failed, i.e., the records of the log file whose status is "failed"
     * @note      :
     **/
-    void FtpDownload(const prcopt_t* popt, ftpopt_t* fopt);
+    int FtpDownload(const prcopt_t* popt, ftpopt_t* fopt);
 };
 
 #endif  // FTPS_H
\ No newline at end of file
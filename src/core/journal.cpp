@@ -0,0 +1,140 @@
+/*------------------------------------------------------------------------------
+* journal.cpp : append-only journal of the job states for resuming the interrupted runs
+*
+* Copyright (C) 2020-2099 by Ubiquitous Navigation & Integrated positioning lab in Quest (UNIQ), all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader)
+*
+* history : 2026/10/19 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "../common/common.h"
+#include "../common/types.h"
+#include "../common/cstring.h"
+#include "../common/logger.h"
+#include "journal.h"
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : Open - to open one journal, i.e., the states recorded in the last runs are replayed, the journal is compacted
+*              to the last state of each job, and then it is appended
+* @param[I]: file (journal file with full path)
+* @param[I]: compact (false: the journal is NOT compacted, i.e., it is shared by the concurrent processes)
+* @param[O]: none
+* @return  : true: successful, false: failed
+* @note    : each line is "<time (s) since 1970/01/01 UTC>\t<state>\t<key>", and the truncated last line of a crash is skipped.
+*              The journal shared by the concurrent processes is replayed but NOT compacted, because the lines appended by
+*              the others would be lost
+**/
+bool JournalUtil::Open(std::string file, bool compact)
+{
+    Close();
+    file_ = file;
+    states_.clear();
+
+    std::ifstream fp(file_.c_str());
+    std::string line;
+    while (fp.is_open() && getline(fp, line))
+    {
+        std::string::size_type ipos = line.find('\t');
+        std::string::size_type jpos = ipos == std::string::npos ? ipos : line.find('\t', ipos + 1);
+        if (jpos == std::string::npos || jpos + 1 >= line.size()) continue;
+        states_[line.substr(jpos + 1)] = line.substr(ipos + 1, jpos - ipos - 1);
+    }
+    if (fp.is_open()) fp.close();
+
+    if (compact) return Compact();
+
+    fp_.open(file_.c_str(), std::ios::app);
+    if (!fp_.is_open())
+    {
+        Logger::Trace(TERROR, "*** ERROR(JournalUtil::Open): open journal " + file_ + " failed, please check it");
+        return false;
+    }
+
+    return true;
+} /* end of Open */
+
+/**
+* @brief   : Compact - to compact the journal opened to the last state of each job, and then it is appended again
+* @param[I]: none
+* @param[O]: none
+* @return  : true: successful, false: failed
+* @note    : it must NOT be called while the journal is shared by the concurrent processes, see Open. The jobs whose last
+*              state is empty are dropped
+**/
+bool JournalUtil::Compact()
+{
+    if (file_.empty()) return false;
+    Close();
+
+    /* the compacted journal replaces the old one atomically */
+    std::string tmpfile = file_ + ".tmp";
+    std::ofstream fptmp(tmpfile.c_str(), std::ios::out);
+    if (!fptmp.is_open())
+    {
+        Logger::Trace(TERROR, "*** ERROR(JournalUtil::Compact): open journal " + tmpfile + " failed, please check it");
+        return false;
+    }
+    long long tnow = (long long)time(NULL);
+    for (auto it = states_.begin(); it != states_.end(); ++it)
+    {
+        if (it->second.empty()) continue;
+        fptmp << tnow << "\t" << it->second << "\t" << it->first << "\n";
+    }
+    fptmp.close();
+    if (std::rename(tmpfile.c_str(), file_.c_str()) != 0)
+    {
+        std::remove(file_.c_str());
+        std::rename(tmpfile.c_str(), file_.c_str());
+    }
+
+    fp_.open(file_.c_str(), std::ios::app);
+    if (!fp_.is_open())
+    {
+        Logger::Trace(TERROR, "*** ERROR(JournalUtil::Compact): open journal " + file_ + " failed, please check it");
+        return false;
+    }
+
+    return true;
+} /* end of Compact */
+
+/**
+* @brief   : Close - to close the journal
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void JournalUtil::Close()
+{
+    if (fp_.is_open()) fp_.close();
+} /* end of Close */
+
+/**
+* @brief   : GetState - to get the last state of one job
+* @param[I]: key (key of the job)
+* @param[O]: none
+* @return  : the last state, empty if the job is NOT in the journal
+* @note    :
+**/
+std::string JournalUtil::GetState(std::string key) const
+{
+    auto it = states_.find(key);
+
+    return it == states_.end() ? "" : it->second;
+} /* end of GetState */
+
+/**
+* @brief   : SetState - to record one state transition of one job
+* @param[I]: key (key of the job)
+* @param[I]: state (new state)
+* @param[O]: none
+* @return  : none
+* @note    : the line is flushed at once, so that it survives the crash of the process
+**/
+void JournalUtil::SetState(std::string key, std::string state)
+{
+    states_[key] = state;
+    if (!fp_.is_open()) return;
+    fp_ << (long long)time(NULL) << "\t" << state << "\t" << key << std::endl;
+} /* end of SetState */
@@ -0,0 +1,81 @@
+/*------------------------------------------------------------------------------
+* journal.h : header file of journal.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+/* constants/macros ----------------------------------------------------------*/
+#define JOB_PLANNED    "planned"     /* the job (or file) is planned, but NOT started yet */
+#define JOB_FETCHING   "fetching"    /* the job (or file) is being fetched, i.e., the '*.part' file is resumed after a crash */
+#define JOB_FETCHED    "fetched"     /* the file is fetched, but it may NOT be decoded (i.e., decompressed, Hatanaka-decompressed) yet */
+#define JOB_DECODED    "decoded"     /* the file is decoded */
+#define JOB_COMMITTED  "committed"   /* the job (or file) is done, and it is NOT examined again after a restart */
+#define JOB_FAILED     "failed"      /* the job is failed, and it is run again after a restart */
+
+class JournalUtil
+{
+private:
+    std::string file_;                   /* journal file with full path, empty: NOT opened */
+    std::ofstream fp_;                   /* ofstream of the journal file, appended only */
+    std::map<std::string, std::string> states_;  /* the last state of each job */
+
+public:
+    JournalUtil() = default;
+    ~JournalUtil() { Close(); }
+
+    /**
+    * @brief   : Open - to open one journal, i.e., the states recorded in the last runs are replayed, the journal is compacted
+    *              to the last state of each job, and then it is appended
+    * @param[I]: file (journal file with full path)
+    * @param[I]: compact (false: the journal is NOT compacted, i.e., it is shared by the concurrent processes)
+    * @param[O]: none
+    * @return  : true: successful, false: failed
+    * @note    :
+    **/
+    bool Open(std::string file, bool compact = true);
+
+    /**
+    * @brief   : Compact - to compact the journal opened to the last state of each job, and then it is appended again
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true: successful, false: failed
+    * @note    : it must NOT be called while the journal is shared by the concurrent processes, see Open
+    **/
+    bool Compact();
+
+    /**
+    * @brief   : Close - to close the journal
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Close();
+
+    /**
+    * @brief   : GetState - to get the last state of one job
+    * @param[I]: key (key of the job)
+    * @param[O]: none
+    * @return  : the last state, empty if the job is NOT in the journal
+    * @note    :
+    **/
+    std::string GetState(std::string key) const;
+
+    /**
+    * @brief   : GetStates - to get the last states of all the jobs
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : the last state of each job
+    * @note    :
+    **/
+    const std::map<std::string, std::string>& GetStates() const { return states_; }
+
+    /**
+    * @brief   : SetState - to record one state transition of one job
+    * @param[I]: key (key of the job)
+    * @param[I]: state (new state)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the line is flushed at once, so that it survives the crash of the process
+    **/
+    void SetState(std::string key, std::string state);
+};
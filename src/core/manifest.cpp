@@ -0,0 +1,386 @@
+/*------------------------------------------------------------------------------
+* manifest.cpp : manifest of the files materialized by the runs, with their SHA-256 digests
+*
+* Copyright (C) 2020-2099 by Ubiquitous Navigation & Integrated positioning lab in Quest (UNIQ), all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader)
+*
+* history : 2026/10/19 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "../common/common.h"
+#include "../common/types.h"
+#include "../common/cstring.h"
+#include "../common/logger.h"
+#include "../common/digest.h"
+#include "manifest.h"
+
+/* global variables ----------------------------------------------------------*/
+std::string ManifestUtil::file_;
+std::string ManifestUtil::spill_;
+std::string ManifestUtil::maindir_;
+std::map<std::string, ManifestUtil::entry_t> ManifestUtil::entries_;
+std::vector<std::string> ManifestUtil::moved_;
+
+/* the header of the manifest, i.e., the names of the columns */
+static const std::string mftheader = "# local\turl\thost\tsource\tsize\tsha256\ttier\tfetched\tmtime\n";
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : Open - to switch the manifest of the run on, and compare the local files with one input manifest
+* @param[I]: dir (directory of the manifest, i.e., 'logDir')
+* @param[I]: tag (tag of the file names, i.e., "_shard0of4")
+* @param[I]: maindir (the root/main directory of the local files)
+* @param[I]: infile (input manifest with full path, i.e., the one of another site, empty: none)
+* @param[O]: none
+* @return  : none
+* @note    : the digests of the last manifest are trusted for the local files of the same size and modification time, so
+*              the unchanged files are NOT hashed again. The local file whose digest differs from the one of the input
+*              manifest is moved to '*.old', so that only the delta is fetched by the downloading
+**/
+void ManifestUtil::Open(std::string dir, std::string tag, std::string maindir, std::string infile)
+{
+    std::string sep;
+    sep.push_back((char)FILEPATHSEP);
+    file_ = dir + sep + "run" + tag + ".manifest";
+    spill_ = file_ + ".spill";
+    maindir_ = maindir;
+    while (maindir_.size() > 1 && (maindir_.back() == '/' || maindir_.back() == '\\')) maindir_.pop_back();
+
+    /* the last manifest, and the records of the last run stopped before it was written */
+    entries_.clear();
+    moved_.clear();
+    Read(file_, entries_);
+    Read(spill_, entries_);
+
+    /* the files moved aside by the last runs (or by Verify) and NOT fetched again yet */
+    for (auto it = entries_.begin(); it != entries_.end(); ++it)
+    {
+        std::string path = Path(it->first);
+        if (access(path.c_str(), 0) == -1 && access((path + ".old").c_str(), 0) == 0) moved_.push_back(path);
+    }
+    if (infile.empty()) return;
+
+    std::map<std::string, entry_t> inputs;
+    if (!Read(infile, inputs))
+    {
+        Logger::Trace(TWARNING, "*** WARNING(ManifestUtil::Open): the input manifest " + infile + " is NOT found");
+        return;
+    }
+
+    int nsame = 0, nhash = 0, nmiss = 0, ndiff = 0;
+    for (auto it = inputs.begin(); it != inputs.end(); ++it)
+    {
+        const entry_t& in = it->second;
+        std::string path = Path(in.local);
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0)
+        {
+            nmiss++;
+            continue;
+        }
+
+        auto jt = entries_.find(in.local);
+        if (jt == entries_.end() || jt->second.size != (double)st.st_size || jt->second.mtime != (long long)st.st_mtime)
+        {
+            entry_t e = in;
+            e.size = (double)st.st_size;
+            e.mtime = (long long)st.st_mtime;
+            e.sha256 = Digest::File(path, DIGEST_SHA256);
+            entries_[in.local] = e;
+            jt = entries_.find(in.local);
+            nhash++;
+        }
+        if (jt->second.sha256 == in.sha256)
+        {
+            nsame++;
+            continue;
+        }
+
+        /* the old one is kept aside, since the fetching may fail */
+        std::string oldfile = path + ".old";
+        std::remove(oldfile.c_str());
+        if (std::rename(path.c_str(), oldfile.c_str()) != 0) continue;
+        entries_.erase(jt);
+        moved_.push_back(path);
+        ndiff++;
+        Logger::Trace(TDEBUG, "*** DEBUG(ManifestUtil::Open): " + path + " differs from the input manifest, moved to " + oldfile);
+    }
+
+    Logger::Trace(TINFO, "*** INFO(ManifestUtil::Open): " + std::to_string(inputs.size()) + " files in " + infile + ": " +
+        std::to_string(nsame) + " unchanged (" + std::to_string(nhash) + " hashed), " + std::to_string(nmiss) + " missing and " +
+        std::to_string(ndiff) + " different, which are fetched if planned");
+} /* end of Open */
+
+/**
+* @brief   : Add - to record one file materialized with its SHA-256 digest
+* @param[I]: localfile (local file with full path)
+* @param[I]: url (source URL)
+* @param[I]: host (host (or mirror) the file is got from)
+* @param[I]: source ("remote", "cache", "mirror", or "none")
+* @param[I]: tier (product tier)
+* @param[O]: none
+* @return  : none
+* @note    : the record is appended to the spill file at once, so that the files of the child processes of the backfill
+*              mode are NOT lost
+**/
+void ManifestUtil::Add(std::string localfile, std::string url, std::string host, std::string source, std::string tier)
+{
+    if (file_.empty()) return;
+    struct stat st;
+    if (stat(localfile.c_str(), &st) != 0) return;
+
+    entry_t e;
+    e.local = localfile;
+    if (localfile.size() > maindir_.size() + 1 && localfile.compare(0, maindir_.size(), maindir_) == 0 &&
+        (localfile[maindir_.size()] == '/' || localfile[maindir_.size()] == '\\')) e.local = localfile.substr(maindir_.size() + 1);
+    e.url = url;
+    e.host = host;
+    e.source = source;
+    e.size = (double)st.st_size;
+    e.sha256 = Digest::File(localfile, DIGEST_SHA256);
+    e.tier = tier;
+    char stime[32];
+    std::time_t tnow = std::time(NULL);
+    std::strftime(stime, sizeof(stime), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&tnow));
+    e.fetched = stime;
+    e.mtime = (long long)st.st_mtime;
+    if (e.sha256.empty()) return;
+    entries_[e.local] = e;
+
+    std::ofstream fp(spill_.c_str(), std::ios::app);
+    if (!fp.is_open())
+    {
+        Logger::Trace(TWARNING, "*** WARNING(ManifestUtil::Add): open " + spill_ + " failed, " + localfile + " is NOT recorded");
+        return;
+    }
+    std::string line = Line(e);
+    fp.write(line.c_str(), line.size());
+    fp.close();
+} /* end of Add */
+
+/**
+* @brief   : Write - to write the manifest of the run atomically, with the files recorded by all the processes
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    : the manifest is cumulative, i.e., the files of the last runs are kept if they are unchanged, and the ones
+*              removed or modified since are dropped. It is called at the end of the run and after each polling cycle of
+*              the watch mode
+**/
+void ManifestUtil::Write()
+{
+    if (file_.empty()) return;
+
+    std::map<std::string, entry_t> entries = entries_;
+    Read(spill_, entries);
+    for (auto it = entries.begin(); it != entries.end(); )
+    {
+        struct stat st;
+        if (stat(Path(it->first).c_str(), &st) != 0 || (double)st.st_size != it->second.size ||
+            (long long)st.st_mtime != it->second.mtime) it = entries.erase(it);
+        else ++it;
+    }
+
+    if (!Save(file_, entries)) return;
+    std::remove(spill_.c_str());
+    entries_.swap(entries);
+} /* end of Write */
+
+/**
+* @brief   : Merge - to merge the manifests of the shards of one run into one
+* @param[I]: infiles (manifests of the shards with full path)
+* @param[I]: outfile (manifest merged with full path)
+* @param[O]: none
+* @return  : number of the files in the manifest merged
+* @note    : the later manifests replace the entries of the same local files of the earlier ones
+**/
+int ManifestUtil::Merge(std::vector<std::string> infiles, std::string outfile)
+{
+    std::map<std::string, entry_t> entries;
+    bool isread = false;
+    for (size_t i = 0; i < infiles.size(); i++)
+    {
+        if (Read(infiles[i], entries)) isread = true;
+    }
+    if (!isread || !Save(outfile, entries)) return 0;
+
+    return (int)entries.size();
+} /* end of Merge */
+
+/**
+* @brief   : Verify - to verify the local files of the manifest against their digests in parallel, without any network access
+* @param[I]: nthread (number of threads, 0: the number of cores)
+* @param[O]: none
+* @return  : number of the files mismatched or missing
+* @note    : each thread takes the next file, the largest first, so that the huge files do NOT stretch the tail. The file
+*              mismatching its digest is moved to '*.old', and it is fetched again by the next run
+**/
+int ManifestUtil::Verify(int nthread)
+{
+    if (file_.empty()) return 0;
+
+    std::map<std::string, entry_t> entries = entries_;
+    Read(spill_, entries);
+    std::vector<const entry_t*> files;
+    for (auto it = entries.begin(); it != entries.end(); ++it) files.push_back(&it->second);
+    std::sort(files.begin(), files.end(), [](const entry_t* a, const entry_t* b) { return a->size > b->size; });
+
+    if (nthread <= 0) nthread = (int)std::thread::hardware_concurrency();
+    nthread = std::max(1, std::min(nthread, (int)files.size()));
+    std::vector<int> states(files.size(), 0);  /* 0: OK, 1: mismatched, 2: missing */
+    std::atomic<size_t> inext(0);
+    std::atomic<long long> nbytes(0);
+    auto tstart = std::chrono::steady_clock::now();
+    auto worker = [&]() {
+        for (size_t i = inext++; i < files.size(); i = inext++)
+        {
+            std::string path = Path(files[i]->local);
+            struct stat st;
+            if (stat(path.c_str(), &st) != 0)
+            {
+                states[i] = 2;
+                continue;
+            }
+            if (Digest::File(path, DIGEST_SHA256) != files[i]->sha256) states[i] = 1;
+            nbytes += (long long)st.st_size;
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int i = 0; i < nthread; i++) threads.push_back(std::thread(worker));
+    for (size_t i = 0; i < threads.size(); i++) threads[i].join();
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - tstart).count();
+
+    int nok = 0, ndiff = 0, nmiss = 0;
+    for (size_t i = 0; i < files.size(); i++)
+    {
+        if (states[i] == 0) nok++;
+        else if (states[i] == 2) nmiss++;
+        else
+        {
+            std::string path = Path(files[i]->local), oldfile = path + ".old";
+            std::remove(oldfile.c_str());
+            if (std::rename(path.c_str(), oldfile.c_str()) == 0) ndiff++;
+            Logger::Trace(TWARNING, "*** WARNING(ManifestUtil::Verify): " + path + " mismatches its SHA-256 in the manifest, moved to " +
+                oldfile + " to be fetched again");
+        }
+    }
+
+    std::ostringstream ss;
+    double mb = (double)nbytes.load() / 1048576.0;
+    ss << std::fixed << std::setprecision(1) << mb << " MB in " << sec << "s (" << (sec > 0.0 ? mb / sec : 0.0) << " MB/s on " <<
+        nthread << " threads)";
+    Logger::Trace(TINFO, "*** INFO(ManifestUtil::Verify): " + std::to_string(files.size()) + " files of " + file_ + " verified, " +
+        ss.str() + ": " + std::to_string(nok) + " OK, " + std::to_string(ndiff) + " mismatched and " + std::to_string(nmiss) +
+        " missing");
+
+    return ndiff + nmiss;
+} /* end of Verify */
+
+/**
+* @brief   : Read - to read the entries of one manifest
+* @param[I]: file (manifest or spill file with full path)
+* @param[O]: entries (entries per local file, the later lines replace the earlier ones)
+* @return  : true: read, false: NOT found
+* @note    :
+**/
+bool ManifestUtil::Read(std::string file, std::map<std::string, entry_t>& entries)
+{
+    std::ifstream fp(file.c_str());
+    if (!fp.is_open()) return false;
+
+    std::string line;
+    while (getline(fp, line))
+    {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        /* the empty fields are kept, unlike CString::split */
+        std::vector<std::string> items;
+        for (size_t ipos = 0; ; )
+        {
+            size_t jpos = line.find('\t', ipos);
+            items.push_back(line.substr(ipos, jpos == std::string::npos ? std::string::npos : jpos - ipos));
+            if (jpos == std::string::npos) break;
+            ipos = jpos + 1;
+        }
+        if (items.size() < 9 || items[5].size() != 64) continue;
+        entry_t e = { items[0], items[1], items[2], items[3], atof(items[4].c_str()), items[5], items[6], items[7],
+            atoll(items[8].c_str()) };
+        entries[e.local] = e;
+    }
+    fp.close();
+
+    return true;
+} /* end of Read */
+
+/**
+* @brief   : Save - to write the entries to one manifest atomically
+* @param[I]: file (manifest with full path)
+* @param[I]: entries (entries per local file)
+* @param[O]: none
+* @return  : true: written, false: failed
+* @note    : the manifest is written to a temporary file and renamed, so that the readers never get a partial one
+**/
+bool ManifestUtil::Save(std::string file, const std::map<std::string, entry_t>& entries)
+{
+    std::string buff = mftheader;
+    for (auto it = entries.begin(); it != entries.end(); ++it) buff += Line(it->second);
+
+    std::string tmpfile = file + "." + std::to_string(getpid()) + ".tmp";
+    std::ofstream fp(tmpfile.c_str(), std::ios::out | std::ios::binary);
+    if (!fp.is_open())
+    {
+        Logger::Trace(TWARNING, "*** WARNING(ManifestUtil::Save): open " + tmpfile + " failed, please check it");
+        return false;
+    }
+    fp.write(buff.c_str(), buff.size());
+    fp.close();
+#ifdef _WIN32   /* for Windows */
+    std::remove(file.c_str());
+#endif
+    if (std::rename(tmpfile.c_str(), file.c_str()) != 0)
+    {
+        std::remove(tmpfile.c_str());
+        return false;
+    }
+
+    return true;
+} /* end of Save */
+
+/**
+* @brief   : Line - to get one entry in one line of the manifest
+* @param[I]: e (entry)
+* @param[O]: none
+* @return  : tab-separated line with the line feed
+* @note    : the tabs and line feeds in the fields are replaced by spaces
+**/
+std::string ManifestUtil::Line(const entry_t& e)
+{
+    std::vector<std::string> items = { e.local, e.url, e.host, e.source };
+    std::ostringstream ss;
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        std::replace(items[i].begin(), items[i].end(), '\t', ' ');
+        std::replace(items[i].begin(), items[i].end(), '\n', ' ');
+        ss << items[i] << "\t";
+    }
+    ss << std::fixed << std::setprecision(0) << e.size << "\t" << e.sha256 << "\t" << e.tier << "\t" << e.fetched << "\t" <<
+        e.mtime << "\n";
+
+    return ss.str();
+} /* end of Line */
+
+/**
+* @brief   : Path - to get the full path of one local file of the manifest
+* @param[I]: local (local file in the manifest)
+* @param[O]: none
+* @return  : local file with full path
+* @note    :
+**/
+std::string ManifestUtil::Path(std::string local)
+{
+    bool isabs = (!local.empty() && (local[0] == '/' || local[0] == '\\')) || (local.size() > 1 && local[1] == ':');
+    if (isabs) return local;
+
+    return maindir_ + (char)FILEPATHSEP + local;
+} /* end of Path */
@@ -0,0 +1,136 @@
+/*------------------------------------------------------------------------------
+* manifest.h : header file of manifest.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+class ManifestUtil
+{
+private:
+    struct entry_t
+    {                                    /* one file materialized */
+        std::string local;               /* local file, relative to 'mainDir' if it is below */
+        std::string url;                 /* source URL */
+        std::string host;                /* host (or mirror) the file is got from */
+        std::string source;              /* "remote", "cache", "mirror", or "none" */
+        double size;                     /* size (bytes) */
+        std::string sha256;              /* SHA-256 digest in lowercase hexadecimal */
+        std::string tier;                /* product tier, i.e., "final", "rapid", "ultra-rapid", "real-time", or "data" */
+        std::string fetched;             /* time (UTC) the file is got, i.e., "2024-01-01T12:00:00Z" */
+        long long mtime;                 /* modification time (Unix time) of the local file when it is hashed */
+    };
+
+    static std::string file_;            /* manifest of the run, empty: off */
+    static std::string spill_;           /* spill file of the records of all the processes of the run */
+    static std::string maindir_;         /* the root/main directory of the local files */
+    static std::map<std::string, entry_t> entries_;  /* files known by this process, per local file */
+    static std::vector<std::string> moved_;  /* local files (full path) moved to '*.old' (by the input manifest or Verify) */
+
+    /**
+    * @brief   : Read - to read the entries of one manifest
+    * @param[I]: file (manifest or spill file with full path)
+    * @param[O]: entries (entries per local file, the later lines replace the earlier ones)
+    * @return  : true: read, false: NOT found
+    * @note    :
+    **/
+    static bool Read(std::string file, std::map<std::string, entry_t>& entries);
+
+    /**
+    * @brief   : Save - to write the entries to one manifest atomically
+    * @param[I]: file (manifest with full path)
+    * @param[I]: entries (entries per local file)
+    * @param[O]: none
+    * @return  : true: written, false: failed
+    * @note    :
+    **/
+    static bool Save(std::string file, const std::map<std::string, entry_t>& entries);
+
+    /**
+    * @brief   : Line - to get one entry in one line of the manifest
+    * @param[I]: e (entry)
+    * @param[O]: none
+    * @return  : tab-separated line with the line feed
+    * @note    :
+    **/
+    static std::string Line(const entry_t& e);
+
+    /**
+    * @brief   : Path - to get the full path of one local file of the manifest
+    * @param[I]: local (local file in the manifest)
+    * @param[O]: none
+    * @return  : local file with full path
+    * @note    :
+    **/
+    static std::string Path(std::string local);
+
+public:
+    /**
+    * @brief   : Open - to switch the manifest of the run on, and compare the local files with one input manifest
+    * @param[I]: dir (directory of the manifest, i.e., 'logDir')
+    * @param[I]: tag (tag of the file names, i.e., "_shard0of4")
+    * @param[I]: maindir (the root/main directory of the local files)
+    * @param[I]: infile (input manifest with full path, i.e., the one of another site, empty: none)
+    * @param[O]: none
+    * @return  : none
+    * @note    : it must be called before the child processes of the backfill mode are forked
+    **/
+    static void Open(std::string dir, std::string tag, std::string maindir, std::string infile);
+
+    /**
+    * @brief   : IsOn - to check whether the manifest is on
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true: on, false: off
+    * @note    :
+    **/
+    static bool IsOn() { return !file_.empty(); }
+
+    /**
+    * @brief   : Moved - to get the local files differing from the input manifest
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : local files (full path) moved to '*.old' (by the input manifest or Verify), which are to be fetched again
+    * @note    :
+    **/
+    static const std::vector<std::string>& Moved() { return moved_; }
+
+    /**
+    * @brief   : Add - to record one file materialized with its SHA-256 digest
+    * @param[I]: localfile (local file with full path)
+    * @param[I]: url (source URL)
+    * @param[I]: host (host (or mirror) the file is got from)
+    * @param[I]: source ("remote", "cache", "mirror", or "none")
+    * @param[I]: tier (product tier)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    static void Add(std::string localfile, std::string url, std::string host, std::string source, std::string tier);
+
+    /**
+    * @brief   : Write - to write the manifest of the run atomically, with the files recorded by all the processes
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    static void Write();
+
+    /**
+    * @brief   : Merge - to merge the manifests of the shards of one run into one
+    * @param[I]: infiles (manifests of the shards with full path)
+    * @param[I]: outfile (manifest merged with full path)
+    * @param[O]: none
+    * @return  : number of the files in the manifest merged
+    * @note    :
+    **/
+    static int Merge(std::vector<std::string> infiles, std::string outfile);
+
+    /**
+    * @brief   : Verify - to verify the local files of the manifest against their digests in parallel, without any network access
+    * @param[I]: nthread (number of threads, 0: the number of cores)
+    * @param[O]: none
+    * @return  : number of the files mismatched or missing
+    * @note    : the manifest must be opened by Open
+    **/
+    static int Verify(int nthread);
+};
@@ -0,0 +1,279 @@
+/*------------------------------------------------------------------------------
+* metrics.cpp : live metrics of the downloading in the Prometheus exposition format
+*
+* Copyright (C) 2020-2099 by Ubiquitous Navigation & Integrated positioning lab in Quest (UNIQ), all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader)
+*
+* history : 2026/10/19 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "../common/common.h"
+#include "../common/types.h"
+#include "../common/cstring.h"
+#include "../common/logger.h"
+#include "metrics.h"
+
+/* global variables ----------------------------------------------------------*/
+MetricsUtil::series_t* MetricsUtil::table_ = NULL;
+std::string MetricsUtil::file_;
+double MetricsUtil::intvl_ = 15.0;
+double MetricsUtil::tlast_ = -1.0e9;
+
+/* help and type of each metric, the age of the newest product is derived from its time stamp when it is written */
+static const std::vector<std::vector<std::string>> metricdefs = {
+    { "good_queue_depth", "gauge", "Jobs waiting in the queue of the backfill mode, per host" },
+    { "good_running_jobs", "gauge", "Jobs running in the backfill mode, per host" },
+    { "good_active_transfers", "gauge", "Transfers ('wget' or the local mirror) running, per host" },
+    { "good_transfer_bytes_total", "counter", "Bytes of the files transferred, per host and source (remote, cache or mirror)" },
+    { "good_transfer_seconds_total", "counter", "Seconds spent in the transfers, per host and source" },
+    { "good_files_total", "counter", "Files got or failed, per product family" },
+    { "good_cache_requests_total", "counter", "Requests to the shared cache, per result (hit or miss)" },
+    { "good_newest_product_timestamp_seconds", "gauge", "Epoch (Unix time) of the newest product got, per product family" },
+    { "good_newest_product_age_seconds", "gauge", "Age of the newest product got, per product family" },
+};
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : Open - to switch the metrics on
+* @param[I]: file (textfile with full path, empty: only the counters for the progress, see ProgressUtil)
+* @param[I]: intvl (minimum interval (s) between two rewrites of the textfile)
+* @param[O]: none
+* @return  : none
+* @note    : the table is mapped as shared anonymous memory, so that the counters are updated lock-free by the parent and
+*              the child processes of the backfill mode. On Windows, the jobs are run in the process itself
+**/
+void MetricsUtil::Open(std::string file, double intvl)
+{
+    if (table_ != NULL) return;
+
+    size_t size = sizeof(series_t) * MAXSERIES;
+#ifdef _WIN32   /* for Windows */
+    void* mem = ::operator new(size);
+#else           /* for Linux or Mac */
+    void* mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED)
+    {
+        Logger::Trace(TWARNING, "*** WARNING(MetricsUtil::Open): the shared memory is NOT available, the metrics are off");
+        return;
+    }
+#endif
+    series_t* table = (series_t*)mem;
+    for (int i = 0; i < MAXSERIES; i++)
+    {
+        new (&table[i].state) std::atomic<int>(0);
+        table[i].key[0] = '\0';
+        new (&table[i].value) std::atomic<double>(0.0);
+    }
+
+    table_ = table;
+    file_ = file;
+    intvl_ = intvl;
+    if (!file_.empty()) Logger::Trace(TINFO, "*** INFO(MetricsUtil::Open): the metrics are written to " + file_);
+} /* end of Open */
+
+/**
+* @brief   : Find - to find (or claim) the slot of one time series
+* @param[I]: key (name and labels)
+* @param[O]: none
+* @return  : slot, NULL if the table is full or the metrics are off
+* @note    : the free slot is claimed by compare-and-swap, and the others wait only while one slot is being claimed
+**/
+MetricsUtil::series_t* MetricsUtil::Find(std::string key)
+{
+    if (table_ == NULL || key.size() >= MAXSERIESLEN) return NULL;
+
+    for (int i = 0; i < MAXSERIES; i++)
+    {
+        series_t& s = table_[i];
+        int state = s.state.load(std::memory_order_acquire);
+        if (state == 0)
+        {
+            if (s.state.compare_exchange_strong(state, 1, std::memory_order_acq_rel))
+            {
+                strcpy(s.key, key.c_str());
+                s.value.store(0.0, std::memory_order_relaxed);
+                s.state.store(2, std::memory_order_release);
+                return &s;
+            }
+        }
+        while ((state = s.state.load(std::memory_order_acquire)) == 1) std::this_thread::yield();
+        if (state == 2 && key == s.key) return &s;
+    }
+
+    return NULL;
+} /* end of Find */
+
+/**
+* @brief   : Series - to get the key of one time series
+* @param[I]: name (metric name, i.e., "good_files_total")
+* @param[I]: labels (label names and values)
+* @param[O]: none
+* @return  : name and labels, i.e., 'good_files_total{family="nav",status="ok"}'
+* @note    : the backslash, double quote and line feed in the label values are escaped
+**/
+std::string MetricsUtil::Series(std::string name, const std::vector<std::pair<std::string, std::string>>& labels)
+{
+    if (labels.empty()) return name;
+
+    std::string key = name + "{";
+    for (size_t i = 0; i < labels.size(); i++)
+    {
+        if (i > 0) key += ",";
+        key += labels[i].first + "=\"";
+        for (size_t j = 0; j < labels[i].second.size(); j++)
+        {
+            char c = labels[i].second[j];
+            if (c == '\\') key += "\\\\";
+            else if (c == '"') key += "\\\"";
+            else if (c == '\n') key += "\\n";
+            else key += c;
+        }
+        key += "\"";
+    }
+
+    return key + "}";
+} /* end of Series */
+
+/**
+* @brief   : Add - to add one value to one counter (or gauge)
+* @param[I]: key (name and labels, see Series)
+* @param[I]: value (value to be added)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void MetricsUtil::Add(std::string key, double value)
+{
+    series_t* s = Find(key);
+    if (s == NULL) return;
+
+    double v = s->value.load(std::memory_order_relaxed);
+    while (!s->value.compare_exchange_weak(v, v + value, std::memory_order_relaxed));
+} /* end of Add */
+
+/**
+* @brief   : Set - to set one gauge
+* @param[I]: key (name and labels, see Series)
+* @param[I]: value (value)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void MetricsUtil::Set(std::string key, double value)
+{
+    series_t* s = Find(key);
+    if (s == NULL) return;
+
+    s->value.store(value, std::memory_order_relaxed);
+} /* end of Set */
+
+/**
+* @brief   : Max - to raise one gauge to one value if it is less
+* @param[I]: key (name and labels, see Series)
+* @param[I]: value (value)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void MetricsUtil::Max(std::string key, double value)
+{
+    series_t* s = Find(key);
+    if (s == NULL) return;
+
+    double v = s->value.load(std::memory_order_relaxed);
+    while (v < value && !s->value.compare_exchange_weak(v, value, std::memory_order_relaxed));
+} /* end of Max */
+
+/**
+* @brief   : Sum - to sum the time series of one metric per value of one label
+* @param[I]: name (metric name, i.e., "good_active_transfers")
+* @param[I]: label (label name, i.e., "host")
+* @param[O]: values (sum per value of the label)
+* @return  : sum of all the time series of the metric
+* @note    : the escaped label values are kept as they are
+**/
+double MetricsUtil::Sum(std::string name, std::string label, std::map<std::string, double>& values)
+{
+    values.clear();
+    if (table_ == NULL) return 0.0;
+
+    double sum = 0.0;
+    std::string prefix = label + "=\"";
+    for (int i = 0; i < MAXSERIES; i++)
+    {
+        if (table_[i].state.load(std::memory_order_acquire) != 2) continue;
+        std::string key = table_[i].key;
+        if (key.compare(0, name.size(), name) != 0 || (key.size() > name.size() && key[name.size()] != '{')) continue;
+        double value = table_[i].value.load(std::memory_order_relaxed);
+        sum += value;
+
+        std::string::size_type ipos = key.find(prefix, name.size());
+        while (ipos != std::string::npos && key[ipos - 1] != '{' && key[ipos - 1] != ',') ipos = key.find(prefix, ipos + 1);
+        if (ipos == std::string::npos) continue;
+        ipos += prefix.size();
+        std::string::size_type jpos = ipos;
+        while (jpos < key.size() && key[jpos] != '"') jpos += key[jpos] == '\\' ? 2 : 1;
+        values[key.substr(ipos, jpos - ipos)] += value;
+    }
+
+    return sum;
+} /* end of Sum */
+
+/**
+* @brief   : Write - to rewrite the textfile if the interval since the last rewrite has passed
+* @param[I]: force (true: rewritten regardless of the interval)
+* @param[O]: none
+* @return  : none
+* @note    : the textfile is written to a temporary file and renamed, so that the scraper (i.e., the textfile collector of
+*              'node_exporter') never reads a partial one
+**/
+void MetricsUtil::Write(bool force)
+{
+    if (table_ == NULL || file_.empty()) return;
+    double tnow = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    if (!force && tnow - tlast_ < intvl_) return;
+    tlast_ = tnow;
+
+    /* the time series of each metric */
+    double unixnow = (double)std::time(NULL);
+    std::map<std::string, std::vector<std::pair<std::string, double>>> metrics;
+    for (int i = 0; i < MAXSERIES; i++)
+    {
+        if (table_[i].state.load(std::memory_order_acquire) != 2) continue;
+        std::string key = table_[i].key;
+        double value = table_[i].value.load(std::memory_order_relaxed);
+        std::string name = key.substr(0, key.find('{'));
+        std::string labels = key.substr(name.size());
+        metrics[name].push_back({ key, value });
+        if (name == "good_newest_product_timestamp_seconds")
+        {
+            metrics["good_newest_product_age_seconds"].push_back({ "good_newest_product_age_seconds" + labels, unixnow - value });
+        }
+    }
+
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    for (size_t i = 0; i < metricdefs.size(); i++)
+    {
+        auto it = metrics.find(metricdefs[i][0]);
+        if (it == metrics.end()) continue;
+        std::sort(it->second.begin(), it->second.end());
+        ss << "# HELP " << metricdefs[i][0] << " " << metricdefs[i][2] << "\n";
+        ss << "# TYPE " << metricdefs[i][0] << " " << metricdefs[i][1] << "\n";
+        for (size_t j = 0; j < it->second.size(); j++) ss << it->second[j].first << " " << it->second[j].second << "\n";
+    }
+
+    std::string tmpfile = file_ + "." + std::to_string(getpid()) + ".tmp";
+    std::ofstream fp(tmpfile.c_str(), std::ios::out);
+    if (!fp.is_open())
+    {
+        Logger::Trace(TWARNING, "*** WARNING(MetricsUtil::Write): open " + tmpfile + " failed, please check it");
+        return;
+    }
+    fp << ss.str();
+    fp.close();
+#ifdef _WIN32   /* for Windows */
+    std::remove(file_.c_str());
+#endif
+    if (std::rename(tmpfile.c_str(), file_.c_str()) != 0) std::remove(tmpfile.c_str());
+} /* end of Write */
@@ -0,0 +1,112 @@
+/*------------------------------------------------------------------------------
+* metrics.h : header file of metrics.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+/* constants/macros ----------------------------------------------------------*/
+#define MAXSERIES      512               /* maximum number of the time series */
+#define MAXSERIESLEN   192               /* maximum length of the name and labels of one time series */
+
+class MetricsUtil
+{
+private:
+    struct series_t                      /* one time series, shared by the processes of one run */
+    {
+        std::atomic<int> state;          /* 0: free, 1: being claimed, 2: claimed */
+        char key[MAXSERIESLEN];          /* name and labels, i.e., 'good_files_total{family="nav",status="ok"}' */
+        std::atomic<double> value;       /* value */
+    };
+
+    static series_t* table_;             /* table of the time series, in the memory shared with the child processes */
+    static std::string file_;            /* textfile in the Prometheus exposition format, empty: off */
+    static double intvl_;                /* minimum interval (s) between two rewrites of the textfile */
+    static double tlast_;                /* time (s) of the steady clock of the last rewrite */
+
+    /**
+    * @brief   : Find - to find (or claim) the slot of one time series
+    * @param[I]: key (name and labels)
+    * @param[O]: none
+    * @return  : slot, NULL if the table is full or the metrics are off
+    * @note    :
+    **/
+    static series_t* Find(std::string key);
+
+public:
+    /**
+    * @brief   : Open - to switch the metrics on
+    * @param[I]: file (textfile with full path, empty: only the counters for the progress, see ProgressUtil)
+    * @param[I]: intvl (minimum interval (s) between two rewrites of the textfile)
+    * @param[O]: none
+    * @return  : none
+    * @note    : it must be called before the child processes of the backfill mode are forked
+    **/
+    static void Open(std::string file, double intvl);
+
+    /**
+    * @brief   : IsOn - to check whether the metrics are on
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true: on, false: off
+    * @note    :
+    **/
+    static bool IsOn() { return table_ != NULL; }
+
+    /**
+    * @brief   : Series - to get the key of one time series
+    * @param[I]: name (metric name, i.e., "good_files_total")
+    * @param[I]: labels (label names and values)
+    * @param[O]: none
+    * @return  : name and labels, i.e., 'good_files_total{family="nav",status="ok"}'
+    * @note    :
+    **/
+    static std::string Series(std::string name, const std::vector<std::pair<std::string, std::string>>& labels = {});
+
+    /**
+    * @brief   : Add - to add one value to one counter (or gauge)
+    * @param[I]: key (name and labels, see Series)
+    * @param[I]: value (value to be added)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    static void Add(std::string key, double value);
+
+    /**
+    * @brief   : Set - to set one gauge
+    * @param[I]: key (name and labels, see Series)
+    * @param[I]: value (value)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    static void Set(std::string key, double value);
+
+    /**
+    * @brief   : Max - to raise one gauge to one value if it is less
+    * @param[I]: key (name and labels, see Series)
+    * @param[I]: value (value)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    static void Max(std::string key, double value);
+
+    /**
+    * @brief   : Sum - to sum the time series of one metric per value of one label
+    * @param[I]: name (metric name, i.e., "good_active_transfers")
+    * @param[I]: label (label name, i.e., "host")
+    * @param[O]: values (sum per value of the label)
+    * @return  : sum of all the time series of the metric
+    * @note    :
+    **/
+    static double Sum(std::string name, std::string label, std::map<std::string, double>& values);
+
+    /**
+    * @brief   : Write - to rewrite the textfile if the interval since the last rewrite has passed
+    * @param[I]: force (true: rewritten regardless of the interval)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    static void Write(bool force = false);
+};
@@ -0,0 +1,388 @@
+/*------------------------------------------------------------------------------
+* profile.cpp : stage-level profiling of the downloading, per product family
+*
+* Copyright (C) 2020-2099 by Ubiquitous Navigation & Integrated positioning lab in Quest (UNIQ), all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader)
+*
+* history : 2026/10/19 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "../common/common.h"
+#include "../common/types.h"
+#include "../common/cstring.h"
+#include "../common/logger.h"
+#include "profile.h"
+
+/* global variables ----------------------------------------------------------*/
+std::string ProfUtil::file_;
+std::string ProfUtil::tracefile_;
+std::string ProfUtil::tablefile_;
+double ProfUtil::spawn_ = 0.0;
+std::vector<std::pair<std::string, ProfUtil::tick_t>> ProfUtil::families_;
+std::vector<ProfUtil::event_t> ProfUtil::events_;
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : Classify - to get the stage of one command line
+* @param[I]: cmd (command line)
+* @param[O]: none
+* @return  : stage (PROF_*)
+* @note    : the command lines of 'cat x.yyd | crx2rnx' are counted in the Hatanaka decompression
+**/
+std::string ProfUtil::Classify(std::string cmd)
+{
+    CString::trim(cmd);
+    std::string prog = cmd.substr(0, cmd.find(' '));
+    prog = prog.substr(prog.find_last_of("/\\") + 1);
+    CString::ToLower(prog);
+
+    if (cmd.find("crx2rnx") != std::string::npos) return PROF_CRX2RNX;
+    if (prog == "wget" || prog == "wget.exe")
+    {
+        if (cmd.find("--spider") != std::string::npos || cmd.find("--no-remove-listing") != std::string::npos) return PROF_LISTING;
+        return PROF_TRANSFER;
+    }
+    if (prog == "gzip" || prog == "gzip.exe" || prog == "uncompress")
+    {
+        if ((cmd + " ").find(" -t ") != std::string::npos) return PROF_VERIFY;
+        return PROF_DECOMPRESS;
+    }
+    if (prog == "mkdir" || prog == "rm" || prog == "del" || prog == "mv" || prog == "move" || prog == "rename" ||
+        prog == "cp" || prog == "copy" || prog == "rd" || prog == "rmdir") return PROF_FS;
+    if (prog == "cat" || prog == "type") return PROF_MERGE;
+
+    return PROF_OTHER;
+} /* end of Classify */
+
+/**
+* @brief   : Open - to switch the profiling on, and calibrate the time of spawning one process
+* @param[I]: dir (directory of the profile files)
+* @param[I]: tag (tag of the file names, i.e., "_shard0of4")
+* @param[O]: none
+* @return  : none
+* @note    : the time of spawning is the shortest of a few empty commands, and it is counted out of each command line run
+*              by System as the stage of spawning
+**/
+void ProfUtil::Open(std::string dir, std::string tag)
+{
+    std::string sep;
+    sep.push_back((char)FILEPATHSEP);
+    file_ = dir + sep + "profile" + tag + ".events";
+    tracefile_ = dir + sep + "profile" + tag + ".json";
+    tablefile_ = dir + sep + "profile" + tag + ".txt";
+    std::remove(file_.c_str());
+    families_.clear();
+    events_.clear();
+
+    spawn_ = 1.0e9;
+    for (int i = 0; i < 5; i++)
+    {
+        tick_t t0 = Tic();
+        std::system("exit 0");
+        spawn_ = std::min(spawn_, Tic().wall - t0.wall);
+    }
+
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(2) << spawn_ * 1000.0;
+    Logger::Trace(TINFO, "*** INFO(ProfUtil::Open): the profiling is on, spawning one process takes " + ss.str() + " ms");
+} /* end of Open */
+
+/**
+* @brief   : Tic - to get the time stamp now
+* @param[I]: none
+* @param[O]: none
+* @return  : time stamp
+* @note    : the CPU time of the child processes is NOT available on Windows
+**/
+ProfUtil::tick_t ProfUtil::Tic()
+{
+    tick_t t = { 0.0, 0.0, 0.0 };
+    t.wall = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#ifdef _WIN32   /* for Windows */
+    FILETIME tc, te, tk, tu;
+    if (GetProcessTimes(GetCurrentProcess(), &tc, &te, &tk, &tu))
+    {
+        ULARGE_INTEGER k, u;
+        k.LowPart = tk.dwLowDateTime;
+        k.HighPart = tk.dwHighDateTime;
+        u.LowPart = tu.dwLowDateTime;
+        u.HighPart = tu.dwHighDateTime;
+        /* 100-nanosecond intervals */
+        t.cpu = (double)(k.QuadPart + u.QuadPart) * 1.0e-7;
+    }
+#else           /* for Linux or Mac */
+    struct rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) == 0)
+    {
+        t.cpu = ru.ru_utime.tv_sec + ru.ru_stime.tv_sec + (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) * 1.0e-6;
+    }
+    if (getrusage(RUSAGE_CHILDREN, &ru) == 0)
+    {
+        t.cpuc = ru.ru_utime.tv_sec + ru.ru_stime.tv_sec + (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) * 1.0e-6;
+    }
+#endif
+
+    return t;
+} /* end of Tic */
+
+/**
+* @brief   : Toc - to record one span of one stage in the process itself, from one time stamp to now
+* @param[I]: stage (PROF_*)
+* @param[I]: t0 (time stamp at the start, see Tic)
+* @param[I]: detail (the other detail, i.e., the file name)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void ProfUtil::Toc(std::string stage, const tick_t& t0, std::string detail)
+{
+    if (!IsOn()) return;
+
+    tick_t t1 = Tic();
+    event_t ev = { Family(), stage, detail, t0.wall, t1.wall - t0.wall,
+        (t1.cpu - t0.cpu) + (t1.cpuc - t0.cpuc), 0.0, 0.0 };
+    events_.push_back(ev);
+    if (events_.size() >= 4096) Spill();
+} /* end of Toc */
+
+/**
+* @brief   : Begin - to begin the span of one product family, the stages recorded until End are counted in it
+* @param[I]: family (product family, i.e., "obs_igs", "nav", "orbclk_cod")
+* @param[O]: none
+* @return  : none
+* @note    : the family is tracked even if the profiling is off, because the metrics are counted per family, see Family
+**/
+void ProfUtil::Begin(std::string family)
+{
+    families_.push_back({ family, IsOn() ? Tic() : tick_t{ 0.0, 0.0, 0.0 } });
+} /* end of Begin */
+
+/**
+* @brief   : End - to end the span of the innermost product family
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void ProfUtil::End()
+{
+    if (families_.empty()) return;
+
+    std::pair<std::string, tick_t> fam = families_.back();
+    families_.pop_back();
+    if (!IsOn()) return;
+    tick_t t1 = Tic();
+    event_t ev = { fam.first, "", "", fam.second.wall, t1.wall - fam.second.wall, (t1.cpu - fam.second.cpu) +
+        (t1.cpuc - fam.second.cpuc), 0.0, 0.0 };
+    events_.push_back(ev);
+} /* end of End */
+
+/**
+* @brief   : System - to run one command line by 'std::system', and record its span if the profiling is on
+* @param[I]: cmd (command line)
+* @param[O]: none
+* @return  : return value of 'std::system'
+* @note    : the CPU time of the command is the one of its processes, and the CPU time of spawning is the one spent in the
+*              process itself
+**/
+int ProfUtil::System(std::string cmd)
+{
+    /* the messages queued are written before the output of the command to the same console */
+    Logger::Flush();
+    if (!IsOn()) return std::system(cmd.c_str());
+
+    tick_t t0 = Tic();
+    int stat = std::system(cmd.c_str());
+    tick_t t1 = Tic();
+
+    double wall = t1.wall - t0.wall, spawncpu = t1.cpu - t0.cpu;
+    event_t ev = { Family(), Classify(cmd), cmd, t0.wall, wall,
+        spawncpu + (t1.cpuc - t0.cpuc), std::min(spawn_, wall), spawncpu };
+    events_.push_back(ev);
+    if (events_.size() >= 4096) Spill();
+
+    return stat;
+} /* end of System */
+
+/**
+* @brief   : Spill - to append the events recorded to the spill file
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    : one event per line, i.e., "<pid>\t<family>\t<stage or '-'>\t<start>\t<wall>\t<cpu>\t<spawn>\t<spawn cpu>\t<detail>",
+*              and all the lines are written at once, so that the lines of the concurrent processes are NOT interleaved
+**/
+void ProfUtil::Spill()
+{
+    if (!IsOn() || events_.empty()) return;
+
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(6);
+    for (size_t i = 0; i < events_.size(); i++)
+    {
+        const event_t& ev = events_[i];
+        std::string detail = ev.detail;
+        std::replace(detail.begin(), detail.end(), '\t', ' ');
+        std::replace(detail.begin(), detail.end(), '\n', ' ');
+        ss << getpid() << "\t" << ev.family << "\t" << (ev.stage.empty() ? "-" : ev.stage) << "\t" << ev.ts << "\t" <<
+            ev.wall << "\t" << ev.cpu << "\t" << ev.spawn << "\t" << ev.spawncpu << "\t" << detail << "\n";
+    }
+    events_.clear();
+
+    std::ofstream fp(file_.c_str(), std::ios::app);
+    if (!fp.is_open())
+    {
+        Logger::Trace(TWARNING, "*** WARNING(ProfUtil::Spill): open " + file_ + " failed, the profile is lost");
+        return;
+    }
+    std::string buff = ss.str();
+    fp.write(buff.c_str(), buff.size());
+    fp.close();
+} /* end of Spill */
+
+/**
+* @brief   : Report - to write the summary table and the Chrome trace-event JSON of all the events spilled by the
+*              processes of this run
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    : the spawning of each command line is counted out of its stage, and the time of one product family NOT spent
+*              in any stage is counted in PROF_OTHER. The spill file is kept, so that it is reported again after the next
+*              polling cycle of the watch mode
+**/
+void ProfUtil::Report()
+{
+    if (!IsOn()) return;
+    Spill();
+
+    /* calls, wall time (s) and CPU time (s) of each stage of each family */
+    struct sum_t { int n; double wall, cpu; };
+    std::map<std::string, std::map<std::string, sum_t>> sums;
+    std::map<std::string, sum_t> totals;
+    std::ostringstream trace;
+    trace << std::fixed << std::setprecision(3);
+    std::vector<std::string> lines;
+    std::ifstream fp(file_.c_str());
+    std::string line;
+    double tmin = 1.0e30;
+    while (fp.is_open() && getline(fp, line))
+    {
+        std::vector<std::string> items = CString::split(line, "\t");
+        if (items.size() < 8) continue;
+        lines.push_back(line);
+        tmin = std::min(tmin, atof(items[3].c_str()));
+    }
+    if (fp.is_open()) fp.close();
+
+    for (size_t i = 0; i < lines.size(); i++)
+    {
+        std::vector<std::string> items = CString::split(lines[i], "\t");
+        std::string pid = items[0], family = items[1], stage = items[2];
+        double ts = atof(items[3].c_str()), wall = atof(items[4].c_str()), cpu = atof(items[5].c_str());
+        double spawn = atof(items[6].c_str()), spawncpu = atof(items[7].c_str());
+        std::string detail = items.size() > 8 ? items[8] : "";
+
+        if (stage == "-")
+        {
+            sum_t& t = totals[family];
+            t.n++;
+            t.wall += wall;
+            t.cpu += cpu;
+        }
+        else
+        {
+            sum_t& s = sums[family][stage];
+            s.n++;
+            s.wall += wall - spawn;
+            s.cpu += cpu - spawncpu;
+            if (spawn > 0.0)
+            {
+                sum_t& p = sums[family][PROF_SPAWN];
+                p.n++;
+                p.wall += spawn;
+                p.cpu += spawncpu;
+            }
+        }
+
+        /* the complete events ('ph' = 'X') in microseconds, one thread per process */
+        trace << (i == 0 ? "\n" : ",\n") << "{\"name\":\"" << (stage == "-" ? family : stage) << "\",\"cat\":\"" <<
+            (stage == "-" ? "family" : family) << "\",\"ph\":\"X\",\"ts\":" << (ts - tmin) * 1.0e6 << ",\"dur\":" <<
+            wall * 1.0e6 << ",\"pid\":" << pid << ",\"tid\":" << pid << ",\"args\":{\"cpu_s\":" << cpu;
+        if (!detail.empty()) trace << ",\"detail\":\"" << CString::EscapeJson(detail) << "\"";
+        trace << "}}";
+    }
+
+    std::ofstream fptrace(tracefile_.c_str(), std::ios::out);
+    if (fptrace.is_open())
+    {
+        fptrace << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" << trace.str() << "\n]}\n";
+        fptrace.close();
+    }
+    else Logger::Trace(TWARNING, "*** WARNING(ProfUtil::Report): open " + tracefile_ + " failed, please check it");
+
+    /* the rest of each family is spent in the process itself, i.e., scanning the directories and parsing the listings */
+    std::vector<std::string> stages = { PROF_SPAWN, PROF_LISTING, PROF_TRANSFER, PROF_VERIFY, PROF_DECOMPRESS, PROF_CRX2RNX,
+        PROF_FS, PROF_MERGE, PROF_OTHER };
+    std::map<std::string, sum_t> all;
+    for (auto it = totals.begin(); it != totals.end(); ++it) sums[it->first];
+    for (auto it = sums.begin(); it != sums.end(); ++it)
+    {
+        auto itt = totals.find(it->first);
+        if (itt != totals.end())
+        {
+            sum_t rest = { itt->second.n, itt->second.wall, itt->second.cpu };
+            for (auto its = it->second.begin(); its != it->second.end(); ++its)
+            {
+                rest.wall -= its->second.wall;
+                rest.cpu -= its->second.cpu;
+            }
+            sum_t& s = it->second[PROF_OTHER];
+            s.wall += std::max(rest.wall, 0.0);
+            s.cpu += std::max(rest.cpu, 0.0);
+        }
+        for (auto its = it->second.begin(); its != it->second.end(); ++its)
+        {
+            sum_t& a = all[its->first];
+            a.n += its->second.n;
+            a.wall += its->second.wall;
+            a.cpu += its->second.cpu;
+        }
+    }
+
+    std::ostringstream table;
+    table << std::fixed << std::setprecision(3);
+    table << std::left << std::setw(16) << "family" << std::setw(12) << "stage" << std::right << std::setw(8) << "calls" <<
+        std::setw(14) << "wall (s)" << std::setw(14) << "cpu (s)" << std::setw(10) << "wall (%)" << "\n";
+    for (auto it = sums.begin(); it != sums.end(); ++it)
+    {
+        double wsum = 0.0;
+        for (auto its = it->second.begin(); its != it->second.end(); ++its) wsum += its->second.wall;
+        for (size_t j = 0; j < stages.size(); j++)
+        {
+            auto its = it->second.find(stages[j]);
+            if (its == it->second.end() || (its->second.n == 0 && its->second.wall <= 0.0)) continue;
+            table << std::left << std::setw(16) << it->first << std::setw(12) << stages[j] << std::right << std::setw(8) <<
+                its->second.n << std::setw(14) << its->second.wall << std::setw(14) << its->second.cpu << std::setw(10) <<
+                std::setprecision(1) << (wsum > 0.0 ? its->second.wall / wsum * 100.0 : 0.0) << std::setprecision(3) << "\n";
+        }
+    }
+    double wall = 0.0;
+    for (auto its = all.begin(); its != all.end(); ++its) wall += its->second.wall;
+    for (size_t j = 0; j < stages.size(); j++)
+    {
+        auto its = all.find(stages[j]);
+        if (its == all.end()) continue;
+        table << std::left << std::setw(16) << "total" << std::setw(12) << stages[j] << std::right << std::setw(8) <<
+            its->second.n << std::setw(14) << its->second.wall << std::setw(14) << its->second.cpu << std::setw(10) <<
+            std::setprecision(1) << (wall > 0.0 ? its->second.wall / wall * 100.0 : 0.0) << std::setprecision(3) << "\n";
+    }
+
+    std::ofstream fptable(tablefile_.c_str(), std::ios::out);
+    if (fptable.is_open())
+    {
+        fptable << table.str();
+        fptable.close();
+    }
+    Logger::Trace(TINFO, "*** INFO(ProfUtil::Report): time spent per product family and stage (Chrome trace in " +
+        tracefile_ + ")\n" + table.str());
+} /* end of Report */
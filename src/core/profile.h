@@ -0,0 +1,150 @@
+/*------------------------------------------------------------------------------
+* profile.h : header file of profile.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+/* constants/macros ----------------------------------------------------------*/
+#define PROF_SPAWN       "spawn"       /* spawning of the external processes (i.e., the shell of 'std::system') */
+#define PROF_LISTING     "listing"     /* remote listing, i.e., 'wget --no-remove-listing' or 'wget --spider' */
+#define PROF_TRANSFER    "transfer"    /* network transfer, i.e., 'wget' */
+#define PROF_DECOMPRESS  "decompress"  /* decompression, i.e., 'gzip -d' */
+#define PROF_VERIFY      "verify"      /* integrity test and checksum of the files transferred, i.e., 'gzip -t' or the digests */
+#define PROF_CRX2RNX     "crx2rnx"     /* Hatanaka decompression, i.e., 'crx2rnx' */
+#define PROF_FS          "fs"          /* file system operations, i.e., 'mkdir', 'mv', 'rm' or the hardlinks of the cache */
+#define PROF_MERGE       "merge"       /* merging steps, i.e., the SP3 files of three days into one */
+#define PROF_OTHER       "other"       /* the rest of one product family spent in the process itself */
+
+class ProfUtil
+{
+public:
+    struct tick_t                        /* time stamp of the profiling */
+    {
+        double wall;                     /* wall time (s) of the steady clock */
+        double cpu;                      /* CPU time (s) of the process itself */
+        double cpuc;                     /* CPU time (s) of the terminated child processes */
+    };
+
+private:
+    struct event_t                       /* one span in the profile */
+    {
+        std::string family;              /* product family, i.e., "obs_igs", "orbclk_cod" */
+        std::string stage;               /* stage (PROF_*), empty for the span of the whole family */
+        std::string detail;              /* the command line or the other detail */
+        double ts;                       /* start time (s) of the steady clock */
+        double wall;                     /* wall time (s) */
+        double cpu;                      /* CPU time (s) */
+        double spawn;                    /* wall time (s) of spawning the process, included in 'wall' */
+        double spawncpu;                 /* CPU time (s) of spawning the process in the process itself, included in 'cpu' */
+    };
+
+    static std::string file_;            /* spill file of the events, shared by the processes of one run, empty: off */
+    static std::string tracefile_;       /* Chrome trace-event JSON file */
+    static std::string tablefile_;       /* summary table file */
+    static double spawn_;                /* wall time (s) of spawning one process, calibrated by Open */
+    static std::vector<std::pair<std::string, tick_t>> families_;  /* the product families being fetched, the innermost last */
+    static std::vector<event_t> events_; /* the events NOT spilled yet */
+
+    /**
+    * @brief   : Classify - to get the stage of one command line
+    * @param[I]: cmd (command line)
+    * @param[O]: none
+    * @return  : stage (PROF_*)
+    * @note    :
+    **/
+    static std::string Classify(std::string cmd);
+
+public:
+    /**
+    * @brief   : Open - to switch the profiling on, and calibrate the time of spawning one process
+    * @param[I]: dir (directory of the profile files)
+    * @param[I]: tag (tag of the file names, i.e., "_shard0of4")
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    static void Open(std::string dir, std::string tag);
+
+    /**
+    * @brief   : IsOn - to check whether the profiling is on
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true: on, false: off
+    * @note    :
+    **/
+    static bool IsOn() { return !file_.empty(); }
+
+    /**
+    * @brief   : Tic - to get the time stamp now
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : time stamp
+    * @note    :
+    **/
+    static tick_t Tic();
+
+    /**
+    * @brief   : Toc - to record one span of one stage in the process itself, from one time stamp to now
+    * @param[I]: stage (PROF_*)
+    * @param[I]: t0 (time stamp at the start, see Tic)
+    * @param[I]: detail (the other detail, i.e., the file name)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    static void Toc(std::string stage, const tick_t& t0, std::string detail = "");
+
+    /**
+    * @brief   : Begin - to begin the span of one product family, the stages recorded until End are counted in it
+    * @param[I]: family (product family, i.e., "obs_igs", "nav", "orbclk_cod")
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    static void Begin(std::string family);
+
+    /**
+    * @brief   : End - to end the span of the innermost product family
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    static void End();
+
+    /**
+    * @brief   : Family - to get the innermost product family being fetched
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : product family, "general" if none
+    * @note    :
+    **/
+    static std::string Family() { return families_.empty() ? "general" : families_.back().first; }
+
+    /**
+    * @brief   : System - to run one command line by 'std::system', and record its span if the profiling is on
+    * @param[I]: cmd (command line)
+    * @param[O]: none
+    * @return  : return value of 'std::system'
+    * @note    :
+    **/
+    static int System(std::string cmd);
+
+    /**
+    * @brief   : Spill - to append the events recorded to the spill file
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    : it must be called before the child process of the backfill mode exits
+    **/
+    static void Spill();
+
+    /**
+    * @brief   : Report - to write the summary table and the Chrome trace-event JSON of all the events spilled by the
+    *              processes of this run
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    static void Report();
+};
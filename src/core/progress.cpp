@@ -0,0 +1,245 @@
+/*------------------------------------------------------------------------------
+* progress.cpp : live progress and ETA of the downloading on the console
+*
+* Copyright (C) 2020-2099 by Ubiquitous Navigation & Integrated positioning lab in Quest (UNIQ), all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader)
+*
+* history : 2026/10/19 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "../common/common.h"
+#include "../common/types.h"
+#include "../common/cstring.h"
+#include "../common/logger.h"
+#include "metrics.h"
+#include "progress.h"
+
+/* global variables ----------------------------------------------------------*/
+std::map<std::string, ProgressUtil::family_t> ProgressUtil::families_;
+std::mutex ProgressUtil::lock_;
+std::condition_variable ProgressUtil::cv_;
+std::thread* ProgressUtil::thread_ = NULL;
+bool ProgressUtil::stop_ = false;
+bool ProgressUtil::istty_ = false;
+double ProgressUtil::intvl_ = 30.0;
+std::chrono::steady_clock::time_point ProgressUtil::tstart_;
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : Start - to start the display of the progress
+* @param[I]: intvl (interval (s) between two messages if the console is NOT a terminal)
+* @param[O]: none
+* @return  : none
+* @note    : on a terminal, the status line is kept at the bottom, and the messages of all the processes erase it before
+*              they are printed, see Logger::Status
+**/
+void ProgressUtil::Start(double intvl)
+{
+    if (thread_ != NULL) return;
+
+#ifdef _WIN32   /* for Windows */
+    istty_ = _isatty(_fileno(stdout)) != 0;
+#else           /* for Linux or Mac */
+    istty_ = isatty(STDOUT_FILENO) != 0;
+#endif
+    intvl_ = intvl;
+    stop_ = false;
+    tstart_ = std::chrono::steady_clock::now();
+    Logger::StatusMode(istty_);
+    thread_ = new std::thread(ProgressUtil::Run);
+} /* end of Start */
+
+/**
+* @brief   : Plan - to add one job to the progress
+* @param[I]: family (product family, i.e., "obs_igs", "nav", "orbclk_cod")
+* @param[I]: size (estimated size (bytes) of the files of the job)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void ProgressUtil::Plan(std::string family, double size)
+{
+    if (thread_ == NULL) return;
+
+    std::lock_guard<std::mutex> lock(lock_);
+    family_t& fam = families_[family];
+    fam.ntotal++;
+    fam.sizetotal += size;
+} /* end of Plan */
+
+/**
+* @brief   : Done - to mark one job done
+* @param[I]: family (product family, see Plan)
+* @param[I]: size (estimated size (bytes) of the files of the job, see Plan)
+* @param[I]: isok (true: done, false: failed)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void ProgressUtil::Done(std::string family, double size, bool isok)
+{
+    if (thread_ == NULL) return;
+
+    std::lock_guard<std::mutex> lock(lock_);
+    family_t& fam = families_[family];
+    fam.ndone++;
+    if (!isok) fam.nfail++;
+    fam.sizedone += size;
+} /* end of Done */
+
+/**
+* @brief   : Stop - to stop the display and print the final progress
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void ProgressUtil::Stop()
+{
+    if (thread_ == NULL) return;
+
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        stop_ = true;
+    }
+    cv_.notify_one();
+    if (thread_->joinable()) thread_->join();
+    delete thread_;
+    thread_ = NULL;
+
+    std::vector<std::pair<double, double>> samples;
+    std::string line = Line(samples);
+    if (istty_)
+    {
+        Logger::Status(line, true);
+        Logger::StatusMode(false);
+    }
+    else Logger::Trace(TINFO, "*** INFO(ProgressUtil::Stop): " + line);
+    families_.clear();
+} /* end of Stop */
+
+/**
+* @brief   : Run - the loop of the thread of the display
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void ProgressUtil::Run()
+{
+    std::vector<std::pair<double, double>> samples;
+    std::unique_lock<std::mutex> lock(lock_);
+    while (true)
+    {
+        double ms = istty_ ? (double)PROG_TTYMS : intvl_ * 1000.0;
+        cv_.wait_for(lock, std::chrono::milliseconds((long long)ms), [] { return stop_; });
+        if (stop_) break;
+
+        std::string line = Line(samples);
+        lock.unlock();
+        if (istty_)
+        {
+            /* the line folded by the terminal is NOT erased by the next one */
+            int width = Width();
+            if ((int)line.size() >= width) line = line.substr(0, std::max(width - 4, 0)) + "...";
+            Logger::Status(line, false);
+        }
+        else Logger::Trace(TINFO, "*** INFO(ProgressUtil::Run): " + line);
+        lock.lock();
+    }
+} /* end of Run */
+
+/**
+* @brief   : Line - to get the progress in one line
+* @param[I]: samples (times (s) and bytes transferred in the window of the throughput)
+* @param[O]: samples (the sample now appended, the expired ones removed)
+* @return  : progress, i.e., "jobs 12/40 (obs_igs 3/10, nav 9/10, ...) | 1.2 GB, 8.5 MB/s | streams CDDIS 2 | ETA 00:12:34"
+* @note    : the bytes are counted when each file is transferred, and the ETA is the time left at the average rate of the
+*              estimated sizes of the jobs done, i.e., the same sizes as the order of the backfill mode
+**/
+std::string ProgressUtil::Line(std::vector<std::pair<double, double>>& samples)
+{
+    /* the size in B, KB, MB or GB */
+    auto human = [](double bytes) -> std::string {
+        const char* units[] = { "B", "KB", "MB", "GB", "TB" };
+        int i = 0;
+        while (bytes >= 1024.0 && i < 4)
+        {
+            bytes /= 1024.0;
+            i++;
+        }
+        std::ostringstream ss;
+        ss << std::fixed << std::setprecision(i == 0 ? 0 : 1) << bytes << " " << units[i];
+        return ss.str();
+    };
+    /* the time in hh:mm:ss */
+    auto hms = [](double sec) -> std::string {
+        long long s = (long long)(sec + 0.5);
+        return CString::int2str((int)(s / 3600), 2) + ":" + CString::int2str((int)(s / 60 % 60), 2) + ":" +
+            CString::int2str((int)(s % 60), 2);
+    };
+
+    double tnow = std::chrono::duration<double>(std::chrono::steady_clock::now() - tstart_).count();
+    int ntotal = 0, ndone = 0, nfail = 0;
+    double sizetotal = 0.0, sizedone = 0.0;
+    std::string fams;
+    for (auto it = families_.begin(); it != families_.end(); ++it)
+    {
+        const family_t& fam = it->second;
+        ntotal += fam.ntotal;
+        ndone += fam.ndone;
+        nfail += fam.nfail;
+        sizetotal += fam.sizetotal;
+        sizedone += fam.sizedone;
+        fams += (fams.empty() ? "" : ", ") + it->first + " " + std::to_string(fam.ndone) + "/" + std::to_string(fam.ntotal);
+    }
+
+    /* the aggregate throughput in the window */
+    std::map<std::string, double> values;
+    double bytes = MetricsUtil::Sum("good_transfer_bytes_total", "host", values);
+    samples.push_back({ tnow, bytes });
+    while (samples.size() > 2 && tnow - samples[1].first >= PROG_WINDOW) samples.erase(samples.begin());
+    double dt = tnow - samples.front().first;
+    double rate = dt > 0.0 ? (bytes - samples.front().second) / dt : (tnow > 0.0 ? bytes / tnow : 0.0);
+
+    std::string line = "jobs " + std::to_string(ndone) + "/" + std::to_string(ntotal);
+    if (nfail > 0) line += " (" + std::to_string(nfail) + " failed)";
+    if (!fams.empty()) line += " [" + fams + "]";
+    line += " | " + human(bytes) + ", " + human(rate) + "/s";
+
+    /* the transfers running per host */
+    MetricsUtil::Sum("good_active_transfers", "host", values);
+    std::string streams;
+    for (auto it = values.begin(); it != values.end(); ++it)
+    {
+        int n = (int)(it->second + 0.5);
+        if (n > 0) streams += " " + it->first + " " + std::to_string(n);
+    }
+    line += " | streams" + (streams.empty() ? std::string(" none") : streams);
+
+    if (ndone >= ntotal) line += " | elapsed " + hms(tnow);
+    else if (sizedone > 0.0) line += " | ETA " + hms(tnow * (sizetotal - sizedone) / sizedone);
+    else line += " | ETA --:--:--";
+
+    return line;
+} /* end of Line */
+
+/**
+* @brief   : Width - to get the width of the terminal
+* @param[I]: none
+* @param[O]: none
+* @return  : number of columns, 80 if unknown
+* @note    :
+**/
+int ProgressUtil::Width()
+{
+#ifdef _WIN32   /* for Windows */
+    CONSOLE_SCREEN_BUFFER_INFO csbi;
+    if (GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi)) return csbi.srWindow.Right - csbi.srWindow.Left + 1;
+#else           /* for Linux or Mac */
+    struct winsize ws;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) == 0 && ws.ws_col > 0) return (int)ws.ws_col;
+#endif
+
+    return 80;
+} /* end of Width */
@@ -0,0 +1,107 @@
+/*------------------------------------------------------------------------------
+* progress.h : header file of progress.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+/* constants/macros ----------------------------------------------------------*/
+#define PROG_TTYMS     1000              /* interval (ms) between two redraws of the status line on a terminal */
+#define PROG_WINDOW    10.0              /* time span (s) of the window of the aggregate throughput */
+
+class ProgressUtil
+{
+private:
+    struct family_t                      /* jobs of one product family */
+    {
+        int ntotal;                      /* jobs planned */
+        int ndone;                       /* jobs done, including the failed ones */
+        int nfail;                       /* jobs failed */
+        double sizetotal;                /* estimated size (bytes) of the jobs planned */
+        double sizedone;                 /* estimated size (bytes) of the jobs done */
+    };
+
+    static std::map<std::string, family_t> families_;  /* jobs of each product family */
+    static std::mutex lock_;             /* lock of the jobs and the flags, the child processes never take it */
+    static std::condition_variable cv_;  /* to wake up the thread of the display */
+    static std::thread* thread_;         /* thread of the display, NULL: off */
+    static bool stop_;                   /* to stop the thread of the display */
+    static bool istty_;                  /* true: one status line redrawn on the terminal, false: one message per interval */
+    static double intvl_;                /* interval (s) between two messages if the console is NOT a terminal */
+    static std::chrono::steady_clock::time_point tstart_;  /* start of the run */
+
+    /**
+    * @brief   : Run - the loop of the thread of the display
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    static void Run();
+
+    /**
+    * @brief   : Line - to get the progress in one line
+    * @param[I]: samples (times (s) and bytes transferred in the window of the throughput)
+    * @param[O]: samples (the sample now appended, the expired ones removed)
+    * @return  : progress, i.e., "jobs 12/40 (obs_igs 3/10, nav 9/10, ...) | 1.2 GB, 8.5 MB/s | streams CDDIS 2 | ETA 00:12:34"
+    * @note    : under 'lock_'
+    **/
+    static std::string Line(std::vector<std::pair<double, double>>& samples);
+
+    /**
+    * @brief   : Width - to get the width of the terminal
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : number of columns, 80 if unknown
+    * @note    :
+    **/
+    static int Width();
+
+public:
+    /**
+    * @brief   : Start - to start the display of the progress
+    * @param[I]: intvl (interval (s) between two messages if the console is NOT a terminal)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the counters of the bytes and streams are shared with the child processes by MetricsUtil, which must be
+    *              opened before
+    **/
+    static void Start(double intvl);
+
+    /**
+    * @brief   : IsOn - to check whether the progress is displayed
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true: on, false: off
+    * @note    :
+    **/
+    static bool IsOn() { return thread_ != NULL; }
+
+    /**
+    * @brief   : Plan - to add one job to the progress
+    * @param[I]: family (product family, i.e., "obs_igs", "nav", "orbclk_cod")
+    * @param[I]: size (estimated size (bytes) of the files of the job)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    static void Plan(std::string family, double size);
+
+    /**
+    * @brief   : Done - to mark one job done
+    * @param[I]: family (product family, see Plan)
+    * @param[I]: size (estimated size (bytes) of the files of the job, see Plan)
+    * @param[I]: isok (true: done, false: failed)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    static void Done(std::string family, double size, bool isok);
+
+    /**
+    * @brief   : Stop - to stop the display and print the final progress
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    static void Stop();
+};
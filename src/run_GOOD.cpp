@@ -32,11 +32,28 @@
 int main(int argc, char * argv[])
 {
     std::string cfgfile;  /* configuration file */
-    if (argc != 2)
+    int ishard = 0, nshard = 1, nmerge = 0;  /* '--shard ishard/nshard' or '--merge nshard' */
+    bool profile = false;  /* '--profile' */
+    bool isverify = false;  /* '--verify' */
+    bool stat = argc >= 2;
+    for (int i = 2; i < argc && stat; i++)
     {
-        std::cout << std::endl;
-        Logger::Trace(TEXPORT, "* Usage: run_GOOD GOOD_cfg.yaml");
-        std::cout << std::endl;
+        std::string arg = argv[i];
+        if (arg == "--profile") profile = true;
+        else if (arg == "--verify") isverify = true;
+        else if (arg == "--shard" && i + 1 < argc)
+        {
+            stat = sscanf(argv[++i], "%d/%d", &ishard, &nshard) == 2 && nshard >= 1 && ishard >= 0 && ishard < nshard;
+        }
+        else if (arg == "--merge" && i + 1 < argc)
+        {
+            stat = sscanf(argv[++i], "%d", &nmerge) == 1 && nmerge >= 1;
+        }
+        else stat = false;
+    }
+    if (!stat)
+    {
+        Logger::Trace(TEXPORT, "\n* Usage: run_GOOD GOOD_cfg.yaml [--shard i/N | --merge N] [--verify] [--profile]\n");
 
         return -1;
     }
@@ -46,9 +63,12 @@ int main(int argc, char * argv[])
     Logger::Trace(TEXPORT, "===================================================================================================");
     Logger::Trace(TEXPORT, "* Now, we are running GAMP II - GOOD (GNSS Observations and prOducts Downloader)\n");
 
-    Config::run(cfgfile);
+    if (nmerge > 0) Config::merge(cfgfile, nmerge);
+    else if (isverify) Config::verify(cfgfile, ishard, nshard);
+    else Config::run(cfgfile, ishard, nshard, profile);
 
 #if (defined(_WIN32) && defined(_DEBUG))  /* for Windows */
+    Logger::Flush();
     std::cout << std::endl << "Press any key to exit!" << std::endl;
     getchar();
 #endif